@@ -35,12 +35,16 @@
 #include "simulationControl/SimulationDescription.hpp"
 #include "mappings/simulation/Filesystem.hpp"
 #include "eventSystem/events/EventPool.hpp"
+#include "eventSystem/graph/StepGraph.hpp"
 #include "Environment.def"
 #include "communication/manager_common.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 #include "assert.hpp"
 
 #include <cuda_runtime.h>
 #include <mpi.h>
+#include <algorithm>
+#include <stdexcept>
 
 namespace PMacc
 {
@@ -64,13 +68,17 @@ namespace detail
         EnvironmentContext( ) :
             m_isMpiInitialized( false ),
             m_isDeviceSelected( false ),
-            m_isSubGridDefined( false )
+            m_isSubGridDefined( false ),
+            m_mpiThreadLevel( MPI_THREAD_SERIALIZED )
         {
         }
 
         /** initialization state of MPI */
         bool m_isMpiInitialized;
 
+        /** level of thread support requested from MPI */
+        int m_mpiThreadLevel;
+
         /** state if a computing device is selected */
         bool m_isDeviceSelected;
 
@@ -114,6 +122,17 @@ namespace detail
             return m_isSubGridDefined;
         }
 
+        /** raise the level of thread support requested from MPI
+         *
+         * @param threadLevel MPI_THREAD_* constant
+         */
+        void requestMpiThreadLevel( int threadLevel )
+        {
+            if( m_isMpiInitialized )
+                throw std::runtime_error( "the MPI thread level must be requested before MPI is initialized" );
+            m_mpiThreadLevel = std::max( m_mpiThreadLevel, threadLevel );
+        }
+
         /** initialize the environment
          *
          * After this call it is allowed to use MPI.
@@ -224,6 +243,15 @@ namespace detail
             return EventPool::getInstance();
         }
 
+        /** get the singleton StepGraph
+         *
+         * @return instance of StepGraph
+         */
+        PMacc::StepGraph& StepGraph()
+        {
+            return StepGraph::getInstance();
+        }
+
         /** get the singleton ParticleFactory
          *
          * @return instance of ParticleFactory
@@ -327,6 +355,39 @@ public:
         return instance;
     }
 
+    /** request a level of thread support of MPI
+     *
+     * Must be called before MPI is initialized by initStagingRanks() or
+     * initDevices(), e.g. while the command line is parsed. The highest
+     * requested level is used, the default is MPI_THREAD_SERIALIZED.
+     * Users must check the provided level with `MPI_Query_thread`.
+     *
+     * @param threadLevel MPI_THREAD_* constant
+     */
+    void requestMpiThreadLevel( int threadLevel )
+    {
+        detail::EnvironmentContext::getInstance().requestMpiThreadLevel( threadLevel );
+    }
+
+    /** reserve MPI ranks for staging
+     *
+     * Must be called on all MPI ranks before initDevices(). The last
+     * `numStagingRanks` ranks are excluded from the simulation, all
+     * communicators of PMacc only contain the remaining ranks.
+     * Staging ranks must not call initDevices().
+     *
+     * @param numStagingRanks number of ranks reserved for staging
+     * @return true if this rank is a staging rank
+     */
+    bool initStagingRanks(uint32_t numStagingRanks)
+    {
+        // initialize the MPI context
+        detail::EnvironmentContext::getInstance().init();
+
+        mpi::CommunicatorSplit::get().init(numStagingRanks);
+        return mpi::CommunicatorSplit::get().isStagingRank();
+    }
+
     /** create and initialize the environment of PMacc
      *
      * Usage of MPI or device(accelerator) function calls before this method
@@ -416,15 +477,26 @@ private:
 namespace detail
 {
 
-    void EnvironmentContext::init()
+    inline void EnvironmentContext::init()
     {
+        // MPI is already initialized if staging ranks are reserved
+        if( m_isMpiInitialized )
+            return;
+
         m_isMpiInitialized = true;
 
-        // MPI_Init with NULL is allowed since MPI 2.0
-        MPI_CHECK(MPI_Init(NULL,NULL));
+        /* MPI_Init with NULL is allowed since MPI 2.0
+         *
+         * Serialized MPI calls from helper threads are requested by default
+         * (e.g. for prefetching file reads), a higher level only if a user
+         * needs it (see requestMpiThreadLevel()). Users must check the
+         * provided level with `MPI_Query_thread`.
+         */
+        int providedThreadLevel = MPI_THREAD_SINGLE;
+        MPI_CHECK(MPI_Init_thread(NULL, NULL, m_mpiThreadLevel, &providedThreadLevel));
     }
 
-    void EnvironmentContext::finalize()
+    inline void EnvironmentContext::finalize()
     {
         if( m_isMpiInitialized )
         {
@@ -432,6 +504,7 @@ namespace detail
             // Required by scorep for flushing the buffers
             cudaDeviceSynchronize();
             m_isMpiInitialized = false;
+            mpi::CommunicatorSplit::get().finalize();
             /* Free the MPI context.
              * The gpu context is freed by the `StreamController`, because
              * MPI and CUDA are independent.
@@ -440,7 +513,7 @@ namespace detail
         }
     }
 
-    void EnvironmentContext::setDevice(int deviceNumber)
+    inline void EnvironmentContext::setDevice(int deviceNumber)
     {
         int num_gpus = 0; //number of gpus
         cudaGetDeviceCount(&num_gpus);
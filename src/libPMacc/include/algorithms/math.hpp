@@ -23,6 +23,7 @@
 
 #include "pmacc_types.hpp"
 
+#include "algorithms/math/defines/precision.hpp"
 #include "algorithms/math/defines/abs.hpp"
 #include "algorithms/math/defines/sqrt.hpp"
 #include "algorithms/math/defines/exp.hpp"
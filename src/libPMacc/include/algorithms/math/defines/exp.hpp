@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "algorithms/math/defines/precision.hpp"
+
 namespace PMacc
 {
 namespace algorithms
@@ -30,12 +32,24 @@ namespace math
 {
 
 
-template<typename Type>
+template<typename Type, typename T_Precision = Precise>
 struct Exp;
 
+/* Fast falls back to Precise */
 template<typename Type>
+struct Exp< Type, Fast > : public Exp< Type >
+{
+};
+
+template<typename Type, typename T_Precision = Precise>
 struct Log;
 
+/* Fast falls back to Precise */
+template<typename Type>
+struct Log< Type, Fast > : public Log< Type >
+{
+};
+
 template<typename Type>
 struct Log10;
 
@@ -57,6 +71,18 @@ HDINLINE typename Log10< T1 >::result log10(const T1& value)
     return Log10< T1 > ()(value);
 }
 
+template<typename T1, typename T_Precision>
+HDINLINE typename Exp< T1, T_Precision >::result exp(const T1& value, const T_Precision&)
+{
+    return Exp< T1, T_Precision > ()(value);
+}
+
+template<typename T1, typename T_Precision>
+HDINLINE typename Log< T1, T_Precision >::result log(const T1& value, const T_Precision&)
+{
+    return Log< T1, T_Precision > ()(value);
+}
+
 } //namespace math
 } //namespace algorithms
 }//namespace PMacc
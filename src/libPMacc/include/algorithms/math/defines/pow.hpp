@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include "algorithms/math/defines/precision.hpp"
+
 namespace PMacc
 {
 namespace algorithms
@@ -29,9 +31,15 @@ namespace algorithms
 namespace math
 {
 
-template<typename T1, typename T2>
+template<typename T1, typename T2, typename T_Precision = Precise>
 struct Pow;
 
+/* Fast falls back to Precise */
+template<typename T1, typename T2>
+struct Pow< T1, T2, Fast > : public Pow< T1, T2 >
+{
+};
+
 
 /** Raised the base to the power exponent
  *
@@ -45,6 +53,16 @@ HDINLINE typename Pow< T1, T2 >::result pow(const T1& base,const T2& exponent)
     return Pow< T1, T2 > ()(base, exponent);
 }
 
+/** Raised the base to the power exponent with a precision policy
+ *
+ * @see precision.hpp
+ */
+template<typename T1, typename T2, typename T_Precision>
+HDINLINE typename Pow< T1, T2, T_Precision >::result pow(const T1& base, const T2& exponent, const T_Precision&)
+{
+    return Pow< T1, T2, T_Precision > ()(base, exponent);
+}
+
 } //namespace math
 } //namespace algorithms
 }//namespace PMacc
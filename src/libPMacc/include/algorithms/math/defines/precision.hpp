@@ -0,0 +1,60 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace PMacc
+{
+namespace algorithms
+{
+namespace math
+{
+
+/** precision policies of the math functors
+ *
+ * The functors Exp, Log, Sin, Cos, SinCos, Sqrt, RSqrt and Pow have an
+ * optional precision policy as last template parameter, e.g.
+ * `Exp< float, Fast >`. The free functions take it as last argument,
+ * e.g. `math::exp( x, Fast( ) )`.
+ *
+ * A type without a Fast implementation uses the Precise one.
+ */
+
+/** standard functions of the C library and CUDA (default) */
+struct Precise
+{
+};
+
+/** approximations, e.g. the CUDA intrinsics
+ *
+ * Only float has a Fast implementation. The maximal errors are
+ * documented at the float specializations (floatMath). On the host the
+ * same formulas are evaluated with the standard functions (e.g. exp as
+ * exp2f, sin and cos after the reduction to [-pi, pi]), the results are
+ * within the documented errors but not bitwise equal to the device.
+ */
+struct Fast
+{
+};
+
+} //namespace math
+} //namespace algorithms
+} //namespace PMacc
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include "algorithms/math/defines/precision.hpp"
+
 namespace PMacc
 {
 namespace algorithms
@@ -28,12 +30,24 @@ namespace algorithms
 namespace math
 {
 
-template<typename Type>
+template<typename Type, typename T_Precision = Precise>
 struct Sqrt;
 
+/* Fast falls back to Precise */
 template<typename Type>
+struct Sqrt< Type, Fast > : public Sqrt< Type >
+{
+};
+
+template<typename Type, typename T_Precision = Precise>
 struct RSqrt;
 
+/* Fast falls back to Precise */
+template<typename Type>
+struct RSqrt< Type, Fast > : public RSqrt< Type >
+{
+};
+
 
 template<typename T1>
 HDINLINE typename Sqrt< T1 >::result sqrt(const T1& value)
@@ -47,6 +61,18 @@ HDINLINE typename RSqrt< T1 >::result rsqrt(const T1& value)
     return RSqrt< T1 > ()(value);
 }
 
+template<typename T1, typename T_Precision>
+HDINLINE typename Sqrt< T1, T_Precision >::result sqrt(const T1& value, const T_Precision&)
+{
+    return Sqrt< T1, T_Precision > ()(value);
+}
+
+template<typename T1, typename T_Precision>
+HDINLINE typename RSqrt< T1, T_Precision >::result rsqrt(const T1& value, const T_Precision&)
+{
+    return RSqrt< T1, T_Precision > ()(value);
+}
+
 } //namespace math
 } //namespace algorithms
 }//namespace PMacc
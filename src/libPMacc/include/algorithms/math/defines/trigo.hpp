@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include "algorithms/math/defines/precision.hpp"
+
 namespace PMacc
 {
 namespace algorithms
@@ -29,15 +31,27 @@ namespace algorithms
 namespace math
 {
 
-template<typename Type>
+template<typename Type, typename T_Precision = Precise>
 struct Sin;
 
+/* Fast falls back to Precise */
 template<typename Type>
-struct ASin;
+struct Sin< Type, Fast > : public Sin< Type >
+{
+};
 
 template<typename Type>
+struct ASin;
+
+template<typename Type, typename T_Precision = Precise>
 struct Cos;
 
+/* Fast falls back to Precise */
+template<typename Type>
+struct Cos< Type, Fast > : public Cos< Type >
+{
+};
+
 template<typename Type>
 struct ACos;
 
@@ -50,9 +64,15 @@ struct ATan;
 template<typename Type>
 struct Atan2;
 
-template<typename ArgType, typename SinType, typename CosType>
+template<typename ArgType, typename SinType, typename CosType, typename T_Precision = Precise>
 struct SinCos;
 
+/* Fast falls back to Precise */
+template<typename ArgType, typename SinType, typename CosType>
+struct SinCos< ArgType, SinType, CosType, Fast > : public SinCos< ArgType, SinType, CosType >
+{
+};
+
 template<typename Type>
 struct Sinc;
 
@@ -129,6 +149,30 @@ atan2(const T1& val1, const T1& val2)
     return Atan2< T1 > ()(val1, val2);
 }
 
+template<typename T1, typename T_Precision>
+HDINLINE
+typename Sin< T1, T_Precision >::result
+sin(const T1& value, const T_Precision&)
+{
+    return Sin< T1, T_Precision > ()(value);
+}
+
+template<typename T1, typename T_Precision>
+HDINLINE
+typename Cos< T1, T_Precision >::result
+cos(const T1& value, const T_Precision&)
+{
+    return Cos< T1, T_Precision > ()(value);
+}
+
+template<typename ArgType, typename SinType, typename CosType, typename T_Precision>
+HDINLINE
+typename SinCos< ArgType, SinType, CosType, T_Precision >::result
+sincos(ArgType arg, SinType& sinValue, CosType& cosValue, const T_Precision&)
+{
+    return SinCos< ArgType, SinType, CosType, T_Precision > ()(arg, sinValue, cosValue);
+}
+
 } /* namespace math */
 } /* namespace algorithms */
 } /* namespace PMacc */
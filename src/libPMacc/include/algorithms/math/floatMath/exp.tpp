@@ -55,6 +55,46 @@ struct Log<float>
     }
 };
 
+/** exp on the device with the intrinsic __expf
+ *
+ * maximal error: 2 + floor(abs(1.16 * value)) ulp
+ */
+template<>
+struct Exp<float, Fast>
+{
+    typedef float result;
+
+    HDINLINE float operator( )(const float& value )
+    {
+#if __CUDA_ARCH__
+        return ::__expf( value );
+#else
+        /* same formula as the intrinsic: 2^(value * log2(e)) */
+        return ::exp2f( value * 1.44269504088896340736f );
+#endif
+    }
+};
+
+/** log on the device with the intrinsic __logf
+ *
+ * maximal error: 2^-21.41 absolute for value in [0.5, 2], else 3 ulp
+ */
+template<>
+struct Log<float, Fast>
+{
+    typedef float result;
+
+    HDINLINE float operator( )(const float& value )
+    {
+#if __CUDA_ARCH__
+        return ::__logf( value );
+#else
+        /* same formula as the intrinsic: log2(value) * ln(2) */
+        return ::log2f( value ) * 0.69314718055994530942f;
+#endif
+    }
+};
+
 template<>
 struct Log10<float>
 {
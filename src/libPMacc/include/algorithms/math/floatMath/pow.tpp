@@ -51,6 +51,28 @@ struct Pow<float, float>
     }
 };
 
+/** pow on the device with the intrinsic __powf
+ *
+ * implemented as exp2(exponent * log2(base)) with intrinsics, the error
+ * is about the error of Exp<float, Fast> for exponent * log(base) plus
+ * the error of the intrinsic log2, only for base > 0
+ */
+template<>
+struct Pow<float, float, Fast>
+{
+    typedef float result;
+
+    HDINLINE result operator()(const float& base, const float& exponent)
+    {
+#ifdef __CUDA_ARCH__
+        return ::__powf(base, exponent);
+#else
+        /* same formula as the intrinsic */
+        return ::exp2f(exponent * ::log2f(base));
+#endif
+    }
+};
+
 template<>
 struct Pow<float, int>
 {
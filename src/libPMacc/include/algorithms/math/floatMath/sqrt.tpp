@@ -60,6 +60,30 @@ struct RSqrt<float>
     }
 };
 
+/** sqrt on the device with the approximated reciprocal square root
+ *
+ * maximal error: 3 ulp, not valid for infinity
+ */
+template<>
+struct Sqrt<float, Fast>
+{
+    typedef float result;
+
+    HDINLINE float operator( )(const float& value )
+    {
+#if __CUDA_ARCH__
+        /* avoid 0 * inf */
+        return value == 0.0f ? 0.0f : value * ::rsqrtf( value );
+#else
+        /* sqrtf is a single correctly rounded instruction on the host */
+        return ::sqrtf( value );
+#endif
+    }
+};
+
+/* RSqrt<float> uses the intrinsic rsqrtf on the device (maximal error:
+ * 2 ulp), RSqrt<float, Fast> falls back to it */
+
 } //namespace math
 } //namespace algorithms
 } // namespace PMacc
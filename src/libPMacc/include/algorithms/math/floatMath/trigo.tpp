@@ -45,6 +45,42 @@ struct Sin<float>
     }
 };
 
+namespace detail
+{
+    /** shift an angle to [-pi, pi]
+     *
+     * The intrinsics __sinf, __cosf and __sincosf are only accurate in
+     * [-pi, pi]. The shift adds an absolute error of up to
+     * abs(value) * 2^-23, about the resolution of value itself.
+     */
+    HDINLINE float reduceToPlusMinusPi( const float value )
+    {
+        const float twoPi = 6.28318530717958647692f;
+        const float twoPiReci = 0.15915494309189533577f;
+        return value - twoPi * ::rintf( value * twoPiReci );
+    }
+} //namespace detail
+
+/** sin on the device with the intrinsic __sinf
+ *
+ * maximal error: 2^-21.41 absolute for value in [-pi, pi], plus the
+ * error of detail::reduceToPlusMinusPi outside
+ */
+template<>
+struct Sin<float, Fast>
+{
+    typedef float result;
+
+    HDINLINE float operator( )(const float& value )
+    {
+#if __CUDA_ARCH__
+        return ::__sinf( detail::reduceToPlusMinusPi( value ) );
+#else
+        return ::sinf( detail::reduceToPlusMinusPi( value ) );
+#endif
+    }
+};
+
 template<>
 struct ASin<float>
 {
@@ -71,6 +107,26 @@ struct Cos<float>
     }
 };
 
+/** cos on the device with the intrinsic __cosf
+ *
+ * maximal error: 2^-21.41 absolute for value in [-pi, pi], plus the
+ * error of detail::reduceToPlusMinusPi outside
+ */
+template<>
+struct Cos<float, Fast>
+{
+    typedef float result;
+
+    HDINLINE float operator( )(const float& value )
+    {
+#if __CUDA_ARCH__
+        return ::__cosf( detail::reduceToPlusMinusPi( value ) );
+#else
+        return ::cosf( detail::reduceToPlusMinusPi( value ) );
+#endif
+    }
+};
+
 template<>
 struct ACos<float>
 {
@@ -124,6 +180,25 @@ struct SinCos<float, float, float>
     }
 };
 
+/** sincos on the device with the intrinsic __sincosf
+ *
+ * maximal error: see Sin<float, Fast> and Cos<float, Fast>
+ */
+template<>
+struct SinCos<float, float, float, Fast>
+{
+    typedef void result;
+
+    HDINLINE void operator( )(float arg, float& sinValue, float& cosValue )
+    {
+#if __CUDA_ARCH__
+        ::__sincosf( detail::reduceToPlusMinusPi( arg ), &sinValue, &cosValue );
+#else
+        SinCos<float, float, float>( )( detail::reduceToPlusMinusPi( arg ), sinValue, cosValue );
+#endif
+    }
+};
+
 
 
 template<>
@@ -24,6 +24,7 @@
 
 #include "communication/ICommunicator.hpp"
 #include "communication/manager_common.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 #include "dimensions/DataSpace.hpp"
 #include "memory/dataTypes/Mask.hpp"
 #include "pmacc_types.hpp"
@@ -78,7 +79,7 @@ public:
 
     /*! ctor
      */
-    CommunicatorMPI() : hostRank(0)
+    CommunicatorMPI() : hostRank(0), numSentMessages(0u), numSentBytes(0u)
     {
         //MPI_Init(nullptr, nullptr);
     }
@@ -127,15 +128,15 @@ public:
         this->periodic = periodic;
 
         //check if parameters are correct
-        MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &mpiSize));
+        MPI_CHECK(MPI_Comm_size(mpi::CommunicatorSplit::get().getSimulationComm(), &mpiSize));
 
         if (numberProcesses.productOfComponents() != mpiSize)
         {
             throw std::invalid_argument("wrong parameters or wrong mpirun-call!");
         }
 
-        //1. create Communicator (computing_comm) of computing nodes (ranks 0...n)
-        MPI_Comm computing_comm = MPI_COMM_WORLD;
+        //1. create Communicator (computing_comm) of computing nodes (ranks 0...n), staging ranks are excluded
+        MPI_Comm computing_comm = mpi::CommunicatorSplit::get().getSimulationComm();
 
         yoffset = 0;
 
@@ -201,11 +202,28 @@ public:
                             topology,
                             request));
 
+        ++numSentMessages;
+        numSentBytes += send_data_count;
+
         return request;
     }
 
     // description in ICommunicator
 
+    uint64_t getNumSentMessages() const
+    {
+        return numSentMessages;
+    }
+
+    // description in ICommunicator
+
+    uint64_t getNumSentBytes() const
+    {
+        return numSentBytes;
+    }
+
+    // description in ICommunicator
+
     MPI_Request* startReceive(uint32_t ex, char *recv_data, size_t recv_data_max, uint32_t tag)
     {
 
@@ -299,8 +317,9 @@ protected:
         cleanHostname(hostname);
         hostname[length++] = '\0';
 
-        MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &mpiSize));
-        MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank));
+        const MPI_Comm simulationComm = mpi::CommunicatorSplit::get().getSimulationComm();
+        MPI_CHECK(MPI_Comm_size(simulationComm, &mpiSize));
+        MPI_CHECK(MPI_Comm_rank(simulationComm, &mpiRank));
 
         if (mpiRank == 0)
         {
@@ -309,13 +328,13 @@ protected:
             hostRank = 0;
             for (int rank = 1; rank < mpiSize; ++rank)
             {
-                MPI_CHECK(MPI_Recv(hostname, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, rank, gridHostnameTag, MPI_COMM_WORLD, MPI_STATUS_IGNORE));
+                MPI_CHECK(MPI_Recv(hostname, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, rank, gridHostnameTag, simulationComm, MPI_STATUS_IGNORE));
 
                 //printf("Hostname: %s\n", hostname);
                 int hostrank = 0;
                 if (hosts.count(hostname) > 0) hostrank = hosts[hostname] + 1;
 
-                MPI_CHECK(MPI_Send(&hostrank, 1, MPI_INT, rank, gridHostRankTag, MPI_COMM_WORLD));
+                MPI_CHECK(MPI_Send(&hostrank, 1, MPI_INT, rank, gridHostRankTag, simulationComm));
 
                 hosts[hostname] = hostrank;
             }
@@ -323,9 +342,9 @@ protected:
         }
         else
         {
-            MPI_CHECK(MPI_Send(hostname, length, MPI_CHAR, GridManagerRank, gridHostnameTag, MPI_COMM_WORLD));
+            MPI_CHECK(MPI_Send(hostname, length, MPI_CHAR, GridManagerRank, gridHostnameTag, simulationComm));
 
-            MPI_CHECK(MPI_Recv(&hostRank, 1, MPI_INT, GridManagerRank, gridHostRankTag, MPI_COMM_WORLD, MPI_STATUS_IGNORE));
+            MPI_CHECK(MPI_Recv(&hostRank, 1, MPI_INT, GridManagerRank, gridHostRankTag, simulationComm, MPI_STATUS_IGNORE));
 
             // if(hostRank!=0) hostRank--; //!\todo fix mpi hostrank start with 1
         }
@@ -424,7 +443,7 @@ private:
     DataSpace<DIM> coordinates;
 
     DataSpace<DIM3> periodic;
-    //! MPI communicator (currently MPI_COMM_WORLD)
+    //! MPI communicator (cartesian topology of the simulation ranks)
     MPI_Comm topology;
     //! array for exchangetype-to-rank conversion \see ExchangeTypeToRank
     int ranks[27];
@@ -439,6 +458,9 @@ private:
 
     int mpiRank;
     int mpiSize;
+    //! statistics of startSend(), \see getNumSentMessages
+    uint64_t numSentMessages;
+    uint64_t numSentBytes;
 };
 
 } //namespace PMacc
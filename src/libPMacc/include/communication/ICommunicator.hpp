@@ -80,6 +80,14 @@ public:
 
     virtual int getRank()=0;
 
+    /*! number of messages started with startSend() since the start of the program
+     */
+    virtual uint64_t getNumSentMessages() const = 0;
+
+    /*! number of bytes started with startSend() since the start of the program
+     */
+    virtual uint64_t getNumSentBytes() const = 0;
+
     /*! Return which of the three directions are periodic
      *
      * \return for each direction a false (0) or true(1) value
@@ -25,6 +25,7 @@
 
 #include "mappings/simulation/GridController.hpp"
 #include "communication/manager_common.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 
 #include <iostream>
 #include <numeric>      // std::partial_sum
@@ -75,15 +76,17 @@ Gather<dim>::Gather(const zone::SphericZone<dim>& p_zone) : comm(MPI_COMM_NULL)
     PMacc::GridController<dim>& con = PMacc::Environment<dim>::get().GridController();
     Int<dim> pos = con.getPosition();
 
-    int numWorldRanks; MPI_Comm_size(MPI_COMM_WORLD, &numWorldRanks);
+    /* staging ranks are not part of the grid */
+    const MPI_Comm simulationComm = PMacc::mpi::CommunicatorSplit::get().getSimulationComm();
+    int numWorldRanks; MPI_Comm_size(simulationComm, &numWorldRanks);
     std::vector<Int<dim> > allPositions(numWorldRanks);
 
     MPI_CHECK(MPI_Allgather(static_cast<void*>(&pos), sizeof(Int<dim>), MPI_CHAR,
                   static_cast<void*>(allPositions.data()), sizeof(Int<dim>), MPI_CHAR,
-                  MPI_COMM_WORLD));
+                  simulationComm));
 
     std::vector<int> new_ranks;
-    int myWorldId; MPI_Comm_rank(MPI_COMM_WORLD, &myWorldId);
+    int myWorldId; MPI_Comm_rank(simulationComm, &myWorldId);
 
     this->m_participate = false;
     for(int i = 0; i < static_cast<int>(allPositions.size()); i++)
@@ -97,9 +100,9 @@ Gather<dim>::Gather(const zone::SphericZone<dim>& p_zone) : comm(MPI_COMM_NULL)
     }
     MPI_Group world_group, new_group;
 
-    MPI_CHECK(MPI_Comm_group(MPI_COMM_WORLD, &world_group));
+    MPI_CHECK(MPI_Comm_group(simulationComm, &world_group));
     MPI_CHECK(MPI_Group_incl(world_group, new_ranks.size(), new_ranks.data(), &new_group));
-    MPI_CHECK(MPI_Comm_create(MPI_COMM_WORLD, new_group, &this->comm));
+    MPI_CHECK(MPI_Comm_create(simulationComm, new_group, &this->comm));
     MPI_CHECK(MPI_Group_free(&new_group));
 }
 
@@ -26,6 +26,7 @@
 #include "lambda/make_Functor.hpp"
 #include "mappings/simulation/GridController.hpp"
 #include "communication/manager_common.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 
 #include <iostream>
 #include <utility>
@@ -51,15 +52,17 @@ Reduce<dim>::Reduce(const zone::SphericZone<dim>& p_zone, bool setThisAsRoot) :
     posFlag.first = (Int<dim>)con.getPosition();
     posFlag.second = setThisAsRoot;
 
-    int numWorldRanks; MPI_Comm_size(MPI_COMM_WORLD, &numWorldRanks);
+    /* staging ranks are not part of the grid */
+    const MPI_Comm simulationComm = PMacc::mpi::CommunicatorSplit::get().getSimulationComm();
+    int numWorldRanks; MPI_Comm_size(simulationComm, &numWorldRanks);
     std::vector<PosFlag> allPositionsFlags(numWorldRanks);
 
     MPI_CHECK(MPI_Allgather((void*)&posFlag, sizeof(PosFlag), MPI_CHAR,
                   (void*)allPositionsFlags.data(), sizeof(PosFlag), MPI_CHAR,
-                  MPI_COMM_WORLD));
+                  simulationComm));
 
     std::vector<int> new_ranks;
-    int myWorldId; MPI_Comm_rank(MPI_COMM_WORLD, &myWorldId);
+    int myWorldId; MPI_Comm_rank(simulationComm, &myWorldId);
 
     this->m_participate = false;
     for(int i = 0; i < (int)allPositionsFlags.size(); i++)
@@ -77,9 +80,9 @@ Reduce<dim>::Reduce(const zone::SphericZone<dim>& p_zone, bool setThisAsRoot) :
     MPI_Group world_group = MPI_GROUP_NULL;
     MPI_Group new_group = MPI_GROUP_NULL;
 
-    MPI_CHECK(MPI_Comm_group(MPI_COMM_WORLD, &world_group));
+    MPI_CHECK(MPI_Comm_group(simulationComm, &world_group));
     MPI_CHECK(MPI_Group_incl(world_group, new_ranks.size(), &(new_ranks.front()), &new_group));
-    MPI_CHECK(MPI_Comm_create(MPI_COMM_WORLD, new_group, &this->comm));
+    MPI_CHECK(MPI_Comm_create(simulationComm, new_group, &this->comm));
     MPI_CHECK(MPI_Group_free(&new_group));
     MPI_CHECK(MPI_Group_free(&world_group));
 }
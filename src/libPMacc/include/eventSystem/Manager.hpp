@@ -23,6 +23,7 @@
 #pragma once
 
 #include "eventSystem/tasks/ITask.hpp"
+#include "eventSystem/tasks/TaskPool.hpp"
 #include "Environment.def"
 
 #include <map>
@@ -39,7 +40,15 @@ namespace PMacc
     class Manager : public IEvent
     {
     public:
-        typedef std::map<id_t, ITask*> TaskMap;
+        /* nodes of the map are served by the TaskPool to avoid a system
+         * allocation each time a task is added
+         */
+        typedef std::map<
+            id_t,
+            ITask*,
+            std::less<id_t>,
+            TaskPoolAllocator<std::pair<const id_t, ITask*> >
+        > TaskMap;
         typedef std::set<id_t> TaskSet;
 
         bool execute(id_t taskToWait = 0);
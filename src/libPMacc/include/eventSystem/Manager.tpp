@@ -191,6 +191,11 @@ inline void Manager::addPassiveTask( ITask *task )
 
 inline Manager::Manager( )
 {
+    /* The pool must outlive the manager because tasks which are not finished
+     * are deleted in the destructor of the manager.
+     * Static objects are destroyed in reverse order of their construction.
+     */
+    TaskPool::getInstance( );
 }
 
 inline Manager::Manager( const Manager& )
@@ -24,6 +24,7 @@
 
 #include <set>
 
+#include "eventSystem/tasks/TaskPool.hpp"
 #include "pmacc_types.hpp"
 
 namespace PMacc
@@ -70,7 +71,13 @@ namespace PMacc
         void notify(id_t eventId, EventType type, IEventData *data);
 
     private:
-        std::set<IEvent*> observers;
+        typedef std::set<
+            IEvent*,
+            std::less<IEvent*>,
+            TaskPoolAllocator<IEvent*>
+        > ObserverSet;
+
+        ObserverSet observers;
 
     };
 
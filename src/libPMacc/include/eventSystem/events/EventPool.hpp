@@ -28,7 +28,6 @@
 #include "pmacc_types.hpp"
 
 #include <vector>
-#include <list>
 #include <stdexcept>
 
 namespace PMacc
@@ -47,8 +46,9 @@ namespace PMacc
         {
             if( freeEvents.size( ) != 0 )
             {
-                CudaEventHandle result = freeEvents.front( );
-                freeEvents.pop_front( );
+                /* last in first out: reuse the event released most recently */
+                CudaEventHandle result = freeEvents.back( );
+                freeEvents.pop_back( );
                 return result;
             }
             createEvents( );
@@ -77,6 +77,8 @@ namespace PMacc
          */
         void createEvents( size_t count = 1u )
         {
+            /* the free list can never hold more handles than events exist */
+            freeEvents.reserve( events.size( ) + count );
             for( size_t i = 0u; i < count; i++ )
             {
                 CudaEvent* nativeEvent = new CudaEvent( );
@@ -128,8 +130,12 @@ namespace PMacc
         //! hold all CudaEvents
         std::vector<CudaEvent*> events;
 
-        //! hold currently free CudaEventHandle's
-        std::list<CudaEventHandle> freeEvents;
+        /** hold currently free CudaEventHandle's
+         *
+         * used as stack, the capacity is kept equal to the number of events
+         * so that push() and pop() never allocate
+         */
+        std::vector<CudaEventHandle> freeEvents;
 
         /**! state if the pool is closed
          *
@@ -189,8 +189,11 @@ namespace exec
                 std::string( "Crash before kernel call " ) + kernelInfo
             );
 
+            /* the kernel type and the launch position identify the task,
+             * e.g. in the StepGraph
+             */
             PMacc::TaskKernel* taskKernel = PMacc::Environment<>::get().Factory().createTaskKernel(
-                typeid( kernelName ).name()
+                kernelInfo
             );
 
             DataSpace<
@@ -0,0 +1,406 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "Environment.def"
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace PMacc
+{
+
+    class EventStream;
+
+    /** Node of a captured StepGraph
+     *
+     * A node represents one task which was created by the Factory during a
+     * time step.
+     */
+    struct StepGraphNode
+    {
+        /** name of the task, e.g. the result of ITask::toString()
+         *
+         * The name of a kernel task contains the type of the kernel functor
+         * and the file and line of the launch.
+         */
+        std::string name;
+        /** type of the task (ITask::TaskType) */
+        uint32_t taskType;
+        /** index of the node this node depends on
+         *
+         * -1 if the dependency is not part of the graph (task from a previous
+         * step, combined events or no dependency)
+         */
+        int32_t dependency;
+        /** index of the stream used by the task, -1 if no stream is used */
+        int32_t streamSlot;
+    };
+
+    /** Record and replay the task graph of a time step
+     *
+     * The tasks created within one time step are structurally identical for
+     * each step as long as no plugin is called or the moving window is not
+     * sliding. The graph records the sequence of tasks of the first
+     * steady-state step, the dependency edges between them and the stream
+     * each task was executed in.
+     * Later steps are compared node by node against the recorded graph and
+     * replay the recorded stream assignment instead of selecting a new stream
+     * per task. The dependencies of a replayed task are taken from the graph,
+     * the Manager is not asked for the state of the dependency: a task whose
+     * dependency matches the recorded edge to a stream task of the same step
+     * is enqueued in the stream of this dependency, all other dependencies
+     * (host/MPI tasks, combined events, tasks of the previous step) are
+     * waited for.
+     *
+     * If a task differs from the recorded node the graph is invalidated and
+     * the next step is captured again.
+     *
+     * State sequence:
+     *   DISABLED: no recording
+     *   IDLE: the next step will be captured
+     *   CAPTURING: tasks are appended to the graph
+     *   CAPTURED: a complete step is recorded
+     *   REPLAYING: tasks are compared against the graph
+     */
+    class StepGraph
+    {
+    public:
+
+        enum State
+        {
+            DISABLED, IDLE, CAPTURING, CAPTURED, REPLAYING
+        };
+
+        /** Constructor
+         *
+         * The event system uses the singleton provided by the Environment,
+         * separate instances are only useful to test the graph logic.
+         */
+        StepGraph( ) :
+            state( DISABLED ),
+            replayCursor( 0u ),
+            currentNode( -1 ),
+            streamSlotUsed( false ),
+            edgeDependencyId( 0 ),
+            edgeNode( -1 ),
+            numCaptures( 0u ),
+            numReplays( 0u ),
+            numInvalidations( 0u )
+        {
+        }
+
+        /** enable or disable the capture mode
+         *
+         * Disabling drops the recorded graph.
+         *
+         * @param enable true to capture and replay steps
+         */
+        void setEnabled( bool enable )
+        {
+            clear( );
+            state = enable ? IDLE : DISABLED;
+        }
+
+        /** @return true if steps are captured and replayed */
+        bool isEnabled( ) const
+        {
+            return state != DISABLED;
+        }
+
+        /** @return current state */
+        State getState( ) const
+        {
+            return state;
+        }
+
+        /** @return true if the most recently created task is a replayed node */
+        bool isReplaying( ) const
+        {
+            return state == REPLAYING && currentNode >= 0;
+        }
+
+        /** mark the begin of a time step
+         *
+         * Starts the capture if no valid graph exists, else the replay.
+         */
+        void beginStep( )
+        {
+            if( state == IDLE )
+            {
+                clear( );
+                state = CAPTURING;
+            }
+            else if( state == CAPTURED )
+            {
+                state = REPLAYING;
+                replayCursor = 0u;
+                currentNode = -1;
+                taskToNode.clear( );
+                replayStreams.assign( nodes.size( ), nullptr );
+            }
+        }
+
+        /** mark the end of a time step
+         *
+         * A replayed step which created fewer tasks than recorded invalidates
+         * the graph.
+         */
+        void endStep( )
+        {
+            if( state == CAPTURING )
+            {
+                state = CAPTURED;
+                ++numCaptures;
+            }
+            else if( state == REPLAYING )
+            {
+                if( replayCursor != nodes.size( ) )
+                    invalidate( );
+                else
+                {
+                    state = CAPTURED;
+                    ++numReplays;
+                }
+            }
+            currentNode = -1;
+            taskToNode.clear( );
+            clearEdge( );
+        }
+
+        /** drop the recorded graph
+         *
+         * Must be called if the structure of a time step changes,
+         * e.g. after a slide of the moving window.
+         * The next step will be captured again.
+         */
+        void invalidate( )
+        {
+            if( state == DISABLED )
+                return;
+            if( state == CAPTURED || state == REPLAYING )
+                ++numInvalidations;
+            clear( );
+            state = IDLE;
+        }
+
+        /** record the creation of a task
+         *
+         * @param taskId id of the new task
+         * @param name name of the task
+         * @param taskType type of the task (ITask::TaskType)
+         * @param dependencyId id of the task the new task depends on (0 if none)
+         */
+        void recordTask( id_t taskId, const std::string& name, uint32_t taskType, id_t dependencyId )
+        {
+            if( state != CAPTURING && state != REPLAYING )
+                return;
+
+            std::map< id_t, int32_t >::const_iterator it = taskToNode.find( dependencyId );
+            const int32_t dependency = it != taskToNode.end( ) ? it->second : -1;
+
+            if( state == CAPTURING )
+            {
+                StepGraphNode node;
+                node.name = name;
+                node.taskType = taskType;
+                node.dependency = dependency;
+                node.streamSlot = -1;
+                currentNode = static_cast< int32_t >( nodes.size( ) );
+                nodes.push_back( node );
+            }
+            else
+            {
+                /* dependencies through combined events depend on the timing of
+                 * the tasks, therefore only the task sequence is compared
+                 */
+                if( replayCursor >= nodes.size( ) ||
+                    nodes[ replayCursor ].name != name ||
+                    nodes[ replayCursor ].taskType != taskType )
+                {
+                    invalidate( );
+                    return;
+                }
+                currentNode = static_cast< int32_t >( replayCursor );
+                ++replayCursor;
+
+                /* the edge is only reused if the task depends on the
+                 * recorded node */
+                clearEdge( );
+                if( dependency >= 0 && dependency == nodes[ currentNode ].dependency )
+                {
+                    edgeDependencyId = dependencyId;
+                    edgeNode = dependency;
+                }
+            }
+            streamSlotUsed = false;
+            taskToNode[ taskId ] = currentNode;
+        }
+
+        /** record the stream selected for the most recently recorded task
+         *
+         * Only the first stream selected for a task is recorded.
+         *
+         * @param slot index of the stream in the StreamController
+         */
+        void recordStream( size_t slot )
+        {
+            if( state != CAPTURING || currentNode < 0 )
+                return;
+            if( nodes[ currentNode ].streamSlot < 0 )
+                nodes[ currentNode ].streamSlot = static_cast< int32_t >( slot );
+        }
+
+        /** get the recorded stream of the most recently replayed task
+         *
+         * The recorded stream is handed out only once per task.
+         *
+         * @return stream index in the StreamController, -1 if no stream is recorded
+         */
+        int32_t getReplayStreamSlot( )
+        {
+            if( state != REPLAYING || currentNode < 0 || streamSlotUsed )
+                return -1;
+            streamSlotUsed = true;
+            return nodes[ currentNode ].streamSlot;
+        }
+
+        /** record the stream a task of a replayed step is executed in
+         *
+         * @param taskId id of the task
+         * @param stream stream of the task
+         */
+        void recordTaskStream( id_t taskId, EventStream* stream )
+        {
+            if( state != REPLAYING )
+                return;
+            std::map< id_t, int32_t >::const_iterator it = taskToNode.find( taskId );
+            if( it != taskToNode.end( ) && replayStreams[ it->second ] == nullptr )
+                replayStreams[ it->second ] = stream;
+        }
+
+        /** get the stream of the dependency of the most recently replayed task
+         *
+         * The dependency is taken from the recorded edge, the task can be
+         * enqueued in the returned stream without any further synchronization.
+         *
+         * @param dependencyId id of the task the current task depends on
+         * @return stream of the dependency, nullptr if the dependency is not the
+         *         recorded dependency or is not executed in a stream
+         */
+        EventStream* getReplayDependencyStream( id_t dependencyId ) const
+        {
+            if( state != REPLAYING || edgeNode < 0 || dependencyId == 0 ||
+                dependencyId != edgeDependencyId )
+                return nullptr;
+            return replayStreams[ edgeNode ];
+        }
+
+        /** @return recorded nodes */
+        const std::vector< StepGraphNode >& getNodes( ) const
+        {
+            return nodes;
+        }
+
+        /** @return number of completely replayed steps */
+        uint64_t getReplayCount( ) const
+        {
+            return numReplays;
+        }
+
+        /** @return number of captured steps */
+        uint64_t getCaptureCount( ) const
+        {
+            return numCaptures;
+        }
+
+        /** @return number of invalidated graphs */
+        uint64_t getInvalidationCount( ) const
+        {
+            return numInvalidations;
+        }
+
+        /** @return human readable description of the recorded graph */
+        std::string toString( ) const
+        {
+            std::stringstream result;
+            for( size_t i = 0u; i < nodes.size( ); ++i )
+            {
+                result << i << ": " << nodes[ i ].name
+                       << " type=" << nodes[ i ].taskType
+                       << " dependency=" << nodes[ i ].dependency
+                       << " stream=" << nodes[ i ].streamSlot << std::endl;
+            }
+            return result.str( );
+        }
+
+    private:
+
+        friend class detail::Environment;
+
+        StepGraph( const StepGraph& ) = delete;
+
+        static StepGraph& getInstance( )
+        {
+            static StepGraph instance;
+            return instance;
+        }
+
+        void clear( )
+        {
+            nodes.clear( );
+            taskToNode.clear( );
+            replayCursor = 0u;
+            currentNode = -1;
+            streamSlotUsed = false;
+            replayStreams.clear( );
+            clearEdge( );
+        }
+
+        void clearEdge( )
+        {
+            edgeDependencyId = 0;
+            edgeNode = -1;
+        }
+
+        State state;
+        std::vector< StepGraphNode > nodes;
+        /** map from task ids of the current step to node indices */
+        std::map< id_t, int32_t > taskToNode;
+        /** streams of the tasks of the replayed step, indexed by node */
+        std::vector< EventStream* > replayStreams;
+        size_t replayCursor;
+        int32_t currentNode;
+        bool streamSlotUsed;
+        /** task id and node of the dependency of the most recently replayed
+         *  task, if it matches the recorded edge */
+        id_t edgeDependencyId;
+        int32_t edgeNode;
+        uint64_t numCaptures;
+        uint64_t numReplays;
+        uint64_t numInvalidations;
+    };
+
+} //namespace PMacc
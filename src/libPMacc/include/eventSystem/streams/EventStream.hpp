@@ -23,6 +23,7 @@
 
 #include "eventSystem/events/CudaEventHandle.hpp"
 #include "pmacc_types.hpp"
+#include "assert.hpp"
 
 #include <cuda_runtime.h>
 
@@ -41,7 +42,11 @@ public:
      * Constructor.
      * Creates the cudaStream_t object.
      */
-    EventStream() : stream(nullptr)
+    EventStream() :
+        stream(nullptr),
+        numActiveTasks(0u),
+        numAssignedTasks(0u),
+        numCrossStreamWaits(0u)
     {
         CUDA_CHECK(cudaStreamCreate(&stream));
     }
@@ -71,11 +76,61 @@ public:
         if (this->stream != ev.getStream())
         {
             CUDA_CHECK(cudaStreamWaitEvent(this->getCudaStream(), *ev, 0));
+            ++numCrossStreamWaits;
         }
     }
 
+    /**
+     * Registers a task which is executed in this stream.
+     * Must be called once for each task which uses this stream.
+     */
+    void registerTask()
+    {
+        ++numActiveTasks;
+        ++numAssignedTasks;
+    }
+
+    /**
+     * Releases a task registered with registerTask() after it is finished.
+     */
+    void releaseTask()
+    {
+        PMACC_ASSERT(numActiveTasks > 0u);
+        --numActiveTasks;
+    }
+
+    /**
+     * Returns the number of registered tasks which are not finished.
+     * @return number of tasks in flight
+     */
+    size_t getActiveTasksCount() const
+    {
+        return numActiveTasks;
+    }
+
+    /**
+     * Returns the number of tasks ever registered to this stream.
+     * @return number of tasks
+     */
+    uint64_t getAssignedTasksCount() const
+    {
+        return numAssignedTasks;
+    }
+
+    /**
+     * Returns how often this stream waited for an event of another stream.
+     * @return number of cross stream waits
+     */
+    uint64_t getCrossStreamWaitsCount() const
+    {
+        return numCrossStreamWaits;
+    }
+
 private:
     cudaStream_t stream;
+    size_t numActiveTasks;
+    uint64_t numAssignedTasks;
+    uint64_t numCrossStreamWaits;
 };
 
 }
@@ -24,17 +24,51 @@
 #pragma once
 
 #include "eventSystem/streams/EventStream.hpp"
+#include "debug/VerboseLog.hpp"
 #include "pmacc_types.hpp"
 #include "Environment.def"
 
 #include <cuda_runtime.h>
 
 #include <string>
+#include <sstream>
 #include <stdexcept>
 #include <vector>
 
 namespace PMacc
 {
+    /**
+     * Policy to select a stream for a task without an unfinished producer task
+     * on the device.
+     *
+     * A task which depends on an unfinished device task always uses the stream
+     * of this producer task (see Transaction::getEventStream()).
+     * Independent work (e.g. receiving exchanges) is placed on the pool of
+     * independent streams with both policies if the pool is not empty.
+     */
+    enum StreamPolicy
+    {
+        /* hand out the streams of a pool round-robin */
+        STREAM_ROUND_ROBIN,
+        /* take the stream of a pool with the fewest unfinished tasks */
+        STREAM_DEPENDENCY_AWARE
+    };
+
+    /**
+     * Utilization of a single EventStream
+     */
+    struct StreamStatistics
+    {
+        /* true if the stream belongs to the pool for independent work */
+        bool isIndependent;
+        /* number of tasks executed in the stream */
+        uint64_t assignedTasks;
+        /* number of unfinished tasks */
+        size_t activeTasks;
+        /* number of waits for events of other streams */
+        uint64_t crossStreamWaits;
+    };
+
     /**
      * Manages a pool of EventStreams and gives access to them.
      * This class is a singleton.
@@ -45,18 +79,53 @@ namespace PMacc
 
         /**
          * Returns a pointer to the next EventStream in the controller's queue.
+         * Independent streams are not part of the queue.
          * @return pointer to next EventStream
          */
         EventStream* getNextStream()
         {
             if(!isActivated)
                 throw std::runtime_error(std::string("StreamController is not activated but getNextStream() was called"));
-            size_t oldIndex = currentStreamIndex;
-            currentStreamIndex++;
-            if (currentStreamIndex == streams.size())
-                currentStreamIndex = 0;
+            return streams[getNextComputeStreamIndex()];
+        }
+
+        /**
+         * Selects a stream for a task which has no unfinished producer task
+         * on the device.
+         *
+         * @param isIndependent true if the task belongs to independent work
+         *                      like exchanges or plugin copies
+         * @return index of the selected stream
+         */
+        size_t selectStreamIndex(bool isIndependent)
+        {
+            if(!isActivated)
+                throw std::runtime_error(std::string("StreamController is not activated but selectStreamIndex() was called"));
+
+            const bool useIndependentPool = isIndependent && independentStreams.size() != 0;
+
+            if(policy == STREAM_ROUND_ROBIN)
+            {
+                if(useIndependentPool)
+                    return getNextStreamIndex(independentStreams, currentIndependentStreamIndex);
+                return getNextComputeStreamIndex();
+            }
+
+            if(useIndependentPool)
+                return getLeastLoadedStreamIndex(independentStreams, currentIndependentStreamIndex);
+            return getLeastLoadedStreamIndex(computeStreams, currentStreamIndex);
+        }
 
-            return streams[oldIndex];
+        /**
+         * Returns the EventStream with the given index.
+         * @param index index of the EventStream, must be less than getStreamsCount()
+         * @return pointer to the EventStream
+         */
+        EventStream* getStream(size_t index)
+        {
+            if(!isActivated)
+                throw std::runtime_error(std::string("StreamController is not activated but getStream() was called"));
+            return streams.at(index);
         }
 
         /**
@@ -65,6 +134,7 @@ namespace PMacc
          */
         virtual ~StreamController()
         {
+            log(ggLog::CUDA_RT()+ggLog::EVENT(), "shutdown StreamController: %1%") % getStatisticsString();
 
             for (size_t i = 0; i < streams.size(); i++)
             {
@@ -86,10 +156,42 @@ namespace PMacc
         {
             for (size_t i = 0; i < count; i++)
             {
+                computeStreams.push_back(streams.size());
                 streams.push_back(new EventStream());
             }
         }
 
+        /**
+         * Add EventStreams to the pool for independent work.
+         * @param count number of EventStreams to add.
+         */
+        void addIndependentStreams(size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                independentStreams.push_back(streams.size());
+                streams.push_back(new EventStream());
+            }
+        }
+
+        /**
+         * Set the policy to select streams.
+         * @param newPolicy policy used by selectStreamIndex()
+         */
+        void setPolicy(StreamPolicy newPolicy)
+        {
+            policy = newPolicy;
+        }
+
+        /**
+         * Returns the policy to select streams.
+         * @return selected policy
+         */
+        StreamPolicy getPolicy() const
+        {
+            return policy;
+        }
+
         /** enable StreamController and add one stream
          *
          * If StreamController is not activated getNextStream() will crash on its first call
@@ -109,6 +211,62 @@ namespace PMacc
             return streams.size();
         }
 
+        /**
+         * Count a task which used the stream of its producer task.
+         */
+        void countProducerStreamReuse()
+        {
+            ++numProducerStreamReuses;
+        }
+
+        /**
+         * Returns how often a task used the stream of its producer task.
+         * @return number of producer stream reuses
+         */
+        uint64_t getProducerStreamReusesCount() const
+        {
+            return numProducerStreamReuses;
+        }
+
+        /**
+         * Returns the utilization of all streams.
+         * @return statistics for each stream, the index is equal to the stream index
+         */
+        std::vector<StreamStatistics> getStatistics() const
+        {
+            std::vector<StreamStatistics> result(streams.size());
+            for (size_t i = 0; i < streams.size(); i++)
+            {
+                result[i].isIndependent = false;
+                result[i].assignedTasks = streams[i]->getAssignedTasksCount();
+                result[i].activeTasks = streams[i]->getActiveTasksCount();
+                result[i].crossStreamWaits = streams[i]->getCrossStreamWaitsCount();
+            }
+            for (size_t i = 0; i < independentStreams.size(); i++)
+                result[independentStreams[i]].isIndependent = true;
+            return result;
+        }
+
+        /**
+         * Returns the utilization of all streams in human readable form.
+         * @return description of the stream utilization
+         */
+        std::string getStatisticsString() const
+        {
+            std::stringstream result;
+            const std::vector<StreamStatistics> statistics = getStatistics();
+            result << "producer stream reuses: " << numProducerStreamReuses;
+            for (size_t i = 0; i < statistics.size(); i++)
+            {
+                result << " | stream " << i
+                       << (statistics[i].isIndependent ? " (independent)" : "")
+                       << ": tasks=" << statistics[i].assignedTasks
+                       << " active=" << statistics[i].activeTasks
+                       << " crossStreamWaits=" << statistics[i].crossStreamWaits;
+            }
+            return result.str();
+        }
+
     private:
 
         friend class detail::Environment;
@@ -116,7 +274,12 @@ namespace PMacc
         /**
          * Constructor.
          */
-        StreamController() : isActivated(false),currentStreamIndex(0)
+        StreamController() :
+            currentStreamIndex(0),
+            currentIndependentStreamIndex(0),
+            numProducerStreamReuses(0),
+            policy(STREAM_ROUND_ROBIN),
+            isActivated(false)
         {
         }
 
@@ -131,8 +294,63 @@ namespace PMacc
             return instance;
         }
 
+        /**
+         * Returns the next compute stream in round-robin order.
+         * @return index of the stream
+         */
+        size_t getNextComputeStreamIndex()
+        {
+            return getNextStreamIndex(computeStreams, currentStreamIndex);
+        }
+
+        /**
+         * Returns the next stream of a pool in round-robin order.
+         *
+         * @param pool indices of the candidate streams
+         * @param[in,out] cursor position in the pool of the next stream
+         * @return index of the stream
+         */
+        size_t getNextStreamIndex(const std::vector<size_t>& pool, size_t& cursor)
+        {
+            if (cursor >= pool.size())
+                cursor = 0;
+            return pool[cursor++];
+        }
+
+        /**
+         * Returns the stream with the fewest unfinished tasks.
+         *
+         * The search starts after the previously selected stream so that idle
+         * streams are used in round-robin order.
+         *
+         * @param pool indices of the candidate streams
+         * @param[in,out] cursor position in the pool to start the search
+         * @return index of the stream
+         */
+        size_t getLeastLoadedStreamIndex(const std::vector<size_t>& pool, size_t& cursor)
+        {
+            size_t bestPosition = cursor % pool.size();
+            for (size_t i = 0; i < pool.size(); i++)
+            {
+                const size_t position = (cursor + i) % pool.size();
+                if (streams[pool[position]]->getActiveTasksCount() < streams[pool[bestPosition]]->getActiveTasksCount())
+                    bestPosition = position;
+                if (streams[pool[bestPosition]]->getActiveTasksCount() == 0)
+                    break;
+            }
+            cursor = bestPosition + 1;
+            return pool[bestPosition];
+        }
+
         std::vector<EventStream*> streams;
+        /* indices of the streams handed out by getNextStream() */
+        std::vector<size_t> computeStreams;
+        /* indices of the streams for independent work */
+        std::vector<size_t> independentStreams;
         size_t currentStreamIndex;
+        size_t currentIndependentStreamIndex;
+        uint64_t numProducerStreamReuses;
+        StreamPolicy policy;
         bool isActivated;
 
     };
@@ -45,6 +45,8 @@ namespace PMacc
      * Singleton Factory-pattern class for creation of several types of EventTasks.
      * Tasks are not actually 'returned' but immediately initialized and
      * added to the Manager's queue. An exception is TaskKernel.
+     *
+     * The memory of all tasks is served by the TaskPool (see ITask::operator new).
      */
     class Factory
     {
@@ -166,6 +168,14 @@ namespace PMacc
 
         friend class detail::Environment;
 
+        /**
+         * Records a task in the StepGraph if the capture mode is enabled.
+         * Must be called before the task selects its stream.
+         *
+         * @param task the ITask to record
+         */
+        void recordTask(ITask& task);
+
         Factory() {};
 
         Factory(const Factory&) { };
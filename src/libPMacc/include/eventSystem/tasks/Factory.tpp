@@ -40,6 +40,7 @@
 #include "eventSystem/tasks/TaskGetCurrentSizeFromDevice.hpp"
 #include "eventSystem/streams/EventStream.hpp"
 #include "eventSystem/streams/StreamController.hpp"
+#include "eventSystem/graph/StepGraph.hpp"
 
 namespace PMacc
 {
@@ -213,6 +214,8 @@ namespace PMacc
         if (registeringTask != nullptr)
             task->addObserver(registeringTask);
 
+        recordTask(*task);
+
         return task;
     }
 
@@ -224,6 +227,7 @@ namespace PMacc
         }
         EventTask event(task.getId());
 
+        recordTask(task);
         task.init();
         Environment<>::get().Manager().addTask(&task);
         Environment<>::get().TransactionManager().setTransactionEvent(event);
@@ -231,6 +235,20 @@ namespace PMacc
         return event;
     }
 
+    inline void Factory::recordTask(ITask& task)
+    {
+        StepGraph& graph = Environment<>::get().StepGraph();
+        if (graph.isEnabled())
+        {
+            graph.recordTask(
+                task.getId(),
+                task.toString(),
+                static_cast<uint32_t>(task.getTaskType()),
+                Environment<>::get().TransactionManager().getTransactionEvent().getTaskId()
+            );
+        }
+    }
+
 
 } //namespace PMacc
 
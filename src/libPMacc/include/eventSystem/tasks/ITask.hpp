@@ -24,6 +24,7 @@
 
 #include "eventSystem/events/EventNotify.hpp"
 #include "eventSystem/events/IEvent.hpp"
+#include "eventSystem/tasks/TaskPool.hpp"
 #include "pmacc_types.hpp"
 #include "assert.hpp"
 
@@ -62,6 +63,25 @@ namespace PMacc
         {
         }
 
+        /** allocate tasks from the TaskPool
+         *
+         * Tasks are short living objects, most of them are destroyed within the
+         * time step they are created in.
+         */
+        static void* operator new(size_t size)
+        {
+            return TaskPool::getInstance().allocate(size);
+        }
+
+        /** give the memory of a task back to the TaskPool
+         *
+         * @param size size of the dynamic type of the task (the destructor is virtual)
+         */
+        static void operator delete(void* ptr, size_t size)
+        {
+            TaskPool::getInstance().deallocate(ptr, size);
+        }
+
         /**
          * Executes this task.
          *
@@ -45,9 +45,7 @@ namespace PMacc
         /**
          * Destructor.
          */
-        virtual ~StreamTask()
-        {
-        }
+        virtual ~StreamTask();
 
         /**
          * Returns the cuda event associated with this task.
@@ -100,11 +98,20 @@ namespace PMacc
          */
         inline void activate();
 
+        /**
+         * Registers this task at its stream for the stream utilization statistics.
+         */
+        inline void registerAtStream();
 
         EventStream *stream;
         CudaEventHandle cudaEvent;
         bool hasCudaEventHandle;
         bool alwaysFinished;
+        /* stream where this task is counted as active task
+         *
+         * can differ from `stream` if a derived task reassigns `stream`
+         */
+        EventStream *registeredStream;
     };
 
 } //namespace PMacc
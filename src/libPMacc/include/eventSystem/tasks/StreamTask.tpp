@@ -34,11 +34,18 @@ inline StreamTask::StreamTask( ) :
 ITask( ),
 stream( nullptr ),
 hasCudaEventHandle( false ),
-alwaysFinished( false )
+alwaysFinished( false ),
+registeredStream( nullptr )
 {
     this->setTaskType( ITask::TASK_CUDA );
 }
 
+inline StreamTask::~StreamTask( )
+{
+    if ( registeredStream != nullptr )
+        registeredStream->releaseTask( );
+}
+
 inline CudaEventHandle StreamTask::getCudaEventHandle( ) const
 {
     PMACC_ASSERT( hasCudaEventHandle );
@@ -69,7 +76,10 @@ inline bool StreamTask::isFinished( )
 inline EventStream* StreamTask::getEventStream( )
 {
     if ( stream == nullptr )
+    {
         stream = __getEventStream( TASK_CUDA );
+        registerAtStream( );
+    }
     return stream;
 }
 
@@ -78,15 +88,27 @@ inline void StreamTask::setEventStream( EventStream* newStream )
     PMACC_ASSERT( newStream != nullptr );
     PMACC_ASSERT( stream == nullptr ); //it is only allowed to set a stream if no stream is set before
     this->stream = newStream;
+    registerAtStream( );
 }
 
 inline cudaStream_t StreamTask::getCudaStream( )
 {
     if ( stream == nullptr )
+    {
         stream = Environment<>::get( ).TransactionManager( ).getEventStream( TASK_CUDA );
+        registerAtStream( );
+    }
     return stream->getCudaStream( );
 }
 
+inline void StreamTask::registerAtStream( )
+{
+    PMACC_ASSERT( registeredStream == nullptr );
+    registeredStream = stream;
+    registeredStream->registerTask( );
+    Environment<>::get( ).StepGraph( ).recordTaskStream( this->getId( ), stream );
+}
+
 inline void StreamTask::activate( )
 {
     cudaEvent = Environment<>::get().EventPool( ).pop( );
@@ -27,7 +27,7 @@
 
 namespace PMacc{
 
-    void TaskKernel::activateChecks()
+    inline void TaskKernel::activateChecks()
     {
         canBeChecked = true;
         this->activate();
@@ -0,0 +1,226 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace PMacc
+{
+
+    /** Size class free list pool for host objects of the event system
+     *
+     * Tasks, and the nodes of the containers which keep track of them, are
+     * created and destroyed several hundred times per time step. The pool
+     * rounds each request up to a multiple of `granularity` and serves it from
+     * a free list of that size class. Memory is taken from the system in
+     * chunks of `objectsPerChunk` objects and is only given back when the pool
+     * is destroyed, so after the first time step all allocations are served
+     * without calling the system allocator.
+     *
+     * Requests larger than `maxObjectSize` are forwarded to `::operator new`.
+     *
+     * The event system is single threaded, therefore the pool is not thread safe.
+     */
+    class TaskPool
+    {
+    public:
+
+        /** every object is aligned to this number of bytes */
+        static constexpr size_t granularity = 16u;
+        /** number of size classes */
+        static constexpr size_t numSizeClasses = 64u;
+        /** largest object size in byte served from the pool */
+        static constexpr size_t maxObjectSize = granularity * numSizeClasses;
+        /** number of objects allocated at once for a size class */
+        static constexpr size_t objectsPerChunk = 64u;
+
+        /** get the singleton TaskPool
+         *
+         * @return instance of TaskPool
+         */
+        static TaskPool& getInstance()
+        {
+            static TaskPool instance;
+            return instance;
+        }
+
+        /** allocate memory
+         *
+         * @param size number of bytes
+         * @return pointer to memory aligned to `granularity`
+         */
+        void* allocate( size_t size )
+        {
+            if( size > maxObjectSize )
+                return ::operator new( size );
+
+            const size_t sizeClass = getSizeClass( size );
+            if( freeLists[ sizeClass ] == nullptr )
+                refill( sizeClass );
+
+            FreeNode* node = freeLists[ sizeClass ];
+            freeLists[ sizeClass ] = node->next;
+            ++numLiveObjects;
+            return node;
+        }
+
+        /** give memory back to the pool
+         *
+         * @param ptr pointer returned by allocate(), nullptr is allowed
+         * @param size number of bytes, must be equal to the size passed to allocate()
+         */
+        void deallocate( void* ptr, size_t size )
+        {
+            if( ptr == nullptr )
+                return;
+            if( size > maxObjectSize )
+            {
+                ::operator delete( ptr );
+                return;
+            }
+
+            const size_t sizeClass = getSizeClass( size );
+            FreeNode* node = static_cast< FreeNode* >( ptr );
+            node->next = freeLists[ sizeClass ];
+            freeLists[ sizeClass ] = node;
+            --numLiveObjects;
+        }
+
+        /** number of objects currently handed out by the pool */
+        size_t getLiveObjectsCount() const
+        {
+            return numLiveObjects;
+        }
+
+        /** number of bytes requested from the system */
+        size_t getReservedBytes() const
+        {
+            return reservedBytes;
+        }
+
+        ~TaskPool()
+        {
+            for( std::vector< void* >::const_iterator iter = chunks.begin(); iter != chunks.end(); ++iter )
+                std::free( *iter );
+            chunks.clear();
+        }
+
+    private:
+
+        /** element of a free list, placed inside the unused object memory */
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+
+        TaskPool() : numLiveObjects( 0u ), reservedBytes( 0u )
+        {
+            for( size_t i = 0u; i < numSizeClasses; ++i )
+                freeLists[ i ] = nullptr;
+        }
+
+        TaskPool( const TaskPool& ) = delete;
+        TaskPool& operator=( const TaskPool& ) = delete;
+
+        static size_t getSizeClass( size_t size )
+        {
+            /* size zero is mapped to the smallest class */
+            return size == 0u ? 0u : ( size - 1u ) / granularity;
+        }
+
+        /** allocate a new chunk and split it into free list nodes
+         *
+         * @param sizeClass index of the free list to fill
+         */
+        void refill( size_t sizeClass )
+        {
+            const size_t objectSize = ( sizeClass + 1u ) * granularity;
+            const size_t chunkSize = objectSize * objectsPerChunk;
+            /* malloc guarantees an alignment suitable for any fundamental type */
+            char* chunk = static_cast< char* >( std::malloc( chunkSize ) );
+            if( chunk == nullptr )
+                throw std::bad_alloc();
+            chunks.push_back( chunk );
+            reservedBytes += chunkSize;
+
+            for( size_t i = objectsPerChunk; i > 0u; --i )
+            {
+                FreeNode* node = reinterpret_cast< FreeNode* >( chunk + ( i - 1u ) * objectSize );
+                node->next = freeLists[ sizeClass ];
+                freeLists[ sizeClass ] = node;
+            }
+        }
+
+        FreeNode* freeLists[ numSizeClasses ];
+        std::vector< void* > chunks;
+        size_t numLiveObjects;
+        size_t reservedBytes;
+    };
+
+    /** standard conforming allocator which uses the TaskPool
+     *
+     * Used for the node based containers of the event system, e.g. the task
+     * maps of the Manager.
+     *
+     * @tparam T_Type type of the allocated objects
+     */
+    template< typename T_Type >
+    struct TaskPoolAllocator
+    {
+        typedef T_Type value_type;
+
+        TaskPoolAllocator()
+        {
+        }
+
+        template< typename T_Other >
+        TaskPoolAllocator( const TaskPoolAllocator< T_Other >& )
+        {
+        }
+
+        T_Type* allocate( size_t n )
+        {
+            return static_cast< T_Type* >( TaskPool::getInstance().allocate( n * sizeof( T_Type ) ) );
+        }
+
+        void deallocate( T_Type* ptr, size_t n )
+        {
+            TaskPool::getInstance().deallocate( ptr, n * sizeof( T_Type ) );
+        }
+
+        template< typename T_Other >
+        bool operator==( const TaskPoolAllocator< T_Other >& ) const
+        {
+            return true;
+        }
+
+        template< typename T_Other >
+        bool operator!=( const TaskPoolAllocator< T_Other >& ) const
+        {
+            return false;
+        }
+    };
+
+} //namespace PMacc
@@ -59,7 +59,8 @@ namespace PMacc
                     break;
                 case RunCopy:
                     state = WaitForFinish;
-                   __startTransaction();
+                    /* the received data does not depend on local device work */
+                    __startTransaction(EventTask(), true);
                     exchange->getHostBuffer().setCurrentSize(newBufferSize);
                     if (exchange->hasDeviceDoubleBuffer())
                     {
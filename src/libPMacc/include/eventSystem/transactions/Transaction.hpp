@@ -40,8 +40,10 @@ public:
      * Constructor.
      *
      * @param event initial EventTask for base event
+     * @param isIndependent true if the transaction describes independent work,
+     *                      e.g. exchanges or plugin copies (see StreamPolicy)
      */
-    Transaction(EventTask event);
+    Transaction(EventTask event, bool isIndependent = false);
 
     /**
      * Adds event to the base event of this transaction.
@@ -71,8 +73,19 @@ public:
      */
     EventStream* getEventStream(ITask::TaskType operation);
 
+    /**
+     * Returns if the transaction describes independent work.
+     *
+     * @return true if independent, else false
+     */
+    bool isIndependentWork() const
+    {
+        return isIndependent;
+    }
+
 private:
     EventTask baseEvent;
+    bool isIndependent;
 };
 
 }
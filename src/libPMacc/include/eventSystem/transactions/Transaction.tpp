@@ -24,13 +24,16 @@
 #include "eventSystem/transactions/Transaction.hpp"
 
 #include "eventSystem/streams/StreamController.hpp"
+#include "eventSystem/graph/StepGraph.hpp"
 #include "eventSystem/events/EventTask.hpp"
 #include "eventSystem/tasks/StreamTask.hpp"
 
 namespace PMacc
 {
 
-Transaction::Transaction( EventTask event ) : baseEvent( event )
+inline Transaction::Transaction( EventTask event, bool isIndependent ) :
+    baseEvent( event ),
+    isIndependent( isIndependent )
 {
 
 }
@@ -46,8 +49,21 @@ inline EventTask Transaction::getTransactionEvent( )
     return baseEvent;
 }
 
-void Transaction::operation( ITask::TaskType operation )
+inline void Transaction::operation( ITask::TaskType operation )
 {
+    StepGraph& graph = Environment<>::get( ).StepGraph( );
+    if ( graph.isReplaying( ) )
+    {
+        /* a replayed step only trusts the recorded edge to a stream task,
+         * every other dependency is waited for
+         */
+        if ( operation == ITask::TASK_CUDA &&
+             graph.getReplayDependencyStream( this->baseEvent.getTaskId( ) ) != nullptr )
+            return;
+        baseEvent.waitForFinished( );
+        return;
+    }
+
     if ( operation == ITask::TASK_CUDA )
     {
         Manager &manager = Environment<>::get( ).Manager( );
@@ -65,8 +81,31 @@ void Transaction::operation( ITask::TaskType operation )
     baseEvent.waitForFinished( );
 }
 
-EventStream* Transaction::getEventStream( ITask::TaskType )
+inline EventStream* Transaction::getEventStream( ITask::TaskType )
 {
+    StreamController& streamController = Environment<>::get( ).StreamController( );
+    StepGraph& graph = Environment<>::get( ).StepGraph( );
+
+    if ( graph.isReplaying( ) )
+    {
+        /* a replayed step takes the stream of the dependency from the recorded
+         * edge instead of resolving the dependency in the Manager
+         */
+        EventStream* dependencyStream = graph.getReplayDependencyStream( this->baseEvent.getTaskId( ) );
+        if ( dependencyStream != nullptr )
+        {
+            streamController.countProducerStreamReuse( );
+            return dependencyStream;
+        }
+        baseEvent.waitForFinished( );
+
+        /* the replayed task uses the stream of the captured step */
+        const int32_t replaySlot = graph.getReplayStreamSlot( );
+        if ( replaySlot >= 0 && static_cast<size_t>( replaySlot ) < streamController.getStreamsCount( ) )
+            return streamController.getStream( static_cast<size_t>( replaySlot ) );
+        return streamController.getStream( streamController.selectStreamIndex( isIndependent ) );
+    }
+
     Manager &manager = Environment<>::get( ).Manager( );
     ITask* baseTask = manager.getITaskIfNotFinished( this->baseEvent.getTaskId( ) );
 
@@ -78,11 +117,16 @@ EventStream* Transaction::getEventStream( ITask::TaskType )
              * that the dependency chain not brake
              */
             StreamTask* task = static_cast<StreamTask*> ( baseTask );
+            streamController.countProducerStreamReuse( );
             return task->getEventStream( );
         }
         baseEvent.waitForFinished( );
     }
-    return Environment<>::get( ).StreamController( ).getNextStream( );
+
+    const size_t slot = streamController.selectStreamIndex( isIndependent );
+    if ( graph.isEnabled( ) )
+        graph.recordStream( slot );
+    return streamController.getStream( slot );
 }
 
 } //namespace PMacc
@@ -50,8 +50,11 @@ public:
      * Adds a new transaction to the stack.
      *
      * @param serialEvent initial base event for new transaction
+     * @param isIndependent mark the transaction as independent work, e.g.
+     *                      exchanges or plugin copies (see StreamPolicy),
+     *                      nested transactions inherit this property
      */
-    void startTransaction(EventTask serialEvent = EventTask());
+    void startTransaction(EventTask serialEvent = EventTask(), bool isIndependent = false);
 
     /**
      * Removes the top-most transaction from the stack.
@@ -46,9 +46,11 @@ inline TransactionManager::TransactionManager( const TransactionManager& )
 
 }
 
-inline void TransactionManager::startTransaction( EventTask serialEvent )
+inline void TransactionManager::startTransaction( EventTask serialEvent, bool isIndependent )
 {
-    transactions.push( Transaction( serialEvent ) );
+    if ( transactions.size( ) != 0 && transactions.top( ).isIndependentWork( ) )
+        isIndependent = true;
+    transactions.push( Transaction( serialEvent, isIndependent ) );
 }
 
 inline EventTask TransactionManager::endTransaction( )
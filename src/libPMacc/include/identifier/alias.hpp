@@ -39,7 +39,7 @@ identifier(pmacc_isAlias);
 #ifdef __CUDACC__
 #   define PMACC_alias_CUDA(name,id)                                          \
         namespace PMACC_JOIN(device_placeholder,id){                           \
-            __constant__ PMACC_JOIN(placeholder_definition,id)::name<> PMACC_JOIN(name,_); \
+            __constant__ const PMACC_JOIN(placeholder_definition,id)::name<> PMACC_JOIN(name,_){ }; \
         }
 #else
 #   define PMACC_alias_CUDA(name,id)
@@ -59,7 +59,7 @@ identifier(pmacc_isAlias);
     }                                                                          \
     using namespace PMACC_JOIN(placeholder_definition,id);                     \
     namespace PMACC_JOIN(host_placeholder,id){                                 \
-        PMACC_JOIN(placeholder_definition,id)::name<> PMACC_JOIN(name,_);      \
+        const PMACC_JOIN(placeholder_definition,id)::name<> PMACC_JOIN(name,_){ }; \
     }                                                                          \
     PMACC_alias_CUDA(name,id);                                                 \
     PMACC_PLACEHOLDER(id);
@@ -35,7 +35,7 @@
 #ifdef __CUDACC__
 #   define PMACC_identifier_CUDA(name,id)                                         \
         namespace PMACC_JOIN(device_placeholder,id){                               \
-            __constant__ PMACC_JOIN(placeholder_definition,id)::name PMACC_JOIN(name,_); \
+            __constant__ const PMACC_JOIN(placeholder_definition,id)::name PMACC_JOIN(name,_){ }; \
         }
 #else
 #   define PMACC_identifier_CUDA(name,id)
@@ -50,7 +50,7 @@
     }                                                                          \
     using namespace PMACC_JOIN(placeholder_definition,id);                     \
     namespace PMACC_JOIN(host_placeholder,id){                                 \
-        PMACC_JOIN(placeholder_definition,id)::name PMACC_JOIN(name,_);        \
+        const PMACC_JOIN(placeholder_definition,id)::name PMACC_JOIN(name,_){ }; \
     }                                                                          \
     PMACC_identifier_CUDA(name,id);                                            \
     PMACC_PLACEHOLDER(id);
@@ -203,6 +203,23 @@ namespace PMacc
                 return result;
             }
 
+            /**
+             * Moves the global domain in y direction without reassigning GPU positions.
+             *
+             * Used if the data is shifted on each GPU instead of re-initializing
+             * a whole local domain, e.g. for a window which slides by less than
+             * the local domain size.
+             * All nodes in the simulation must call this function at the same iteration.
+             *
+             * @param[in] numCells number of cells to move the global domain offset
+             */
+            void shiftGlobalDomainOffset(size_t numCells)
+            {
+                DataSpace<DIM> globalDomainOffset(Environment<DIM>::get().SubGrid().getGlobalDomain().offset);
+                globalDomainOffset.y() += numCells;
+                Environment<DIM>::get().SubGrid().setGlobalDomainOffset(globalDomainOffset);
+            }
+
             /**
              * Returns a Mask which describes all neighbouring GPU nodes.
              *
@@ -52,6 +52,12 @@ namespace PMacc
         template <typename T_Species, typename T_MappingDesc>
         std::vector<std::size_t> getParticleCounts(T_MappingDesc &cellDescription);
 
+        /**
+         * Returns the number of frames per species on the device
+         */
+        template <typename T_Species, typename T_MappingDesc>
+        std::vector<std::size_t> getFrameCounts(T_MappingDesc &cellDescription);
+
     };
 
 } //namespace PMacc
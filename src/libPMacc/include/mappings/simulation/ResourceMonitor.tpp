@@ -22,6 +22,7 @@
 // PMacc
 #include "Environment.hpp"
 #include "particles/operations/CountParticles.hpp"
+#include "particles/operations/CountFrames.hpp"
 #include "pmacc_types.hpp"
 #include "forward.hpp"
 #include "dimensions/DataSpace.hpp"
@@ -53,6 +54,22 @@ namespace PMacc
         }
     };
 
+    template<typename T_Species>
+    struct MyCountFrames
+    {
+        template <typename T_Vector, typename T_MappingDesc>
+        void operator()(T_Vector & frameCounts, T_MappingDesc & cellDescription)
+        {
+            DataConnector & dc = Environment<>::get().DataConnector();
+
+            uint64_cu totalNumFrames = PMacc::CountFrames::countOnDevice < CORE + BORDER > (
+                    *dc.get<T_Species >(T_Species::FrameType::getName(), true),
+                    cellDescription);
+            dc.releaseData(T_Species::FrameType::getName());
+            frameCounts.push_back(totalNumFrames);
+        }
+    };
+
     template<unsigned T_DIM>
     ResourceMonitor<T_DIM>::ResourceMonitor()
     {
@@ -76,4 +93,14 @@ namespace PMacc
         return particleCounts;
     }
 
+    template<unsigned T_DIM>
+    template <typename T_Species, typename T_MappingDesc>
+    std::vector<size_t> ResourceMonitor<T_DIM>::getFrameCounts(T_MappingDesc &cellDescription)
+    {
+        std::vector<size_t> frameCounts;
+        algorithms::forEach::ForEach<T_Species, MyCountFrames<bmpl::_1> > countFrames;
+        countFrames(forward(frameCounts), forward(cellDescription));
+        return frameCounts;
+    }
+
 } //namespace PMacc
@@ -73,10 +73,12 @@ struct Euler
     }
 };
 
-/* Specialize sqrt() for complex numbers. */
+namespace detail
+{
 
-template<typename T_Type>
-struct Sqrt< ::PMacc::math::Complex<T_Type> >
+/** sqrt() for complex numbers with a precision policy */
+template<typename T_Type, typename T_Precision>
+struct ComplexSqrt
 {
     typedef typename ::PMacc::math::Complex<T_Type> result;
     typedef T_Type type;
@@ -84,29 +86,62 @@ struct Sqrt< ::PMacc::math::Complex<T_Type> >
     HDINLINE result operator( )(const ::PMacc::math::Complex<T_Type>& other)
     {
         if (other.get_real()<=type(0.0) && other.get_imag()==type(0.0) ) {
-            return ::PMacc::math::Complex<T_Type>(type(0.0), pmMath::sqrt( -other.get_real() ) );
+            return ::PMacc::math::Complex<T_Type>(type(0.0), pmMath::sqrt( -other.get_real(), T_Precision() ) );
         }
         else {
-            return pmMath::sqrt( pmMath::abs(other) )*(other+pmMath::abs(other))
+            return pmMath::sqrt( pmMath::abs(other), T_Precision() )*(other+pmMath::abs(other))
                 /pmMath::abs(other+pmMath::abs(other));
         }
     }
 };
 
-/* Specialize exp() for complex numbers. */
-
-template<typename T_Type>
-struct Exp< ::PMacc::math::Complex<T_Type> >
+/** exp() for complex numbers with a precision policy */
+template<typename T_Type, typename T_Precision>
+struct ComplexExp
 {
     typedef typename ::PMacc::math::Complex<T_Type> result;
     typedef T_Type type;
 
     HDINLINE result operator( )(const ::PMacc::math::Complex<T_Type>& other)
     {
-        return pmMath::euler(type(1.0),other.get_imag())*pmMath::exp(other.get_real());
+        return pmMath::euler(type(1.0), pmMath::sin(other.get_imag(), T_Precision()),
+                             pmMath::cos(other.get_imag(), T_Precision()))
+            *pmMath::exp(other.get_real(), T_Precision());
     }
 };
 
+} //namespace detail
+
+/* Specialize sqrt() and exp() for complex numbers.
+ *
+ * The precision policy is given explicitly, a specialization for any
+ * policy would be ambiguous with the fallback of Fast to Precise.
+ */
+
+template<typename T_Type>
+struct Sqrt< ::PMacc::math::Complex<T_Type> > :
+    public detail::ComplexSqrt< T_Type, Precise >
+{
+};
+
+template<typename T_Type>
+struct Sqrt< ::PMacc::math::Complex<T_Type>, Fast > :
+    public detail::ComplexSqrt< T_Type, Fast >
+{
+};
+
+template<typename T_Type>
+struct Exp< ::PMacc::math::Complex<T_Type> > :
+    public detail::ComplexExp< T_Type, Precise >
+{
+};
+
+template<typename T_Type>
+struct Exp< ::PMacc::math::Complex<T_Type>, Fast > :
+    public detail::ComplexExp< T_Type, Fast >
+{
+};
+
 /*  Set primary template and subsequent specialization of arg() for retrieving
  *  the phase of a complex number (Note: Branchcut running from -infinity to 0).
  */
@@ -140,9 +175,12 @@ struct Arg< ::PMacc::math::Complex<T_Type> >
     }
 };
 
-/*  Specialize pow() for complex numbers. */
-template<typename T_Type>
-struct Pow< ::PMacc::math::Complex<T_Type>, T_Type >
+namespace detail
+{
+
+/** pow() for complex numbers with a precision policy */
+template<typename T_Type, typename T_Precision>
+struct ComplexPow
 {
     typedef typename ::PMacc::math::Complex<T_Type> result;
     typedef T_Type type;
@@ -150,12 +188,27 @@ struct Pow< ::PMacc::math::Complex<T_Type>, T_Type >
     HDINLINE result operator( )(const ::PMacc::math::Complex<T_Type>& other,
                                 const T_Type& exponent)
     {
-        return pmMath::pow( pmMath::abs(other),exponent )
+        return pmMath::pow( pmMath::abs(other),exponent, T_Precision() )
                 *pmMath::exp( ::PMacc::math::Complex<T_Type>(type(0.),type(1.) )
-                *pmMath::arg(other)*exponent );
+                *pmMath::arg(other)*exponent, T_Precision() );
     }
 };
 
+} //namespace detail
+
+/*  Specialize pow() for complex numbers. */
+template<typename T_Type>
+struct Pow< ::PMacc::math::Complex<T_Type>, T_Type > :
+    public detail::ComplexPow< T_Type, Precise >
+{
+};
+
+template<typename T_Type>
+struct Pow< ::PMacc::math::Complex<T_Type>, T_Type, Fast > :
+    public detail::ComplexPow< T_Type, Fast >
+{
+};
+
 /*  Specialize abs() for complex numbers. */
 template<typename T_Type>
 struct Abs< ::PMacc::math::Complex<T_Type> >
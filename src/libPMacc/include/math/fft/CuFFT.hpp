@@ -0,0 +1,275 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "math/fft/FFT.def"
+#include "math/Complex.hpp"
+#include "memory/buffers/DeviceBufferIntern.hpp"
+#include "eventSystem/EventSystem.hpp"
+#include "Environment.hpp"
+
+#include <cufft.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+
+#ifndef CUFFT_CHECK
+/** throw a std::runtime_error if a cuFFT call fails */
+#define CUFFT_CHECK(cmd)                                                       \
+    {                                                                          \
+        cufftResult result = cmd;                                              \
+        if( result != CUFFT_SUCCESS )                                          \
+        {                                                                      \
+            std::stringstream msg;                                             \
+            msg << "[cuFFT] error " << result << " in " << #cmd                \
+                << " (" << __FILE__ << ":" << __LINE__ << ")";                 \
+            throw std::runtime_error( msg.str() );                             \
+        }                                                                      \
+    }
+#endif
+
+namespace PMacc
+{
+namespace math
+{
+namespace fft
+{
+namespace detail
+{
+
+    /** map the precision to the cuFFT transform types and functions */
+    template< typename T_Real >
+    struct CuFFTTypes;
+
+    template< >
+    struct CuFFTTypes< float >
+    {
+        static constexpr cufftType forward = CUFFT_R2C;
+        static constexpr cufftType inverse = CUFFT_C2R;
+
+        static cufftResult
+        execForward( cufftHandle plan, float* in, Complex< float >* out )
+        {
+            return cufftExecR2C( plan, in, reinterpret_cast< cufftComplex* >( out ) );
+        }
+
+        static cufftResult
+        execInverse( cufftHandle plan, Complex< float >* in, float* out )
+        {
+            return cufftExecC2R( plan, reinterpret_cast< cufftComplex* >( in ), out );
+        }
+    };
+
+    template< >
+    struct CuFFTTypes< double >
+    {
+        static constexpr cufftType forward = CUFFT_D2Z;
+        static constexpr cufftType inverse = CUFFT_Z2D;
+
+        static cufftResult
+        execForward( cufftHandle plan, double* in, Complex< double >* out )
+        {
+            return cufftExecD2Z( plan, in, reinterpret_cast< cufftDoubleComplex* >( out ) );
+        }
+
+        static cufftResult
+        execInverse( cufftHandle plan, Complex< double >* in, double* out )
+        {
+            return cufftExecZ2D( plan, reinterpret_cast< cufftDoubleComplex* >( in ), out );
+        }
+    };
+
+} // namespace detail
+
+    /** real to complex FFT executed with cuFFT on the device
+     *
+     * The buffers are device buffers without host mirror, rows padded to
+     * the pitch of the PMacc device buffers are supported.
+     * The plans (and the cuFFT work areas) are created by prepare() or at
+     * the first transform, all later calls must use buffers with the same
+     * size and pitch.
+     *
+     * The transforms are not normalized, `inverse( forward( x ) )` is `x`
+     * multiplied with the number of real elements.
+     *
+     * @tparam T_dim dimensionality of the transform
+     * @tparam T_Real float or double
+     */
+    template< unsigned T_dim, typename T_Real >
+    class CuFFT
+    {
+    public:
+        static constexpr unsigned dim = T_dim;
+        typedef T_Real Real;
+        typedef Complex< T_Real > ComplexType;
+        typedef DeviceBufferIntern< Real, dim > RealBuffer;
+        typedef DeviceBufferIntern< ComplexType, dim > ComplexBuffer;
+
+        /** constructor
+         *
+         * @param realSize size of the real data,
+         *                 the complex data has the size getComplexSize( realSize )
+         */
+        CuFFT( const DataSpace< dim >& realSize ) :
+            realSize( realSize ),
+            hasPlans( false ),
+            realPitch( 0 ),
+            complexPitch( 0 )
+        {
+        }
+
+        ~CuFFT()
+        {
+            if( hasPlans )
+            {
+                cufftDestroy( planForward );
+                cufftDestroy( planInverse );
+            }
+        }
+
+        /** create the plans and allocate the cuFFT work areas
+         *
+         * Allows to allocate all device memory of the transforms before the
+         * remaining memory is distributed, e.g. to the particle heap.
+         *
+         * @param realBuffer real buffer used for all later transforms
+         * @param complexBuffer complex buffer with the layout of all later spectra
+         */
+        void prepare( RealBuffer& realBuffer, ComplexBuffer& complexBuffer )
+        {
+            createPlans( realBuffer, complexBuffer );
+        }
+
+        /** transform from real to complex space
+         *
+         * @param in real data, the content is preserved
+         * @param[out] out spectrum
+         */
+        void forward( RealBuffer& in, ComplexBuffer& out )
+        {
+            createPlans( in, out );
+            TaskKernel* task = Environment<>::get().Factory().createTaskKernel( "cufftExecForward" );
+            CUFFT_CHECK( cufftSetStream( planForward, task->getCudaStream() ) );
+            CUFFT_CHECK( detail::CuFFTTypes< Real >::execForward(
+                planForward,
+                in.getBasePointer(),
+                out.getBasePointer()
+            ) );
+            task->activateChecks();
+        }
+
+        /** transform from complex to real space
+         *
+         * @param in spectrum, the content is overwritten by cuFFT
+         * @param[out] out real data
+         */
+        void inverse( ComplexBuffer& in, RealBuffer& out )
+        {
+            createPlans( out, in );
+            TaskKernel* task = Environment<>::get().Factory().createTaskKernel( "cufftExecInverse" );
+            CUFFT_CHECK( cufftSetStream( planInverse, task->getCudaStream() ) );
+            CUFFT_CHECK( detail::CuFFTTypes< Real >::execInverse(
+                planInverse,
+                in.getBasePointer(),
+                out.getBasePointer()
+            ) );
+            task->activateChecks();
+        }
+
+        static std::string getName()
+        {
+            return std::string( "cuFFT" );
+        }
+
+    private:
+
+        /** get the pitch of a device buffer in elements */
+        template< typename T_Type >
+        static int getPitchInElements( DeviceBuffer< T_Type, dim >& buffer )
+        {
+            if( dim == DIM1 )
+                return buffer.getDataSpace().x();
+
+            const size_t pitch = buffer.getPitch();
+            if( pitch % sizeof( T_Type ) != 0 )
+                throw std::runtime_error( "[cuFFT] pitch of the device buffer is not a multiple of the element size" );
+            return static_cast< int >( pitch / sizeof( T_Type ) );
+        }
+
+        void createPlans( RealBuffer& realBuffer, ComplexBuffer& complexBuffer )
+        {
+            const int newRealPitch = getPitchInElements( realBuffer );
+            const int newComplexPitch = getPitchInElements( complexBuffer );
+
+            if( hasPlans )
+            {
+                if( newRealPitch != realPitch || newComplexPitch != complexPitch )
+                    throw std::runtime_error( "[cuFFT] buffers must have the same layout for all transforms of a plan" );
+                return;
+            }
+
+            realPitch = newRealPitch;
+            complexPitch = newComplexPitch;
+
+            /* cuFFT expects the slowest varying dimension first */
+            int n[ dim ];
+            int realEmbed[ dim ];
+            int complexEmbed[ dim ];
+            for( unsigned d = 0; d < dim; ++d )
+            {
+                n[ d ] = realSize[ dim - 1 - d ];
+                realEmbed[ d ] = n[ d ];
+                complexEmbed[ d ] = n[ d ];
+            }
+            realEmbed[ dim - 1 ] = realPitch;
+            complexEmbed[ dim - 1 ] = complexPitch;
+
+            const int realDist = realEmbed[ dim - 1 ] * ( realSize.productOfComponents() / realSize.x() );
+            const int complexDist = complexEmbed[ dim - 1 ] * ( realSize.productOfComponents() / realSize.x() );
+
+            CUFFT_CHECK( cufftPlanMany(
+                &planForward, dim, n,
+                realEmbed, 1, realDist,
+                complexEmbed, 1, complexDist,
+                detail::CuFFTTypes< Real >::forward, 1
+            ) );
+            CUFFT_CHECK( cufftPlanMany(
+                &planInverse, dim, n,
+                complexEmbed, 1, complexDist,
+                realEmbed, 1, realDist,
+                detail::CuFFTTypes< Real >::inverse, 1
+            ) );
+            hasPlans = true;
+        }
+
+        DataSpace< dim > realSize;
+        bool hasPlans;
+        int realPitch;
+        int complexPitch;
+        cufftHandle planForward;
+        cufftHandle planInverse;
+    };
+
+} // namespace fft
+} // namespace math
+} // namespace PMacc
@@ -0,0 +1,256 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "math/fft/FFT.def"
+#include "math/Complex.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "eventSystem/EventSystem.hpp"
+#include "Environment.hpp"
+
+#include <fftw3.h>
+#include <stdexcept>
+#include <string>
+
+
+namespace PMacc
+{
+namespace math
+{
+namespace fft
+{
+namespace detail
+{
+
+    /** map the precision to the FFTW plan type and functions */
+    template< typename T_Real >
+    struct FFTWTypes;
+
+    template< >
+    struct FFTWTypes< float >
+    {
+        typedef fftwf_plan Plan;
+
+        static Plan
+        planForward( int rank, const int* n, float* in, Complex< float >* out )
+        {
+            return fftwf_plan_dft_r2c( rank, n, in, reinterpret_cast< fftwf_complex* >( out ), FFTW_ESTIMATE );
+        }
+
+        static Plan
+        planInverse( int rank, const int* n, Complex< float >* in, float* out )
+        {
+            return fftwf_plan_dft_c2r( rank, n, reinterpret_cast< fftwf_complex* >( in ), out, FFTW_ESTIMATE );
+        }
+
+        static void
+        execForward( Plan plan, float* in, Complex< float >* out )
+        {
+            fftwf_execute_dft_r2c( plan, in, reinterpret_cast< fftwf_complex* >( out ) );
+        }
+
+        static void
+        execInverse( Plan plan, Complex< float >* in, float* out )
+        {
+            fftwf_execute_dft_c2r( plan, reinterpret_cast< fftwf_complex* >( in ), out );
+        }
+
+        static void
+        destroy( Plan plan )
+        {
+            fftwf_destroy_plan( plan );
+        }
+    };
+
+    template< >
+    struct FFTWTypes< double >
+    {
+        typedef fftw_plan Plan;
+
+        static Plan
+        planForward( int rank, const int* n, double* in, Complex< double >* out )
+        {
+            return fftw_plan_dft_r2c( rank, n, in, reinterpret_cast< fftw_complex* >( out ), FFTW_ESTIMATE );
+        }
+
+        static Plan
+        planInverse( int rank, const int* n, Complex< double >* in, double* out )
+        {
+            return fftw_plan_dft_c2r( rank, n, reinterpret_cast< fftw_complex* >( in ), out, FFTW_ESTIMATE );
+        }
+
+        static void
+        execForward( Plan plan, double* in, Complex< double >* out )
+        {
+            fftw_execute_dft_r2c( plan, in, reinterpret_cast< fftw_complex* >( out ) );
+        }
+
+        static void
+        execInverse( Plan plan, Complex< double >* in, double* out )
+        {
+            fftw_execute_dft_c2r( plan, reinterpret_cast< fftw_complex* >( in ), out );
+        }
+
+        static void
+        destroy( Plan plan )
+        {
+            fftw_destroy_plan( plan );
+        }
+    };
+
+} // namespace detail
+
+    /** real to complex FFT executed with FFTW on the host
+     *
+     * Has the same interface as CuFFT. The device side of the input buffer
+     * is copied to the host, transformed with FFTW and the result is copied
+     * back to the device side of the output buffer. This backend is meant
+     * for hosts without cuFFT and for validating the device backend.
+     *
+     * The transforms are not normalized, `inverse( forward( x ) )` is `x`
+     * multiplied with the number of real elements.
+     *
+     * @tparam T_dim dimensionality of the transform
+     * @tparam T_Real float or double
+     */
+    template< unsigned T_dim, typename T_Real >
+    class FFTW
+    {
+    public:
+        static constexpr unsigned dim = T_dim;
+        typedef T_Real Real;
+        typedef Complex< T_Real > ComplexType;
+        typedef GridBuffer< Real, dim > RealBuffer;
+        typedef GridBuffer< ComplexType, dim > ComplexBuffer;
+
+        /** constructor
+         *
+         * @param realSize size of the real data,
+         *                 the complex data has the size getComplexSize( realSize )
+         */
+        FFTW( const DataSpace< dim >& realSize ) :
+            realSize( realSize ),
+            hasPlans( false )
+        {
+        }
+
+        ~FFTW()
+        {
+            if( hasPlans )
+            {
+                detail::FFTWTypes< Real >::destroy( planForward );
+                detail::FFTWTypes< Real >::destroy( planInverse );
+            }
+        }
+
+        /** create the plans
+         *
+         * @param realBuffer real buffer used for all later transforms
+         * @param complexBuffer complex buffer with the layout of all later spectra
+         */
+        void prepare( RealBuffer& realBuffer, ComplexBuffer& complexBuffer )
+        {
+            createPlans( realBuffer, complexBuffer );
+        }
+
+        /** transform from real to complex space
+         *
+         * @param in real data, the content is preserved
+         * @param[out] out spectrum
+         */
+        void forward( RealBuffer& in, ComplexBuffer& out )
+        {
+            in.deviceToHost();
+            __getTransactionEvent().waitForFinished();
+
+            createPlans( in, out );
+            detail::FFTWTypes< Real >::execForward(
+                planForward,
+                in.getHostBuffer().getBasePointer(),
+                out.getHostBuffer().getBasePointer()
+            );
+            out.hostToDevice();
+        }
+
+        /** transform from complex to real space
+         *
+         * @param in spectrum, the host side is overwritten by FFTW
+         * @param[out] out real data
+         */
+        void inverse( ComplexBuffer& in, RealBuffer& out )
+        {
+            in.deviceToHost();
+            __getTransactionEvent().waitForFinished();
+
+            createPlans( out, in );
+            detail::FFTWTypes< Real >::execInverse(
+                planInverse,
+                in.getHostBuffer().getBasePointer(),
+                out.getHostBuffer().getBasePointer()
+            );
+            out.hostToDevice();
+        }
+
+        static std::string getName()
+        {
+            return std::string( "FFTW" );
+        }
+
+    private:
+
+        void createPlans( RealBuffer& realBuffer, ComplexBuffer& complexBuffer )
+        {
+            if( hasPlans )
+                return;
+
+            /* FFTW expects the slowest varying dimension first */
+            int n[ dim ];
+            for( unsigned d = 0; d < dim; ++d )
+                n[ d ] = realSize[ dim - 1 - d ];
+
+            /* FFTW_ESTIMATE does not touch the data while planning,
+             * later calls execute the plans on other buffers of the same size
+             */
+            planForward = detail::FFTWTypes< Real >::planForward(
+                dim, n,
+                realBuffer.getHostBuffer().getBasePointer(),
+                complexBuffer.getHostBuffer().getBasePointer()
+            );
+            planInverse = detail::FFTWTypes< Real >::planInverse(
+                dim, n,
+                complexBuffer.getHostBuffer().getBasePointer(),
+                realBuffer.getHostBuffer().getBasePointer()
+            );
+            if( planForward == nullptr || planInverse == nullptr )
+                throw std::runtime_error( "[FFTW] plan creation failed" );
+            hasPlans = true;
+        }
+
+        DataSpace< dim > realSize;
+        bool hasPlans;
+        typename detail::FFTWTypes< Real >::Plan planForward;
+        typename detail::FFTWTypes< Real >::Plan planInverse;
+    };
+
+} // namespace fft
+} // namespace math
+} // namespace PMacc
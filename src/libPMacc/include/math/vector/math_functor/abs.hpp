@@ -42,7 +42,7 @@ struct Abs
     }
 };
 
-lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Abs> > _abs;
+const lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Abs> > _abs;
 
 } // math_vector
 } // math
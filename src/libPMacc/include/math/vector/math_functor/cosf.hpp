@@ -42,7 +42,7 @@ struct Cosf
     }
 };
 
-lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Cosf> > _cosf;
+const lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Cosf> > _cosf;
 
 } // math_functor
 } // math
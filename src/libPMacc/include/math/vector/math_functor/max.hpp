@@ -42,7 +42,7 @@ struct Max
     }
 };
 
-lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Max> > _max;
+const lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Max> > _max;
 
 } // math_vector
 } // math
@@ -43,7 +43,7 @@ struct Min
     }
 };
 
-lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Min> > _min;
+const lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Min> > _min;
 
 } // math_functor
 } // math
@@ -43,8 +43,8 @@ struct Sin
     }
 };
 
-lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Sin<float>> > _sinf;
-lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Sin<double>> > _sind;
+const lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Sin<float>> > _sinf;
+const lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Sin<double>> > _sind;
 
 } // math_functor
 } // math
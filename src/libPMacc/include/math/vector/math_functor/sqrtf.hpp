@@ -42,7 +42,7 @@ struct Sqrtf
     }
 };
 
-lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Sqrtf> > _sqrtf;
+const lambda::Expression<lambda::exprTypes::terminal, mpl::vector<Sqrtf> > _sqrtf;
 
 } // math_functor
 } // math
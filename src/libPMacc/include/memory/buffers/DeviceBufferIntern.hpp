@@ -51,7 +51,8 @@ public:
     DeviceBuffer<TYPE, DIM>(size, size),
     sizeOnDevice(sizeOnDevice),
     useOtherMemory(false),
-    offset(DataSpace<DIM>())
+    offset(DataSpace<DIM>()),
+    allocatedBytes(0)
     {
         //create size on device before any use of setCurrentSize
         if (useVectorAsBase)
@@ -75,7 +76,8 @@ public:
     sizeOnDevice(sizeOnDevice),
     offset(offset + source.getOffset()),
     data(source.getCudaPitched()),
-    useOtherMemory(true)
+    useOtherMemory(true),
+    allocatedBytes(0)
     {
         createSizeOnDevice(sizeOnDevice);
         this->data1D = false;
@@ -92,7 +94,7 @@ public:
         if (!useOtherMemory)
         {
             CUDA_CHECK(cudaFree(data.ptr));
-
+            Environment<>::get().MemoryInfo().removeBufferMemory(nvidia::memory::DEVICE_BUFFER_MEMORY, allocatedBytes);
         }
     }
 
@@ -274,6 +276,10 @@ private:
             CUDA_CHECK(cudaMalloc3D(&data, extent));
         }
 
+        /* all rows are padded to the pitch */
+        allocatedBytes = data.pitch * (this->getDataSpace().productOfComponents() / this->getDataSpace()[0]);
+        Environment<>::get().MemoryInfo().addBufferMemory(nvidia::memory::DEVICE_BUFFER_MEMORY, allocatedBytes);
+
         reset(false);
     }
 
@@ -290,6 +296,9 @@ private:
         log<ggLog::MEMORY >("Create device fake data: %1% MiB") % (this->getDataSpace().productOfComponents() * sizeof (TYPE) / 1024 / 1024);
         CUDA_CHECK(cudaMallocPitch(&data.ptr, &data.pitch, this->getDataSpace().productOfComponents() * sizeof (TYPE), 1));
 
+        allocatedBytes = this->getDataSpace().productOfComponents() * sizeof (TYPE);
+        Environment<>::get().MemoryInfo().addBufferMemory(nvidia::memory::DEVICE_BUFFER_MEMORY, allocatedBytes);
+
         //fake the pitch, thus we can use this 1D Buffer as 2D or 3D
         data.pitch = this->getDataSpace()[0] * sizeof (TYPE);
 
@@ -320,6 +329,8 @@ private:
     size_t* sizeOnDevicePtr;
     cudaPitchedPtr data;
     bool useOtherMemory;
+    /* size of the own device memory in byte */
+    size_t allocatedBytes;
 };
 
 } //namespace PMacc
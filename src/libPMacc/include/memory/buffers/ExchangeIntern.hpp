@@ -47,7 +47,8 @@ namespace PMacc
 
         ExchangeIntern(DeviceBuffer<TYPE, DIM>& source, GridLayout<DIM> memoryLayout, DataSpace<DIM> guardingCells, uint32_t exchange,
                        uint32_t communicationTag, uint32_t area = BORDER, bool sizeOnDevice = false) :
-        Exchange<TYPE, DIM>(exchange, communicationTag), deviceDoubleBuffer(nullptr)
+        Exchange<TYPE, DIM>(exchange, communicationTag), deviceDoubleBuffer(nullptr),
+        exchangeDeviceBytes(0), exchangeHostBytes(0)
         {
 
             PMACC_ASSERT(!guardingCells.isOneDimensionGreaterThan(memoryLayout.getGuard()));
@@ -77,11 +78,13 @@ namespace PMacc
             }
 
             this->hostBuffer = new HostBufferIntern<TYPE, DIM > (tmp_size);
+            accountMemory(false);
         }
 
         ExchangeIntern(DataSpace<DIM> exchangeDataSpace, uint32_t exchange,
                        uint32_t communicationTag, bool sizeOnDevice = false) :
-        Exchange<TYPE, DIM>(exchange, communicationTag), deviceDoubleBuffer(nullptr)
+        Exchange<TYPE, DIM>(exchange, communicationTag), deviceDoubleBuffer(nullptr),
+        exchangeDeviceBytes(0), exchangeHostBytes(0)
         {
             this->deviceBuffer = new DeviceBufferIntern<TYPE, DIM > (exchangeDataSpace, sizeOnDevice);
            //  this->deviceBuffer = new DeviceBufferIntern<TYPE, DIM > (exchangeDataSpace, sizeOnDevice,true);
@@ -92,6 +95,7 @@ namespace PMacc
             }
 
             this->hostBuffer = new HostBufferIntern<TYPE, DIM > (exchangeDataSpace);
+            accountMemory(true);
         }
 
         /**
@@ -119,6 +123,8 @@ namespace PMacc
 
         virtual ~ExchangeIntern()
         {
+            Environment<>::get().MemoryInfo().removeBufferMemory(nvidia::memory::DEVICE_EXCHANGE_MEMORY, exchangeDeviceBytes);
+            Environment<>::get().MemoryInfo().removeBufferMemory(nvidia::memory::HOST_EXCHANGE_MEMORY, exchangeHostBytes);
             __delete(hostBuffer);
             __delete(deviceBuffer);
             __delete(deviceDoubleBuffer);
@@ -230,6 +236,27 @@ namespace PMacc
         /*! This buffer is a vector which is used as message buffer for faster memcopy
          */
         DeviceBufferIntern<TYPE, DIM> *deviceDoubleBuffer;
+
+        /* size of the memory owned by this exchange in byte */
+        size_t exchangeDeviceBytes;
+        size_t exchangeHostBytes;
+
+        /** add the size of the exchange buffers to the memory statistics
+         *
+         * @param ownsDeviceBuffer true if the device buffer is not a view
+         *                         into the source buffer
+         */
+        void accountMemory(bool ownsDeviceBuffer)
+        {
+            const size_t bytes = this->hostBuffer->getDataSpace().productOfComponents() * sizeof (TYPE);
+            exchangeHostBytes = bytes;
+            if (ownsDeviceBuffer)
+                exchangeDeviceBytes += bytes;
+            if (deviceDoubleBuffer != nullptr)
+                exchangeDeviceBytes += bytes;
+            Environment<>::get().MemoryInfo().addBufferMemory(nvidia::memory::DEVICE_EXCHANGE_MEMORY, exchangeDeviceBytes);
+            Environment<>::get().MemoryInfo().addBufferMemory(nvidia::memory::HOST_EXCHANGE_MEMORY, exchangeHostBytes);
+        }
         DeviceBufferIntern<TYPE, DIM> *deviceBuffer;
 
     };
@@ -50,6 +50,10 @@ public:
     pointer(nullptr),ownPointer(true)
     {
         CUDA_CHECK(cudaMallocHost(&pointer, size.productOfComponents() * sizeof (TYPE)));
+        Environment<>::get().MemoryInfo().addBufferMemory(
+            nvidia::memory::HOST_BUFFER_MEMORY,
+            size.productOfComponents() * sizeof (TYPE)
+        );
         reset(false);
     }
 
@@ -71,6 +75,10 @@ public:
         if (pointer && ownPointer)
         {
             CUDA_CHECK(cudaFreeHost(pointer));
+            Environment<>::get().MemoryInfo().removeBufferMemory(
+                nvidia::memory::HOST_BUFFER_MEMORY,
+                this->getDataSpace().productOfComponents() * sizeof (TYPE)
+            );
         }
     }
 
@@ -0,0 +1,162 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "communication/manager_common.hpp"
+#include "pmacc_types.hpp"
+
+#include <mpi.h>
+#include <stdexcept>
+
+
+namespace PMacc
+{
+namespace mpi
+{
+
+/** split of the MPI ranks into simulation and staging ranks
+ *
+ * The last `numStagingRanks` ranks of MPI_COMM_WORLD are reserved for
+ * non-time-critical work (e.g. writing data which is shipped by the
+ * simulation ranks). All other ranks form the simulation communicator which
+ * replaces MPI_COMM_WORLD in PMacc.
+ *
+ * Without a call of init() or with zero staging ranks the simulation
+ * communicator is MPI_COMM_WORLD.
+ */
+class CommunicatorSplit
+{
+public:
+
+    /** get the singleton CommunicatorSplit
+     *
+     * @return instance of CommunicatorSplit
+     */
+    static CommunicatorSplit& get()
+    {
+        static CommunicatorSplit instance;
+        return instance;
+    }
+
+    /** split MPI_COMM_WORLD
+     *
+     * Collective over MPI_COMM_WORLD, must be called after MPI_Init and before
+     * any communicator of PMacc is created.
+     *
+     * @param numStagingRanks number of ranks reserved for staging
+     */
+    void init(uint32_t numStagingRanks)
+    {
+        int worldSize = 0;
+        int worldRank = 0;
+        MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &worldSize));
+        MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &worldRank));
+
+        if (numStagingRanks == 0)
+            return;
+
+        if (static_cast<int>(numStagingRanks) >= worldSize)
+            throw std::invalid_argument("number of staging ranks must be smaller than the number of MPI ranks");
+
+        this->numStagingRanks = numStagingRanks;
+        const int firstStagingRank = worldSize - static_cast<int>(numStagingRanks);
+        stagingRank = worldRank >= firstStagingRank;
+
+        MPI_CHECK(MPI_Comm_split(MPI_COMM_WORLD, stagingRank ? 1 : 0, worldRank, &localComm));
+
+        /* the leader of the other group in MPI_COMM_WORLD */
+        const int remoteLeader = stagingRank ? 0 : firstStagingRank;
+        MPI_CHECK(MPI_Intercomm_create(localComm, 0, MPI_COMM_WORLD, remoteLeader,
+                                       interCommTag, &interComm));
+    }
+
+    /** free all communicators created by init() */
+    void finalize()
+    {
+        if (interComm != MPI_COMM_NULL)
+            MPI_CHECK(MPI_Comm_free(&interComm));
+        if (localComm != MPI_COMM_NULL)
+            MPI_CHECK(MPI_Comm_free(&localComm));
+        numStagingRanks = 0;
+        stagingRank = false;
+    }
+
+    /** communicator of all simulation ranks
+     *
+     * must not be used on staging ranks
+     */
+    MPI_Comm getSimulationComm() const
+    {
+        return localComm == MPI_COMM_NULL ? MPI_COMM_WORLD : localComm;
+    }
+
+    /** communicator of the own group (simulation or staging ranks) */
+    MPI_Comm getLocalComm() const
+    {
+        return getSimulationComm();
+    }
+
+    /** intercommunicator between simulation and staging ranks
+     *
+     * @return MPI_COMM_NULL if no staging ranks are used
+     */
+    MPI_Comm getInterComm() const
+    {
+        return interComm;
+    }
+
+    /** true if this rank is a staging rank */
+    bool isStagingRank() const
+    {
+        return stagingRank;
+    }
+
+    /** number of staging ranks */
+    uint32_t getNumStagingRanks() const
+    {
+        return numStagingRanks;
+    }
+
+    CommunicatorSplit(const CommunicatorSplit&) = delete;
+    CommunicatorSplit& operator=(const CommunicatorSplit&) = delete;
+
+private:
+
+    /** tag used on MPI_COMM_WORLD to create the intercommunicator */
+    static constexpr int interCommTag = 1;
+
+    CommunicatorSplit() :
+        numStagingRanks(0),
+        stagingRank(false),
+        localComm(MPI_COMM_NULL),
+        interComm(MPI_COMM_NULL)
+    {
+    }
+
+    uint32_t numStagingRanks;
+    bool stagingRank;
+    MPI_Comm localComm;
+    MPI_Comm interComm;
+};
+
+} // namespace mpi
+} // namespace PMacc
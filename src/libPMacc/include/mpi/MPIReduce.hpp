@@ -25,6 +25,7 @@
 #include "mpi/reduceMethods/AllReduce.hpp"
 #include "mpi/GetMPI_StructAsArray.hpp"
 #include "mpi/GetMPI_Op.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 #include "assert.hpp"
 #include "pmacc_types.hpp"
 
@@ -95,16 +96,17 @@ struct MPIReduce
             isMPICommInitialized = false;
         }
 
+        const MPI_Comm simulationComm = CommunicatorSplit::get().getSimulationComm();
         int countRanks;
-        MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &countRanks));
+        MPI_CHECK(MPI_Comm_size(simulationComm, &countRanks));
         std::vector<int> reduceRank(countRanks);
         std::vector<int> groupRanks(countRanks);
-        MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank));
+        MPI_CHECK(MPI_Comm_rank(simulationComm, &mpiRank));
 
         if (!isActive)
             mpiRank = -1;
 
-        MPI_CHECK(MPI_Allgather(&mpiRank, 1, MPI_INT, &reduceRank[0], 1, MPI_INT, MPI_COMM_WORLD));
+        MPI_CHECK(MPI_Allgather(&mpiRank, 1, MPI_INT, &reduceRank[0], 1, MPI_INT, simulationComm));
 
         for (int i = 0; i < countRanks; ++i)
         {
@@ -117,10 +119,10 @@ struct MPIReduce
 
         MPI_Group group = MPI_GROUP_NULL;
         MPI_Group newgroup = MPI_GROUP_NULL;
-        MPI_CHECK(MPI_Comm_group(MPI_COMM_WORLD, &group));
+        MPI_CHECK(MPI_Comm_group(simulationComm, &group));
         MPI_CHECK(MPI_Group_incl(group, numRanks, &groupRanks[0], &newgroup));
 
-        MPI_CHECK(MPI_Comm_create(MPI_COMM_WORLD, newgroup, &comm));
+        MPI_CHECK(MPI_Comm_create(simulationComm, newgroup, &comm));
 
         if (mpiRank != -1)
         {
@@ -47,7 +47,7 @@ namespace PMacc
 namespace mpi
 {
     template<>
-    MPI_Op getMPI_Op<PMacc::nvidia::functors::Add>()
+    inline MPI_Op getMPI_Op<PMacc::nvidia::functors::Add>()
     {
         return MPI_SUM;
     }
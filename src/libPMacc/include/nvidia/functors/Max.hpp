@@ -49,7 +49,7 @@ namespace PMacc
 namespace mpi
 {
     template<>
-    MPI_Op getMPI_Op<PMacc::nvidia::functors::Max>()
+    inline MPI_Op getMPI_Op<PMacc::nvidia::functors::Max>()
     {
         return MPI_MAX;
     }
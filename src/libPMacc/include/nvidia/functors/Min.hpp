@@ -38,7 +38,7 @@ namespace functors
         template<typename Dst, typename Src >
         DINLINE void operator()(Dst & dst, const Src & src) const
         {
-            dst = algorithms::math::max(dst, src);
+            dst = algorithms::math::min(dst, src);
         }
     };
 } // namespace functors
@@ -50,7 +50,7 @@ namespace PMacc
 namespace mpi
 {
     template<>
-    MPI_Op getMPI_Op<PMacc::nvidia::functors::Min>()
+    inline MPI_Op getMPI_Op<PMacc::nvidia::functors::Min>()
     {
         return MPI_MIN;
     }
@@ -48,7 +48,7 @@ namespace PMacc
 namespace mpi
 {
     template<>
-    MPI_Op getMPI_Op<PMacc::nvidia::functors::Mul>()
+    inline MPI_Op getMPI_Op<PMacc::nvidia::functors::Mul>()
     {
         return MPI_PROD;
     }
@@ -34,6 +34,20 @@ namespace nvidia
 namespace memory
 {
 
+/** categories of the memory allocated by buffers */
+enum BufferMemoryType
+{
+    /* device memory of all buffers including exchanges */
+    DEVICE_BUFFER_MEMORY = 0,
+    /* page-locked host memory of all buffers including exchanges */
+    HOST_BUFFER_MEMORY = 1,
+    /* device memory of exchange buffers */
+    DEVICE_EXCHANGE_MEMORY = 2,
+    /* host memory of exchange buffers */
+    HOST_EXCHANGE_MEMORY = 3,
+    NUM_BUFFER_MEMORY_TYPES = 4
+};
+
 /**
  * Provides convenience methods for querying memory information.
  * Singleton class.
@@ -103,8 +117,44 @@ public:
         this->reservedMem = reservedMem;
     }
 
+    /** account memory allocated by a buffer
+     *
+     * @param type category of the memory
+     * @param bytes number of allocated bytes
+     */
+    void addBufferMemory(BufferMemoryType type, size_t bytes)
+    {
+        bufferMemory[type] += bytes;
+        if (bufferMemory[type] > peakBufferMemory[type])
+            peakBufferMemory[type] = bufferMemory[type];
+    }
+
+    /** account memory freed by a buffer
+     *
+     * @param type category of the memory
+     * @param bytes number of freed bytes
+     */
+    void removeBufferMemory(BufferMemoryType type, size_t bytes)
+    {
+        bufferMemory[type] -= bytes;
+    }
+
+    /** Returns the number of bytes currently allocated by buffers */
+    size_t getBufferMemory(BufferMemoryType type) const
+    {
+        return bufferMemory[type];
+    }
+
+    /** Returns the maximum number of bytes allocated by buffers at once */
+    size_t getPeakBufferMemory(BufferMemoryType type) const
+    {
+        return peakBufferMemory[type];
+    }
+
 protected:
     size_t reservedMem;
+    size_t bufferMemory[NUM_BUFFER_MEMORY_TYPES];
+    size_t peakBufferMemory[NUM_BUFFER_MEMORY_TYPES];
 
 private:
 
@@ -119,7 +169,11 @@ private:
     MemoryInfo() :
     reservedMem(0)
     {
-
+        for (int i = 0; i < NUM_BUFFER_MEMORY_TYPES; ++i)
+        {
+            bufferMemory[i] = 0;
+            peakBufferMemory[i] = 0;
+        }
     }
 };
 } //namespace memory
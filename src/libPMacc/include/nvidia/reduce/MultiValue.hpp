@@ -0,0 +1,206 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "algorithms/math.hpp"
+#include "pmacc_types.hpp"
+
+
+namespace PMacc
+{
+namespace nvidia
+{
+namespace reduce
+{
+
+    /** value with an error compensation term
+     *
+     * Sums are accumulated with the Kahan-Babuska (Neumaier) algorithm, the
+     * rounding error of each addition is collected in `compensation`.
+     * Together with the tree reduction of kernel::Reduce the error grows
+     * only with the number of values reduced by a single thread and not with
+     * the total number of values.
+     *
+     * @tparam T_Type floating point type
+     */
+    template< typename T_Type >
+    struct CompensatedValue
+    {
+        typedef T_Type type;
+
+        T_Type value;
+        T_Type compensation;
+
+        HDINLINE CompensatedValue( )
+        {
+        }
+
+        HDINLINE CompensatedValue( const T_Type initValue ) :
+            value( initValue ),
+            compensation( T_Type( 0.0 ) )
+        {
+        }
+
+        /** add a value with error compensation */
+        HDINLINE void add( const T_Type summand )
+        {
+            const T_Type sum = value + summand;
+            if( algorithms::math::abs( value ) >= algorithms::math::abs( summand ) )
+                compensation += ( value - sum ) + summand;
+            else
+                compensation += ( summand - sum ) + value;
+            value = sum;
+        }
+
+        /** merge two partial sums */
+        HDINLINE void add( const CompensatedValue& other )
+        {
+            add( other.value );
+            compensation += other.compensation;
+        }
+
+        /** result of the summation */
+        HDINLINE T_Type get( ) const
+        {
+            return value + compensation;
+        }
+    };
+
+    /** reduce a slot of a MultiValue with a compensated sum */
+    struct Sum
+    {
+        template< typename T_Type >
+        HDINLINE static void combine( CompensatedValue< T_Type >& dst, const CompensatedValue< T_Type >& src )
+        {
+            dst.add( src );
+        }
+    };
+
+    /** reduce a slot of a MultiValue to the maximum, the compensation is unused */
+    struct Max
+    {
+        template< typename T_Type >
+        HDINLINE static void combine( CompensatedValue< T_Type >& dst, const CompensatedValue< T_Type >& src )
+        {
+            dst.value = algorithms::math::max( dst.value, src.value );
+        }
+    };
+
+    /** reduce a slot of a MultiValue to the minimum, the compensation is unused */
+    struct Min
+    {
+        template< typename T_Type >
+        HDINLINE static void combine( CompensatedValue< T_Type >& dst, const CompensatedValue< T_Type >& src )
+        {
+            dst.value = algorithms::math::min( dst.value, src.value );
+        }
+    };
+
+namespace detail
+{
+    template< uint32_t T_idx, typename... T_Ops >
+    struct CombineSlots;
+
+    template< uint32_t T_idx, typename T_Op, typename... T_Ops >
+    struct CombineSlots< T_idx, T_Op, T_Ops... >
+    {
+        template< typename T_Slot >
+        HDINLINE static void apply( T_Slot* dst, const T_Slot* src )
+        {
+            T_Op::combine( dst[ T_idx ], src[ T_idx ] );
+            CombineSlots< T_idx + 1, T_Ops... >::apply( dst, src );
+        }
+    };
+
+    template< uint32_t T_idx >
+    struct CombineSlots< T_idx >
+    {
+        template< typename T_Slot >
+        HDINLINE static void apply( T_Slot*, const T_Slot* )
+        {
+        }
+    };
+} // namespace detail
+
+    /** several values which are reduced in a single pass
+     *
+     * Each slot is reduced with its own operation, e.g.
+     * `MultiValue< float_64, Sum, Sum, Max >` computes two sums and one
+     * maximum. Use it as value type of the source of nvidia::reduce::Reduce
+     * together with the functor CombineMultiValue, all slots are copied to
+     * the host at once.
+     *
+     * @tparam T_Type floating point type of the slots
+     * @tparam T_Ops reduce operation of each slot (Sum, Max or Min)
+     */
+    template< typename T_Type, typename... T_Ops >
+    struct MultiValue
+    {
+        typedef T_Type type;
+        typedef CompensatedValue< T_Type > Slot;
+        static constexpr uint32_t numSlots = sizeof...( T_Ops );
+
+        Slot slots[ numSlots ];
+
+        HDINLINE MultiValue( )
+        {
+        }
+
+        /** initialize all slots with the same value */
+        HDINLINE static MultiValue create( const T_Type value )
+        {
+            MultiValue result;
+            for( uint32_t i = 0; i < numSlots; ++i )
+                result.slots[ i ] = Slot( value );
+            return result;
+        }
+
+        HDINLINE Slot& operator[]( const uint32_t idx )
+        {
+            return slots[ idx ];
+        }
+
+        HDINLINE const Slot& operator[]( const uint32_t idx ) const
+        {
+            return slots[ idx ];
+        }
+
+        /** reduce the slots of other into this object */
+        HDINLINE void combine( const MultiValue& other )
+        {
+            detail::CombineSlots< 0, T_Ops... >::apply( slots, other.slots );
+        }
+    };
+
+    /** binary reduce functor for MultiValue */
+    struct CombineMultiValue
+    {
+        template< typename Dst, typename Src >
+        HDINLINE void operator()( Dst& dst, const Src& src ) const
+        {
+            dst.combine( src );
+        }
+    };
+
+} // namespace reduce
+} // namespace nvidia
+} // namespace PMacc
@@ -101,10 +101,14 @@ protected:
         delete this->particlesBuffer;
     }
 
+public:
+
     /* Shift all particle in a AREA
      * @tparam AREA area which is used (CORE,BORDER,GUARD or a combination)
+     * @tparam T_fillGaps fill the gaps left by the shifted particles,
+     *                    if false fillGaps<AREA>() must be called afterwards
      */
-    template<uint32_t AREA>
+    template<uint32_t AREA, bool T_fillGaps = true>
     void shiftParticles()
     {
         StrideMapping<AREA, 3, MappingDesc> mapper(this->cellDescription);
@@ -116,12 +120,15 @@ protected:
             PMACC_KERNEL(KernelShiftParticles{})
                 (mapper.getGridDim(), (int)TileSize)
                 (pBox, mapper);
-            PMACC_KERNEL(KernelFillGaps{})
-                (mapper.getGridDim(), (int)TileSize)
-                (pBox, mapper);
-            PMACC_KERNEL(KernelFillGapsLastFrame{})
-                (mapper.getGridDim(), (int)TileSize)
-                (pBox, mapper);
+            if( T_fillGaps )
+            {
+                PMACC_KERNEL(KernelFillGaps{})
+                    (mapper.getGridDim(), (int)TileSize)
+                    (pBox, mapper);
+                PMACC_KERNEL(KernelFillGapsLastFrame{})
+                    (mapper.getGridDim(), (int)TileSize)
+                    (pBox, mapper);
+            }
         }
         while (mapper.next());
 
@@ -146,9 +153,6 @@ protected:
             (particlesBuffer->getDeviceParticleBox(), mapper);
     }
 
-
-public:
-
     /* fill gaps in a the complete simulation area (include GUARD)
      */
     void fillAllGaps()
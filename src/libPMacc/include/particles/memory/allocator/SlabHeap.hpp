@@ -0,0 +1,480 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "static_assert.hpp"
+#include "Environment.hpp"
+#include "eventSystem/EventSystem.hpp"
+#include "debug/PMaccVerbose.hpp"
+#include "particles/memory/allocator/SlabHeapHandle.hpp"
+#include "particles/memory/allocator/SlabHeap.kernel"
+
+#include "mallocMC/mallocMC.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace PMacc
+{
+
+    /** usage of the objects of one size in a SlabHeap */
+    struct SlabHeapStatistics
+    {
+        /** object size in byte, 0 if no object of the requested size exists */
+        size_t objectSize;
+        /** number of slabs assigned to the size */
+        size_t numSlabs;
+        /** number of allocated objects */
+        size_t liveObjects;
+        /** number of objects which fit into the assigned slabs */
+        size_t capacity;
+        /** number of slabs which are not assigned to any size */
+        size_t unusedSlabs;
+
+        SlabHeapStatistics( ) :
+            objectSize( 0 ), numSlabs( 0 ), liveObjects( 0 ), capacity( 0 ), unusedSlabs( 0 )
+        {
+        }
+
+        /** fraction of the assigned slots which hold an object */
+        double getOccupancy( ) const
+        {
+            return capacity == 0u ? 0.0 : static_cast< double >( liveObjects ) / static_cast< double >( capacity );
+        }
+
+        /** fraction of the assigned slabs which is not usable because it is
+         * scattered over partially filled slabs
+         *
+         * The value is in [0, 1]. 0 means all free slots could be collected in
+         * the last slab, 1 means every slab but one could be given back, e.g.
+         * every slab holds only one object or all assigned slabs are empty.
+         */
+        double getFragmentation( ) const
+        {
+            if( numSlabs <= 1u )
+                return 0.0;
+            const size_t objectsPerSlab = capacity / numSlabs;
+            /* at least one slab stays assigned, also for zero live objects */
+            const size_t neededSlabs = std::max(
+                ( liveObjects + objectsPerSlab - 1u ) / objectsPerSlab,
+                size_t( 1u )
+            );
+            return static_cast< double >( numSlabs - neededSlabs ) / static_cast< double >( numSlabs - 1u );
+        }
+    };
+
+    /** device heap with one fixed object size per slab
+     *
+     * Replacement for the general purpose mallocMC allocator which is
+     * optimized for the allocation pattern of particle frames: few different
+     * sizes (one per species), many objects per size and allocations grouped by
+     * supercell.
+     * The interface is the subset of mallocMC::Allocator used by PMacc, so the
+     * heap can be used as `T_DeviceHeap` of a ParticlesBuffer.
+     *
+     * @tparam T_Config configuration with the compile time integral types
+     *         - slabSize: size of a slab in byte
+     *         - regions: number of free lists per object size
+     *         - sizeClasses: maximum number of different object sizes
+     *         - minObjectSize: smallest object size in byte
+     */
+    template< typename T_Config >
+    class SlabHeap
+    {
+    public:
+        using AllocatorHandle = slabHeap::SlabHeapHandle;
+
+        static constexpr uint32_t slabSize = T_Config::slabSize::value;
+        static constexpr uint32_t numRegions = T_Config::regions::value;
+        static constexpr uint32_t maxSizeClasses = T_Config::sizeClasses::value;
+        static constexpr uint32_t maxObjectsPerSlab = slabSize / T_Config::minObjectSize::value;
+        static constexpr uint32_t bitmapWordsPerSlab = ( maxObjectsPerSlab + 31u ) / 32u;
+
+        PMACC_STATIC_ASSERT_MSG(
+            slabSize % 16u == 0u && T_Config::minObjectSize::value >= 16u,
+            slab_size_must_be_a_multiple_of_16_and_objects_at_least_16_byte
+        );
+
+        /** create the heap
+         *
+         * @param heapSize size of the heap in byte including the meta data
+         */
+        SlabHeap( size_t heapSize )
+        {
+            allocate( heapSize );
+        }
+
+        ~SlabHeap( )
+        {
+            release( );
+        }
+
+        /** discard all objects and change the size of the heap
+         *
+         * @param heapSize size of the heap in byte including the meta data
+         */
+        void destructiveResize( size_t heapSize )
+        {
+            release( );
+            allocate( heapSize );
+        }
+
+        /** get the handle used on the device to allocate and free objects */
+        AllocatorHandle getAllocatorHandle( ) const
+        {
+            return handle;
+        }
+
+        /** memory range of the objects */
+        std::vector< mallocMC::HeapInfo > getHeapLocations( ) const
+        {
+            mallocMC::HeapInfo info;
+            info.p = handle.heap;
+            info.size = static_cast< size_t >( handle.numSlabs ) * slabSize;
+            return std::vector< mallocMC::HeapInfo >( 1, info );
+        }
+
+        /** number of objects of a size which can be allocated
+         *
+         * Free slots in slabs of other sizes are not counted.
+         *
+         * @param objectSize size in byte
+         */
+        size_t getAvailableSlots( size_t objectSize )
+        {
+            if( handle.numSlabs == 0u )
+                return 0u;
+            const SlabHeapStatistics stats = getStatistics( objectSize );
+            const uint32_t alignedSize = static_cast< uint32_t >( ( objectSize + 15u ) & ~size_t( 15u ) );
+            return stats.capacity - stats.liveObjects +
+                stats.unusedSlabs * handle.objectsPerSlab( alignedSize );
+        }
+
+        /** usage of the slabs for objects of one size
+         *
+         * Objects of the same size share their slabs, e.g. the frames of two
+         * species with an identical frame size.
+         * This method synchronizes with the device.
+         *
+         * @param objectSize size in byte
+         */
+        SlabHeapStatistics getStatistics( size_t objectSize )
+        {
+            SlabHeapStatistics stats;
+            if( handle.numSlabs == 0u )
+                return stats;
+
+            downloadMetaData( );
+            const uint32_t alignedSize = static_cast< uint32_t >( ( objectSize + 15u ) & ~size_t( 15u ) );
+            uint32_t sizeClass = slabHeap::invalid;
+            for( uint32_t i = 0; i < maxSizeClasses; ++i )
+                if( hostObjectSizes[ i ] == alignedSize )
+                    sizeClass = i;
+
+            for( uint32_t slab = 0; slab < handle.numSlabs; ++slab )
+            {
+                if( slab >= hostNextUnusedSlab || hostSlabSizeClass[ slab ] == slabHeap::invalid )
+                    ++stats.unusedSlabs;
+                else if( hostSlabSizeClass[ slab ] == sizeClass )
+                {
+                    ++stats.numSlabs;
+                    stats.liveObjects += hostSlabLiveObjects[ slab ];
+                }
+            }
+            if( sizeClass != slabHeap::invalid )
+            {
+                stats.objectSize = alignedSize;
+                stats.capacity = stats.numSlabs * handle.objectsPerSlab( alignedSize );
+            }
+            return stats;
+        }
+
+        /** size of the largest range of contiguous unused slabs in byte
+         *
+         * This method synchronizes with the device.
+         */
+        size_t getLargestFreeBlock( )
+        {
+            if( handle.numSlabs == 0u )
+                return 0u;
+
+            downloadMetaData( );
+            size_t largestRange = 0u;
+            size_t range = 0u;
+            for( uint32_t slab = 0; slab < handle.numSlabs; ++slab )
+            {
+                if( slab >= hostNextUnusedSlab || hostSlabSizeClass[ slab ] == slabHeap::invalid )
+                    ++range;
+                else
+                    range = 0u;
+                if( range > largestRange )
+                    largestRange = range;
+            }
+            return largestRange * slabSize;
+        }
+
+        /** give empty slabs back and order the free slots by slab fullness
+         *
+         * Objects are not moved, pointers stay valid. Slabs without live
+         * objects can be reused by every object size afterwards. Each free list
+         * is rebuilt from its partially filled slabs, the fullest slab first
+         * and slabs with the same number of live objects by ascending address;
+         * the free slots of a slab are ordered by address. New objects are
+         * therefore placed into the holes of the fullest slabs first.
+         * No other kernel which allocates or frees objects may run concurrently.
+         */
+        void compact( )
+        {
+            if( handle.numSlabs == 0u )
+                return;
+            downloadMetaData( );
+
+            const uint32_t numLists = maxSizeClasses * numRegions;
+            const uint32_t blockSize = 256u;
+
+            /* partially filled slabs, the fullest first, std::stable_sort keeps
+             * the ascending address order of slabs with equal fullness
+             */
+            std::vector< uint32_t > slabs;
+            for( uint32_t slab = 0; slab < hostNextUnusedSlab; ++slab )
+            {
+                const uint32_t sizeClass = hostSlabSizeClass[ slab ];
+                if( sizeClass == slabHeap::invalid || hostSlabLiveObjects[ slab ] == 0u )
+                    continue;
+                if( hostSlabLiveObjects[ slab ] < handle.objectsPerSlab( hostObjectSizes[ sizeClass ] ) )
+                    slabs.push_back( slab );
+            }
+            std::stable_sort(
+                slabs.begin( ),
+                slabs.end( ),
+                [ this ]( uint32_t a, uint32_t b )
+                {
+                    return hostSlabLiveObjects[ a ] > hostSlabLiveObjects[ b ];
+                }
+            );
+
+            std::vector< uint32_t > listHeads( numLists, slabHeap::invalid );
+            std::vector< uint32_t > listTails( numLists, slabHeap::invalid );
+            std::vector< uint32_t > slabNext( hostNextUnusedSlab, slabHeap::invalid );
+            for( std::vector< uint32_t >::const_iterator it = slabs.begin( ); it != slabs.end( ); ++it )
+            {
+                const uint32_t list = hostSlabSizeClass[ *it ] * numRegions + *it % numRegions;
+                if( listTails[ list ] == slabHeap::invalid )
+                    listHeads[ list ] = *it;
+                else
+                    slabNext[ listTails[ list ] ] = *it;
+                listTails[ list ] = *it;
+            }
+            CUDA_CHECK( cudaMemcpy( compactionListHeads, &listHeads[ 0 ],
+                numLists * sizeof( uint32_t ), cudaMemcpyHostToDevice ) );
+            if( hostNextUnusedSlab != 0u )
+                CUDA_CHECK( cudaMemcpy( handle.slabNext, &slabNext[ 0 ],
+                    hostNextUnusedSlab * sizeof( uint32_t ), cudaMemcpyHostToDevice ) );
+
+            PMACC_KERNEL( slabHeap::KernelResetFreeLists{ } )
+                ( ( numLists + 1u + blockSize - 1u ) / blockSize, blockSize )
+                ( handle, numLists );
+            if( hostNextUnusedSlab != 0u )
+                PMACC_KERNEL( slabHeap::KernelCompactSlabs{ } )
+                    ( ( hostNextUnusedSlab + blockSize - 1u ) / blockSize, blockSize )
+                    ( handle, compactionListHeads, hostNextUnusedSlab );
+            __getTransactionEvent( ).waitForFinished( );
+
+            log< ggLog::MEMORY >( "SlabHeap: compacted %1% slabs" ) % hostNextUnusedSlab;
+        }
+
+    private:
+
+        SlabHeap( const SlabHeap& ) = delete;
+        SlabHeap& operator=( const SlabHeap& ) = delete;
+
+        /** meta data size per slab in byte */
+        static constexpr size_t metaDataPerSlab =
+            3u * sizeof( uint32_t ) + bitmapWordsPerSlab * sizeof( uint32_t );
+
+        void allocate( size_t heapSize )
+        {
+            const size_t fixedMetaData = maxSizeClasses * sizeof( uint32_t ) +
+                ( maxSizeClasses * numRegions + 1u ) * sizeof( unsigned long long int ) +
+                maxSizeClasses * numRegions * sizeof( uint32_t ) +
+                sizeof( uint32_t );
+
+            hostNextUnusedSlab = 0u;
+            compactionListHeads = nullptr;
+            handle = AllocatorHandle( );
+            handle.slabSize = slabSize;
+            handle.numRegions = numRegions;
+            handle.maxSizeClasses = maxSizeClasses;
+            handle.maxObjectsPerSlab = maxObjectsPerSlab;
+            handle.bitmapWordsPerSlab = bitmapWordsPerSlab;
+            handle.numSlabs = heapSize > fixedMetaData ?
+                static_cast< uint32_t >( ( heapSize - fixedMetaData ) / ( slabSize + metaDataPerSlab ) ) : 0u;
+
+            log< ggLog::MEMORY >( "SlabHeap: %1% slabs a %2% byte" ) % handle.numSlabs % slabSize;
+
+            if( handle.numSlabs == 0u )
+                return;
+
+            const size_t numSlabs = handle.numSlabs;
+            CUDA_CHECK( cudaMalloc( (void**)&handle.heap, numSlabs * slabSize ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.objectSizes, maxSizeClasses * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.slabSizeClass, numSlabs * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.slabLiveObjects, numSlabs * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.slabBitmap, numSlabs * bitmapWordsPerSlab * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.slabNext, numSlabs * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.nextUnusedSlab, sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.freeLists, maxSizeClasses * numRegions * sizeof( unsigned long long int ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&handle.freeSlabs, sizeof( unsigned long long int ) ) );
+            CUDA_CHECK( cudaMalloc( (void**)&compactionListHeads, maxSizeClasses * numRegions * sizeof( uint32_t ) ) );
+
+            CUDA_CHECK( cudaMemset( handle.objectSizes, 0, maxSizeClasses * sizeof( uint32_t ) ) );
+            /* all bits set is `slabHeap::invalid` */
+            CUDA_CHECK( cudaMemset( handle.slabSizeClass, 0xFF, numSlabs * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMemset( handle.slabLiveObjects, 0, numSlabs * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMemset( handle.slabBitmap, 0, numSlabs * bitmapWordsPerSlab * sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMemset( handle.nextUnusedSlab, 0, sizeof( uint32_t ) ) );
+            CUDA_CHECK( cudaMemset( handle.freeLists, 0, maxSizeClasses * numRegions * sizeof( unsigned long long int ) ) );
+            CUDA_CHECK( cudaMemset( handle.freeSlabs, 0, sizeof( unsigned long long int ) ) );
+
+            hostObjectSizes.resize( maxSizeClasses );
+            hostSlabSizeClass.resize( numSlabs );
+            hostSlabLiveObjects.resize( numSlabs );
+        }
+
+        void release( )
+        {
+            if( handle.numSlabs == 0u )
+                return;
+            /* objects can be in use by running kernels */
+            __getTransactionEvent( ).waitForFinished( );
+            CUDA_CHECK( cudaFree( handle.heap ) );
+            CUDA_CHECK( cudaFree( handle.objectSizes ) );
+            CUDA_CHECK( cudaFree( handle.slabSizeClass ) );
+            CUDA_CHECK( cudaFree( handle.slabLiveObjects ) );
+            CUDA_CHECK( cudaFree( handle.slabBitmap ) );
+            CUDA_CHECK( cudaFree( handle.slabNext ) );
+            CUDA_CHECK( cudaFree( handle.nextUnusedSlab ) );
+            CUDA_CHECK( cudaFree( handle.freeLists ) );
+            CUDA_CHECK( cudaFree( handle.freeSlabs ) );
+            CUDA_CHECK( cudaFree( compactionListHeads ) );
+            compactionListHeads = nullptr;
+            handle = AllocatorHandle( );
+        }
+
+        /** copy the per slab meta data to the host */
+        void downloadMetaData( )
+        {
+            __getTransactionEvent( ).waitForFinished( );
+            const size_t numSlabs = handle.numSlabs;
+            CUDA_CHECK( cudaMemcpy( &hostObjectSizes[ 0 ], handle.objectSizes,
+                maxSizeClasses * sizeof( uint32_t ), cudaMemcpyDeviceToHost ) );
+            CUDA_CHECK( cudaMemcpy( &hostSlabSizeClass[ 0 ], handle.slabSizeClass,
+                numSlabs * sizeof( uint32_t ), cudaMemcpyDeviceToHost ) );
+            CUDA_CHECK( cudaMemcpy( &hostSlabLiveObjects[ 0 ], handle.slabLiveObjects,
+                numSlabs * sizeof( uint32_t ), cudaMemcpyDeviceToHost ) );
+            CUDA_CHECK( cudaMemcpy( &hostNextUnusedSlab, handle.nextUnusedSlab,
+                sizeof( uint32_t ), cudaMemcpyDeviceToHost ) );
+        }
+
+        AllocatorHandle handle;
+        std::vector< uint32_t > hostObjectSizes;
+        std::vector< uint32_t > hostSlabSizeClass;
+        std::vector< uint32_t > hostSlabLiveObjects;
+        uint32_t hostNextUnusedSlab;
+        /* first slab of each free list, input of the compaction */
+        uint32_t* compactionListHeads;
+    };
+
+    /** compact a device heap
+     *
+     * Heaps without compaction support are left untouched.
+     */
+    template< typename T_DeviceHeap >
+    void compactDeviceHeap( T_DeviceHeap& )
+    {
+    }
+
+    template< typename T_Config >
+    void compactDeviceHeap( SlabHeap< T_Config >& heap )
+    {
+        heap.compact( );
+    }
+
+    /** usage of a device heap for objects of one size
+     *
+     * Heaps without statistics support report an empty usage.
+     *
+     * @param objectSize size in byte
+     */
+    template< typename T_DeviceHeap >
+    SlabHeapStatistics getDeviceHeapStatistics( T_DeviceHeap&, size_t )
+    {
+        return SlabHeapStatistics( );
+    }
+
+    template< typename T_Config >
+    SlabHeapStatistics getDeviceHeapStatistics( SlabHeap< T_Config >& heap, size_t objectSize )
+    {
+        return heap.getStatistics( objectSize );
+    }
+
+    /** check at compile time if an object fits into a device heap
+     *
+     * Heaps without a size limit accept every object.
+     *
+     * @tparam T_DeviceHeap type of the heap
+     * @tparam T_objectSize size of the object in byte
+     */
+    template< typename T_DeviceHeap, size_t T_objectSize >
+    struct FitsIntoDeviceHeap : std::true_type
+    {
+    };
+
+    /* a SlabHeap can not allocate objects larger than a slab */
+    template< typename T_Config, size_t T_objectSize >
+    struct FitsIntoDeviceHeap< SlabHeap< T_Config >, T_objectSize > :
+        std::integral_constant<
+            bool,
+            ( ( T_objectSize + 15u ) & ~size_t( 15u ) ) <= size_t( T_Config::slabSize::value )
+        >
+    {
+    };
+
+    /** size of the largest free block of a device heap in byte
+     *
+     * Heaps without support report 0.
+     */
+    template< typename T_DeviceHeap >
+    size_t getDeviceHeapLargestFreeBlock( T_DeviceHeap& )
+    {
+        return 0u;
+    }
+
+    template< typename T_Config >
+    size_t getDeviceHeapLargestFreeBlock( SlabHeap< T_Config >& heap )
+    {
+        return heap.getLargestFreeBlock( );
+    }
+
+} // namespace PMacc
@@ -0,0 +1,331 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+
+#include <climits>
+
+namespace PMacc
+{
+namespace slabHeap
+{
+    /* marker for an invalid slab, size class or object */
+    constexpr uint32_t invalid = UINT_MAX;
+
+    /** device side view of a SlabHeap
+     *
+     * The heap is divided into slabs of equal size. Each slab holds objects
+     * of a single size (size class), e.g. the frames of one particle species.
+     * Free objects of a size class are kept in several lock-free stacks
+     * (regions). A block uses the region selected by its linear block index,
+     * so blocks working on different supercells rarely compete for the same
+     * stack.
+     *
+     * Objects are identified by `slab * maxObjectsPerSlab + slot`.
+     * The head of a stack stores the object id + 1 in the lower 32 bit and a
+     * version tag in the upper 32 bit to avoid the ABA problem. The link to
+     * the next free object is stored in the first 4 byte of the free object.
+     */
+    struct SlabHeapHandle
+    {
+        /* begin of the first slab */
+        char* heap;
+        uint32_t numSlabs;
+        uint32_t slabSize;
+        uint32_t numRegions;
+        uint32_t maxSizeClasses;
+        uint32_t maxObjectsPerSlab;
+        uint32_t bitmapWordsPerSlab;
+        /* object size in byte per size class, 0 if the class is unused */
+        uint32_t* objectSizes;
+        /* size class per slab, `invalid` if the slab is unused */
+        uint32_t* slabSizeClass;
+        /* number of allocated objects per slab */
+        uint32_t* slabLiveObjects;
+        /* one bit per object, set if the object is allocated */
+        uint32_t* slabBitmap;
+        /* link to the next released slab, during the compaction link to the
+         * next slab of the same free list */
+        uint32_t* slabNext;
+        /* number of slabs which were never used */
+        uint32_t* nextUnusedSlab;
+        /* stack heads of free objects [sizeClass * numRegions + region] */
+        unsigned long long int* freeLists;
+        /* stack head of released slabs */
+        unsigned long long int* freeSlabs;
+
+        HDINLINE SlabHeapHandle( ) :
+            heap( nullptr ),
+            numSlabs( 0 ),
+            slabSize( 0 ),
+            numRegions( 0 ),
+            maxSizeClasses( 0 ),
+            maxObjectsPerSlab( 0 ),
+            bitmapWordsPerSlab( 0 ),
+            objectSizes( nullptr ),
+            slabSizeClass( nullptr ),
+            slabLiveObjects( nullptr ),
+            slabBitmap( nullptr ),
+            slabNext( nullptr ),
+            nextUnusedSlab( nullptr ),
+            freeLists( nullptr ),
+            freeSlabs( nullptr )
+        {
+        }
+
+        /** number of objects of a size class which fit into one slab */
+        HDINLINE uint32_t objectsPerSlab( uint32_t objectSize ) const
+        {
+            const uint32_t n = slabSize / objectSize;
+            return n < maxObjectsPerSlab ? n : maxObjectsPerSlab;
+        }
+
+        /** allocate an object
+         *
+         * @param size size in byte
+         * @return pointer to the object, nullptr if the heap is exhausted
+         */
+        DINLINE void* malloc( size_t size )
+        {
+            /* objects are aligned to 16 byte */
+            const uint32_t objectSize = static_cast< uint32_t >( ( size + 15u ) & ~size_t( 15u ) );
+            if( size == 0u || size > slabSize )
+                return nullptr;
+
+            const uint32_t sizeClass = getSizeClass( objectSize );
+            if( sizeClass == invalid )
+                return nullptr;
+
+            const uint32_t region = getRegion( );
+            uint32_t objectId = invalid;
+            for( uint32_t i = 0; i < numRegions && objectId == invalid; ++i )
+                objectId = pop( sizeClass * numRegions + ( region + i ) % numRegions, objectSize );
+
+            if( objectId == invalid )
+                objectId = allocateFromNewSlab( sizeClass, objectSize, region );
+            if( objectId == invalid )
+                return nullptr;
+
+            const uint32_t slab = objectId / maxObjectsPerSlab;
+            const uint32_t slot = objectId % maxObjectsPerSlab;
+            atomicOr( slabBitmap + slab * bitmapWordsPerSlab + slot / 32u, 1u << ( slot % 32u ) );
+            atomicAdd( slabLiveObjects + slab, 1u );
+
+            return getObjectPtr( objectId, objectSize );
+        }
+
+        /** free an object
+         *
+         * @param ptr pointer returned by malloc(), nullptr is allowed
+         */
+        DINLINE void free( void* ptr )
+        {
+            if( ptr == nullptr )
+                return;
+            const size_t offset = static_cast< size_t >( static_cast< char* >( ptr ) - heap );
+            const uint32_t slab = static_cast< uint32_t >( offset / slabSize );
+            const uint32_t sizeClass = slabSizeClass[ slab ];
+            const uint32_t objectSize = objectSizes[ sizeClass ];
+            const uint32_t slot = static_cast< uint32_t >( ( offset % slabSize ) / objectSize );
+            const uint32_t objectId = slab * maxObjectsPerSlab + slot;
+
+            atomicAnd( slabBitmap + slab * bitmapWordsPerSlab + slot / 32u, ~( 1u << ( slot % 32u ) ) );
+            atomicSub( slabLiveObjects + slab, 1u );
+
+            push( sizeClass * numRegions + getRegion( ), objectId, objectId, objectSize );
+        }
+
+        /** pointer to an object
+         *
+         * @param objectId id of the object
+         * @param objectSize size of the object in byte
+         */
+        HDINLINE char* getObjectPtr( uint32_t objectId, uint32_t objectSize ) const
+        {
+            const uint32_t slab = objectId / maxObjectsPerSlab;
+            const uint32_t slot = objectId % maxObjectsPerSlab;
+            return heap + static_cast< size_t >( slab ) * slabSize + static_cast< size_t >( slot ) * objectSize;
+        }
+
+        /** push a chain of linked objects to a free list
+         *
+         * The objects from `first` to `last` must already be linked.
+         *
+         * @param list index of the free list
+         * @param first id of the first object of the chain
+         * @param last id of the last object of the chain
+         * @param objectSize size of the objects in byte
+         */
+        DINLINE void push( uint32_t list, uint32_t first, uint32_t last, uint32_t objectSize )
+        {
+            volatile uint32_t* lastLink = reinterpret_cast< volatile uint32_t* >( getObjectPtr( last, objectSize ) );
+            unsigned long long int* head = freeLists + list;
+            unsigned long long int oldHead = *reinterpret_cast< volatile unsigned long long int* >( head );
+            while( true )
+            {
+                *lastLink = static_cast< uint32_t >( oldHead & 0xFFFFFFFFull );
+                /* the link must be visible before the object is published */
+                __threadfence( );
+                const unsigned long long int newHead =
+                    ( ( ( oldHead >> 32 ) + 1ull ) << 32 ) | static_cast< unsigned long long int >( first + 1u );
+                const unsigned long long int prev = atomicCAS( head, oldHead, newHead );
+                if( prev == oldHead )
+                    break;
+                oldHead = prev;
+            }
+        }
+
+        /** give an unused slab back to the heap
+         *
+         * @param slab index of the slab, must not contain live objects
+         */
+        DINLINE void releaseSlab( uint32_t slab )
+        {
+            slabSizeClass[ slab ] = invalid;
+            unsigned long long int oldHead = *reinterpret_cast< volatile unsigned long long int* >( freeSlabs );
+            while( true )
+            {
+                slabNext[ slab ] = static_cast< uint32_t >( oldHead & 0xFFFFFFFFull );
+                __threadfence( );
+                const unsigned long long int newHead =
+                    ( ( ( oldHead >> 32 ) + 1ull ) << 32 ) | static_cast< unsigned long long int >( slab + 1u );
+                const unsigned long long int prev = atomicCAS( freeSlabs, oldHead, newHead );
+                if( prev == oldHead )
+                    break;
+                oldHead = prev;
+            }
+        }
+
+    private:
+
+        DINLINE uint32_t getRegion( ) const
+        {
+            const uint32_t linearBlockIdx = blockIdx.x + gridDim.x * ( blockIdx.y + gridDim.y * blockIdx.z );
+            return linearBlockIdx % numRegions;
+        }
+
+        /** find or register the size class of an object size */
+        DINLINE uint32_t getSizeClass( uint32_t objectSize )
+        {
+            for( uint32_t i = 0; i < maxSizeClasses; ++i )
+            {
+                const uint32_t classSize = *reinterpret_cast< volatile uint32_t* >( objectSizes + i );
+                if( classSize == objectSize )
+                    return i;
+                if( classSize == 0u )
+                {
+                    const uint32_t prev = atomicCAS( objectSizes + i, 0u, objectSize );
+                    if( prev == 0u || prev == objectSize )
+                        return i;
+                }
+            }
+            return invalid;
+        }
+
+        /** pop an object from a free list
+         *
+         * @return object id or `invalid` if the list is empty
+         */
+        DINLINE uint32_t pop( uint32_t list, uint32_t objectSize )
+        {
+            unsigned long long int* head = freeLists + list;
+            unsigned long long int oldHead = *reinterpret_cast< volatile unsigned long long int* >( head );
+            while( true )
+            {
+                const uint32_t idPlusOne = static_cast< uint32_t >( oldHead & 0xFFFFFFFFull );
+                if( idPlusOne == 0u )
+                    return invalid;
+                /* the link can be outdated if the object was taken by another
+                 * thread, in this case the version tag of the head has changed
+                 * and the exchange fails
+                 */
+                const uint32_t next = *reinterpret_cast< volatile uint32_t* >( getObjectPtr( idPlusOne - 1u, objectSize ) );
+                const unsigned long long int newHead =
+                    ( ( ( oldHead >> 32 ) + 1ull ) << 32 ) | static_cast< unsigned long long int >( next );
+                const unsigned long long int prev = atomicCAS( head, oldHead, newHead );
+                if( prev == oldHead )
+                    return idPlusOne - 1u;
+                oldHead = prev;
+            }
+        }
+
+        /** take a released or never used slab */
+        DINLINE uint32_t acquireSlab( )
+        {
+            /* reuse slabs released by the compaction first */
+            unsigned long long int oldHead = *reinterpret_cast< volatile unsigned long long int* >( freeSlabs );
+            while( true )
+            {
+                const uint32_t slabPlusOne = static_cast< uint32_t >( oldHead & 0xFFFFFFFFull );
+                if( slabPlusOne == 0u )
+                    break;
+                const uint32_t next = *reinterpret_cast< volatile uint32_t* >( slabNext + slabPlusOne - 1u );
+                const unsigned long long int newHead =
+                    ( ( ( oldHead >> 32 ) + 1ull ) << 32 ) | static_cast< unsigned long long int >( next );
+                const unsigned long long int prev = atomicCAS( freeSlabs, oldHead, newHead );
+                if( prev == oldHead )
+                    return slabPlusOne - 1u;
+                oldHead = prev;
+            }
+
+            uint32_t slab = *reinterpret_cast< volatile uint32_t* >( nextUnusedSlab );
+            while( slab < numSlabs )
+            {
+                const uint32_t prev = atomicCAS( nextUnusedSlab, slab, slab + 1u );
+                if( prev == slab )
+                    return slab;
+                slab = prev;
+            }
+            return invalid;
+        }
+
+        /** assign a new slab to a size class
+         *
+         * The first object is returned, all other objects are linked and
+         * pushed to the free list of the region.
+         *
+         * @return object id or `invalid` if no slab is left
+         */
+        DINLINE uint32_t allocateFromNewSlab( uint32_t sizeClass, uint32_t objectSize, uint32_t region )
+        {
+            const uint32_t slab = acquireSlab( );
+            if( slab == invalid )
+                return invalid;
+
+            slabSizeClass[ slab ] = sizeClass;
+            const uint32_t firstId = slab * maxObjectsPerSlab;
+            const uint32_t numObjects = objectsPerSlab( objectSize );
+            if( numObjects > 1u )
+            {
+                for( uint32_t slot = 1u; slot + 1u < numObjects; ++slot )
+                    *reinterpret_cast< uint32_t* >( getObjectPtr( firstId + slot, objectSize ) ) = firstId + slot + 2u;
+                push( sizeClass * numRegions + region, firstId + 1u, firstId + numObjects - 1u, objectSize );
+            }
+            else
+                __threadfence( );
+            return firstId;
+        }
+    };
+
+} // namespace slabHeap
+} // namespace PMacc
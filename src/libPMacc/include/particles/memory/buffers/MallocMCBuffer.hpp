@@ -32,6 +32,11 @@
 namespace PMacc
 {
 
+    /** share the mallocMC heap of the particle frames via the DataConnector
+     *
+     * The heap is not mirrored to the host, plugins gather the particles they
+     * need on the device (e.g. with the CopySpecies kernel).
+     */
     template< typename T_DeviceHeap >
     class MallocMCBuffer : public ISimulationData
     {
@@ -52,18 +57,18 @@ namespace PMacc
             return std::string("MallocMCBuffer");
         }
 
-        int64_t getOffset()
+        /** nothing to synchronize, the heap lives on the device only */
+        void synchronize();
+
+        /** get the heap which is shared by this buffer */
+        std::shared_ptr<DeviceHeap> getDeviceHeap()
         {
-            return hostBufferOffset;
+            return deviceHeap;
         }
 
-        void synchronize();
-
     private:
 
-        char* hostPtr;
-        int64_t hostBufferOffset;
-        mallocMC::HeapInfo deviceHeapInfo;
+        std::shared_ptr<DeviceHeap> deviceHeap;
     };
 
 
@@ -32,47 +32,18 @@ namespace PMacc
 {
 template< typename T_DeviceHeap >
 MallocMCBuffer< T_DeviceHeap >::MallocMCBuffer( const std::shared_ptr<DeviceHeap>& deviceHeap ) :
-    hostPtr( nullptr ),
-    /* currently mallocMC has only one heap */
-    deviceHeapInfo( deviceHeap->getHeapLocations( )[ 0 ] ),
-    hostBufferOffset( 0 )
+    deviceHeap( deviceHeap )
 {
 }
 
 template< typename T_DeviceHeap >
 MallocMCBuffer< T_DeviceHeap >::~MallocMCBuffer( )
 {
-    if ( hostPtr != nullptr )
-        cudaHostUnregister(hostPtr);
-
-    __deleteArray(hostPtr);
-
 }
 
 template< typename T_DeviceHeap >
 void MallocMCBuffer< T_DeviceHeap >::synchronize( )
 {
-    /** \todo: we had no abstraction to create a host buffer and a pseudo
-     *         device buffer (out of the mallocMC ptr) and copy both with our event
-     *         system.
-     *         WORKAROUND: use native cuda calls :-(
-     */
-    if ( hostPtr == nullptr )
-    {
-        /* use `new` and than `cudaHostRegister` is faster than `cudaMallocHost`
-         * but with the some result (create page-locked memory)
-         */
-        hostPtr = new char[deviceHeapInfo.size];
-        CUDA_CHECK(cudaHostRegister(hostPtr, deviceHeapInfo.size, cudaHostRegisterDefault));
-
-
-        this->hostBufferOffset = static_cast<int64_t>(reinterpret_cast<char*>(deviceHeapInfo.p) - hostPtr);
-    }
-    /* add event system hints */
-    __startOperation(ITask::TASK_CUDA);
-    __startOperation(ITask::TASK_HOST);
-    CUDA_CHECK(cudaMemcpy(hostPtr, deviceHeapInfo.p, deviceHeapInfo.size, cudaMemcpyDeviceToHost));
-
 }
 
 } //namespace PMacc
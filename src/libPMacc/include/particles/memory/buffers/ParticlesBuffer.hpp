@@ -354,6 +354,18 @@ public:
         return superCells->getGridLayout();
     }
 
+    /**
+     * Returns the buffer with the frame lists of all supercells.
+     *
+     * @return buffer of supercells
+     */
+    GridBuffer<SuperCellType, DIM>& getSuperCellsBuffer()
+    {
+
+        PMACC_ASSERT(superCells != nullptr);
+        return *superCells;
+    }
+
     /**
      * Returns size of supercells in each dimension.
      *
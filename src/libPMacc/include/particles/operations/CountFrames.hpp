@@ -0,0 +1,93 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "mappings/kernel/AreaMapping.hpp"
+#include "particles/memory/dataTypes/FramePointer.hpp"
+
+
+namespace PMacc
+{
+
+/* count the frames in an area
+ * one thread per supercell walks the frame list
+ */
+struct KernelCountFrames
+{
+    template<class PBox, class Mapping>
+    DINLINE void operator()(
+        PBox pb,
+        uint64_cu* gCounter,
+        Mapping mapper
+    ) const
+    {
+        typedef typename PBox::FramePtr FramePtr;
+        const uint32_t Dim = Mapping::Dim;
+
+        const DataSpace<Dim> superCellIdx(mapper.getSuperCellIndex(DataSpace<Dim > (blockIdx)));
+
+        uint64_cu counter = 0;
+        FramePtr frame = pb.getFirstFrame(superCellIdx);
+        while (frame.isValid())
+        {
+            ++counter;
+            frame = pb.getNextFrame(frame);
+        }
+
+        if (counter != 0)
+            atomicAdd(gCounter, counter);
+    }
+};
+
+struct CountFrames
+{
+
+    /** Get frame count
+     *
+     * @tparam AREA area were frames are counted (CORE, BORDER, GUARD)
+     *
+     * @param buffer source particle buffer
+     * @param cellDescription instance of MappingDesction
+     * @return number of frames in defined area
+     */
+    template<uint32_t AREA, class PBuffer, class CellDesc>
+    static uint64_cu countOnDevice(PBuffer& buffer, CellDesc cellDescription)
+    {
+        GridBuffer<uint64_cu, DIM1> counter(DataSpace<DIM1>(1));
+
+        AreaMapping<AREA, CellDesc> mapper(cellDescription);
+
+        PMACC_KERNEL(KernelCountFrames{})
+            (mapper.getGridDim(), 1)
+            (buffer.getDeviceParticlesBox(),
+             counter.getDeviceBuffer().getBasePointer(),
+             mapper);
+
+        counter.deviceToHost();
+        return *(counter.getHostBuffer().getDataBox());
+    }
+
+};
+
+} //namespace PMacc
@@ -0,0 +1,148 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace PMacc
+{
+namespace particles
+{
+namespace operations
+{
+
+/** Ranges of the supercells in a contiguous list of particles
+ *
+ * Particles of the same supercell are stored next to each other and the
+ * supercells follow in linear index order. This defines one deterministic
+ * layout for host particle lists, independent of the number of threads.
+ *
+ * The ranges are built in two passes:
+ *   - set the number of particles of each supercell (can be done in parallel)
+ *   - `scan()` converts the sizes to the offset of each supercell
+ */
+class SuperCellRanges
+{
+public:
+
+    /** @param numSuperCells number of supercells, all sizes are zero */
+    SuperCellRanges( const size_t numSuperCells ) :
+        offsets( numSuperCells + 1u, 0u ),
+        isScanned( false )
+    {
+    }
+
+    size_t getNumSuperCells( ) const
+    {
+        return offsets.size( ) - 1u;
+    }
+
+    /** set the number of particles of a supercell, only valid before `scan()` */
+    void setSize( const size_t superCellIdx, const uint64_t numParticles )
+    {
+        offsets[ superCellIdx + 1u ] = numParticles;
+    }
+
+    /** exclusive prefix sum over the sizes of all supercells */
+    void scan( )
+    {
+        if( isScanned )
+            throw std::logic_error( "SuperCellRanges: sizes are already scanned" );
+        for( size_t i = 1u; i < offsets.size( ); ++i )
+            offsets[ i ] += offsets[ i - 1u ];
+        isScanned = true;
+    }
+
+    /** index of the first particle of a supercell, only valid after `scan()` */
+    uint64_t getOffset( const size_t superCellIdx ) const
+    {
+        return offsets[ superCellIdx ];
+    }
+
+    /** number of particles of a supercell, only valid after `scan()` */
+    uint64_t getSize( const size_t superCellIdx ) const
+    {
+        return offsets[ superCellIdx + 1u ] - offsets[ superCellIdx ];
+    }
+
+    /** number of particles of all supercells, only valid after `scan()` */
+    uint64_t getNumParticles( ) const
+    {
+        return offsets.back( );
+    }
+
+    /** offsets of all supercells and the total number of particles as last element */
+    const std::vector< uint64_t >& getOffsets( ) const
+    {
+        return offsets;
+    }
+
+    /** count the particles of each supercell and scan the counts
+     *
+     * @param superCellIds linear supercell index of each particle
+     * @return ranges of the supercells
+     */
+    static SuperCellRanges count(
+        const std::vector< uint32_t >& superCellIds,
+        const size_t numSuperCells
+    )
+    {
+        SuperCellRanges ranges( numSuperCells );
+        for( size_t i = 0u; i < superCellIds.size( ); ++i )
+            ++ranges.offsets.at( superCellIds[ i ] + 1u );
+        ranges.scan( );
+        return ranges;
+    }
+
+    /** order particles by supercell
+     *
+     * The order is stable: particles of one supercell keep their relative
+     * order in `superCellIds`.
+     *
+     * @param superCellIds linear supercell index of each particle, the
+     *                     sizes of the ranges must have been counted from it
+     * @return index of the source particle for each position in the ordered list
+     */
+    std::vector< uint32_t > order( const std::vector< uint32_t >& superCellIds ) const
+    {
+        if( !isScanned || superCellIds.size( ) != getNumParticles( ) )
+            throw std::logic_error( "SuperCellRanges: ranges do not match the particles" );
+
+        std::vector< uint64_t > next( offsets.begin( ), offsets.end( ) - 1u );
+        std::vector< uint32_t > result( superCellIds.size( ) );
+        for( size_t i = 0u; i < superCellIds.size( ); ++i )
+            result[ next[ superCellIds[ i ] ]++ ] = static_cast< uint32_t >( i );
+        return result;
+    }
+
+private:
+
+    /* before `scan()` element i + 1 is the size of supercell i */
+    std::vector< uint64_t > offsets;
+    bool isScanned;
+};
+
+} //namespace operations
+} //namespace particles
+} //namespace PMacc
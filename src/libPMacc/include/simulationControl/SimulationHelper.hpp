@@ -64,6 +64,7 @@ public:
     restartStep(-1),
     restartDirectory("checkpoints"),
     restartRequested(false),
+    useStepGraph(false),
     CHECKPOINT_MASTER_FILE("checkpoints.txt"),
     author("")
     {
@@ -130,8 +131,13 @@ public:
      */
     virtual void dumpOneStep(uint32_t currentStep)
     {
-        /* trigger notification */
+        /* trigger notification
+         *
+         * plugins are executed as independent work (see StreamPolicy)
+         */
+        __startTransaction(__getTransactionEvent(), true);
         Environment<DIM>::get().PluginConnector().notifyPlugins(currentStep);
+        __setTransactionEvent(__endTransaction());
 
         /* trigger checkpoint notification */
         if (checkpointPeriod && (currentStep % checkpointPeriod == 0))
@@ -260,7 +266,9 @@ public:
             while (currentStep < Environment<>::get().SimulationDescription().getRunSteps())
             {
                 tRound.toggleStart();
+                Environment<>::get().StepGraph().beginStep();
                 runOneStep(currentStep);
+                Environment<>::get().StepGraph().endStep();
                 tRound.toggleEnd();
                 roundAvg += tRound.getInterval();
 
@@ -306,7 +314,9 @@ public:
             ("checkpoint-directory", po::value<std::string>(&checkpointDirectory)->default_value(checkpointDirectory),
              "Directory for checkpoints")
             ("author", po::value<std::string>(&author)->default_value(std::string("")),
-             "The author that runs the simulation and is responsible for created output files");
+             "The author that runs the simulation and is responsible for created output files")
+            ("stepGraph", po::value<bool>(&useStepGraph)->zero_tokens(),
+             "Capture the task graph of a steady-state step and replay its stream assignment and dependency edges in later steps");
     }
 
     std::string pluginGetName() const
@@ -318,6 +328,7 @@ public:
     {
         Environment<>::get().SimulationDescription().setRunSteps(runSteps);
         Environment<>::get().SimulationDescription().setAuthor(author);
+        Environment<>::get().StepGraph().setEnabled(useStepGraph);
 
         calcProgress();
 
@@ -368,6 +379,9 @@ protected:
     /* author that runs the simulation */
     std::string author;
 
+    /* capture and replay the task graph of the time steps */
+    bool useStepGraph;
+
 private:
 
     /**
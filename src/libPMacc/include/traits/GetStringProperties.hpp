@@ -77,7 +77,7 @@ namespace traits
 
     /** stream operator for a StringProperty
      */
-    std::ostream& operator<<( std::ostream& out, const StringProperty& property )
+    inline std::ostream& operator<<( std::ostream& out, const StringProperty& property )
     {
         out << property.value;
         return out;
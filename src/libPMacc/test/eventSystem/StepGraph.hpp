@@ -0,0 +1,138 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* #includes in "test/eventSystem/eventSystemUT.cu" */
+
+namespace
+{
+    /** create the tasks of one synthetic time step
+     *
+     * @param graph graph to record the tasks in
+     * @param firstId task id of the first task
+     * @param withPlugin add an additional task in the middle of the step
+     */
+    void recordSyntheticStep( PMacc::StepGraph& graph, PMacc::id_t firstId, bool withPlugin )
+    {
+        graph.beginStep( );
+        PMacc::id_t id = firstId;
+        graph.recordTask( id, "TaskKernel kernelA", PMacc::ITask::TASK_CUDA, 0 );
+        graph.recordStream( 0 );
+        graph.recordTask( id + 1, "TaskKernel kernelB", PMacc::ITask::TASK_CUDA, id );
+        graph.recordStream( 1 );
+        if( withPlugin )
+            graph.recordTask( id + 2, "TaskCopyDeviceToHost", PMacc::ITask::TASK_CUDA, id + 1 );
+        graph.recordTask( id + 3, "TaskSendMPI", PMacc::ITask::TASK_MPI, id + 1 );
+        graph.endStep( );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( StepGraphCaptureReplay )
+{
+    PMacc::StepGraph graph;
+    BOOST_REQUIRE( !graph.isEnabled( ) );
+
+    /* nothing is recorded if the graph is disabled */
+    recordSyntheticStep( graph, 1, false );
+    BOOST_REQUIRE_EQUAL( graph.getNodes( ).size( ), 0u );
+
+    graph.setEnabled( true );
+    recordSyntheticStep( graph, 10, false );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::CAPTURED );
+    BOOST_REQUIRE_EQUAL( graph.getCaptureCount( ), 1u );
+
+    const std::vector< PMacc::StepGraphNode >& nodes = graph.getNodes( );
+    BOOST_REQUIRE_EQUAL( nodes.size( ), 3u );
+    BOOST_CHECK_EQUAL( nodes[ 0 ].dependency, -1 );
+    BOOST_CHECK_EQUAL( nodes[ 1 ].dependency, 0 );
+    BOOST_CHECK_EQUAL( nodes[ 2 ].dependency, 1 );
+    BOOST_CHECK_EQUAL( nodes[ 0 ].streamSlot, 0 );
+    BOOST_CHECK_EQUAL( nodes[ 1 ].streamSlot, 1 );
+    BOOST_CHECK_EQUAL( nodes[ 2 ].streamSlot, -1 );
+
+    /* a structurally identical step replays the recorded streams */
+    graph.beginStep( );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::REPLAYING );
+    graph.recordTask( 20, "TaskKernel kernelA", PMacc::ITask::TASK_CUDA, 0 );
+    BOOST_CHECK_EQUAL( graph.getReplayStreamSlot( ), 0 );
+    /* the stream is handed out once per task */
+    BOOST_CHECK_EQUAL( graph.getReplayStreamSlot( ), -1 );
+    /* only the address of the stream is used by the graph */
+    int streamDummy = 0;
+    PMacc::EventStream* const streamA = reinterpret_cast< PMacc::EventStream* >( &streamDummy );
+    graph.recordTaskStream( 20, streamA );
+    graph.recordTask( 21, "TaskKernel kernelB", PMacc::ITask::TASK_CUDA, 20 );
+    /* the dependency of kernelB is resolved through the recorded edge */
+    BOOST_CHECK( graph.getReplayDependencyStream( 20 ) == streamA );
+    BOOST_CHECK( graph.getReplayDependencyStream( 19 ) == nullptr );
+    BOOST_CHECK_EQUAL( graph.getReplayStreamSlot( ), 1 );
+    graph.recordTask( 23, "TaskSendMPI", PMacc::ITask::TASK_MPI, 21 );
+    /* kernelB has no stream in this step, the dependency is resolved at runtime */
+    BOOST_CHECK( graph.getReplayDependencyStream( 21 ) == nullptr );
+    graph.endStep( );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::CAPTURED );
+    BOOST_REQUIRE_EQUAL( graph.getReplayCount( ), 1u );
+
+    /* an additional task invalidates the graph */
+    recordSyntheticStep( graph, 30, true );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::IDLE );
+    BOOST_REQUIRE_EQUAL( graph.getInvalidationCount( ), 1u );
+    BOOST_REQUIRE_EQUAL( graph.getNodes( ).size( ), 0u );
+
+    /* the next step is captured again */
+    recordSyntheticStep( graph, 40, true );
+    BOOST_REQUIRE_EQUAL( graph.getNodes( ).size( ), 4u );
+    BOOST_REQUIRE_EQUAL( graph.getCaptureCount( ), 2u );
+
+    /* a step with fewer tasks invalidates the graph */
+    recordSyntheticStep( graph, 50, false );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::IDLE );
+
+    /* e.g. a slide of the moving window */
+    recordSyntheticStep( graph, 60, false );
+    graph.invalidate( );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::IDLE );
+    BOOST_REQUIRE_EQUAL( graph.getInvalidationCount( ), 3u );
+}
+
+BOOST_AUTO_TEST_CASE( StepGraphKernelIdentity )
+{
+    PMacc::StepGraph graph;
+    graph.setEnabled( true );
+
+    /* kernel tasks are named by the functor type and the launch position */
+    graph.beginStep( );
+    graph.recordTask( 1, "TaskKernel KernelA [a.hpp:10 ]", PMacc::ITask::TASK_CUDA, 0 );
+    graph.recordTask( 2, "TaskKernel KernelB [b.hpp:20 ]", PMacc::ITask::TASK_CUDA, 1 );
+    BOOST_CHECK( !graph.isReplaying( ) );
+    graph.endStep( );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::CAPTURED );
+
+    graph.beginStep( );
+    graph.recordTask( 3, "TaskKernel KernelA [a.hpp:10 ]", PMacc::ITask::TASK_CUDA, 0 );
+    BOOST_CHECK( graph.isReplaying( ) );
+    /* the same functor launched at a different position is another node */
+    graph.recordTask( 4, "TaskKernel KernelA [a.hpp:30 ]", PMacc::ITask::TASK_CUDA, 3 );
+    BOOST_CHECK( !graph.isReplaying( ) );
+    BOOST_REQUIRE_EQUAL( graph.getState( ), PMacc::StepGraph::IDLE );
+    BOOST_REQUIRE_EQUAL( graph.getInvalidationCount( ), 1u );
+}
@@ -0,0 +1,168 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* #includes in "test/eventSystem/eventSystemUT.cu" */
+
+namespace
+{
+    /** minimal host task with the size of a typical task */
+    class DummyTask : public PMacc::ITask
+    {
+    public:
+        DummyTask()
+        {
+            this->setTaskType( PMacc::ITask::TASK_HOST );
+        }
+
+        void init()
+        {
+        }
+
+        void event( PMacc::id_t, PMacc::EventType, PMacc::IEventData* )
+        {
+        }
+
+        std::string toString()
+        {
+            return std::string( "DummyTask" );
+        }
+
+    protected:
+        bool executeIntern()
+        {
+            return true;
+        }
+
+    private:
+        char payload[ 96 ];
+    };
+
+    /** same task but allocated with the system allocator */
+    struct SystemAllocatedTask : public DummyTask
+    {
+        static void* operator new( size_t size )
+        {
+            return ::operator new( size );
+        }
+
+        static void operator delete( void* ptr, size_t )
+        {
+            ::operator delete( ptr );
+        }
+    };
+
+    /** create and retire tasks in the pattern of one time step
+     *
+     * Tasks are kept in a map like in the Manager and removed in creation
+     * order.
+     *
+     * @return number of tasks created per second
+     */
+    template< typename T_Task, typename T_TaskMap >
+    double createRetireThroughput( size_t numSteps, size_t tasksPerStep )
+    {
+        T_TaskMap tasks;
+        PMacc::id_t id = 0;
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for( size_t step = 0; step < numSteps; ++step )
+        {
+            for( size_t i = 0; i < tasksPerStep; ++i )
+                tasks[ ++id ] = new T_Task();
+            while( !tasks.empty() )
+            {
+                PMacc::ITask* task = tasks.begin()->second;
+                tasks.erase( tasks.begin() );
+                delete task;
+            }
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration< double >( end - start ).count();
+
+        return static_cast< double >( numSteps * tasksPerStep ) / seconds;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TaskPoolReuse )
+{
+    PMacc::TaskPool& pool = PMacc::TaskPool::getInstance();
+    const size_t liveObjects = pool.getLiveObjectsCount();
+
+    std::vector< PMacc::ITask* > tasks;
+    for( size_t i = 0; i < PMacc::TaskPool::objectsPerChunk; ++i )
+    {
+        tasks.push_back( new DummyTask() );
+        BOOST_REQUIRE_EQUAL( reinterpret_cast< size_t >( tasks.back() ) % PMacc::TaskPool::granularity, 0u );
+    }
+    BOOST_REQUIRE_EQUAL( pool.getLiveObjectsCount(), liveObjects + tasks.size() );
+    const size_t reservedBytes = pool.getReservedBytes();
+
+    PMacc::ITask* last = tasks.back();
+    for( size_t i = 0; i < tasks.size(); ++i )
+        delete tasks[ i ];
+    BOOST_REQUIRE_EQUAL( pool.getLiveObjectsCount(), liveObjects );
+
+    /* the most recently released memory is reused first and the pool does not grow */
+    PMacc::ITask* task = new DummyTask();
+    BOOST_REQUIRE_EQUAL( task, last );
+    delete task;
+    for( size_t i = 0; i < tasks.size(); ++i )
+        tasks[ i ] = new DummyTask();
+    BOOST_REQUIRE_EQUAL( pool.getReservedBytes(), reservedBytes );
+    for( size_t i = 0; i < tasks.size(); ++i )
+        delete tasks[ i ];
+
+    /* large objects bypass the pool */
+    void* large = pool.allocate( PMacc::TaskPool::maxObjectSize + 1u );
+    BOOST_REQUIRE_EQUAL( pool.getLiveObjectsCount(), liveObjects );
+    pool.deallocate( large, PMacc::TaskPool::maxObjectSize + 1u );
+}
+
+/** host micro benchmark of the task create/retire throughput
+ *
+ * The benchmark only reports the throughput, the result is hardware dependent
+ * and therefore not checked.
+ */
+BOOST_AUTO_TEST_CASE( TaskPoolThroughput )
+{
+    typedef std::map< PMacc::id_t, PMacc::ITask* > SystemTaskMap;
+    typedef std::map<
+        PMacc::id_t,
+        PMacc::ITask*,
+        std::less< PMacc::id_t >,
+        PMacc::TaskPoolAllocator< std::pair< const PMacc::id_t, PMacc::ITask* > >
+    > PoolTaskMap;
+
+    const size_t numSteps = 1000;
+    const size_t tasksPerStep = 500;
+
+    /* warm up the pool */
+    createRetireThroughput< DummyTask, PoolTaskMap >( 1, tasksPerStep );
+
+    const double systemRate = createRetireThroughput< SystemAllocatedTask, SystemTaskMap >( numSteps, tasksPerStep );
+    const double poolRate = createRetireThroughput< DummyTask, PoolTaskMap >( numSteps, tasksPerStep );
+
+    BOOST_TEST_MESSAGE( "task create/retire throughput [tasks/s]: system allocator " << systemRate
+        << ", TaskPool " << poolRate );
+    BOOST_CHECK( poolRate > 0.0 );
+}
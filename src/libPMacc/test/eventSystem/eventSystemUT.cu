@@ -0,0 +1,42 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STL
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+// BOOST
+#include <boost/test/unit_test.hpp>
+
+// PMacc
+#include <pmacc_types.hpp>
+#include <eventSystem/tasks/ITask.hpp>
+#include <eventSystem/tasks/TaskPool.hpp>
+#include <eventSystem/graph/StepGraph.hpp>
+
+BOOST_AUTO_TEST_SUITE( eventSystem )
+
+#   include "TaskPool.hpp"
+#   include "StepGraph.hpp"
+
+BOOST_AUTO_TEST_SUITE_END()
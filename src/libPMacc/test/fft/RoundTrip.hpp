@@ -0,0 +1,88 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <math/fft/FFT.hpp>
+#include <memory/buffers/HostBufferIntern.hpp>
+#include <dimensions/DataSpace.hpp>
+#include <dimensions/DataSpaceOperations.hpp>
+#include <Environment.hpp>
+
+#include <cmath>
+
+/** forward and inverse transform reproduce the input scaled by the number of elements
+ *
+ * The x extent is odd to check that padded rows of the device buffers are
+ * handled, the DC component must be the sum of all elements.
+ *
+ * @tparam T_FFT FFT backend
+ */
+template< typename T_FFT >
+void checkRoundTrip( )
+{
+    typedef T_FFT FFT;
+    typedef ::PMacc::DataSpace< TEST_DIM > Space;
+    namespace pmFFT = ::PMacc::math::fft;
+
+    Space realSize = Space::create( 8 );
+    realSize.x() = 13;
+    const Space complexSize = pmFFT::getComplexSize( realSize );
+    const int numElements = realSize.productOfComponents();
+
+    typename FFT::RealBuffer input( realSize );
+    typename FFT::RealBuffer output( realSize );
+    typename FFT::ComplexBuffer spectrum( complexSize );
+    ::PMacc::HostBufferIntern< float, TEST_DIM > hostInput( realSize );
+    ::PMacc::HostBufferIntern< float, TEST_DIM > hostOutput( realSize );
+    ::PMacc::HostBufferIntern< typename FFT::ComplexType, TEST_DIM > hostSpectrum( complexSize );
+
+    auto inputBox = hostInput.getDataBox();
+    double sum = 0.0;
+    for( int i = 0; i < numElements; ++i )
+    {
+        const Space cell = ::PMacc::DataSpaceOperations< TEST_DIM >::map( realSize, i );
+        const float value = std::sin( 0.3f * i ) + 0.25f * cell.x();
+        inputBox( cell ) = value;
+        sum += value;
+    }
+    pmFFT::getDeviceBuffer( input ).copyFrom( hostInput );
+
+    FFT fft( realSize );
+    fft.prepare( input, spectrum );
+    fft.forward( input, spectrum );
+    fft.inverse( spectrum, output );
+
+    /* the inverse transform overwrites the spectrum, transform again for the DC check */
+    fft.forward( input, spectrum );
+    hostSpectrum.copyFrom( pmFFT::getDeviceBuffer( spectrum ) );
+    hostOutput.copyFrom( pmFFT::getDeviceBuffer( output ) );
+    ::PMacc::Environment<>::get().Manager().waitForAllTasks();
+
+    BOOST_CHECK_CLOSE( double( hostSpectrum.getDataBox()( Space::create( 0 ) ).get_real() ), sum, 1.0e-3 );
+
+    auto outputBox = hostOutput.getDataBox();
+    for( int i = 0; i < numElements; ++i )
+    {
+        const Space cell = ::PMacc::DataSpaceOperations< TEST_DIM >::map( realSize, i );
+        BOOST_CHECK_SMALL( outputBox( cell ) / float( numElements ) - inputBox( cell ), 1.0e-4f );
+    }
+}
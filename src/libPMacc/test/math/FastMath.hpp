@@ -0,0 +1,211 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <pmacc_types.hpp>
+#include <algorithms/math.hpp>
+#include <memory/buffers/HostDeviceBuffer.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include <stdint.h>
+
+BOOST_AUTO_TEST_SUITE( fastMath )
+
+namespace pmMath = ::PMacc::algorithms::math;
+
+namespace
+{
+    struct ExpFunctor
+    {
+        template< typename T_Precision >
+        HDINLINE float operator()( const float value, const T_Precision& precision ) const
+        {
+            return pmMath::exp( value, precision );
+        }
+    };
+
+    struct LogFunctor
+    {
+        template< typename T_Precision >
+        HDINLINE float operator()( const float value, const T_Precision& precision ) const
+        {
+            return pmMath::log( value, precision );
+        }
+    };
+
+    struct SinFunctor
+    {
+        template< typename T_Precision >
+        HDINLINE float operator()( const float value, const T_Precision& precision ) const
+        {
+            return pmMath::sin( value, precision );
+        }
+    };
+
+    struct CosFunctor
+    {
+        template< typename T_Precision >
+        HDINLINE float operator()( const float value, const T_Precision& precision ) const
+        {
+            return pmMath::cos( value, precision );
+        }
+    };
+
+    struct SqrtFunctor
+    {
+        template< typename T_Precision >
+        HDINLINE float operator()( const float value, const T_Precision& precision ) const
+        {
+            return pmMath::sqrt( value, precision );
+        }
+    };
+
+    /** evaluate a functor with both precisions for equidistant samples */
+    template< typename T_Functor >
+    struct EvaluatePrecisions
+    {
+        template< class T_Box >
+        DINLINE void operator()( T_Box preciseBox, T_Box fastBox, float lower,
+                                 float step, uint32_t numSamples ) const
+        {
+            const uint32_t linearId = blockIdx.x * blockDim.x + threadIdx.x;
+            if( linearId < numSamples )
+            {
+                const float value = lower + step * float( linearId );
+                preciseBox( linearId ) = T_Functor( )( value, pmMath::Precise( ) );
+                fastBox( linearId ) = T_Functor( )( value, pmMath::Fast( ) );
+            }
+        }
+    };
+
+    /** distance to the next larger float */
+    double ulp( const float value )
+    {
+        const float absValue = std::abs( value );
+        return double( std::nextafter( absValue, std::numeric_limits< float >::max( ) ) ) - double( absValue );
+    }
+}
+
+/** compare the Fast and the Precise result of a functor on the device
+ * and on the host
+ *
+ * @tparam T_Functor functor to evaluate
+ * @tparam T_Bound maximal absolute difference, called with the sample
+ *                 and the Precise result
+ */
+template< typename T_Functor, typename T_Bound >
+void checkFastPrecision( const float lower, const float upper, const T_Bound& bound )
+{
+    constexpr uint32_t numSamples = 1u << 16;
+    constexpr uint32_t numThreadsPerBlock = 256u;
+    const float step = ( upper - lower ) / float( numSamples );
+
+    PMacc::HostDeviceBuffer< float, 1 > preciseBuffer( numSamples );
+    PMacc::HostDeviceBuffer< float, 1 > fastBuffer( numSamples );
+    PMACC_KERNEL( EvaluatePrecisions< T_Functor >{ } )( numSamples / numThreadsPerBlock, numThreadsPerBlock )
+        ( preciseBuffer.getDeviceBuffer( ).getDataBox( ), fastBuffer.getDeviceBuffer( ).getDataBox( ),
+          lower, step, numSamples );
+    preciseBuffer.deviceToHost( );
+    fastBuffer.deviceToHost( );
+
+    auto preciseBox = preciseBuffer.getHostBuffer( ).getDataBox( );
+    auto fastBox = fastBuffer.getHostBuffer( ).getDataBox( );
+    for( uint32_t i = 0u; i < numSamples; ++i )
+    {
+        const float value = lower + step * float( i );
+        const double difference = std::abs( double( fastBox( i ) ) - double( preciseBox( i ) ) );
+        BOOST_REQUIRE_MESSAGE(
+            difference <= bound( value, preciseBox( i ) ),
+            "value " << value << ": fast " << fastBox( i ) << " precise " << preciseBox( i )
+        );
+
+        const float hostPrecise = T_Functor( )( value, pmMath::Precise( ) );
+        const float hostFast = T_Functor( )( value, pmMath::Fast( ) );
+        const double hostDifference = std::abs( double( hostFast ) - double( hostPrecise ) );
+        BOOST_REQUIRE_MESSAGE(
+            hostDifference <= bound( value, hostPrecise ),
+            "host value " << value << ": fast " << hostFast << " precise " << hostPrecise
+        );
+    }
+}
+
+/* the bounds are the documented maximal errors of the Fast functors
+ * (floatMath) plus one ulp of the Precise result */
+
+BOOST_AUTO_TEST_CASE( expFast )
+{
+    checkFastPrecision< ExpFunctor >(
+        -20.0f, 20.0f,
+        []( const float value, const float precise )
+        {
+            return ( 3.0 + std::floor( std::abs( 1.16 * value ) ) ) * ulp( precise );
+        }
+    );
+}
+
+BOOST_AUTO_TEST_CASE( logFast )
+{
+    checkFastPrecision< LogFunctor >(
+        1.0e-3f, 1.0e3f,
+        []( const float value, const float precise )
+        {
+            if( value >= 0.5f && value <= 2.0f )
+                return std::pow( 2.0, -21.41 ) + ulp( precise );
+            return 4.0 * ulp( precise );
+        }
+    );
+}
+
+BOOST_AUTO_TEST_CASE( sinCosFast )
+{
+    /* far outside [-pi, pi] to cover the argument reduction */
+    auto bound = []( const float value, const float precise )
+    {
+        return std::pow( 2.0, -21.41 ) + std::abs( value ) * std::pow( 2.0, -23.0 ) + ulp( precise );
+    };
+    checkFastPrecision< SinFunctor >( -1.0e3f, 1.0e3f, bound );
+    checkFastPrecision< CosFunctor >( -1.0e3f, 1.0e3f, bound );
+}
+
+BOOST_AUTO_TEST_CASE( sqrtFast )
+{
+    checkFastPrecision< SqrtFunctor >(
+        0.0f, 1.0e6f,
+        []( const float, const float precise )
+        {
+            return 4.0 * ulp( precise );
+        }
+    );
+}
+
+/** types without a Fast implementation use the Precise one */
+BOOST_AUTO_TEST_CASE( fastFallback )
+{
+    const double value = 0.7;
+    BOOST_CHECK_EQUAL( pmMath::exp( value, pmMath::Fast( ) ), pmMath::exp( value ) );
+    BOOST_CHECK_EQUAL( pmMath::sqrt( value, pmMath::Fast( ) ), pmMath::sqrt( value ) );
+    BOOST_CHECK_EQUAL( pmMath::pow( value, 1.5, pmMath::Fast( ) ), pmMath::pow( value, 1.5 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
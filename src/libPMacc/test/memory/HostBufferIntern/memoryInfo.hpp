@@ -0,0 +1,72 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* #includes in "test/memoryUT.cu" */
+
+/**
+ * Checks if the memory of a HostBufferIntern is accounted in the MemoryInfo.
+ */
+struct MemoryInfoTest {
+
+    template<typename T_Dim>
+    void exec(T_Dim)
+    {
+
+        typedef uint8_t Data;
+
+        std::vector<size_t> nElementsPerDim = getElementsPerDim<T_Dim>();
+        ::PMacc::nvidia::memory::MemoryInfo& memoryInfo = ::PMacc::Environment<>::get().MemoryInfo();
+
+        for(unsigned i = 0; i < nElementsPerDim.size(); ++i)
+        {
+            ::PMacc::DataSpace<T_Dim::value> const dataSpace = ::PMacc::DataSpace<T_Dim::value>::create(nElementsPerDim[i]);
+            size_t const before = memoryInfo.getBufferMemory(::PMacc::nvidia::memory::HOST_BUFFER_MEMORY);
+            {
+                ::PMacc::HostBufferIntern<Data, T_Dim::value> hostBufferIntern(dataSpace);
+
+                BOOST_CHECK_EQUAL(
+                    memoryInfo.getBufferMemory(::PMacc::nvidia::memory::HOST_BUFFER_MEMORY),
+                    before + static_cast<size_t>(dataSpace.productOfComponents()) * sizeof(Data)
+                );
+                BOOST_CHECK(
+                    memoryInfo.getPeakBufferMemory(::PMacc::nvidia::memory::HOST_BUFFER_MEMORY) >=
+                    before + static_cast<size_t>(dataSpace.productOfComponents()) * sizeof(Data)
+                );
+            }
+            BOOST_CHECK_EQUAL( memoryInfo.getBufferMemory(::PMacc::nvidia::memory::HOST_BUFFER_MEMORY), before );
+        }
+
+    }
+
+    PMACC_NO_NVCC_HDWARNING
+    template<typename T_Dim>
+    HDINLINE void operator()(T_Dim dim)
+    {
+        exec(dim);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( memoryInfo ){
+    ::boost::mpl::for_each< Dims >( MemoryInfoTest() );
+
+}
@@ -99,6 +99,7 @@ BOOST_AUTO_TEST_SUITE( memory )
 #   include "HostBufferIntern/copyFrom.hpp"
 #   include "HostBufferIntern/reset.hpp"
 #   include "HostBufferIntern/setValue.hpp"
+#   include "HostBufferIntern/memoryInfo.hpp"
   BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <nvidia/reduce/MultiValue.hpp>
+#include <nvidia/reduce/Reduce.hpp>
+#include <memory/buffers/GridBuffer.hpp>
+#include <memory/boxes/DataBoxUnaryTransform.hpp>
+#include <Environment.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+typedef ::PMacc::nvidia::reduce::MultiValue<
+    double,
+    ::PMacc::nvidia::reduce::Sum,
+    ::PMacc::nvidia::reduce::Max
+> SumAndMax;
+
+/** map a value to the slots of SumAndMax */
+template< typename T_Type >
+struct ToSumAndMax
+{
+    typedef SumAndMax result;
+
+    HDINLINE result operator()( const T_Type& value ) const
+    {
+        return result::create( value );
+    }
+};
+
+/** compensated summation keeps small summands next to a large value */
+BOOST_AUTO_TEST_CASE( compensatedSum )
+{
+    const uint32_t numSummands = 1000000u;
+    const double smallValue = 1.0e-16;
+
+    ::PMacc::nvidia::reduce::CompensatedValue< double > compensated( 1.0 );
+    double naive = 1.0;
+    for( uint32_t i = 0u; i < numSummands; ++i )
+    {
+        compensated.add( smallValue );
+        naive += smallValue;
+    }
+
+    const double expected = 1.0 + numSummands * smallValue;
+    BOOST_CHECK_EQUAL( naive, 1.0 );
+    BOOST_CHECK_CLOSE( compensated.get(), expected, 1.0e-12 );
+}
+
+/** a sum and a maximum are reduced in one call on the device */
+BOOST_AUTO_TEST_CASE( multiValueReduce )
+{
+    typedef ::PMacc::GridBuffer< double, DIM1 > Buffer;
+    typedef ::PMacc::DataBoxUnaryTransform< Buffer::DataBoxType, ToSumAndMax > D1Box;
+
+    const uint32_t numElements = 100003u;
+    Buffer buffer( ::PMacc::DataSpace< DIM1 >( numElements ) );
+
+    auto hostBox = buffer.getHostBuffer().getDataBox();
+    double sum = 0.0;
+    double maximum = 0.0;
+    for( uint32_t i = 0u; i < numElements; ++i )
+    {
+        /* the largest value is in the middle of the buffer */
+        const double value = 1.0 + 1.0e-3 * double( std::min( i, numElements - i ) );
+        hostBox[ i ] = value;
+        sum += value;
+        maximum = std::max( maximum, value );
+    }
+    buffer.hostToDevice();
+
+    ::PMacc::nvidia::reduce::Reduce reduce( 1024 * sizeof( SumAndMax ), 128 * sizeof( SumAndMax ) );
+    const SumAndMax result = reduce(
+        ::PMacc::nvidia::reduce::CombineMultiValue(),
+        D1Box( buffer.getDeviceBuffer().getDataBox() ),
+        numElements
+    );
+
+    BOOST_CHECK_CLOSE( result[ 0 ].get(), sum, 1.0e-10 );
+    BOOST_CHECK_EQUAL( result[ 1 ].get(), maximum );
+}
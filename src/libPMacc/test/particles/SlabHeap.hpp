@@ -0,0 +1,230 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <pmacc_types.hpp>
+#include <particles/memory/allocator/SlabHeap.hpp>
+#include <memory/buffers/HostDeviceBuffer.hpp>
+#include <eventSystem/EventSystem.hpp>
+
+#include <boost/mpl/int.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <set>
+#include <stdint.h>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( particles )
+
+namespace
+{
+    /* 16 objects of the smallest size per slab */
+    struct SlabHeapTestConfig
+    {
+        using slabSize = boost::mpl::int_< 4096 >;
+        using regions = boost::mpl::int_< 1 >;
+        using sizeClasses = boost::mpl::int_< 4 >;
+        using minObjectSize = boost::mpl::int_< 256 >;
+    };
+
+    using TestSlabHeap = PMacc::SlabHeap< SlabHeapTestConfig >;
+
+    struct AllocateObjects
+    {
+        template< class T_Box >
+        DINLINE void operator()( PMacc::slabHeap::SlabHeapHandle handle, T_Box ptrBox,
+                                 uint32_t numObjects, uint32_t objectSize ) const
+        {
+            const uint32_t linearId = blockIdx.x * blockDim.x + threadIdx.x;
+            if( linearId < numObjects )
+                ptrBox( linearId ) = reinterpret_cast< uint64_t >( handle.malloc( objectSize ) );
+        }
+    };
+
+    /* one thread allocates the objects one after another */
+    struct AllocateObjectsSequential
+    {
+        template< class T_Box >
+        DINLINE void operator()( PMacc::slabHeap::SlabHeapHandle handle, T_Box ptrBox,
+                                 uint32_t numObjects, uint32_t objectSize ) const
+        {
+            for( uint32_t i = 0u; i < numObjects; ++i )
+                ptrBox( i ) = reinterpret_cast< uint64_t >( handle.malloc( objectSize ) );
+        }
+    };
+
+    struct FreeObjects
+    {
+        template< class T_Box >
+        DINLINE void operator()( PMacc::slabHeap::SlabHeapHandle handle, T_Box ptrBox,
+                                 uint32_t numObjects ) const
+        {
+            const uint32_t linearId = blockIdx.x * blockDim.x + threadIdx.x;
+            if( linearId < numObjects )
+                handle.free( reinterpret_cast< void* >( ptrBox( linearId ) ) );
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE( SlabHeapFragmentation )
+{
+    PMacc::SlabHeapStatistics stats;
+    stats.numSlabs = 4u;
+    stats.capacity = 64u;
+
+    /* all live objects fit into the assigned slabs */
+    stats.liveObjects = 64u;
+    BOOST_CHECK_EQUAL( stats.getFragmentation( ), 0.0 );
+    /* one object per slab */
+    stats.liveObjects = 4u;
+    BOOST_CHECK_EQUAL( stats.getFragmentation( ), 1.0 );
+    /* empty slabs are fully fragmented, not more */
+    stats.liveObjects = 0u;
+    BOOST_CHECK_EQUAL( stats.getFragmentation( ), 1.0 );
+
+    stats.numSlabs = 1u;
+    BOOST_CHECK_EQUAL( stats.getFragmentation( ), 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE( SlabHeapObjectSize )
+{
+    BOOST_CHECK( ( PMacc::FitsIntoDeviceHeap< TestSlabHeap, 4096u >::value ) );
+    BOOST_CHECK( ( !PMacc::FitsIntoDeviceHeap< TestSlabHeap, 4097u >::value ) );
+    /* the general purpose allocators have no size limit */
+    BOOST_CHECK( ( PMacc::FitsIntoDeviceHeap< int, 1u << 30 >::value ) );
+}
+
+BOOST_AUTO_TEST_CASE( SlabHeapAllocateFreeCompact )
+{
+    constexpr uint32_t objectSize = 256u;
+    constexpr uint32_t numObjects = 64u;
+    constexpr uint32_t numThreadsPerBlock = 32u;
+    constexpr uint32_t numBlocks = numObjects / numThreadsPerBlock;
+
+    TestSlabHeap heap( 32u * 4096u + 32u * 1024u );
+    const size_t numSlabs = heap.getHeapLocations( )[ 0 ].size / TestSlabHeap::slabSize;
+    BOOST_REQUIRE_GE( numSlabs, numObjects / 16u );
+
+    PMacc::HostDeviceBuffer< uint64_t, 1 > ptrBuffer( numObjects );
+    PMACC_KERNEL( AllocateObjects{ } )( numBlocks, numThreadsPerBlock )
+        ( heap.getAllocatorHandle( ), ptrBuffer.getDeviceBuffer( ).getDataBox( ), numObjects, objectSize );
+    ptrBuffer.deviceToHost( );
+
+    auto ptrBox = ptrBuffer.getHostBuffer( ).getDataBox( );
+    std::set< uint64_t > pointers;
+    for( uint32_t i = 0u; i < numObjects; ++i )
+    {
+        BOOST_REQUIRE( ptrBox( i ) != 0u );
+        pointers.insert( ptrBox( i ) );
+    }
+    BOOST_REQUIRE_EQUAL( pointers.size( ), numObjects );
+
+    PMacc::SlabHeapStatistics stats = heap.getStatistics( objectSize );
+    BOOST_CHECK_EQUAL( stats.objectSize, objectSize );
+    BOOST_CHECK_EQUAL( stats.liveObjects, numObjects );
+    BOOST_CHECK_GE( stats.capacity, numObjects );
+    BOOST_CHECK_GE( stats.getFragmentation( ), 0.0 );
+    BOOST_CHECK_LE( stats.getFragmentation( ), 1.0 );
+
+    /* an object larger than a slab is never allocated */
+    PMacc::HostDeviceBuffer< uint64_t, 1 > largeBuffer( 1u );
+    PMACC_KERNEL( AllocateObjects{ } )( 1u, 1u )
+        ( heap.getAllocatorHandle( ), largeBuffer.getDeviceBuffer( ).getDataBox( ),
+          1u, TestSlabHeap::slabSize + 16u );
+    largeBuffer.deviceToHost( );
+    BOOST_CHECK_EQUAL( largeBuffer.getHostBuffer( ).getDataBox( )( 0 ), 0u );
+
+    PMACC_KERNEL( FreeObjects{ } )( numBlocks, numThreadsPerBlock )
+        ( heap.getAllocatorHandle( ), ptrBuffer.getDeviceBuffer( ).getDataBox( ), numObjects );
+    stats = heap.getStatistics( objectSize );
+    BOOST_CHECK_EQUAL( stats.liveObjects, 0u );
+    BOOST_CHECK_LE( stats.getFragmentation( ), 1.0 );
+
+    /* compaction gives all empty slabs back */
+    heap.compact( );
+    stats = heap.getStatistics( objectSize );
+    BOOST_CHECK_EQUAL( stats.numSlabs, 0u );
+    BOOST_CHECK_EQUAL( stats.unusedSlabs, numSlabs );
+    BOOST_CHECK_EQUAL( heap.getAvailableSlots( objectSize ), numSlabs * 16u );
+}
+
+BOOST_AUTO_TEST_CASE( SlabHeapCompactOrder )
+{
+    constexpr uint32_t objectSize = 256u;
+    constexpr uint32_t objectsPerSlab = 16u;
+    constexpr uint32_t numObjects = 4u * objectsPerSlab;
+    constexpr uint32_t numThreadsPerBlock = 32u;
+
+    TestSlabHeap heap( 32u * 4096u + 32u * 1024u );
+
+    PMacc::HostDeviceBuffer< uint64_t, 1 > ptrBuffer( numObjects );
+    PMACC_KERNEL( AllocateObjects{ } )( numObjects / numThreadsPerBlock, numThreadsPerBlock )
+        ( heap.getAllocatorHandle( ), ptrBuffer.getDeviceBuffer( ).getDataBox( ), numObjects, objectSize );
+    ptrBuffer.deviceToHost( );
+
+    /* four full slabs, sorted by address */
+    std::vector< uint64_t > pointers( numObjects );
+    auto ptrBox = ptrBuffer.getHostBuffer( ).getDataBox( );
+    for( uint32_t i = 0u; i < numObjects; ++i )
+        pointers[ i ] = ptrBox( i );
+    std::sort( pointers.begin( ), pointers.end( ) );
+
+    /* live objects per slab after the free: 8, 14, 1 and 16 */
+    std::vector< uint64_t > freed;
+    for( uint32_t slot = 0u; slot < objectsPerSlab; ++slot )
+    {
+        if( slot % 2u == 1u )
+            freed.push_back( pointers[ slot ] );
+        if( slot == 3u || slot == 9u )
+            freed.push_back( pointers[ objectsPerSlab + slot ] );
+        if( slot != 5u )
+            freed.push_back( pointers[ 2u * objectsPerSlab + slot ] );
+    }
+    std::sort( freed.begin( ), freed.end( ) );
+    for( uint32_t i = 0u; i < freed.size( ); ++i )
+        ptrBox( i ) = freed[ i ];
+    ptrBuffer.hostToDevice( );
+    PMACC_KERNEL( FreeObjects{ } )( 1u, static_cast< uint32_t >( freed.size( ) ) )
+        ( heap.getAllocatorHandle( ), ptrBuffer.getDeviceBuffer( ).getDataBox( ),
+          static_cast< uint32_t >( freed.size( ) ) );
+
+    heap.compact( );
+
+    /* the free slots are handed out by slab fullness, then by address */
+    std::vector< uint64_t > expected;
+    const uint32_t slabOrder[ 3 ] = { 1u, 0u, 2u };
+    for( uint32_t i = 0u; i < 3u; ++i )
+        for( std::vector< uint64_t >::const_iterator it = freed.begin( ); it != freed.end( ); ++it )
+            if( *it >= pointers[ slabOrder[ i ] * objectsPerSlab ] &&
+                *it <= pointers[ slabOrder[ i ] * objectsPerSlab + objectsPerSlab - 1u ] )
+                expected.push_back( *it );
+    BOOST_REQUIRE_EQUAL( expected.size( ), freed.size( ) );
+
+    const uint32_t numReallocated = static_cast< uint32_t >( expected.size( ) );
+    PMACC_KERNEL( AllocateObjectsSequential{ } )( 1u, 1u )
+        ( heap.getAllocatorHandle( ), ptrBuffer.getDeviceBuffer( ).getDataBox( ), numReallocated, objectSize );
+    ptrBuffer.deviceToHost( );
+    for( uint32_t i = 0u; i < numReallocated; ++i )
+        BOOST_CHECK_EQUAL( ptrBox( i ), expected[ i ] );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+/* Copyright 2017 libPMacc contributors
+ *
+ * This file is part of libPMacc.
+ *
+ * libPMacc is free software: you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libPMacc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libPMacc.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <particles/operations/SuperCellRanges.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include <stdint.h>
+
+BOOST_AUTO_TEST_SUITE( particles )
+
+BOOST_AUTO_TEST_CASE( SuperCellRangesScan )
+{
+    using PMacc::particles::operations::SuperCellRanges;
+
+    SuperCellRanges ranges( 4u );
+    ranges.setSize( 0u, 3u );
+    ranges.setSize( 2u, 5u );
+    ranges.setSize( 3u, 1u );
+    ranges.scan();
+
+    BOOST_REQUIRE_EQUAL( ranges.getNumParticles(), 9u );
+    BOOST_REQUIRE_EQUAL( ranges.getOffset( 0u ), 0u );
+    BOOST_REQUIRE_EQUAL( ranges.getOffset( 1u ), 3u );
+    BOOST_REQUIRE_EQUAL( ranges.getOffset( 2u ), 3u );
+    BOOST_REQUIRE_EQUAL( ranges.getOffset( 3u ), 8u );
+    BOOST_REQUIRE_EQUAL( ranges.getSize( 1u ), 0u );
+    BOOST_REQUIRE_EQUAL( ranges.getSize( 2u ), 5u );
+}
+
+BOOST_AUTO_TEST_CASE( SuperCellRangesOrder )
+{
+    using PMacc::particles::operations::SuperCellRanges;
+
+    /* particle i belongs to supercell superCellIds[i] */
+    const uint32_t ids[] = { 2u, 0u, 2u, 1u, 0u, 2u };
+    const std::vector< uint32_t > superCellIds( ids, ids + 6 );
+
+    const SuperCellRanges ranges( SuperCellRanges::count( superCellIds, 3u ) );
+    BOOST_REQUIRE_EQUAL( ranges.getSize( 0u ), 2u );
+    BOOST_REQUIRE_EQUAL( ranges.getSize( 1u ), 1u );
+    BOOST_REQUIRE_EQUAL( ranges.getSize( 2u ), 3u );
+
+    /* ordered by supercell, stable within a supercell */
+    const uint32_t expected[] = { 1u, 4u, 3u, 0u, 2u, 5u };
+    const std::vector< uint32_t > order( ranges.order( superCellIds ) );
+    BOOST_REQUIRE_EQUAL_COLLECTIONS( order.begin(), order.end(), expected, expected + 6 );
+
+    /* a supercell index outside of the domain is an error */
+    const std::vector< uint32_t > outside( 1u, 3u );
+    BOOST_REQUIRE_THROW( SuperCellRanges::count( outside, 3u ), std::out_of_range );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
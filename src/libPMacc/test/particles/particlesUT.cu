@@ -29,3 +29,5 @@
 #endif
 
 #include "IdProvider.hpp"
+#include "SuperCellRanges.hpp"
+#include "SlabHeap.hpp"
@@ -0,0 +1,80 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *
+ * Kernel benchmark of PIConGPU
+ *
+ * Uses the same param files as PIConGPU but starts the simulation class
+ * KernelBenchmark, which runs the hot kernels in isolation and writes the
+ * throughput to a JSON file instead of executing time steps.
+ */
+
+#include "ArgsParser.hpp"
+#include "Environment.hpp"
+
+#include <simulation_defines.hpp>
+//load starter after user extensions and all params are loaded
+#include <simulation_defines/unitless/starter.unitless>
+#include "simulationControl/KernelBenchmark.hpp"
+
+
+namespace picongpu
+{
+    typedef SimulationStarter
+    <
+        InitialiserController,
+        PluginController,
+        KernelBenchmark
+    > BenchmarkStarter;
+}
+
+/*! start of the PIConGPU kernel benchmark
+ *
+ * @param argc count of arguments in argv
+ * @param argv arguments of program start
+ */
+int main(int argc, char **argv)
+{
+    using namespace picongpu;
+
+    BenchmarkStarter sim;
+    ArgsParser::ArgsErrorCode parserCode = sim.parseConfigs(argc, argv);
+    int errorCode = 1;
+
+    switch(parserCode)
+    {
+        case ArgsParser::ERROR:
+            errorCode = 1;
+            break;
+        case ArgsParser::SUCCESS:
+            sim.load();
+            sim.start();
+            sim.unload();
+            /* missing `break` is voluntarily to set the error code to 0 */
+        case ArgsParser::SUCCESS_EXIT:
+            errorCode = 0;
+            break;
+    };
+
+    /* finalize the PMacc context */
+    PMacc::Environment<>::get().finalize();
+
+    return errorCode;
+}
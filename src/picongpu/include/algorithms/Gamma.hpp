@@ -26,14 +26,20 @@
 namespace picongpu
 {
 
-    template< typename T_PrecisionType >
+    template<
+        typename T_PrecisionType,
+        typename T_MathPrecision
+    >
     template<
         typename T_MomType,
         typename T_MassType
     >
     HDINLINE
     T_PrecisionType
-    Gamma< T_PrecisionType >::operator()(
+    Gamma<
+        T_PrecisionType,
+        T_MathPrecision
+    >::operator()(
         T_MomType const & mom,
         T_MassType const mass
     ) const
@@ -47,7 +53,8 @@ namespace picongpu
             precisionCast<valueType >( mass * mass * c2 );
 
         return math::sqrt(
-            precisionCast<valueType >( valueType( 1.0 ) + fMom2 * m2_c2_reci )
+            precisionCast<valueType >( valueType( 1.0 ) + fMom2 * m2_c2_reci ),
+            T_MathPrecision( )
         );
     }
 
@@ -60,7 +60,7 @@ namespace picongpu
 
 using namespace PMacc;
 
-FieldB::FieldB( MappingDesc cellDescription ) :
+HINLINE FieldB::FieldB( MappingDesc cellDescription ) :
 SimulationFieldHelper<MappingDesc>( cellDescription )
 {
     /*#####create FieldB###############*/
@@ -133,64 +133,64 @@ SimulationFieldHelper<MappingDesc>( cellDescription )
 
 }
 
-FieldB::~FieldB( )
+HINLINE FieldB::~FieldB( )
 {
     __delete(fieldB);
 }
 
-SimulationDataId FieldB::getUniqueId()
+HINLINE SimulationDataId FieldB::getUniqueId()
 {
     return getName();
 }
 
-void FieldB::synchronize( )
+HINLINE void FieldB::synchronize( )
 {
     fieldB->deviceToHost( );
 }
 
-void FieldB::syncToDevice( )
+HINLINE void FieldB::syncToDevice( )
 {
 
     fieldB->hostToDevice( );
 }
 
-EventTask FieldB::asyncCommunication( EventTask serialEvent )
+HINLINE EventTask FieldB::asyncCommunication( EventTask serialEvent )
 {
 
     EventTask eB = fieldB->asyncCommunication( serialEvent );
     return eB;
 }
 
-void FieldB::init( LaserPhysics &laserPhysics )
+HINLINE void FieldB::init( LaserPhysics &laserPhysics )
 {
     this->laser = &laserPhysics;
 }
 
-GridLayout<simDim> FieldB::getGridLayout( )
+HINLINE GridLayout<simDim> FieldB::getGridLayout( )
 {
 
     return cellDescription.getGridLayout( );
 }
 
-FieldB::DataBoxType FieldB::getHostDataBox( )
+HINLINE FieldB::DataBoxType FieldB::getHostDataBox( )
 {
 
     return fieldB->getHostBuffer( ).getDataBox( );
 }
 
-FieldB::DataBoxType FieldB::getDeviceDataBox( )
+HINLINE FieldB::DataBoxType FieldB::getDeviceDataBox( )
 {
 
     return fieldB->getDeviceBuffer( ).getDataBox( );
 }
 
-GridBuffer<FieldB::ValueType, simDim> &FieldB::getGridBuffer( )
+HINLINE GridBuffer<FieldB::ValueType, simDim> &FieldB::getGridBuffer( )
 {
 
     return *fieldB;
 }
 
-void FieldB::reset( uint32_t )
+HINLINE void FieldB::reset( uint32_t )
 {
     fieldB->getHostBuffer( ).reset( true );
     fieldB->getDeviceBuffer( ).reset( false );
@@ -220,13 +220,13 @@ FieldB::getUnitDimension( )
     return unitDimension;
 }
 
-std::string
+HINLINE std::string
 FieldB::getName( )
 {
     return "B";
 }
 
-uint32_t
+HINLINE uint32_t
 FieldB::getCommTag( )
 {
     return FIELD_B;
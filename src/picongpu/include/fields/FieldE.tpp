@@ -56,7 +56,7 @@ namespace picongpu
 {
 using namespace PMacc;
 
-FieldE::FieldE( MappingDesc cellDescription ) :
+HINLINE FieldE::FieldE( MappingDesc cellDescription ) :
 SimulationFieldHelper<MappingDesc>( cellDescription )
 {
     fieldE = new GridBuffer<ValueType, simDim > ( cellDescription.getGridLayout( ) );
@@ -127,57 +127,57 @@ SimulationFieldHelper<MappingDesc>( cellDescription )
     }
 }
 
-FieldE::~FieldE( )
+HINLINE FieldE::~FieldE( )
 {
     __delete(fieldE);
 }
 
-SimulationDataId FieldE::getUniqueId()
+HINLINE SimulationDataId FieldE::getUniqueId()
 {
     return getName();
 }
 
-void FieldE::synchronize( )
+HINLINE void FieldE::synchronize( )
 {
     fieldE->deviceToHost( );
 }
 
-void FieldE::syncToDevice( )
+HINLINE void FieldE::syncToDevice( )
 {
     fieldE->hostToDevice( );
 }
 
-EventTask FieldE::asyncCommunication( EventTask serialEvent )
+HINLINE EventTask FieldE::asyncCommunication( EventTask serialEvent )
 {
     return fieldE->asyncCommunication( serialEvent );
 }
 
-void FieldE::init( LaserPhysics &laserPhysics )
+HINLINE void FieldE::init( LaserPhysics &laserPhysics )
 {
     this->laser = &laserPhysics;
 }
 
-FieldE::DataBoxType FieldE::getDeviceDataBox( )
+HINLINE FieldE::DataBoxType FieldE::getDeviceDataBox( )
 {
     return fieldE->getDeviceBuffer( ).getDataBox( );
 }
 
-FieldE::DataBoxType FieldE::getHostDataBox( )
+HINLINE FieldE::DataBoxType FieldE::getHostDataBox( )
 {
     return fieldE->getHostBuffer( ).getDataBox( );
 }
 
-GridBuffer<FieldE::ValueType, simDim> &FieldE::getGridBuffer( )
+HINLINE GridBuffer<FieldE::ValueType, simDim> &FieldE::getGridBuffer( )
 {
     return *fieldE;
 }
 
-GridLayout< simDim> FieldE::getGridLayout( )
+HINLINE GridLayout< simDim> FieldE::getGridLayout( )
 {
     return cellDescription.getGridLayout( );
 }
 
-void FieldE::laserManipulation( uint32_t currentStep )
+HINLINE void FieldE::laserManipulation( uint32_t currentStep )
 {
     const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
 
@@ -192,7 +192,7 @@ void FieldE::laserManipulation( uint32_t currentStep )
      */
     if (
         laserProfile::INIT_TIME == float_X(0.0) || /* laser is disabled e.g. laserNone */
-        ( currentStep * DELTA_T  - laserTimeShift ) >= laserProfile::INIT_TIME ||
+        ( currentStep * DELTA_T  - laserTimeShift ) >= laserProfile::getInitTime( ) ||
         Environment<simDim>::get().GridController().getCommunicationMask( ).isSet( TOP ) || numSlides != 0
     )
     {
@@ -227,7 +227,7 @@ void FieldE::laserManipulation( uint32_t currentStep )
         ( this->getDeviceDataBox( ), laser->getLaserManipulator( currentStep ) );
 }
 
-void FieldE::reset( uint32_t )
+HINLINE void FieldE::reset( uint32_t )
 {
     fieldE->getHostBuffer( ).reset( true );
     fieldE->getDeviceBuffer( ).reset( false );
@@ -259,13 +259,13 @@ FieldE::getUnitDimension( )
     return unitDimension;
 }
 
-std::string
+HINLINE std::string
 FieldE::getName( )
 {
     return "E";
 }
 
-uint32_t
+HINLINE uint32_t
 FieldE::getCommTag( )
 {
     return FIELD_E;
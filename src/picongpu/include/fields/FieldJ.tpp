@@ -53,7 +53,7 @@ namespace picongpu
 
 using namespace PMacc;
 
-FieldJ::FieldJ( MappingDesc cellDescription ) :
+HINLINE FieldJ::FieldJ( MappingDesc cellDescription ) :
 SimulationFieldHelper<MappingDesc>( cellDescription ),
 fieldJ( cellDescription.getGridLayout( ) ), fieldJrecv( nullptr )
 {
@@ -147,27 +147,27 @@ fieldJ( cellDescription.getGridLayout( ) ), fieldJrecv( nullptr )
     }
 }
 
-FieldJ::~FieldJ( )
+HINLINE FieldJ::~FieldJ( )
 {
     __delete(fieldJrecv);
 }
 
-SimulationDataId FieldJ::getUniqueId( )
+HINLINE SimulationDataId FieldJ::getUniqueId( )
 {
     return getName( );
 }
 
-void FieldJ::synchronize( )
+HINLINE void FieldJ::synchronize( )
 {
     fieldJ.deviceToHost( );
 }
 
-GridBuffer<FieldJ::ValueType, simDim> &FieldJ::getGridBuffer( )
+HINLINE GridBuffer<FieldJ::ValueType, simDim> &FieldJ::getGridBuffer( )
 {
     return fieldJ;
 }
 
-EventTask FieldJ::asyncCommunication( EventTask serialEvent )
+HINLINE EventTask FieldJ::asyncCommunication( EventTask serialEvent )
 {
     EventTask ret;
     __startTransaction( serialEvent );
@@ -187,7 +187,7 @@ EventTask FieldJ::asyncCommunication( EventTask serialEvent )
         return ret;
 }
 
-void FieldJ::bashField( uint32_t exchangeType )
+HINLINE void FieldJ::bashField( uint32_t exchangeType )
 {
     ExchangeMapping<GUARD, MappingDesc> mapper( this->cellDescription, exchangeType );
 
@@ -203,7 +203,7 @@ void FieldJ::bashField( uint32_t exchangeType )
           mapper );
 }
 
-void FieldJ::insertField( uint32_t exchangeType )
+HINLINE void FieldJ::insertField( uint32_t exchangeType )
 {
     ExchangeMapping<GUARD, MappingDesc> mapper( this->cellDescription, exchangeType );
 
@@ -218,20 +218,20 @@ void FieldJ::insertField( uint32_t exchangeType )
           direction, mapper );
 }
 
-void FieldJ::init( )
+HINLINE void FieldJ::init( )
 {
 }
 
-GridLayout<simDim> FieldJ::getGridLayout( )
+HINLINE GridLayout<simDim> FieldJ::getGridLayout( )
 {
     return cellDescription.getGridLayout( );
 }
 
-void FieldJ::reset( uint32_t )
+HINLINE void FieldJ::reset( uint32_t )
 {
 }
 
-void FieldJ::assign( ValueType value )
+HINLINE void FieldJ::assign( ValueType value )
 {
     fieldJ.getDeviceBuffer( ).setValue( value );
     //fieldJ.reset(false);
@@ -261,13 +261,13 @@ FieldJ::getUnitDimension( )
     return unitDimension;
 }
 
-std::string
+HINLINE std::string
 FieldJ::getName( )
 {
     return "J";
 }
 
-uint32_t
+HINLINE uint32_t
 FieldJ::getCommTag( )
 {
     return FIELD_J;
@@ -73,7 +73,7 @@ public:
                      *      no slide was performed and
                      *      laser init time is not over
                      */
-                    if (numSlides == 0 && ((currentStep * DELTA_T) <= laserProfile::INIT_TIME))
+                    if (numSlides == 0 && ((currentStep * DELTA_T) <= laserProfile::getInitTime()))
                     {
                         /* disable absorber on top side */
                         if (i == TOP) continue;
@@ -55,7 +55,7 @@ namespace picongpu
 {
     using namespace PMacc;
 
-    FieldTmp::FieldTmp(
+    HINLINE FieldTmp::FieldTmp(
         MappingDesc cellDescription,
         uint32_t slotId
     ) :
@@ -188,7 +188,7 @@ namespace picongpu
 
     }
 
-    FieldTmp::~FieldTmp( )
+    HINLINE FieldTmp::~FieldTmp( )
     {
         __delete( fieldTmp );
     }
@@ -217,29 +217,29 @@ namespace picongpu
     }
 
 
-    SimulationDataId
+    HINLINE SimulationDataId
     FieldTmp::getUniqueId( uint32_t slotId )
     {
         return getName() + std::to_string( slotId );
     }
 
-    SimulationDataId
+    HINLINE SimulationDataId
     FieldTmp::getUniqueId()
     {
         return getUniqueId( m_slotId );
     }
 
-    void FieldTmp::synchronize( )
+    HINLINE void FieldTmp::synchronize( )
     {
         fieldTmp->deviceToHost( );
     }
 
-    void FieldTmp::syncToDevice( )
+    HINLINE void FieldTmp::syncToDevice( )
     {
         fieldTmp->hostToDevice( );
     }
 
-    EventTask FieldTmp::asyncCommunication( EventTask serialEvent )
+    HINLINE EventTask FieldTmp::asyncCommunication( EventTask serialEvent )
     {
         EventTask ret;
         __startTransaction( serialEvent + m_gatherEv + m_scatterEv );
@@ -253,7 +253,7 @@ namespace picongpu
         return ret;
     }
 
-    EventTask FieldTmp::asyncCommunicationGather( EventTask serialEvent )
+    HINLINE EventTask FieldTmp::asyncCommunicationGather( EventTask serialEvent )
     {
         PMACC_VERIFY_MSG(
             fieldTmpSupportGatherCommunication == true,
@@ -265,7 +265,7 @@ namespace picongpu
         return m_gatherEv;
     }
 
-    void FieldTmp::bashField( uint32_t exchangeType )
+    HINLINE void FieldTmp::bashField( uint32_t exchangeType )
     {
         ExchangeMapping<GUARD, MappingDesc> mapper( this->cellDescription, exchangeType );
 
@@ -281,7 +281,7 @@ namespace picongpu
               mapper );
     }
 
-    void FieldTmp::insertField( uint32_t exchangeType )
+    HINLINE void FieldTmp::insertField( uint32_t exchangeType )
     {
         ExchangeMapping<GUARD, MappingDesc> mapper( this->cellDescription, exchangeType );
 
@@ -296,31 +296,31 @@ namespace picongpu
               direction, mapper );
     }
 
-    void FieldTmp::init( )
+    HINLINE void FieldTmp::init( )
     {
     }
 
-    FieldTmp::DataBoxType FieldTmp::getDeviceDataBox( )
+    HINLINE FieldTmp::DataBoxType FieldTmp::getDeviceDataBox( )
     {
         return fieldTmp->getDeviceBuffer( ).getDataBox( );
     }
 
-    FieldTmp::DataBoxType FieldTmp::getHostDataBox( )
+    HINLINE FieldTmp::DataBoxType FieldTmp::getHostDataBox( )
     {
         return fieldTmp->getHostBuffer( ).getDataBox( );
     }
 
-    GridBuffer<typename FieldTmp::ValueType, simDim> &FieldTmp::getGridBuffer( )
+    HINLINE GridBuffer<typename FieldTmp::ValueType, simDim> &FieldTmp::getGridBuffer( )
     {
         return *fieldTmp;
     }
 
-    GridLayout< simDim> FieldTmp::getGridLayout( )
+    HINLINE GridLayout< simDim> FieldTmp::getGridLayout( )
     {
         return cellDescription.getGridLayout( );
     }
 
-    void FieldTmp::reset( uint32_t )
+    HINLINE void FieldTmp::reset( uint32_t )
     {
         fieldTmp->getHostBuffer( ).reset( true );
         fieldTmp->getDeviceBuffer( ).reset( false );
@@ -340,7 +340,7 @@ namespace picongpu
         return FrameSolver().getUnitDimension();
     }
 
-    std::string
+    HINLINE std::string
     FieldTmp::getName( )
     {
         return "FieldTmp";
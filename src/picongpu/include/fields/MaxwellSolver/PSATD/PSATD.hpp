@@ -0,0 +1,334 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "PSATD.def"
+
+#include "simulation_defines.hpp"
+
+#include "fields/FieldE.hpp"
+#include "fields/FieldB.hpp"
+#include "fields/FieldJ.hpp"
+#include "fields/FieldManipulator.hpp"
+#include "fields/MaxwellSolver/PSATD/PSATD.kernel"
+
+#include "dataManagement/DataConnector.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "math/fft/FFT.hpp"
+#include "memory/buffers/HostBufferIntern.hpp"
+#include "debug/PIConGPUVerbose.hpp"
+#include "verify.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+
+
+namespace picongpu
+{
+namespace psatdSolver
+{
+using namespace PMacc;
+namespace pmFFT = PMacc::math::fft;
+
+/** Check PSATD grid and time conditions
+ *
+ * This is a workaround that the condition check is only
+ * triggered if the current used solver is `PSATD`
+ */
+template<typename T_UsedSolver, typename T_Dummy=void>
+struct ConditionCheck
+{
+};
+
+template<typename T_FFT, typename T_Dummy>
+struct ConditionCheck<PSATD<T_FFT>, T_Dummy>
+{
+    /* PSATD conditions:
+     *
+     * The solver has no Courant limit, but the FFTs are local to a device.
+     * Signals must not travel further than the guard within one time step,
+     * otherwise the periodic wrap of the local FFT reaches the border cells.
+     *
+     * `sizeof(ANY_TYPE) != 0` defers the evaluation, see DirSplitting.
+     */
+    PMACC_CASSERT_MSG(PSATD_light_travels_further_than_the_guard_in_x_within_one_time_step____check_your_gridConfig_param_file,
+                      (SI::SPEED_OF_LIGHT_SI * SI::DELTA_T_SI) <= GUARD_SIZE * SuperCellSize::x::value * SI::CELL_WIDTH_SI &&
+                      (sizeof(T_Dummy) != 0));
+    PMACC_CASSERT_MSG(PSATD_light_travels_further_than_the_guard_in_y_within_one_time_step____check_your_gridConfig_param_file,
+                      (SI::SPEED_OF_LIGHT_SI * SI::DELTA_T_SI) <= GUARD_SIZE * SuperCellSize::y::value * SI::CELL_HEIGHT_SI &&
+                      (sizeof(T_Dummy) != 0));
+#if (SIMDIM == DIM3)
+    PMACC_CASSERT_MSG(PSATD_light_travels_further_than_the_guard_in_z_within_one_time_step____check_your_gridConfig_param_file,
+                      (SI::SPEED_OF_LIGHT_SI * SI::DELTA_T_SI) <= GUARD_SIZE * SuperCellSize::z::value * SI::CELL_DEPTH_SI &&
+                      (sizeof(T_Dummy) != 0));
+#endif
+};
+
+/** pseudo-spectral analytical time domain (PSATD) solver
+ *
+ * E and B are advanced together after the current was deposited.
+ * Each device transforms its local domain including the guard, which acts
+ * as overlap region: E and B in the guard are the values of the neighbors
+ * of the last time step and the current in the guard is filled by the
+ * `Spectral` current interpolation. After the update only CORE+BORDER are
+ * kept and the guards are exchanged as for the finite difference solvers.
+ *
+ * The fields stay on the Yee grid (see KernelUpdateSpectral), all field
+ * interpolations and current solvers can be used unchanged.
+ *
+ * @tparam T_FFT FFT backend for simDim and float_X, e.g.
+ *               PMacc::math::fft::CuFFT< simDim, float_X >
+ */
+template<typename T_FFT>
+class PSATD : private ConditionCheck<fieldSolver::FieldSolver>
+{
+private:
+    typedef T_FFT FFT;
+    typedef typename FFT::RealBuffer RealBuffer;
+    typedef typename FFT::ComplexBuffer ComplexBuffer;
+    typedef typename ComplexBuffer::DataBoxType ComplexBox;
+
+    std::shared_ptr< FieldE > fieldE;
+    std::shared_ptr< FieldB > fieldB;
+    MappingDesc m_cellDescription;
+
+    DataSpace<simDim> realSize;
+    DataSpace<simDim> complexSize;
+
+    std::unique_ptr< FFT > fft;
+    /* real data of one field component including the guard */
+    std::unique_ptr< RealBuffer > scalar;
+    /* spectra of E, B and J, three components each */
+    std::unique_ptr< ComplexBuffer > spectraE[3];
+    std::unique_ptr< ComplexBuffer > spectraB[3];
+    std::unique_ptr< ComplexBuffer > spectraJ[3];
+
+    static uint32_t getGridSize( const DataSpace<simDim>& size )
+    {
+        return ( size.productOfComponents() + kernelBlockSize - 1 ) / kernelBlockSize;
+    }
+
+    /** transform the three components of a field */
+    template<typename T_FieldBox>
+    void forward( T_FieldBox field, std::unique_ptr< ComplexBuffer >* spectra )
+    {
+        for( uint32_t d = 0; d < 3; ++d )
+        {
+            PMACC_KERNEL( KernelFieldToScalar{ } )
+                ( getGridSize( realSize ), kernelBlockSize )(
+                    field,
+                    pmFFT::getDeviceBuffer( *scalar ).getDataBox(),
+                    realSize,
+                    d
+                );
+            fft->forward( *scalar, *spectra[d] );
+        }
+    }
+
+    /** advance the spectra of E and B by one time step */
+    void updateSpectra()
+    {
+        SpectralBoxes< ComplexBox > spectra;
+        for( uint32_t d = 0; d < 3; ++d )
+        {
+            spectra.e[d] = pmFFT::getDeviceBuffer( *spectraE[d] ).getDataBox();
+            spectra.b[d] = pmFFT::getDeviceBuffer( *spectraB[d] ).getDataBox();
+            spectra.j[d] = pmFFT::getDeviceBuffer( *spectraJ[d] ).getDataBox();
+        }
+        PMACC_KERNEL( KernelUpdateSpectral{ } )
+            ( getGridSize( complexSize ), kernelBlockSize )(
+                spectra,
+                realSize,
+                complexSize
+            );
+    }
+
+    /** fill the scalar buffer with a plane wave, see KernelPlaneWave */
+    void fillPlaneWave( const int mode, const float_X shift, const float_X amplitude )
+    {
+        PMACC_KERNEL( KernelPlaneWave{ } )
+            ( getGridSize( realSize ), kernelBlockSize )(
+                pmFFT::getDeviceBuffer( *scalar ).getDataBox(),
+                realSize,
+                mode,
+                shift,
+                amplitude
+            );
+    }
+
+    /** maximal deviation of the scalar buffer from a plane wave
+     *
+     * @param phase phase subtracted from the argument of the cosine
+     * @return maximal absolute difference relative to the amplitude
+     */
+    float_64 getPlaneWaveDeviation( const int mode, const float_64 shift, const float_64 amplitude, const float_64 phase )
+    {
+        HostBufferIntern< float_X, simDim > hostScalar( realSize );
+        hostScalar.copyFrom( pmFFT::getDeviceBuffer( *scalar ) );
+        __getTransactionEvent().waitForFinished();
+
+        auto box = hostScalar.getDataBox();
+        float_64 deviation = 0.0;
+        for( int i = 0; i < realSize.productOfComponents(); ++i )
+        {
+            const DataSpace<simDim> cell( DataSpaceOperations<simDim>::map( realSize, i ) );
+            const float_64 expected = amplitude * std::cos( 2.0 * PI * mode *
+                ( float_64( cell.x() ) + shift ) / float_64( realSize.x() ) - phase );
+            deviation = std::max( deviation, std::abs( float_64( box( cell ) ) - expected ) / amplitude );
+        }
+        return deviation;
+    }
+
+    /** advance a vacuum plane wave by one time step and compare it with
+     *  the analytical solution
+     *
+     * E_y and B_z of a wave in x direction with two periods over the local
+     * domain (including the guard) at their Yee positions x and x + 1/2.
+     * The solver has no numerical dispersion, the wave must move by
+     * c * dt. Checks the FFT backend, the spectral update and the Yee
+     * staggering together, called before the first time step.
+     */
+    void checkPlaneWave()
+    {
+        typedef typename ComplexBuffer::DataBoxType::ValueType ComplexType;
+        const int mode = 2;
+        const float_64 c = SPEED_OF_LIGHT;
+        const float_64 phase = 2.0 * PI * mode * c * DELTA_T / ( float_64( realSize.x() ) * CELL_WIDTH );
+        const float_64 tolerance = 1.0e-3;
+
+        for( uint32_t d = 0; d < 3; ++d )
+        {
+            pmFFT::getDeviceBuffer( *spectraE[d] ).setValue( ComplexType::zero() );
+            pmFFT::getDeviceBuffer( *spectraB[d] ).setValue( ComplexType::zero() );
+            pmFFT::getDeviceBuffer( *spectraJ[d] ).setValue( ComplexType::zero() );
+        }
+        fillPlaneWave( mode, float_X( 0.0 ), float_X( 1.0 ) );
+        fft->forward( *scalar, *spectraE[1] );
+        fillPlaneWave( mode, float_X( 0.5 ), float_X( 1.0 / c ) );
+        fft->forward( *scalar, *spectraB[2] );
+
+        updateSpectra();
+
+        fft->inverse( *spectraE[1], *scalar );
+        const float_64 deviationE = getPlaneWaveDeviation( mode, 0.0, 1.0, phase );
+        fft->inverse( *spectraB[2], *scalar );
+        const float_64 deviationB = getPlaneWaveDeviation( mode, 0.5, 1.0 / c, phase );
+
+        if( Environment<simDim>::get().GridController().getGlobalRank() == 0 )
+            log<picLog::PHYSICS >( "PSATD plane wave check (%1%): relative deviation E %2%, B %3%" ) %
+                FFT::getName() % deviationE % deviationB;
+
+        std::stringstream msg;
+        msg << "PSATD with " << FFT::getName() << " does not propagate a plane wave correctly,"
+            << " relative deviation E " << deviationE << ", B " << deviationB
+            << " (tolerance " << tolerance << ")";
+        PMACC_VERIFY_MSG( deviationE <= tolerance && deviationB <= tolerance, msg.str() );
+    }
+
+    /** transform three spectra back into CORE+BORDER of a field */
+    template<typename T_FieldBox>
+    void inverse( std::unique_ptr< ComplexBuffer >* spectra, T_FieldBox field )
+    {
+        const DataSpace<simDim> coreBorderSize( m_cellDescription.getGridLayout().getDataSpaceWithoutGuarding() );
+        const DataSpace<simDim> guardSize( m_cellDescription.getGridLayout().getGuard() );
+        for( uint32_t d = 0; d < 3; ++d )
+        {
+            fft->inverse( *spectra[d], *scalar );
+            PMACC_KERNEL( KernelScalarToField{ } )
+                ( getGridSize( coreBorderSize ), kernelBlockSize )(
+                    pmFFT::getDeviceBuffer( *scalar ).getDataBox(),
+                    field,
+                    coreBorderSize,
+                    guardSize,
+                    d
+                );
+        }
+    }
+
+public:
+
+    PSATD(MappingDesc cellDescription) :
+        m_cellDescription(cellDescription),
+        realSize(cellDescription.getGridLayout().getDataSpace()),
+        complexSize(PMacc::math::fft::getComplexSize(realSize))
+    {
+        DataConnector &dc = Environment<>::get().DataConnector();
+
+        this->fieldE = dc.get< FieldE >( FieldE::getName(), true );
+        this->fieldB = dc.get< FieldB >( FieldB::getName(), true );
+
+        /* all device memory of the solver is allocated here, the solver is
+         * created before the remaining memory is given to the particles */
+        fft.reset( new FFT( realSize ) );
+        scalar.reset( new RealBuffer( realSize ) );
+        for( uint32_t d = 0; d < 3; ++d )
+        {
+            spectraE[d].reset( new ComplexBuffer( complexSize ) );
+            spectraB[d].reset( new ComplexBuffer( complexSize ) );
+            spectraJ[d].reset( new ComplexBuffer( complexSize ) );
+        }
+        fft->prepare( *scalar, *spectraE[0] );
+
+        checkPlaneWave();
+    }
+
+    void update_beforeCurrent(uint32_t)
+    {
+        /* E and B are advanced together after the current is known */
+    }
+
+    void update_afterCurrent(uint32_t currentStep)
+    {
+        DataConnector &dc = Environment<>::get().DataConnector();
+        auto fieldJ = dc.get< FieldJ >( FieldJ::getName(), true );
+
+        forward( fieldE->getDeviceDataBox(), spectraE );
+        forward( fieldB->getDeviceDataBox(), spectraB );
+        forward( fieldJ->getDeviceDataBox(), spectraJ );
+        dc.releaseData( FieldJ::getName() );
+
+        updateSpectra();
+
+        inverse( spectraE, fieldE->getDeviceDataBox() );
+        inverse( spectraB, fieldB->getDeviceDataBox() );
+
+        FieldManipulator::absorbBorder(currentStep, this->m_cellDescription, this->fieldE->getDeviceDataBox());
+        if (laserProfile::INIT_TIME > float_X(0.0))
+            fieldE->laserManipulation(currentStep);
+        FieldManipulator::absorbBorder(currentStep, this->m_cellDescription, this->fieldB->getDeviceDataBox());
+
+        EventTask eRfieldE = fieldE->asyncCommunication(__getTransactionEvent());
+        EventTask eRfieldB = fieldB->asyncCommunication(__getTransactionEvent());
+        __setTransactionEvent(eRfieldE + eRfieldB);
+    }
+
+    static PMacc::traits::StringProperty getStringProperties()
+    {
+        PMacc::traits::StringProperty propList( "name", "PSATD" );
+        propList["param"] = std::string( "FFT backend: " ) + FFT::getName();
+        return propList;
+    }
+};
+
+} // psatdSolver
+
+} // picongpu
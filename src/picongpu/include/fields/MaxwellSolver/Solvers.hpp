@@ -23,6 +23,7 @@
 
 #include "None/NoSolver.hpp"
 #include "Yee/YeeSolver.hpp"
+#include "PSATD/PSATD.hpp"
 #if (SIMDIM==3)
 #include "Lehe/LeheSolver.hpp"
 #include "DirSplitting/DirSplitting.hpp"
@@ -100,11 +100,11 @@ namespace cellwiseOperation
             const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
             /** offset due to being the n-th GPU */
             DataSpace<simDim> totalCellOffset(subGrid.getLocalDomain().offset);
-            const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter( currentStep );
+            const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance( currentStep );
 
             /** Assumption: all GPUs have the same number of cells in
              *              y direction for sliding window */
-            totalCellOffset.y() += numSlides * subGrid.getLocalDomain().size.y();
+            totalCellOffset.y() += slideDistance;
             /* the first block will start with less offset if started in the GUARD */
             if( T_Area & GUARD)
                 totalCellOffset -= m_cellDescription.getSuperCellSize() * m_cellDescription.getGuardingSuperCells();
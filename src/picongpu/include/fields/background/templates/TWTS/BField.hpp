@@ -135,18 +135,24 @@ public:
     /** Calculate the By(r,t) field, when electric field vector (Ex,0,0)
      *  is normal to the pulse-front-tilt plane (y,z)
      *
+     * \tparam T_Precision precision policy of the complex math functions
+     *
      * \param pos Spatial position of the target field.
      * \param time Absolute time (SI, including all offsets and transformations)
      *  for calculating the field */
+    template< typename T_Precision = mathPrecision::TWTS >
     HDINLINE float_T
     calcTWTSBy( const float3_64& pos, const float_64 time ) const;
 
     /** Calculate the Bz(r,t) field, when electric field vector (Ex,0,0)
      *  is normal to the pulse-front-tilt plane (y,z)
      *
+     * \tparam T_Precision precision policy of the complex math functions
+     *
      * \param pos Spatial position of the target field.
      * \param time Absolute time (SI, including all offsets and transformations)
      *  for calculating the field */
+    template< typename T_Precision = mathPrecision::TWTS >
     HDINLINE float_T
     calcTWTSBz_Ex( const float3_64& pos, const float_64 time ) const;
 
@@ -162,9 +168,12 @@ public:
     /** Calculate the Bz(r,t) field here (electric field vector (0,Ey,0)
      *  lies within the pulse-front-tilt plane (y,z)
      *
+     * \tparam T_Precision precision policy of the complex math functions
+     *
      * \param pos Spatial position of the target field.
      * \param time Absolute time (SI, including all offsets and transformations)
      *  for calculating the field */
+    template< typename T_Precision = mathPrecision::TWTS >
     HDINLINE float_T
     calcTWTSBz_Ey( const float3_64& pos, const float_64 time ) const;
 
@@ -293,6 +293,7 @@ namespace twts
      * \param pos Spatial position of the target field.
      * \param time Absolute time (SI, including all offsets and transformations)
      *             for calculating the field */
+    template< typename T_Precision >
     HDINLINE BField::float_T
     BField::calcTWTSBy( const float3_64& pos, const float_64 time ) const
     {
@@ -433,14 +434,14 @@ namespace twts
         const complex_T helpVar6 = (cspeed*(cspeed*om0*tauG*tauG + complex_T(0,2)
                                 *(-z - y*math::tan(float_T(PI / 2)-phiT))*tanPhi2*tanPhi2))
                                     / (om0*rho0);
-        const complex_T result = (math::exp(helpVar4)*tauG / cosPhi2 / cosPhi2
+        const complex_T result = (math::exp(helpVar4, T_Precision())*tauG / cosPhi2 / cosPhi2
             *(rho0 + complex_T(0,1)*y*cosPhi + complex_T(0,1)*z*sinPhi)
             *(
                   complex_T(0,2)*cspeed*t + cspeed*om0*tauG*tauG - complex_T(0,4)*z
                 + cspeed*(complex_T(0,2)*t + om0*tauG*tauG)*cosPhi
                 + complex_T(0,2)*y*tanPhi2
-            )*math::pow(helpVar3,float_T(-1.5))
-        ) / (float_T(2.0)*helpVar5*math::sqrt(helpVar6));
+            )*math::pow(helpVar3,float_T(-1.5), T_Precision())
+        ) / (float_T(2.0)*helpVar5*math::sqrt(helpVar6, T_Precision()));
 
         return result.get_real() / UNIT_SPEED;
     }
@@ -450,6 +451,7 @@ namespace twts
      * \param pos Spatial position of the target field.
      * \param time Absolute time (SI, including all offsets and transformations)
      *             for calculating the field */
+    template< typename T_Precision >
     HDINLINE BField::float_T
     BField::calcTWTSBz_Ex( const float3_64& pos, const float_64 time ) const
     {
@@ -551,10 +553,10 @@ namespace twts
         const complex_T helpVar7 = cspeed*om0*tauG*tauG
                                     - complex_T(0,1)*y*cosPhi / cosPhi2 / cosPhi2*tanPhi2
                                     - complex_T(0,2)*z*tanPhi2*tanPhi2;
-        const complex_T result = ( complex_T(0,2)*math::exp(helpVar6)*tauG*tanPhi2
+        const complex_T result = ( complex_T(0,2)*math::exp(helpVar6, T_Precision())*tauG*tanPhi2
                                     *(cspeed*t - z + y*tanPhi2)
-                                    *math::sqrt( (om0*rho0) / helpVar3 )
-                                  ) / math::pow(helpVar7,float_T(1.5));
+                                    *math::sqrt( (om0*rho0) / helpVar3, T_Precision() )
+                                  ) / math::pow(helpVar7,float_T(1.5), T_Precision());
 
         return result.get_real() / UNIT_SPEED;
     }
@@ -578,6 +580,7 @@ namespace twts
      * \param pos Spatial position of the target field.
      * \param time Absolute time (SI, including all offsets and transformations)
      *             for calculating the field */
+    template< typename T_Precision >
     HDINLINE BField::float_T
     BField::calcTWTSBz_Ey( const float3_64& pos, const float_64 time ) const
     {
@@ -718,8 +721,8 @@ namespace twts
         ) / rho0;
 
         const complex_T result = float_T(-1.0)*(
-            cspeed*math::exp(helpVar3)*k*tauG*x*math::pow( helpVar2, float_T(-1.5) )
-            / math::sqrt(helpVar4)
+            cspeed*math::exp(helpVar3, T_Precision())*k*tauG*x*math::pow( helpVar2, float_T(-1.5), T_Precision() )
+            / math::sqrt(helpVar4, T_Precision())
         );
 
         return result.get_real() / UNIT_SPEED;
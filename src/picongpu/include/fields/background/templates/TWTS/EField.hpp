@@ -133,11 +133,14 @@ public:
                 const uint32_t currentStep ) const;
 
     /** Calculate the Ex(r,t) field here (electric field vector normal to pulse-front-tilt plane)
+     *
+     * \tparam T_Precision precision policy of the complex math functions
      *
      * \param pos Spatial position of the target field
      * \param time Absolute time (SI, including all offsets and transformations)
      *  for calculating the field
      * \return Ex-field component of the non-rotated TWTS field in SI units */
+    template< typename T_Precision = mathPrecision::TWTS >
     HDINLINE float_T
     calcTWTSEx( const float3_64& pos, const float_64 time ) const;
 
@@ -199,6 +199,7 @@ namespace twts
      * \param pos Spatial position of the target field.
      * \param time Absolute time (SI, including all offsets and transformations) for calculating
      *             the field */
+    template< typename T_Precision >
     HDINLINE EField::float_T
     EField::calcTWTSEx( const float3_64& pos, const float_64 time) const
     {
@@ -330,8 +331,8 @@ namespace twts
             - complex_T(0,8)*y*math::tan( float_T(PI / 2)-phiT )
                                 / sinPhi / sinPhi*sinPhi2*sinPhi2*sinPhi2*sinPhi2
             - complex_T(0,2)*z*tanPhi2*tanPhi2;
-        const complex_T result = (math::exp(helpVar4)*tauG
-            *math::sqrt((cspeed*om0*rho0) / helpVar3)) / math::sqrt(helpVar5);
+        const complex_T result = (math::exp(helpVar4, T_Precision())*tauG
+            *math::sqrt((cspeed*om0*rho0) / helpVar3, T_Precision())) / math::sqrt(helpVar5, T_Precision());
         return result.get_real();
     }
 
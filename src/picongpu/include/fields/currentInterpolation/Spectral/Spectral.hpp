@@ -0,0 +1,62 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "pmacc_types.hpp"
+
+#include "fields/currentInterpolation/Spectral/Spectral.def"
+
+namespace picongpu
+{
+namespace currentInterpolation
+{
+using namespace PMacc;
+
+template<uint32_t T_dim>
+struct Spectral
+{
+    static constexpr uint32_t dim = T_dim;
+
+    /* the whole guard is needed by the local FFTs */
+    typedef typename PMacc::math::CT::mul<
+        SuperCellSize,
+        typename PMacc::math::CT::make_Int<dim, GUARD_SIZE>::type
+    >::type LowerMargin;
+    typedef LowerMargin UpperMargin;
+
+    template<typename DataBoxE, typename DataBoxB, typename DataBoxJ>
+    HDINLINE void operator()(DataBoxE,
+                             DataBoxB,
+                             DataBoxJ )
+    {
+        /* the current is added in k-space by the field solver */
+    }
+
+    static PMacc::traits::StringProperty getStringProperties()
+    {
+        PMacc::traits::StringProperty propList( "name", "spectral" );
+        return propList;
+    }
+};
+
+} /* namespace currentInterpolation */
+
+} /* namespace picongpu */
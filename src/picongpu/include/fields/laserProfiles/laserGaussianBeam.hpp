@@ -22,12 +22,19 @@
 
 #include "pmacc_types.hpp"
 #include "simulation_defines.hpp"
+#include "simulationControl/RuntimeParameters.hpp"
 
 namespace picongpu
 {
     namespace laserGaussianBeam
     {
 
+        /** duration of the laser initialization, INIT_TIME with the runtime pulse length */
+        HDINLINE float_X getInitTime()
+        {
+            return INIT_TIME * runtime::laserPulseLengthScale( );
+        }
+
         /**
          *
          * @param currentStep
@@ -62,14 +69,14 @@ namespace picongpu
             // a time of PULSE_INIT * PULSE_LENGTH = INIT_TIME.
             // we shift the complete pulse for the half of this time to start with
             // the front of the laser pulse.
-            const float_64 mue = 0.5 * INIT_TIME;
+            const float_64 mue = 0.5 * getInitTime( );
 
             //rayleigh length (in y-direction)
             const float_64 y_R = PI * W0 * W0 / WAVE_LENGTH;
             //gaussian beam waist in the nearfield: w_y(y=0) == W0
             const float_64 w_y = W0 * sqrt( 1.0 + ( focusPos / y_R )*( focusPos / y_R ) );
 
-            float_64 envelope = float_64( AMPLITUDE );
+            float_64 envelope = float_64( AMPLITUDE * runtime::laserAmplitudeScale( ) );
             if( simDim == DIM2 )
                 envelope *= math::sqrt( float_64( W0 ) / w_y );
             else if( simDim == DIM3 )
@@ -137,6 +144,7 @@ namespace picongpu
 
             //rayleigh length (in y-direction)
             const float_X y_R = float_X( PI ) * W0 * W0 / WAVE_LENGTH;
+            const float_X pulseLength = PULSE_LENGTH * runtime::laserPulseLengthScale( );
 
             // the radius of curvature of the beam's  wavefronts
             const float_X R_y = -focusPos * ( float_X(1.0) + ( y_R / focusPos )*( y_R / focusPos ) );
@@ -161,7 +169,7 @@ namespace picongpu
                         * math::exp( -r2 / w_y / w_y ) * math::cos( float_X(2.0) * float_X( PI ) / WAVE_LENGTH * focusPos - float_X(2.0) * float_X( PI ) / WAVE_LENGTH * r2 / float_X(2.0) / R_y + ( 2*m + 1 ) * xi_y + phase )
                         * math::exp( -( r2 / float_X(2.0) / R_y - focusPos - phase / float_X(2.0) / float_X( PI ) * WAVE_LENGTH )
                               *( r2 / float_X(2.0) / R_y - focusPos - phase / float_X(2.0) / float_X( PI ) * WAVE_LENGTH )
-                              / SPEED_OF_LIGHT / SPEED_OF_LIGHT / ( float_X(2.0) * PULSE_LENGTH ) / ( float_X(2.0) * PULSE_LENGTH ) );
+                              / SPEED_OF_LIGHT / SPEED_OF_LIGHT / ( float_X(2.0) * pulseLength ) / ( float_X(2.0) * pulseLength ) );
                 }
                 elong *= etrans / etrans_norm;
             }
@@ -173,7 +181,7 @@ namespace picongpu
                         * math::exp( -r2 / w_y / w_y ) * math::cos( float_X(2.0) * float_X( PI ) / WAVE_LENGTH * focusPos - float_X(2.0) * float_X( PI ) / WAVE_LENGTH * r2 / float_X(2.0) / R_y + ( 2*m + 1 ) * xi_y + phase )
                         * math::exp( -( r2 / float_X(2.0) / R_y - focusPos - phase / float_X(2.0) / float_X( PI ) * WAVE_LENGTH )
                               *( r2 / float_X(2.0) / R_y - focusPos - phase / float_X(2.0) / float_X( PI ) * WAVE_LENGTH )
-                              / SPEED_OF_LIGHT / SPEED_OF_LIGHT / ( float_X(2.0) * PULSE_LENGTH ) / ( float_X(2.0) * PULSE_LENGTH ) );
+                              / SPEED_OF_LIGHT / SPEED_OF_LIGHT / ( float_X(2.0) * pulseLength ) / ( float_X(2.0) * pulseLength ) );
                 }
                 elong.x() *= etrans / etrans_norm;
                 phase += float_X( PI / 2.0 );
@@ -184,7 +192,7 @@ namespace picongpu
                         * math::exp( -r2 / w_y / w_y ) * math::cos( float_X(2.0) * float_X( PI ) / WAVE_LENGTH * focusPos - float_X(2.0) * float_X( PI ) / WAVE_LENGTH * r2 / float_X(2.0) / R_y + ( 2*m + 1 ) * xi_y + phase )
                         * math::exp( -( r2 / float_X(2.0) / R_y - focusPos - phase / float_X(2.0) / float_X( PI ) * WAVE_LENGTH )
                               *( r2 / float_X(2.0) / R_y - focusPos - phase / float_X(2.0) / float_X( PI ) * WAVE_LENGTH )
-                              / SPEED_OF_LIGHT / SPEED_OF_LIGHT / ( float_X(2.0) * PULSE_LENGTH ) / ( float_X(2.0) * PULSE_LENGTH ) );
+                              / SPEED_OF_LIGHT / SPEED_OF_LIGHT / ( float_X(2.0) * pulseLength ) / ( float_X(2.0) * pulseLength ) );
                 }
                 elong.z() *= etrans / etrans_norm;
                 phase -= float_X( PI / 2.0 );
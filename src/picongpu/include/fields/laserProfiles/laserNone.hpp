@@ -29,6 +29,11 @@ namespace picongpu
      */
     namespace laserNone
     {
+        /** duration of the laser initialization, the laser is disabled */
+        HDINLINE float_X getInitTime()
+        {
+            return INIT_TIME;
+        }
 
         /** Compute the
          *
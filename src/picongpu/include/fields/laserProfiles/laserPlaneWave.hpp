@@ -22,6 +22,7 @@
 
 #include "pmacc_types.hpp"
 #include "simulation_defines.hpp"
+#include "simulationControl/RuntimeParameters.hpp"
 
 namespace picongpu
 {
@@ -54,6 +55,12 @@ namespace picongpu
      */
     namespace laserPlaneWave
     {
+        /** duration of the laser initialization, INIT_TIME with the runtime pulse length */
+        HDINLINE float_X getInitTime()
+        {
+            return INIT_TIME + ( runtime::laserPulseLengthScale( ) - float_X( 1.0 ) ) * float_X( RAMP_INIT ) * PULSE_LENGTH;
+        }
+
         /** calculates longitudinal field distribution
          *
          * @param currentStep
@@ -69,13 +76,14 @@ namespace picongpu
             const float_64 runTime = DELTA_T * currentStep - laserTimeShift;
             const float_64 f = SPEED_OF_LIGHT / WAVE_LENGTH;
 
-            float_64 envelope = float_64(AMPLITUDE );
+            float_64 envelope = float_64( AMPLITUDE * runtime::laserAmplitudeScale( ) );
             float3_X elong(float3_X::create(0.0));
 
-            const float_64 mue = 0.5 * RAMP_INIT * PULSE_LENGTH;
+            const float_64 pulseLength = PULSE_LENGTH * runtime::laserPulseLengthScale( );
+            const float_64 mue = 0.5 * RAMP_INIT * pulseLength;
 
             const float_64 w = 2.0 * PI * f;
-            const float_64 tau = PULSE_LENGTH * sqrt( 2.0 );
+            const float_64 tau = pulseLength * sqrt( 2.0 );
 
             const float_64 endUpramp = mue;
             const float_64 startDownramp = mue + LASER_NOFOCUS_CONSTANT;
@@ -23,6 +23,7 @@
 
 #include "pmacc_types.hpp"
 #include "simulation_defines.hpp"
+#include "simulationControl/RuntimeParameters.hpp"
 
 namespace picongpu
 {
@@ -35,6 +36,12 @@ namespace laserPolynom
 
 HDINLINE float_X Tpolynomial(const float_X tau);
 
+/** duration of the laser initialization, INIT_TIME with the runtime pulse length */
+HDINLINE float_X getInitTime()
+{
+    return INIT_TIME * runtime::laserPulseLengthScale();
+}
+
 /** Compute the longitudinal enevelope of the laser
  *
  */
@@ -54,12 +61,12 @@ HINLINE float3_X laserLongitudinal(uint32_t currentStep, float_X& phase)
     // and falls for T_rise
     // making the laser pulse 2*T_rise long
 
-    const float_X T_rise = 0.5 * PULSE_LENGTH;
+    const float_X T_rise = 0.5 * PULSE_LENGTH * runtime::laserPulseLengthScale();
     const float_X tau = runTime / T_rise;
 
     const float_X omegaLaser = 2.0 * PI * f;
 
-    elong.x() = AMPLITUDE * Tpolynomial(tau)
+    elong.x() = AMPLITUDE * runtime::laserAmplitudeScale() * Tpolynomial(tau)
                 * math::sin(omegaLaser * (runTime - T_rise) + LASER_PHASE);
 
     phase = 0.0f;
@@ -23,6 +23,7 @@
 
 #include "pmacc_types.hpp"
 #include "simulation_defines.hpp"
+#include "simulationControl/RuntimeParameters.hpp"
 
 namespace picongpu
 {
@@ -36,19 +37,26 @@ namespace picongpu
 namespace laserWavepacket
 {
 
+/** duration of the laser initialization, INIT_TIME with the runtime pulse length */
+HDINLINE float_X getInitTime()
+{
+    return INIT_TIME + (runtime::laserPulseLengthScale() - float_X(1.0)) * float_X(RAMP_INIT) * PULSE_LENGTH;
+}
+
 /** Compute the
  *
  */
 HINLINE float3_X laserLongitudinal(uint32_t currentStep, float_X& phase)
 {
-    float_X envelope = float_X(AMPLITUDE);
+    float_X envelope = float_X(AMPLITUDE * runtime::laserAmplitudeScale());
+    const float_64 pulseLength = PULSE_LENGTH * runtime::laserPulseLengthScale();
     float3_X elong(float3_X::create(0.0));
 
     // a symmetric pulse will be initialized at position z=0 for
     // a time of RAMP_INIT * PULSE_LENGTH + LASER_NOFOCUS_CONSTANT = INIT_TIME.
     // we shift the complete pulse for the half of this time to start with
     // the front of the laser pulse.
-    const float_64 mue = 0.5 * INIT_TIME;
+    const float_64 mue = 0.5 * getInitTime();
 
     /* initialize the laser not in the first cell is equal to a negative shift
      * in time
@@ -62,7 +70,7 @@ HINLINE float3_X laserLongitudinal(uint32_t currentStep, float_X& phase)
     const float_64 endUpramp = -0.5 * LASER_NOFOCUS_CONSTANT;
     const float_64 startDownramp = 0.5 * LASER_NOFOCUS_CONSTANT;
 
-    const float_64 tau = PULSE_LENGTH * sqrt(2.0);
+    const float_64 tau = pulseLength * sqrt(2.0);
 
     float_64 correctionFactor = 0.0;
 
@@ -71,14 +79,14 @@ HINLINE float3_X laserLongitudinal(uint32_t currentStep, float_X& phase)
         // downramp = end
         const float_64 exponent =
             ((runTime - startDownramp)
-             / PULSE_LENGTH / sqrt(2.0));
+             / pulseLength / sqrt(2.0));
         envelope *= math::exp(-0.5 * exponent * exponent);
         correctionFactor = (runTime - startDownramp)/(tau*tau*w);
     }
     else if(runTime < endUpramp)
     {
         // upramp = start
-        const float_64 exponent = ((runTime - endUpramp) / PULSE_LENGTH / sqrt(2.0));
+        const float_64 exponent = ((runTime - endUpramp) / pulseLength / sqrt(2.0));
         envelope *= math::exp(-0.5 * exponent * exponent);
         correctionFactor = (runTime - endUpramp)/(tau*tau*w);
     }
@@ -32,6 +32,7 @@
 #include "initialization/SimStartInitialiser.hpp"
 
 #include "initialization/IInitPlugin.hpp"
+#include "simulationControl/RuntimeParameters.hpp"
 #include "assert.hpp"
 
 #include <boost/mpl/find.hpp>
@@ -112,7 +113,7 @@ public:
             const float_32 charge = frame::getCharge<FrameType>();
             const float_32 mass = frame::getMass<FrameType>();
             log<picLog::PHYSICS >("species %2%: omega_p * dt <= 0.1 ? %1%") %
-                                 (sqrt(BASE_DENSITY *  charge / mass * charge / EPS0) * DELTA_T) %
+                                 (sqrt(BASE_DENSITY * runtime::densityScale() * charge / mass * charge / EPS0) * DELTA_T) %
                                   FrameType::getName();
         }
     };
@@ -131,6 +132,16 @@ public:
             ForEach<VectorAllSpecies, LogOmegaP<> > logOmegaP;
             logOmegaP();
 
+            const runtime::Parameters& runtimeParameters = runtime::getParameters();
+            if (runtimeTunable::laserAmplitudeScale)
+                log<picLog::PHYSICS >("runtime laser amplitude scale: %1%") % runtimeParameters.laserAmplitudeScale;
+            if (runtimeTunable::laserPulseLengthScale)
+                log<picLog::PHYSICS >("runtime laser pulse length scale: %1%") % runtimeParameters.laserPulseLengthScale;
+            if (runtimeTunable::densityScale)
+                log<picLog::PHYSICS >("runtime density scale: %1%") % runtimeParameters.densityScale;
+            if (runtimeTunable::temperatureScale)
+                log<picLog::PHYSICS >("runtime temperature scale: %1%") % runtimeParameters.temperatureScale;
+
             if (laserProfile::INIT_TIME > float_X(0.0))
                 log<picLog::PHYSICS >("y-cells per wavelength: %1%") %
                                      (laserProfile::WAVE_LENGTH / CELL_HEIGHT);
@@ -86,6 +86,12 @@ public:
 
     void update(uint32_t currentStep);
 
+    /** push and mark the particles leaving their supercell without shifting them
+     *
+     * update() is push() followed by ParticlesBase::shiftParticles()
+     */
+    void push(uint32_t currentStep);
+
     template<typename T_DensityFunctor, typename T_PositionFunctor>
     void initDensityProfile(T_DensityFunctor& densityFunctor, T_PositionFunctor& positionFunctor, const uint32_t currentStep);
 
@@ -156,6 +162,16 @@ public:
     }
 
 private:
+
+    /** launch a kernel on all supercells which are initialized
+     *
+     * These are the CORE and BORDER supercells or, while the moving window
+     * initializes the supercell row entering the window, only the last BORDER
+     * row in y direction. The mapper is passed as last kernel argument.
+     */
+    template<typename T_Kernel, typename T_BlockSize, typename... T_Args>
+    void callInitKernel(const T_Kernel& kernel, const T_BlockSize& blockSize, const T_Args&... args);
+
     SimulationDataId m_datasetID;
 
     FieldE *fieldE;
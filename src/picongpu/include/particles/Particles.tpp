@@ -27,6 +27,7 @@
 
 #include "dataManagement/DataConnector.hpp"
 #include "mappings/kernel/AreaMapping.hpp"
+#include "mappings/kernel/ExchangeMapping.hpp"
 
 #include "fields/FieldB.hpp"
 #include "fields/FieldE.hpp"
@@ -54,6 +55,51 @@ namespace picongpu
 
 using namespace PMacc;
 
+namespace detail
+{
+    /** maps to the outermost supercell row of a BORDER exchange in y direction
+     *
+     * The BORDER is GUARD_SIZE supercells thick, only its outermost row
+     * enters the window with a slide by one supercell row.
+     *
+     * @tparam T_MappingDesc mapping description
+     */
+    template< typename T_MappingDesc >
+    class OutermostBorderRowMapping : public ExchangeMapping< BORDER, T_MappingDesc >
+    {
+    public:
+        typedef ExchangeMapping< BORDER, T_MappingDesc > BaseClass;
+
+        enum
+        {
+            Dim = BaseClass::Dim
+        };
+
+        /** @param base mapping description
+         *  @param exchangeType exchange with a y direction of +1 or -1
+         */
+        HINLINE OutermostBorderRowMapping( T_MappingDesc base, uint32_t exchangeType ) :
+            BaseClass( base, exchangeType )
+        {
+        }
+
+        HINLINE DataSpace< Dim > getGridDim( ) const
+        {
+            DataSpace< Dim > result( BaseClass::getGridDim( ) );
+            result.y( ) = 1;
+            return result;
+        }
+
+        HDINLINE DataSpace< Dim > getSuperCellIndex( const DataSpace< Dim >& realSuperCellIdx ) const
+        {
+            DataSpace< Dim > result( BaseClass::getSuperCellIndex( realSuperCellIdx ) );
+            if( Mask::getRelativeDirections< Dim >( this->getExchangeType( ) ).y( ) == 1 )
+                result.y( ) += this->getBorderSuperCells( ) - 1;
+            return result;
+        }
+    };
+} // namespace detail
+
 template<
     typename T_Name,
     typename T_Flags,
@@ -204,7 +250,24 @@ Particles<
     T_Name,
     T_Flags,
     T_Attributes
->::update(uint32_t )
+>::update(uint32_t currentStep)
+{
+    push( currentStep );
+
+    ParticlesBaseType::template shiftParticles < CORE + BORDER > ( );
+}
+
+template<
+    typename T_Name,
+    typename T_Flags,
+    typename T_Attributes
+>
+void
+Particles<
+    T_Name,
+    T_Flags,
+    T_Attributes
+>::push(uint32_t )
 {
     typedef typename GetFlagType<FrameType,particlePusher<> >::type PusherAlias;
     typedef typename PMacc::traits::Resolve<PusherAlias>::type ParticlePush;
@@ -244,8 +307,6 @@ Particles<
 
     dc.releaseData( FieldE::getName() );
     dc.releaseData( FieldB::getName() );
-
-    ParticlesBaseType::template shiftParticles < CORE + BORDER > ( );
 }
 
 template<
@@ -267,17 +328,16 @@ Particles<
 {
     log<picLog::SIMULATION_STATE > ( "initialize density profile for species %1%" ) % FrameType::getName( );
 
-    const uint32_t numSlides = MovingWindow::getInstance( ).getSlideCounter( currentStep );
     const SubGrid<simDim>& subGrid = Environment<simDim>::get( ).SubGrid( );
-    DataSpace<simDim> localCells = subGrid.getLocalDomain( ).size;
     DataSpace<simDim> totalGpuCellOffset = subGrid.getLocalDomain( ).offset;
-    totalGpuCellOffset.y( ) += numSlides * localCells.y( );
+    totalGpuCellOffset.y( ) += MovingWindow::getInstance( ).getSlideDistance( currentStep );
 
     auto block = MappingDesc::SuperCellSize::toRT( );
-    AreaMapping<CORE+BORDER,MappingDesc> mapper(this->cellDescription);
-    PMACC_KERNEL( KernelFillGridWithParticles< Particles >{} )
-        (mapper.getGridDim(), block)
-        ( densityFunctor, positionFunctor, totalGpuCellOffset, this->particlesBuffer->getDeviceParticleBox( ), mapper );
+    callInitKernel(
+        KernelFillGridWithParticles< Particles >{},
+        block,
+        densityFunctor, positionFunctor, totalGpuCellOffset, this->particlesBuffer->getDeviceParticleBox( )
+    );
 
 
     this->fillAllGaps( );
@@ -311,9 +371,11 @@ Particles<
     auto block = PMacc::math::CT::volume<SuperCellSize>::type::value;
 
     log<picLog::SIMULATION_STATE > ( "clone species %1%" ) % FrameType::getName( );
-    AreaMapping<CORE + BORDER, MappingDesc> mapper(this->cellDescription);
-    PMACC_KERNEL( KernelDeriveParticles{} )
-        (mapper.getGridDim(), block) ( this->getDeviceParticlesBox( ), src.getDeviceParticlesBox( ), functor, mapper );
+    callInitKernel(
+        KernelDeriveParticles{},
+        block,
+        this->getDeviceParticlesBox( ), src.getDeviceParticlesBox( ), functor
+    );
     this->fillAllGaps( );
 }
 
@@ -333,13 +395,50 @@ Particles<
 
     auto block = MappingDesc::SuperCellSize::toRT( );
 
-    AreaMapping<CORE + BORDER, MappingDesc> mapper(this->cellDescription);
-    PMACC_KERNEL( KernelManipulateAllParticles{} )
-        (mapper.getGridDim(), block)
-        ( this->particlesBuffer->getDeviceParticleBox( ),
-          functor,
-          mapper
-        );
+    callInitKernel(
+        KernelManipulateAllParticles{},
+        block,
+        this->particlesBuffer->getDeviceParticleBox( ),
+        functor
+    );
+}
+
+template<
+    typename T_Name,
+    typename T_Flags,
+    typename T_Attributes
+>
+template<typename T_Kernel, typename T_BlockSize, typename... T_Args>
+void
+Particles<
+    T_Name,
+    T_Flags,
+    T_Attributes
+>::callInitKernel( const T_Kernel& kernel, const T_BlockSize& blockSize, const T_Args&... args )
+{
+    if( MovingWindow::getInstance( ).isInitEnteringRowOnly( ) )
+    {
+        /* the entering row is the outermost BORDER row in BOTTOM direction,
+         * the union of all BORDER exchanges which point to the BOTTOM
+         * (including the corners) restricted to that row */
+        for( uint32_t i = 1; i < NumberOfExchanges<simDim>::value; ++i )
+        {
+            if( Mask::getRelativeDirections<simDim>( i ).y( ) != 1 )
+                continue;
+
+            detail::OutermostBorderRowMapping<MappingDesc> mapper( this->cellDescription, i );
+            PMACC_KERNEL( kernel )
+                (mapper.getGridDim(), blockSize)
+                ( args..., mapper );
+        }
+    }
+    else
+    {
+        AreaMapping<CORE + BORDER, MappingDesc> mapper( this->cellDescription );
+        PMACC_KERNEL( kernel )
+            (mapper.getGridDim(), blockSize)
+            ( args..., mapper );
+    }
 }
 
 } // end namespace
@@ -34,6 +34,7 @@
 #include "particles/synchrotronPhotons/SynchrotronFunctions.hpp"
 #include "particles/bremsstrahlung/Bremsstrahlung.hpp"
 #include "particles/creation/creation.hpp"
+#include "simulationControl/TranslationUnits.def"
 
 #include <boost/mpl/plus.hpp>
 #include <boost/mpl/accumulate.hpp>
@@ -101,6 +102,14 @@ struct CallCreateParticleBuffer
         const std::shared_ptr<T_DeviceHeap>& deviceHeap
     ) const
     {
+        /* a frame larger than a slab of the SlabHeap would never be allocated,
+         * increase SlabHeapConfig::slabSize in mallocMC.param */
+        PMACC_CASSERT_MSG_TYPE(
+            Frame_does_not_fit_into_a_slab_of_the_device_heap__increase_slabSize_in_mallocMC_param,
+            FrameType,
+            PMacc::FitsIntoDeviceHeap< T_DeviceHeap, sizeof( FrameType ) >::value
+        );
+
         log<picLog::MEMORY >("mallocMC: free slots for species %3%: %1% a %2%") %
             deviceHeap->getAvailableSlots(sizeof (FrameType)) %
             sizeof (FrameType) %
@@ -143,9 +152,40 @@ struct CallReset
     }
 };
 
+/** log the usage of the device heap by the frames of a species
+ *
+ * Species with an equal frame size share their slabs and report the
+ * same numbers.
+ *
+ * @tparam T_SpeciesType type of particle species
+ */
+template<typename T_SpeciesType>
+struct LogDeviceHeapUsage
+{
+    using SpeciesType = T_SpeciesType;
+    using FrameType = typename SpeciesType::FrameType;
+
+    template<typename T_DeviceHeap>
+    HINLINE void operator()(
+        const std::shared_ptr<T_DeviceHeap>& deviceHeap,
+        const uint32_t currentStep
+    ) const
+    {
+        const SlabHeapStatistics stats = getDeviceHeapStatistics( *deviceHeap, sizeof( FrameType ) );
+        log<picLog::MEMORY >("step %1%: species %2%: %3% frames in %4% slabs, occupancy %5%, fragmentation %6%") %
+            currentStep %
+            FrameType::getName() %
+            stats.liveObjects %
+            stats.numSlabs %
+            stats.getOccupancy() %
+            stats.getFragmentation();
+    }
+};
+
 /** push a species
  *
- * push is only triggered for species with a pusher
+ * push is only triggered for species with a pusher, the push is compiled
+ * in the species translation units (translationUnits::pushSpecies)
  *
  * @tparam T_SpeciesType type of particle species that is checked
  */
@@ -153,7 +193,6 @@ template<typename T_SpeciesType>
 struct PushSpecies
 {
     using SpeciesType = T_SpeciesType;
-    using FrameType = typename SpeciesType::FrameType;
 
     template<typename T_EventList>
     HINLINE void operator()(
@@ -162,17 +201,35 @@ struct PushSpecies
         T_EventList& updateEvent
     ) const
     {
-        DataConnector &dc = Environment<>::get().DataConnector();
-        auto species = dc.get< SpeciesType >( FrameType::getName(), true );
-
         __startTransaction(eventInt);
-        species->update(currentStep);
-        dc.releaseData( FrameType::getName() );
+        translationUnits::pushSpecies<
+            translationUnits::GetSpeciesIdx< SpeciesType >::value
+        >( currentStep );
         EventTask ev = __endTransaction();
         updateEvent.push_back(ev);
     }
 };
 
+/** deposit the current of a species in the CORE and BORDER
+ *
+ * the current deposition is compiled in the species translation units
+ * (translationUnits::computeCurrent)
+ *
+ * @tparam T_SpeciesType type of particle species with a current solver
+ */
+template<typename T_SpeciesType>
+struct ComputeSpeciesCurrent
+{
+    using SpeciesType = T_SpeciesType;
+
+    HINLINE void operator()( const uint32_t currentStep ) const
+    {
+        translationUnits::computeCurrent<
+            translationUnits::GetSpeciesIdx< SpeciesType >::value
+        >( currentStep );
+    }
+};
+
 /** Communicate a species
  *
  * communication is only triggered for species with a pusher
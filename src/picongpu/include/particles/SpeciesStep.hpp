@@ -0,0 +1,133 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* only included by the species translation units (translationUnits/species.cu.in) */
+
+#include "simulation_defines.hpp"
+#include "simulationControl/TranslationUnits.def"
+
+#include "fields/FieldE.hpp"
+#include "fields/FieldB.hpp"
+#include "fields/FieldJ.hpp"
+#include "fields/Fields.tpp"
+#include "traits/HasFlag.hpp"
+#include "Environment.hpp"
+
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/int.hpp>
+
+
+namespace picongpu
+{
+namespace translationUnits
+{
+namespace detail
+{
+    /** push and current deposition of a species
+     *
+     * The default implementation is used for indices beyond the number of
+     * species, the translation units instantiate a fixed number of indices.
+     *
+     * @tparam T_speciesIdx index of the species in VectorAllSpecies
+     * @tparam T_isSpecies true if T_speciesIdx is a valid index
+     */
+    template<
+        uint32_t T_speciesIdx,
+        bool T_isSpecies = ( T_speciesIdx < bmpl::size< VectorAllSpecies >::type::value )
+    >
+    struct SpeciesStep
+    {
+        static void push( uint32_t )
+        {
+        }
+
+        static void computeCurrent( uint32_t )
+        {
+        }
+    };
+
+    template< uint32_t T_speciesIdx >
+    struct SpeciesStep<
+        T_speciesIdx,
+        true
+    >
+    {
+        using SpeciesType = typename bmpl::at_c<
+            VectorAllSpecies,
+            T_speciesIdx
+        >::type;
+        using FrameType = typename SpeciesType::FrameType;
+
+        static void push( uint32_t currentStep )
+        {
+            push( currentStep, typename PMacc::traits::HasFlag< FrameType, particlePusher<> >::type( ) );
+        }
+
+        static void computeCurrent( uint32_t currentStep )
+        {
+            computeCurrent( currentStep, typename PMacc::traits::HasFlag< FrameType, current<> >::type( ) );
+        }
+
+    private:
+
+        static void push( uint32_t currentStep, bmpl::true_ )
+        {
+            DataConnector &dc = Environment<>::get().DataConnector();
+            auto species = dc.get< SpeciesType >( FrameType::getName(), true );
+            species->update( currentStep );
+            dc.releaseData( FrameType::getName() );
+        }
+
+        static void push( uint32_t, bmpl::false_ )
+        {
+        }
+
+        static void computeCurrent( uint32_t currentStep, bmpl::true_ )
+        {
+            ComputeCurrent<
+                SpeciesType,
+                bmpl::int_< CORE + BORDER >
+            > computeCurrentOfSpecies;
+            computeCurrentOfSpecies( currentStep );
+        }
+
+        static void computeCurrent( uint32_t, bmpl::false_ )
+        {
+        }
+    };
+
+} // namespace detail
+
+    template< uint32_t T_speciesIdx >
+    void pushSpecies( uint32_t currentStep )
+    {
+        detail::SpeciesStep< T_speciesIdx >::push( currentStep );
+    }
+
+    template< uint32_t T_speciesIdx >
+    void computeCurrent( uint32_t currentStep )
+    {
+        detail::SpeciesStep< T_speciesIdx >::computeCurrent( currentStep );
+    }
+
+} // namespace translationUnits
+} // namespace picongpu
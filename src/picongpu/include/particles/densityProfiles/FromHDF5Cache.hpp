@@ -0,0 +1,446 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "dimensions/DataSpaceOperations.hpp"
+
+#include <splash/splash.h>
+#include <mpi.h>
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <stdint.h>
+
+
+namespace picongpu
+{
+namespace densityProfiles
+{
+
+/** host cache of the part of a density file a rank needs during a run
+ *
+ * The moving window slides in y only, therefore a rank needs the file data of
+ * its local x (and z) range for every y position its local domain reaches
+ * during the run. The caller passes this column, the cache stores the part of
+ * it which overlaps the file. It is read once per run and reused by all later
+ * initializations, e.g. after a slide of the moving window.
+ *
+ * The host memory per rank is the column size times sizeof(T_ValueType).
+ *
+ * In the collective mode only a few aggregator ranks open the file. Each of
+ * them reads a slab along the slowest varying dimension and scatters the
+ * parts to the ranks which need them.
+ *
+ * @tparam T_ValueType scalar type of the density data
+ */
+template<typename T_ValueType>
+class FromHDF5Cache
+{
+public:
+    typedef T_ValueType ValueType;
+
+    /** maximum number of ranks which open the density file in collective mode */
+    static constexpr int maxAggregators = 16;
+
+    FromHDF5Cache() : loaded(false), hasFileData(false)
+    {
+    }
+
+    /** true if loadCollective() or loadIndependent() was called */
+    bool isLoaded() const
+    {
+        return loaded;
+    }
+
+    /** load the column of all ranks
+     *
+     * Must be called by all ranks of the communicator.
+     *
+     * @param filename, iteration, datasetName location of the density data
+     * @param comm communicator of all ranks
+     * @param info MPI info passed to libSplash
+     * @param neededOffset global offset of the column this rank needs [in cells]
+     * @param neededSize size of the column this rank needs [in cells]
+     */
+    void loadCollective(
+        const std::string& filename,
+        const uint32_t iteration,
+        const std::string& datasetName,
+        MPI_Comm comm,
+        MPI_Info info,
+        const DataSpace<simDim>& neededOffset,
+        const DataSpace<simDim>& neededSize
+    )
+    {
+        using namespace splash;
+        loaded = true;
+        hasFileData = false;
+
+        int mpiRank = 0;
+        int mpiSize = 1;
+        MPI_CHECK(MPI_Comm_rank(comm, &mpiRank));
+        MPI_CHECK(MPI_Comm_size(comm, &mpiSize));
+
+        const int numAggregators = std::min(mpiSize, maxAggregators);
+        const int aggregatorStride = (mpiSize + numAggregators - 1) / numAggregators;
+        const int numUsedAggregators = (mpiSize + aggregatorStride - 1) / aggregatorStride;
+        const bool isAggregator = (mpiRank % aggregatorStride) == 0;
+
+        /* rank 0 is always an aggregator and broadcasts the file domain:
+         * offset, size and a valid flag
+         */
+        std::vector<int64_t> fileInfo(2 * simDim + 1, 0);
+        ParallelDomainCollector* pdc = nullptr;
+        bool isFileOpen = false;
+
+        if (isAggregator)
+        {
+            pdc = new ParallelDomainCollector(MPI_COMM_SELF, info, Dimensions(1, 1, 1), 1);
+            try
+            {
+                openFile(*pdc, filename);
+                isFileOpen = true;
+                if (mpiRank == 0)
+                {
+                    Domain fileDomain = pdc->getGlobalDomain(iteration, datasetName.c_str());
+                    for (uint32_t d = 0; d < simDim; ++d)
+                    {
+                        fileInfo[d] = fileDomain.getOffset()[d];
+                        fileInfo[simDim + d] = fileDomain.getSize()[d];
+                    }
+                    fileInfo[2 * simDim] = 1;
+                }
+            }
+            catch (const DCException& e)
+            {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+
+        MPI_CHECK(MPI_Bcast(&(fileInfo.front()), 2 * simDim + 1, MPI_INT64_T, 0, comm));
+        if (fileInfo[2 * simDim] != 0)
+        {
+            for (uint32_t d = 0; d < simDim; ++d)
+            {
+                fileOffset[d] = fileInfo[d];
+                fileSize[d] = fileInfo[simDim + d];
+            }
+            setColumn(neededOffset, neededSize);
+
+            /* column of every rank in file index space */
+            std::vector<int> localColumn(2 * simDim);
+            for (uint32_t d = 0; d < simDim; ++d)
+            {
+                localColumn[d] = columnOffset[d];
+                localColumn[simDim + d] = columnSize[d];
+            }
+            std::vector<int> allColumns(2 * simDim * mpiSize);
+            MPI_CHECK(MPI_Allgather(&(localColumn.front()), 2 * simDim, MPI_INT,
+                                    &(allColumns.front()), 2 * simDim, MPI_INT, comm));
+
+            /* read the slab of this aggregator */
+            std::vector<ValueType> slab;
+            DataSpace<simDim> slabOffset;
+            DataSpace<simDim> slabSize;
+            int isReadValid = 1;
+            if (isAggregator)
+            {
+                getSlab(mpiRank / aggregatorStride, numUsedAggregators, slabOffset, slabSize);
+                slab.resize(slabSize.productOfComponents());
+                isReadValid = isFileOpen &&
+                    readBox(*pdc, iteration, datasetName, slabOffset, slabSize, slab) ? 1 : 0;
+            }
+
+            int isAllReadValid = 0;
+            MPI_CHECK(MPI_Allreduce(&isReadValid, &isAllReadValid, 1, MPI_INT, MPI_MIN, comm));
+
+            if (isAllReadValid != 0)
+            {
+                /* counts are given in elements to stay below the int limit of MPI */
+                MPI_Datatype mpiValueType;
+                MPI_CHECK(MPI_Type_contiguous(sizeof(ValueType), MPI_BYTE, &mpiValueType));
+                MPI_CHECK(MPI_Type_commit(&mpiValueType));
+
+                /* pack the parts of the slab for each rank */
+                std::vector<int> sendCounts(mpiSize, 0);
+                std::vector<int> sendDispls(mpiSize, 0);
+                std::vector<ValueType> sendBuffer;
+                if (isAggregator)
+                {
+                    for (int r = 0; r < mpiSize; ++r)
+                    {
+                        DataSpace<simDim> rankColumnOffset;
+                        DataSpace<simDim> rankColumnSize;
+                        for (uint32_t d = 0; d < simDim; ++d)
+                        {
+                            rankColumnOffset[d] = allColumns[2 * simDim * r + d];
+                            rankColumnSize[d] = allColumns[2 * simDim * r + simDim + d];
+                        }
+                        DataSpace<simDim> partOffset;
+                        DataSpace<simDim> partSize;
+                        sendDispls[r] = sendBuffer.size();
+                        if (intersect(slabOffset, slabSize, rankColumnOffset, rankColumnSize, partOffset, partSize))
+                        {
+                            const int partElements = partSize.productOfComponents();
+                            for (int i = 0; i < partElements; ++i)
+                            {
+                                const DataSpace<simDim> slabIdx =
+                                    partOffset + DataSpaceOperations<simDim>::map(partSize, i) - slabOffset;
+                                sendBuffer.push_back(slab[DataSpaceOperations<simDim>::map(slabSize, slabIdx)]);
+                            }
+                            sendCounts[r] = partElements;
+                        }
+                    }
+                }
+
+                /* receive the parts of the own column from each aggregator */
+                std::vector<int> recvCounts(mpiSize, 0);
+                std::vector<int> recvDispls(mpiSize, 0);
+                std::vector<DataSpace<simDim> > recvOffsets(mpiSize);
+                std::vector<DataSpace<simDim> > recvSizes(mpiSize);
+                int recvElements = 0;
+                for (int a = 0; a < numUsedAggregators; ++a)
+                {
+                    const int r = a * aggregatorStride;
+                    DataSpace<simDim> aggregatorSlabOffset;
+                    DataSpace<simDim> aggregatorSlabSize;
+                    getSlab(a, numUsedAggregators, aggregatorSlabOffset, aggregatorSlabSize);
+                    recvDispls[r] = recvElements;
+                    if (intersect(aggregatorSlabOffset, aggregatorSlabSize, columnOffset, columnSize,
+                                  recvOffsets[r], recvSizes[r]))
+                    {
+                        recvCounts[r] = recvSizes[r].productOfComponents();
+                        recvElements += recvCounts[r];
+                    }
+                }
+                std::vector<ValueType> recvBuffer(recvElements + 1);
+
+                MPI_CHECK(MPI_Alltoallv(sendBuffer.empty() ? nullptr : &(sendBuffer.front()),
+                                        &(sendCounts.front()), &(sendDispls.front()), mpiValueType,
+                                        &(recvBuffer.front()),
+                                        &(recvCounts.front()), &(recvDispls.front()), mpiValueType,
+                                        comm));
+                MPI_CHECK(MPI_Type_free(&mpiValueType));
+
+                column.resize(columnSize.productOfComponents());
+                for (int r = 0; r < mpiSize; ++r)
+                {
+                    if (recvCounts[r] == 0)
+                        continue;
+                    const ValueType* part = &(recvBuffer.front()) + recvDispls[r];
+                    const int partElements = recvCounts[r];
+                    for (int i = 0; i < partElements; ++i)
+                    {
+                        const DataSpace<simDim> columnIdx =
+                            recvOffsets[r] + DataSpaceOperations<simDim>::map(recvSizes[r], i) - columnOffset;
+                        column[DataSpaceOperations<simDim>::map(columnSize, columnIdx)] = part[i];
+                    }
+                }
+                hasFileData = true;
+            }
+        }
+
+        if (pdc != nullptr)
+        {
+            if (isFileOpen)
+                pdc->close();
+            __delete(pdc);
+        }
+    }
+
+    /** load the column of this rank only
+     *
+     * Fallback if not all ranks initialize at the same time, e.g. at the first
+     * slide after a restart.
+     *
+     * @param filename, iteration, datasetName location of the density data
+     * @param info MPI info passed to libSplash
+     * @param neededOffset global offset of the column this rank needs [in cells]
+     * @param neededSize size of the column this rank needs [in cells]
+     */
+    void loadIndependent(
+        const std::string& filename,
+        const uint32_t iteration,
+        const std::string& datasetName,
+        MPI_Info info,
+        const DataSpace<simDim>& neededOffset,
+        const DataSpace<simDim>& neededSize
+    )
+    {
+        using namespace splash;
+        loaded = true;
+        hasFileData = false;
+
+        ParallelDomainCollector pdc(MPI_COMM_SELF, info, Dimensions(1, 1, 1), 1);
+        try
+        {
+            openFile(pdc, filename);
+
+            Domain fileDomain = pdc.getGlobalDomain(iteration, datasetName.c_str());
+            for (uint32_t d = 0; d < simDim; ++d)
+            {
+                fileOffset[d] = fileDomain.getOffset()[d];
+                fileSize[d] = fileDomain.getSize()[d];
+            }
+            setColumn(neededOffset, neededSize);
+
+            column.resize(columnSize.productOfComponents());
+            hasFileData = readBox(pdc, iteration, datasetName, columnOffset, columnSize, column);
+            pdc.close();
+        }
+        catch (const DCException& e)
+        {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    /** copy the cached data which overlaps a domain
+     *
+     * Cells of the domain outside of the file are not touched.
+     *
+     * @param dstBox host data box, origin is the first cell of the domain
+     * @param domainOffset global offset of the domain [in cells]
+     * @param domainSize size of the domain [in cells]
+     */
+    template<typename T_DataBox>
+    void copyTo(T_DataBox dstBox, const DataSpace<simDim>& domainOffset, const DataSpace<simDim>& domainSize) const
+    {
+        if (!hasFileData)
+            return;
+
+        /* domain in file index space */
+        DataSpace<simDim> partOffset;
+        DataSpace<simDim> partSize;
+        if (!intersect(domainOffset - fileOffset, domainSize, columnOffset, columnSize, partOffset, partSize))
+            return;
+
+        const int partElements = partSize.productOfComponents();
+        for (int i = 0; i < partElements; ++i)
+        {
+            const DataSpace<simDim> fileIdx = partOffset + DataSpaceOperations<simDim>::map(partSize, i);
+            dstBox(fileIdx + fileOffset - domainOffset).x() =
+                column[DataSpaceOperations<simDim>::map(columnSize, fileIdx - columnOffset)];
+        }
+    }
+
+private:
+
+    static void openFile(splash::ParallelDomainCollector& pdc, const std::string& filename)
+    {
+        splash::DataCollector::FileCreationAttr attr;
+        splash::DataCollector::initFileCreationAttr(attr);
+        attr.fileAccType = splash::DataCollector::FAT_READ;
+        pdc.open(filename.c_str(), attr);
+    }
+
+    /** read a box given in file index space
+     *
+     * @return true if the full box was read
+     */
+    static bool readBox(
+        splash::ParallelDomainCollector& pdc,
+        const uint32_t iteration,
+        const std::string& datasetName,
+        const DataSpace<simDim>& offset,
+        const DataSpace<simDim>& size,
+        std::vector<ValueType>& buffer
+    )
+    {
+        const size_t elements = size.productOfComponents();
+        if (elements == 0)
+            return true;
+
+        splash::Dimensions fileAccessSpace(1, 1, 1);
+        splash::Dimensions fileAccessOffset(0, 0, 0);
+        for (uint32_t d = 0; d < simDim; ++d)
+        {
+            fileAccessSpace[d] = size[d];
+            fileAccessOffset[d] = offset[d];
+        }
+
+        splash::Dimensions sizeRead(0, 0, 0);
+        pdc.read(iteration,
+                 fileAccessSpace,
+                 fileAccessOffset,
+                 datasetName.c_str(),
+                 sizeRead,
+                 &(buffer.front()));
+
+        return sizeRead.getScalarSize() == elements;
+    }
+
+    /** intersection of two boxes
+     *
+     * @return true if the intersection is not empty
+     */
+    static bool intersect(
+        const DataSpace<simDim>& offsetA, const DataSpace<simDim>& sizeA,
+        const DataSpace<simDim>& offsetB, const DataSpace<simDim>& sizeB,
+        DataSpace<simDim>& offset, DataSpace<simDim>& size
+    )
+    {
+        for (uint32_t d = 0; d < simDim; ++d)
+        {
+            offset[d] = std::max(offsetA[d], offsetB[d]);
+            const int end = std::min(offsetA[d] + sizeA[d], offsetB[d] + sizeB[d]);
+            size[d] = std::max(end - offset[d], 0);
+        }
+        return size.productOfComponents() > 0;
+    }
+
+    /** part of the needed column inside the file, in file index space */
+    void setColumn(const DataSpace<simDim>& neededOffset, const DataSpace<simDim>& neededSize)
+    {
+        if (!intersect(neededOffset - fileOffset, neededSize, DataSpace<simDim>::create(0), fileSize,
+                       columnOffset, columnSize))
+        {
+            columnOffset = DataSpace<simDim>::create(0);
+            columnSize = DataSpace<simDim>::create(0);
+        }
+    }
+
+    /** slab of an aggregator, split along the slowest varying dimension */
+    void getSlab(const int aggregatorIdx, const int numAggregators,
+                 DataSpace<simDim>& slabOffset, DataSpace<simDim>& slabSize) const
+    {
+        const uint32_t slowDim = simDim - 1;
+        const int64_t extent = fileSize[slowDim];
+        slabOffset = DataSpace<simDim>::create(0);
+        slabSize = fileSize;
+        slabOffset[slowDim] = extent * aggregatorIdx / numAggregators;
+        slabSize[slowDim] = extent * (aggregatorIdx + 1) / numAggregators - slabOffset[slowDim];
+    }
+
+    bool loaded;
+    bool hasFileData;
+    /** file domain [in global cells] */
+    DataSpace<simDim> fileOffset;
+    DataSpace<simDim> fileSize;
+    /** cached column in file index space */
+    DataSpace<simDim> columnOffset;
+    DataSpace<simDim> columnSize;
+    std::vector<ValueType> column;
+};
+
+} // namespace densityProfiles
+} // namespace picongpu
@@ -22,14 +22,12 @@
 #include "simulation_defines.hpp"
 #include "fields/Fields.hpp"
 #include "simulationControl/MovingWindow.hpp"
+#include "particles/densityProfiles/FromHDF5Cache.hpp"
 
 #include "static_assert.hpp"
 #include "memory/buffers/GridBuffer.hpp"
-#include "memory/boxes/DataBoxDim1Access.hpp"
 #include "dataManagement/DataConnector.hpp"
 
-#include <splash/splash.h>
-
 
 namespace picongpu
 {
@@ -49,13 +47,14 @@ struct FromHDF5Impl : public T_ParamClass
 
     HINLINE FromHDF5Impl(uint32_t currentStep)
     {
-        const uint32_t numSlides = MovingWindow::getInstance( ).getSlideCounter( currentStep );
+        const uint32_t slideDistance = MovingWindow::getInstance( ).getSlideDistance( currentStep );
+        /* all ranks initialize together only before the first slide */
+        const bool isCollective = MovingWindow::getInstance( ).getSlideCounter( currentStep ) == 0;
         auto window = MovingWindow::getInstance().getWindow(currentStep);
-        loadHDF5(window);
+        loadHDF5(window, isCollective);
         const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
-        DataSpace<simDim> localCells = subGrid.getLocalDomain( ).size;
         totalGpuOffset = subGrid.getLocalDomain( ).offset;
-        totalGpuOffset.y( ) += numSlides * localCells.y( );
+        totalGpuOffset.y( ) += slideDistance;
     }
 
     /** Calculate the normalized density from HDF5 file
@@ -70,9 +69,26 @@ struct FromHDF5Impl : public T_ParamClass
 
 private:
 
-    void loadHDF5(Window &window)
+    typedef FromHDF5Cache<typename FieldTmp::ValueType::type> Cache;
+
+    /** host cache of the density file, shared by all instances with the same parameters */
+    static Cache& getCache()
+    {
+        static Cache cache;
+        return cache;
+    }
+
+    /** fill FieldTmp with the density of the local domain
+     *
+     * The file is read only once per run. If all ranks initialize together,
+     * a few aggregator ranks read the file and scatter the data, otherwise
+     * (e.g. first slide after a restart) every rank reads its part alone.
+     *
+     * @param window current moving window
+     * @param isCollective true if all ranks call this method together
+     */
+    void loadHDF5(Window &window, const bool isCollective)
     {
-        using namespace splash;
         DataConnector &dc = Environment<>::get().DataConnector();
 
         PMACC_CASSERT_MSG(
@@ -86,154 +102,59 @@ private:
 
         GridController<simDim> &gc = Environment<simDim>::get().GridController();
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(0);
-        const uint32_t maxOpenFilesPerNode = 1;
+        const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(0);
 
-        /* get a new ParallelDomainCollector for our MPI rank only*/
-        ParallelDomainCollector pdc(
-                                    MPI_COMM_SELF,
-                                    gc.getCommunicator().getMPIInfo(),
-                                    Dimensions(1, 1, 1),
-                                    maxOpenFilesPerNode);
+        /* set which part of the density our MPI rank needs */
+        DataSpace<simDim> domainOffset(localDomain.offset);
+        domainOffset.y() += slideDistance;
 
-        try
+        Cache& cache = getCache();
+        if (!cache.isLoaded())
         {
-            /* setup ParallelDomainCollector pdc to read the density information from hdf5 */
-            DataCollector::FileCreationAttr attr;
-            DataCollector::initFileCreationAttr(attr);
-            attr.fileAccType = DataCollector::FAT_READ;
-
-            pdc.open(ParamClass::filename, attr);
-
-            /* set which part of the hdf5 file our MPI rank reads */
-            DataSpace<simDim> globalSlideOffset;
-            globalSlideOffset.y() = numSlides * localDomain.size.y();
-
-            Dimensions domainOffset(0, 0, 0);
-            for (uint32_t d = 0; d < simDim; ++d)
-                domainOffset[d] = localDomain.offset[d] + globalSlideOffset[d];
-
-            if (gc.getPosition().y() == 0)
-                domainOffset[1] += window.globalDimensions.offset.y();
-
-            DataSpace<simDim> localDomainSize = localDomain.size;
-            Dimensions domainSize(1, 1, 1);
-            for (uint32_t d = 0; d < simDim; ++d)
-                domainSize[d] = localDomainSize[d];
-
-            /* clear host buffer with default value */
-            fieldBuffer.getHostBuffer().setValue(float1_X(ParamClass::defaultDensity));
-
-            /* get dimensions and offsets (collective call) */
-            Domain fileDomain = pdc.getGlobalDomain(ParamClass::iteration, ParamClass::datasetName);
-            Dimensions fileDomainEnd = fileDomain.getOffset() + fileDomain.getSize();
-            DataSpace<simDim> accessSpace;
-            DataSpace<simDim> accessOffset;
-
-            Dimensions fileAccessSpace(1, 1, 1);
-            Dimensions fileAccessOffset(0, 0, 0);
-
-            /* For each dimension, compute how file domain and local simulation domain overlap
-             * and which sizes and offsets are required for loading data from the file.
-             **/
-            for (uint32_t d = 0; d < simDim; ++d)
+            /* The local domain only moves forward in y: it slides with the
+             * global domain or jumps to its end if the ranks are rotated.
+             * Cache from the current position up to the end the global domain
+             * can reach until the last step of this run.
+             */
+            DataSpace<simDim> neededSize(localDomain.size);
+            if (MovingWindow::getInstance().isSlidingWindowActive())
             {
-                /* file domain in/in-after sim domain */
-                if (fileDomain.getOffset()[d] >= domainOffset[d] &&
-                    fileDomain.getOffset()[d] <= domainOffset[d] + domainSize[d])
-                {
-                    accessSpace[d] = std::min(domainOffset[d] + domainSize[d] - fileDomain.getOffset()[d],
-                                              fileDomain.getSize()[d]);
-                    fileAccessSpace[d] = accessSpace[d];
-
-                    accessOffset[d] = fileDomain.getOffset()[d] - domainOffset[d];
-                    fileAccessOffset[d] = 0;
-                    continue;
-                }
-
-                /* file domain before-in sim domain */
-                if (fileDomainEnd[d] >= domainOffset[d] &&
-                    fileDomainEnd[d] <= domainOffset[d] + domainSize[d])
-                {
-                    accessSpace[d] = fileDomainEnd[d] - domainOffset[d];
-                    fileAccessSpace[d] = accessSpace[d];
-
-                    accessOffset[d] = 0;
-                    fileAccessOffset[d] = domainOffset[d] - fileDomain.getOffset()[d];
-                    continue;
-                }
-
-                /* sim domain in file domain */
-                if (domainOffset[d] >= fileDomain.getOffset()[d] &&
-                    domainOffset[d] + domainSize[d] <= fileDomainEnd[d])
-                {
-                    accessSpace[d] = domainSize[d];
-                    fileAccessSpace[d] = accessSpace[d];
-
-                    accessOffset[d] = 0;
-                    fileAccessOffset[d] = domainOffset[d] - fileDomain.getOffset()[d];
-                    continue;
-                }
-
-                /* file domain and sim domain do not intersect, do not load anything */
-                accessSpace[d] = 0;
-                break;
+                const uint32_t lastStep = Environment<>::get().SimulationDescription().getRunSteps();
+                neededSize.y() = MovingWindow::getInstance().getMaxGlobalDomainEnd(lastStep) - domainOffset.y();
             }
 
-            /* allocate temporary buffer for hdf5 data */
-            typedef typename FieldTmp::ValueType::type ValueType;
-            ValueType *tmpBfr = nullptr;
-
-            size_t accessSize = accessSpace.productOfComponents();
-            if (accessSize > 0)
-            {
-                tmpBfr = new ValueType[accessSize];
-
-                Dimensions sizeRead(0, 0, 0);
-                pdc.read(
-                         ParamClass::iteration,
-                         fileAccessSpace,
-                         fileAccessOffset,
-                         ParamClass::datasetName,
-                         sizeRead,
-                         tmpBfr);
-
-                if (sizeRead.getScalarSize() != accessSize)
-                {
-                    __delete(tmpBfr);
-                    return;
-                }
-
-                /* get the databox of the host buffer */
-                auto dataBox = fieldBuffer.getHostBuffer().getDataBox();
-                /* get a 1D access object to the databox */
-                typedef DataBoxDim1Access< typename FieldTmp::DataBoxType > D1Box;
-                DataSpace<simDim> guards = fieldBuffer.getGridLayout().getGuard();
-                D1Box d1RAccess(dataBox.shift(guards + accessOffset), accessSpace);
-
-                /* copy from temporary buffer to fieldTmp host buffer */
-                for (int i = 0; i < accessSpace.productOfComponents(); ++i)
-                {
-                    d1RAccess[i].x() = tmpBfr[i];
-                }
-
-                __delete(tmpBfr);
-            }
+            if (isCollective)
+                cache.loadCollective(
+                    ParamClass::filename,
+                    ParamClass::iteration,
+                    ParamClass::datasetName,
+                    gc.getCommunicator().getMPIComm(),
+                    gc.getCommunicator().getMPIInfo(),
+                    domainOffset,
+                    neededSize);
+            else
+                cache.loadIndependent(
+                    ParamClass::filename,
+                    ParamClass::iteration,
+                    ParamClass::datasetName,
+                    gc.getCommunicator().getMPIInfo(),
+                    domainOffset,
+                    neededSize);
+        }
 
-            pdc.close();
+        if (gc.getPosition().y() == 0)
+            domainOffset.y() += window.globalDimensions.offset.y();
 
-            /* copy host data to the device */
-            fieldBuffer.hostToDevice();
-            __getTransactionEvent().waitForFinished();
+        /* clear host buffer with default value */
+        fieldBuffer.getHostBuffer().setValue(float1_X(ParamClass::defaultDensity));
 
-        }
-        catch (const DCException& e)
-        {
-            std::cerr << e.what() << std::endl;
-            return;
-        }
+        /* copy the cached part of the file which overlaps the local domain */
+        DataSpace<simDim> guards = fieldBuffer.getGridLayout().getGuard();
+        cache.copyTo(fieldBuffer.getHostBuffer().getDataBox().shift(guards), domainOffset, localDomain.size);
 
-        return;
+        /* copy host data to the device */
+        fieldBuffer.hostToDevice();
+        __getTransactionEvent().waitForFinished();
     }
 
     PMACC_ALIGN(deviceDataBox,FieldTmp::DataBoxType);
@@ -54,6 +54,50 @@ namespace ionization
     template<bool T_linPol>
     struct AlgorithmADK
     {
+        /** ionization rate in atomic units
+         *
+         * \tparam T_Precision precision policy of exp, pow and sqrt
+         *
+         * \param eInAU absolute value of the electric field in atomic units
+         * \param iEnergy ionization energy in atomic units
+         * \param effectiveCharge charge that attracts the electron to be ionized
+         */
+        template< typename T_Precision >
+        HDINLINE static float_X
+        rate( float_X const eInAU, float_X const iEnergy, float_X const effectiveCharge )
+        {
+            float_X const pi = precisionCast< float_X >( M_PI );
+
+            /* effective principal quantum number (unitless) */
+            float_X const nEff = effectiveCharge / math::sqrt( float_X( 2.0 ) * iEnergy, T_Precision( ) );
+            /* nameless variable for convenience dFromADK*/
+            float_X const dBase = float_X( 4.0 ) * util::cube( effectiveCharge ) /
+                ( eInAU * util::quad( nEff ) ) ;
+            float_X const dFromADK = math::pow( dBase, nEff, T_Precision( ) );
+
+            /* ionization rate (for CIRCULAR polarization)*/
+            float_X rateADK = eInAU * util::square( dFromADK ) /
+                ( float_X( 8.0 ) * pi * effectiveCharge ) *
+                math::exp( float_X( -2.0 ) * util::cube( effectiveCharge ) /
+                           ( float_X( 3.0 ) * util::cube( nEff ) * eInAU ),
+                           T_Precision( )
+                );
+
+            /* in case of linear polarization the rate is modified by an additional factor */
+            if( T_linPol )
+            {
+                /* factor from averaging over one laser cycle with LINEAR polarization */
+                float_X const polarizationFactor = math::sqrt(
+                    float_X( 3.0 ) * util::cube( nEff ) * eInAU /
+                    ( pi * util::cube( effectiveCharge ) ),
+                    T_Precision( )
+                );
+
+                rateADK *= polarizationFactor;
+            }
+            return rateADK;
+        }
+
         /** Functor implementation
          * \tparam EType type of electric field
          * \tparam BType type of magnetic field
@@ -78,7 +122,6 @@ namespace ionization
                 uint32_t const cs = math::float2int_rd(chargeState);
                 float_X const iEnergy = GetIonizationEnergies<ParticleType>::type()[cs];
 
-                float_X const pi = precisionCast< float_X >( M_PI );
                 /* electric field in atomic units - only absolute value */
                 float_X const eInAU = math::abs( eField ) / ATOMIC_UNIT_EFIELD;
 
@@ -86,31 +129,7 @@ namespace ionization
                  * equals `protonNumber - #allInnerElectrons`
                  */
                 float_X const effectiveCharge = chargeState + float_X( 1.0 );
-                /* effective principal quantum number (unitless) */
-                float_X const nEff = effectiveCharge / math::sqrt( float_X( 2.0 ) * iEnergy );
-                /* nameless variable for convenience dFromADK*/
-                float_X const dBase = float_X( 4.0 ) * util::cube( effectiveCharge ) /
-                    ( eInAU * util::quad( nEff ) ) ;
-                float_X const dFromADK = math::pow( dBase, nEff );
-
-                /* ionization rate (for CIRCULAR polarization)*/
-                float_X rateADK = eInAU * util::square( dFromADK ) /
-                    ( float_X( 8.0 ) * pi * effectiveCharge ) *
-                    math::exp( float_X( -2.0 ) * util::cube( effectiveCharge ) /
-                               ( float_X( 3.0 ) * util::cube( nEff ) * eInAU )
-                    );
-
-                /* in case of linear polarization the rate is modified by an additional factor */
-                if( T_linPol )
-                {
-                    /* factor from averaging over one laser cycle with LINEAR polarization */
-                    float_X const polarizationFactor = math::sqrt(
-                        float_X( 3.0 ) * util::cube( nEff ) * eInAU /
-                        ( pi * util::cube( effectiveCharge ) )
-                    );
-
-                    rateADK *= polarizationFactor;
-                }
+                float_X const rateADK = rate< mathPrecision::Ionization >( eInAU, iEnergy, effectiveCharge );
 
                 /* simulation time step in atomic units */
                 float_X const timeStepAU = float_X( DELTA_T / ATOMIC_UNIT_TIME );
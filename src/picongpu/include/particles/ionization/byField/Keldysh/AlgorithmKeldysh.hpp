@@ -46,6 +46,29 @@ namespace ionization
      */
     struct AlgorithmKeldysh
     {
+        /** ionization rate in atomic units
+         *
+         * \tparam T_Precision precision policy of exp and sqrt
+         *
+         * \param eInAU absolute value of the electric field in atomic units
+         * \param iEnergy ionization energy in atomic units
+         */
+        template<typename T_Precision>
+        HDINLINE static float_X
+        rate(const float_X eInAU, const float_X iEnergy)
+        {
+            const float_X pi = precisionCast<float_X>(M_PI);
+
+            /* factor two avoid calculation math::pow(2,5./4.); */
+            const float_X twoToFiveQuarters = 2.3784142300054;
+
+            /* characteristic exponential function argument */
+            const float_X charExpArg = math::sqrt(util::cube(float_X(2.)*iEnergy), T_Precision())/eInAU;
+
+            return math::sqrt(float_X(6.)*pi, T_Precision()) / twoToFiveQuarters \
+                * iEnergy * math::sqrt(float_X(1.)/charExpArg, T_Precision()) \
+                * math::exp(-float_X(2./3.) * charExpArg, T_Precision());
+        }
 
         /** Functor implementation
          * \tparam EType type of electric field
@@ -71,20 +94,11 @@ namespace ionization
                 uint32_t cs = math::float2int_rd(chargeState);
                 const float_X iEnergy = GetIonizationEnergies<ParticleType>::type()[cs];
 
-                const float_X pi = precisionCast<float_X>(M_PI);
                 /* electric field in atomic units - only absolute value */
                 float_X eInAU = math::abs(eField) / ATOMIC_UNIT_EFIELD;
 
-                /* factor two avoid calculation math::pow(2,5./4.); */
-                const float_X twoToFiveQuarters = 2.3784142300054;
-
-                /* characteristic exponential function argument */
-                const float_X charExpArg = math::sqrt(util::cube(float_X(2.)*iEnergy))/eInAU;
-
                 /* ionization rate */
-                float_X rateKeldysh = math::sqrt(float_X(6.)*pi) / twoToFiveQuarters \
-                                * iEnergy * math::sqrt(float_X(1.)/charExpArg) \
-                                * math::exp(-float_X(2./3.) * charExpArg);
+                float_X rateKeldysh = rate<mathPrecision::Ionization>(eInAU, iEnergy);
 
                 /* simulation time step in atomic units */
                 const float_X timeStepAU = float_X(DELTA_T / ATOMIC_UNIT_TIME);
@@ -27,6 +27,7 @@
 #include "nvidia/rng/distributions/Normal_float.hpp"
 #include "mpi/SeedPerRank.hpp"
 #include "traits/GetUniqueTypeId.hpp"
+#include "simulationControl/RuntimeParameters.hpp"
 
 namespace picongpu
 {
@@ -91,7 +92,7 @@ struct TemperatureImpl : private T_ValueFunctor
                                               rng());
             const float_X macroWeighting = particle[weighting_];
 
-            const float_X energy = (ParamClass::temperature * UNITCONV_keV_to_Joule) / UNIT_ENERGY;
+            const float_X energy = (ParamClass::temperature * UNITCONV_keV_to_Joule) / UNIT_ENERGY * runtime::temperatureScale();
 
             // since energy is related to one particle,
             // and our units are normalized for macro particle quanities
@@ -58,11 +58,11 @@ struct RandomImpl
                POSITION_SEED;
         seed = seedPerRank(seed) ^ currentStep;
 
-        const uint32_t numSlides = MovingWindow::getInstance( ).getSlideCounter( currentStep );
+        const uint32_t slideDistance = MovingWindow::getInstance( ).getSlideDistance( currentStep );
         const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
         localCells = subGrid.getLocalDomain().size;
         totalGpuOffset = subGrid.getLocalDomain( ).offset;
-        totalGpuOffset.y( ) += numSlides * localCells.y( );
+        totalGpuOffset.y( ) += slideDistance;
     }
 
     DINLINE void init(const DataSpace<simDim>& totalCellOffset)
@@ -50,7 +50,7 @@
 namespace picongpu
 {
 
-ChargeConservation::ChargeConservation()
+inline ChargeConservation::ChargeConservation()
     : name("ChargeConservation: Print the maximum charge deviation between particles and div E to textfile 'chargeConservation.dat'"),
       prefix("chargeConservation"), filename("chargeConservation.dat"),
       cellDescription(nullptr)
@@ -58,16 +58,16 @@ ChargeConservation::ChargeConservation()
     Environment<>::get().PluginConnector().registerPlugin(this);
 }
 
-void ChargeConservation::pluginRegisterHelp(po::options_description& desc)
+inline void ChargeConservation::pluginRegisterHelp(po::options_description& desc)
 {
     desc.add_options()
         ((this->prefix + ".period").c_str(),
         po::value<uint32_t > (&this->notifyPeriod)->default_value(0), "enable plugin [for each n-th step]");
 }
 
-std::string ChargeConservation::pluginGetName() const {return this->name;}
+inline std::string ChargeConservation::pluginGetName() const {return this->name;}
 
-void ChargeConservation::pluginLoad()
+inline void ChargeConservation::pluginLoad()
 {
     if(this->notifyPeriod == 0u)
         return;
@@ -87,7 +87,7 @@ void ChargeConservation::pluginLoad()
     }
 }
 
-void ChargeConservation::restart(uint32_t restartStep, const std::string restartDirectory)
+inline void ChargeConservation::restart(uint32_t restartStep, const std::string restartDirectory)
 {
     if(this->notifyPeriod == 0u)
         return;
@@ -101,7 +101,7 @@ void ChargeConservation::restart(uint32_t restartStep, const std::string restart
                     restartDirectory );
 }
 
-void ChargeConservation::checkpoint(uint32_t currentStep, const std::string checkpointDirectory)
+inline void ChargeConservation::checkpoint(uint32_t currentStep, const std::string checkpointDirectory)
 {
     if(this->notifyPeriod == 0u)
         return;
@@ -115,7 +115,7 @@ void ChargeConservation::checkpoint(uint32_t currentStep, const std::string chec
                        checkpointDirectory );
 }
 
-void ChargeConservation::setMappingDescription(MappingDesc* cellDescription)
+inline void ChargeConservation::setMappingDescription(MappingDesc* cellDescription)
 {
     this->cellDescription = cellDescription;
 }
@@ -188,7 +188,7 @@ struct ComputeChargeDensity
 
 } // namespace detail
 
-void ChargeConservation::notify(uint32_t currentStep)
+inline void ChargeConservation::notify(uint32_t currentStep)
 {
     typedef SuperCellSize BlockDim;
 
@@ -24,15 +24,16 @@
 
 #include "fields/FieldB.hpp"
 #include "fields/FieldE.hpp"
+#include "fields/FieldJ.hpp"
 
 #include "plugins/ISimulationPlugin.hpp"
 
 #include "mpi/reduceMethods/Reduce.hpp"
 #include "mpi/MPIReduce.hpp"
 #include "nvidia/functors/Add.hpp"
+#include "nvidia/functors/Max.hpp"
 #include "nvidia/reduce/Reduce.hpp"
-#include "memory/boxes/DataBoxDim1Access.hpp"
-#include "memory/boxes/DataBoxUnaryTransform.hpp"
+#include "nvidia/reduce/MultiValue.hpp"
 #include "dataManagement/DataConnector.hpp"
 #include "dimensions/DataSpaceOperations.hpp"
 
@@ -52,25 +53,66 @@ namespace po = boost::program_options;
 namespace energyFields
 {
 
-template<typename T_Type>
-struct cast64Bit
+/** quantities reduced in one pass over the local domain
+ *
+ * slot 0-2: B_x^2, B_y^2, B_z^2
+ * slot 3-5: E_x^2, E_y^2, E_z^2
+ * slot 6: J * E
+ * slot 7: max |E|^2
+ */
+typedef nvidia::reduce::MultiValue<
+    float_64,
+    nvidia::reduce::Sum,
+    nvidia::reduce::Sum,
+    nvidia::reduce::Sum,
+    nvidia::reduce::Sum,
+    nvidia::reduce::Sum,
+    nvidia::reduce::Sum,
+    nvidia::reduce::Sum,
+    nvidia::reduce::Max
+> EnergyValue;
+
+/** one dimensional access to the reduced quantities of each cell
+ *
+ * The boxes must point to the first cell of CORE+BORDER.
+ */
+template<typename T_EBox, typename T_BBox, typename T_JBox>
+struct CellEnergyBox
 {
-    typedef typename TypeCast<float_64, T_Type>::result result;
+    typedef EnergyValue ValueType;
 
-    HDINLINE result operator()(const T_Type& value) const
+    PMACC_ALIGN(fieldE, T_EBox);
+    PMACC_ALIGN(fieldB, T_BBox);
+    PMACC_ALIGN(fieldJ, T_JBox);
+    PMACC_ALIGN(size, DataSpace<simDim>);
+
+    HINLINE CellEnergyBox(T_EBox fieldE, T_BBox fieldB, T_JBox fieldJ, DataSpace<simDim> size) :
+        fieldE(fieldE), fieldB(fieldB), fieldJ(fieldJ), size(size)
     {
-        return precisionCast<float_64>(value);
     }
-};
-
-template<typename T_Type>
-struct squareComponentWise
-{
-    typedef T_Type result;
 
-    HDINLINE result operator()(const T_Type& value) const
+    HDINLINE ValueType operator[](const int idx) const
     {
-        return value*value;
+        const DataSpace<simDim> cell(DataSpaceOperations<simDim>::map(size, idx));
+        const FieldE::ValueType e = fieldE(cell);
+        const FieldB::ValueType b = fieldB(cell);
+        const FieldJ::ValueType j = fieldJ(cell);
+
+        ValueType result;
+        float_64 jDotE = 0.0;
+        float_64 e2 = 0.0;
+        for (uint32_t d = 0; d < 3; ++d)
+        {
+            const float_64 e64 = float_64(e[d]);
+            const float_64 b64 = float_64(b[d]);
+            result[d] = b64 * b64;
+            result[3 + d] = e64 * e64;
+            jDotE += float_64(j[d]) * e64;
+            e2 += e64 * e64;
+        }
+        result[6] = jDotE;
+        result[7] = e2;
+        return result;
     }
 };
 
@@ -95,6 +137,9 @@ private:
 
     typedef promoteType<float_64, FieldB::ValueType>::type EneVectorType;
 
+    /* number of summed quantities of energyFields::EnergyValue */
+    static constexpr uint32_t numSums = 7;
+
 public:
 
     EnergyFields() :
@@ -142,7 +187,11 @@ private:
     {
         if (notifyFrequency > 0)
         {
-            localReduce = new nvidia::reduce::Reduce(1024);
+            /* the reduced type is large, scale buffer and shared memory to keep enough blocks busy */
+            localReduce = new nvidia::reduce::Reduce(
+                1024 * sizeof(energyFields::EnergyValue),
+                128 * sizeof(energyFields::EnergyValue)
+            );
             writeToFile = mpiReduce.hasResult(mpi::reduceMethods::Reduce());
 
             if (writeToFile)
@@ -154,7 +203,7 @@ private:
                     writeToFile = false;
                 }
                 //create header of the file
-                outFile << "#step total[Joule] Bx[Joule] By[Joule] Bz[Joule] Ex[Joule] Ey[Joule] Ez[Joule]" << " \n";
+                outFile << "#step total[Joule] Bx[Joule] By[Joule] Bz[Joule] Ex[Joule] Ey[Joule] Ez[Joule] JdotE[Watt] maxE[V/m]" << " \n";
             }
             Environment<>::get().PluginConnector().setNotificationPeriod(this, notifyFrequency);
         }
@@ -200,27 +249,31 @@ private:
 
     void getEnergyFields(uint32_t currentStep)
     {
-        DataConnector &dc = Environment<>::get().DataConnector();
+        const energyFields::EnergyValue localReduced = reduceFields();
 
-        auto fieldE = dc.get< FieldE >( FieldE::getName(), true );
-        auto fieldB = dc.get< FieldB >( FieldB::getName(), true );
+        float_64 localSums[numSums];
+        for (uint32_t i = 0; i < numSums; ++i)
+            localSums[i] = localReduced[i].get();
+        float_64 localMaxE2 = localReduced[numSums].get();
+
+        float_64 globalSums[numSums];
+        float_64 globalMaxE2 = 0.0;
+
+        mpiReduce(nvidia::functors::Add(),
+                  globalSums,
+                  localSums,
+                  numSums,
+                  mpi::reduceMethods::Reduce());
+        mpiReduce(nvidia::functors::Max(),
+                  &globalMaxE2,
+                  &localMaxE2,
+                  1,
+                  mpi::reduceMethods::Reduce());
 
         /* idx == 0 -> fieldB
          * idx == 1 -> fieldE
          */
         EneVectorType globalFieldEnergy[2];
-        globalFieldEnergy[0]=EneVectorType::create(0.0);
-        globalFieldEnergy[1]=EneVectorType::create(0.0);
-
-        EneVectorType localReducedFieldEnergy[2];
-        localReducedFieldEnergy[0] = reduceField(fieldB);
-        localReducedFieldEnergy[1] = reduceField(fieldE);
-
-        mpiReduce(nvidia::functors::Add(),
-                  &globalFieldEnergy,
-                  &localReducedFieldEnergy,
-                  2,
-                  mpi::reduceMethods::Reduce());
 
         float_64 energyFieldBReduced=0.0;
         float_64 energyFieldEReduced=0.0;
@@ -228,9 +281,9 @@ private:
         for(int d=0; d<FieldB::numComponents; ++d)
         {
             /* B field convert */
-            globalFieldEnergy[0][d] *= float_64(0.5 / MUE0 * CELL_VOLUME);
+            globalFieldEnergy[0][d] = globalSums[d] * float_64(0.5 / MUE0 * CELL_VOLUME);
             /* E field convert */
-            globalFieldEnergy[1][d] *= float_64(EPS0 * CELL_VOLUME * 0.5);
+            globalFieldEnergy[1][d] = globalSums[3 + d] * float_64(EPS0 * CELL_VOLUME * 0.5);
 
             /* add all to one */
             energyFieldBReduced+= globalFieldEnergy[0][d];
@@ -238,6 +291,9 @@ private:
         }
 
         float_64 globalEnergy = energyFieldEReduced + energyFieldBReduced;
+        /* power transferred from the fields to the particles */
+        float_64 globalJDotE = globalSums[6] * float_64(CELL_VOLUME);
+        float_64 globalMaxE = math::sqrt(globalMaxE2);
 
 
         if (writeToFile)
@@ -247,35 +303,49 @@ private:
             outFile.precision(dbl::digits10);
             outFile << currentStep << " " << std::scientific << globalEnergy * UNIT_ENERGY << " "
                     << (globalFieldEnergy[0] * UNIT_ENERGY).toString(" ","") << " "
-                    << (globalFieldEnergy[1] * UNIT_ENERGY).toString(" ","") << std::endl;
+                    << (globalFieldEnergy[1] * UNIT_ENERGY).toString(" ","") << " "
+                    << globalJDotE * UNIT_ENERGY / UNIT_TIME << " "
+                    << globalMaxE * UNIT_EFIELD << std::endl;
         }
     }
 
 private:
 
-    template<typename T_Field>
-    EneVectorType reduceField( std::shared_ptr< T_Field > field )
+    /** reduce all quantities of the local domain with a single reduce call */
+    energyFields::EnergyValue reduceFields()
     {
-        /*define stacked DataBox's for reduce algorithm*/
-        typedef DataBoxUnaryTransform<typename T_Field::DataBoxType, energyFields::squareComponentWise > TransformedBox;
-        typedef DataBoxUnaryTransform<TransformedBox, energyFields::cast64Bit > Box64bit;
-        typedef DataBoxDim1Access<Box64bit > D1Box;
+        DataConnector &dc = Environment<>::get().DataConnector();
 
-        /* reduce field E*/
-        DataSpace<simDim> fieldSize = field->getGridLayout().getDataSpaceWithoutGuarding();
-        DataSpace<simDim> fieldGuard = field->getGridLayout().getGuard();
+        auto fieldE = dc.get< FieldE >( FieldE::getName(), true );
+        auto fieldB = dc.get< FieldB >( FieldB::getName(), true );
+        auto fieldJ = dc.get< FieldJ >( FieldJ::getName(), true );
 
-        TransformedBox fieldTransform(field->getDeviceDataBox().shift(fieldGuard));
-        Box64bit field64bit(fieldTransform);
-        D1Box d1Access(field64bit, fieldSize);
+        DataSpace<simDim> fieldSize = fieldE->getGridLayout().getDataSpaceWithoutGuarding();
+        DataSpace<simDim> fieldGuard = fieldE->getGridLayout().getGuard();
 
-        EneVectorType fieldEnergyReduced = (*localReduce)(nvidia::functors::Add(),
-                                               d1Access,
-                                               fieldSize.productOfComponents());
+        typedef energyFields::CellEnergyBox<
+            FieldE::DataBoxType,
+            FieldB::DataBoxType,
+            FieldJ::DataBoxType
+        > D1Box;
 
-        return fieldEnergyReduced;
-    }
+        D1Box d1Access(
+            fieldE->getDeviceDataBox().shift(fieldGuard),
+            fieldB->getDeviceDataBox().shift(fieldGuard),
+            fieldJ->getDeviceDataBox().shift(fieldGuard),
+            fieldSize
+        );
 
+        energyFields::EnergyValue localReduced = (*localReduce)(nvidia::reduce::CombineMultiValue(),
+                                                                d1Access,
+                                                                fieldSize.productOfComponents());
+
+        dc.releaseData( FieldE::getName() );
+        dc.releaseData( FieldB::getName() );
+        dc.releaseData( FieldJ::getName() );
+
+        return localReduced;
+    }
 };
 
 } //namespace picongpu
@@ -35,6 +35,7 @@
 #include "memory/shared/Allocate.hpp"
 #include "memory/Array.hpp"
 #include "dataManagement/DataConnector.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 
 #include <string>
 #include <iostream>
@@ -244,15 +245,16 @@ private:
         float_32* integretedAllTmp = new float_32[yLocalSize * gpus];
         memset(integretedAll, 0, sizeof (float_32) *yGlobalSize);
 
+        const MPI_Comm simulationComm = mpi::CommunicatorSplit::get().getSimulationComm();
         MPI_CHECK(MPI_Gather(&yOffset, 1, MPI_INT, yOffsetsAll, 1,
-                             MPI_INT, 0, MPI_COMM_WORLD));
+                             MPI_INT, 0, simulationComm));
 
         MPI_CHECK(MPI_Gather(localMaxIntensity->getHostBuffer().getBasePointer(), yLocalSize, MPI_FLOAT,
                              maxAllTmp, yLocalSize, MPI_FLOAT,
-                             0, MPI_COMM_WORLD));
+                             0, simulationComm));
         MPI_CHECK(MPI_Gather(localIntegratedIntensity->getHostBuffer().getBasePointer(), yLocalSize, MPI_FLOAT,
                              integretedAllTmp, yLocalSize, MPI_FLOAT,
-                             0, MPI_COMM_WORLD));
+                             0, simulationComm));
 
         if (writeToFile)
         {
@@ -267,8 +269,8 @@ private:
                 }
             }
 
-            const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
-            size_t physicelYCellOffset = numSlides * yLocalSize + window.globalDimensions.offset.y();
+            const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(currentStep);
+            size_t physicelYCellOffset = slideDistance + window.globalDimensions.offset.y();
             writeFile(currentStep,
                       maxAll + window.globalDimensions.offset.y(),
                       window.globalDimensions.size.y(),
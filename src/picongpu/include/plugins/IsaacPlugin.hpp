@@ -25,6 +25,7 @@
 
 #include "plugins/ILightweightPlugin.hpp"
 #include "dataManagement/DataConnector.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 #include "static_assert.hpp"
 
 #include <isaac.hpp>
@@ -362,8 +363,9 @@ private:
             //using an internal variable "render_interval" as notifyPeroid
             //of PIConGPU cannot be changed at runtime
             notifyPeriod = 1;
-            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-            MPI_Comm_size(MPI_COMM_WORLD, &numProc);
+            const MPI_Comm simulationComm = mpi::CommunicatorSplit::get().getSimulationComm();
+            MPI_Comm_rank(simulationComm, &rank);
+            MPI_Comm_size(simulationComm, &numProc);
             if ( MovingWindow::getInstance().isSlidingWindowActive() )
                 movingWindow = true;
             float_X minCellSize = min( cellSize[0], min( cellSize[1], cellSize[2] ) );
@@ -406,7 +408,8 @@ private:
                 subGrid.getLocalDomain().size,
                 subGrid.getLocalDomain().offset,
                 sources,
-                cellSizeFactor
+                cellSizeFactor,
+                simulationComm
             );
             visualization->setJpegQuality(jpeg_quality);
             //Defining the later periodicly sent meta data
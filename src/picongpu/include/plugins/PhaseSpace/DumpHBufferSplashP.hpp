@@ -105,7 +105,7 @@ namespace picongpu
                 SuperCellSize().toRT()[axis_element.space] * GUARD_SIZE;
 
             /** calculate local and global size of the phase space ***********/
-            const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+            const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(currentStep);
             const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
             const int rLocalOffset = subGrid.getLocalDomain().offset[axis_element.space];
             const int rLocalSize = int(hBuffer.size().y() - 2*rGuardCells);
@@ -123,7 +123,7 @@ namespace picongpu
             int globalMovingWindowSize   = rGlobalSize;
             if( axis_element.space == AxisDescription::y ) /* spatial axis == y */
             {
-                globalPhaseSpace_offset.set( 0, numSlides * rLocalSize, 0 );
+                globalPhaseSpace_offset.set( 0, slideDistance, 0 );
                 Window window = MovingWindow::getInstance( ).getWindow( currentStep );
                 globalMovingWindowOffset = window.globalDimensions.offset[axis_element.space];
                 globalMovingWindowSize = window.globalDimensions.size[axis_element.space];
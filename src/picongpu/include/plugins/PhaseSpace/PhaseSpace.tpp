@@ -36,6 +36,7 @@
 #include "mappings/simulation/GridController.hpp"
 #include "mappings/simulation/SubGrid.hpp"
 #include "dataManagement/DataConnector.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 
 #include <vector>
 #include <algorithm>
@@ -126,12 +127,14 @@ namespace picongpu
             int myRootRank = gc.getGlobalRank() * this->isPlaneReduceRoot
                            - ( ! this->isPlaneReduceRoot );
 
+            /* staging ranks are not part of the grid */
+            const MPI_Comm simulationComm = mpi::CommunicatorSplit::get().getSimulationComm();
             MPI_Group world_group, new_group;
             MPI_CHECK(MPI_Allgather( &myRootRank, 1, MPI_INT,
                                      &(planeReduceRootRanks.front()),
                                      1,
                                      MPI_INT,
-                                     MPI_COMM_WORLD ));
+                                     simulationComm ));
 
             /* remove all non-roots (-1 values) */
             std::sort( planeReduceRootRanks.begin(), planeReduceRootRanks.end() );
@@ -140,9 +143,9 @@ namespace picongpu
                                                       0 ),
                                     planeReduceRootRanks.end() );
 
-            MPI_CHECK(MPI_Comm_group( MPI_COMM_WORLD, &world_group ));
+            MPI_CHECK(MPI_Comm_group( simulationComm, &world_group ));
             MPI_CHECK(MPI_Group_incl( world_group, ranks.size(), ranks.data(), &new_group ));
-            MPI_CHECK(MPI_Comm_create( MPI_COMM_WORLD, new_group, &commFileWriter ));
+            MPI_CHECK(MPI_Comm_create( simulationComm, new_group, &commFileWriter ));
             MPI_CHECK(MPI_Group_free( &new_group ));
             MPI_CHECK(MPI_Group_free( &world_group ));
         }
@@ -26,65 +26,17 @@
 #include "simulation_types.hpp"
 #include "assert.hpp"
 
-#include "plugins/CountParticles.hpp"
-#include "plugins/EnergyParticles.hpp"
-#include "plugins/EnergyFields.hpp"
-#include "plugins/SumCurrents.hpp"
-#include "plugins/PositionsParticles.hpp"
-#include "plugins/BinEnergyParticles.hpp"
-#include "plugins/ChargeConservation.hpp"
-#if(ENABLE_HDF5 == 1)
-#include "plugins/radiation/parameters.hpp"
-#include "plugins/radiation/Radiation.hpp"
-#include "plugins/particleCalorimeter/ParticleCalorimeter.hpp"
-#include "plugins/PhaseSpace/PhaseSpaceMulti.hpp"
-#endif
-
-#if (ENABLE_INSITU_VOLVIS == 1)
-#include "plugins/InSituVolumeRenderer.hpp"
-#endif
-
 #include "simulation_classTypes.hpp"
+#include "simulationControl/TranslationUnits.def"
 
 #include "mappings/kernel/MappingDescription.hpp"
+#include "algorithms/ForEach.hpp"
 
-#include "plugins/LiveViewPlugin.hpp"
 #include "plugins/ILightweightPlugin.hpp"
 #include "plugins/ISimulationPlugin.hpp"
 
-#include "plugins/output/images/PngCreator.hpp"
-
-
-// That's an abstract plugin for Png and Binary Density output
-// \todo rename PngPlugin to ImagePlugin or similar
-#include "plugins/PngPlugin.hpp"
-
-#if(SIMDIM==DIM3)
-#include "plugins/IntensityPlugin.hpp"
-#endif
-#include "plugins/SliceFieldPrinterMulti.hpp"
-
-#include "plugins/output/images/Visualisation.hpp"
-
 #include <list>
 
-#include "plugins/ISimulationPlugin.hpp"
-
-#if (ENABLE_HDF5 == 1)
-#include "plugins/hdf5/HDF5Writer.hpp"
-#include "plugins/makroParticleCounter/PerSuperCell.hpp"
-#endif
-
-#if (ENABLE_ADIOS == 1)
-#include "plugins/adios/ADIOSWriter.hpp"
-#endif
-
-#if (ENABLE_ISAAC == 1) && (SIMDIM==DIM3)
-#include "plugins/IsaacPlugin.hpp"
-#endif
-
-#include "plugins/ResourceLog.hpp"
-
 namespace picongpu
 {
 
@@ -99,110 +51,42 @@ private:
 
     std::list<ISimulationPlugin*> plugins;
 
-    template<typename T_Type>
-    struct PushBack
-    {
-
-        template<typename T>
-        void operator()(T& list)
-        {
-            list.push_back(new T_Type());
-        }
-    };
-
-    /** apply the 1st vector component to the 2nd
+    /** create the plugins of a species
      *
-     * @tparam T_TupleVector vector of type PMacc::math::CT::vector<dataType,plugin>
-     *                       with two components
+     * @tparam T_Species particle species
      */
-    template<typename T_TupleVector>
-    struct ApplyDataToPlugin :
-    bmpl::apply1<typename PMacc::math::CT::At<T_TupleVector, bmpl::int_<1> >::type,
-    typename PMacc::math::CT::At<T_TupleVector, bmpl::int_<0> >::type >
+    template<typename T_Species>
+    struct CreateSpeciesPlugins
     {
+        void operator()(std::list<ISimulationPlugin*>& list) const
+        {
+            translationUnits::createSpeciesPlugins<
+                translationUnits::GetSpeciesIdx<T_Species>::value
+            >(list);
+        }
     };
 
-    /* define stand alone plugins*/
-    typedef bmpl::vector<
-        EnergyFields,
-        SumCurrents,
-        ChargeConservation
-#if(SIMDIM==DIM3)
-      , IntensityPlugin
-#endif
-#if (ENABLE_INSITU_VOLVIS == 1)
-      , InSituVolumeRenderer
-#endif
-#if (ENABLE_ADIOS == 1)
-      , adios::ADIOSWriter
-#endif
-#if (ENABLE_HDF5 == 1)
-      , hdf5::HDF5Writer
-#endif
-#if (ENABLE_ISAAC == 1) && (SIMDIM==DIM3)
-      , isaacP::IsaacPlugin
-#endif
-    , ResourceLog
-    > StandAlonePlugins;
-
-
-    /* define field plugins */
-    typedef bmpl::vector<
-     SliceFieldPrinterMulti<bmpl::_1>
-    > UnspecializedFieldPlugins;
-
-    typedef bmpl::vector< FieldB, FieldE, FieldJ> AllFields;
-
-    typedef AllCombinations<
-      bmpl::vector<AllFields, UnspecializedFieldPlugins>
-    >::type CombinedUnspecializedFieldPlugins;
-
-    typedef bmpl::transform<
-    CombinedUnspecializedFieldPlugins,
-      ApplyDataToPlugin<bmpl::_1>
-    >::type FieldPlugins;
-
-
-    /* define species plugins */
-    typedef bmpl::vector <
-        CountParticles<bmpl::_1>,
-        EnergyParticles<bmpl::_1>,
-        BinEnergyParticles<bmpl::_1>,
-        LiveViewPlugin<bmpl::_1>,
-        PositionsParticles<bmpl::_1>,
-        PngPlugin< Visualisation<bmpl::_1, PngCreator> >
-#if(ENABLE_HDF5 == 1)
-      , Radiation<bmpl::_1>
-      , ParticleCalorimeter<bmpl::_1>
-      , PerSuperCell<bmpl::_1>
-      , PhaseSpaceMulti<particles::shapes::Counter::ChargeAssignment, bmpl::_1>
-#endif
-    > UnspecializedSpeciesPlugins;
-
-    typedef AllCombinations<
-        bmpl::vector<VectorAllSpecies, UnspecializedSpeciesPlugins>
-    >::type CombinedUnspecializedSpeciesPlugins;
-
-    typedef bmpl::transform<
-        CombinedUnspecializedSpeciesPlugins,
-        ApplyDataToPlugin<bmpl::_1>
-    >::type SpeciesPlugins;
-
-
-    /* create sequence with all plugins*/
-    typedef MakeSeq<
-        StandAlonePlugins,
-        FieldPlugins,
-        SpeciesPlugins
-    >::type AllPlugins;
-
     /**
      * Initialises the controller by adding all user plugins to its internal list.
+     *
+     * The plugins are created in their own translation units, see
+     * simulationControl/TranslationUnits.def
      */
     virtual void init()
     {
-        ForEach<AllPlugins, PushBack<bmpl::_1> > pushBack;
-        pushBack(forward(plugins));
+        /* each species translation unit instantiates a fixed number of species */
+        PMACC_CASSERT_MSG(
+            _please_increase_PIC_MAX_SPECIES_PER_TRANSLATION_UNIT,
+            bmpl::size<VectorAllSpecies>::type::value <=
+                PIC_SPECIES_TRANSLATION_UNITS * PIC_MAX_SPECIES_PER_TRANSLATION_UNIT
+        );
+
+        translationUnits::createStandAlonePlugins(plugins);
+        translationUnits::createIOPlugins(plugins);
+        translationUnits::createFieldPlugins(plugins);
+
+        ForEach<VectorAllSpecies, CreateSpeciesPlugins<bmpl::_1> > createSpeciesPlugins;
+        createSpeciesPlugins(forward(plugins));
     }
 
 public:
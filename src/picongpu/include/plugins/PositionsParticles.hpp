@@ -262,11 +262,10 @@ private:
         dc.releaseData( ParticlesType::FrameType::getName() );
         gParticle->deviceToHost();
 
-        DataSpace<simDim> localSize(cellDescription->getGridLayout().getDataSpaceWithoutGuarding());
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+        const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(currentStep);
 
         DataSpace<simDim> gpuPhyCellOffset(Environment<simDim>::get().SubGrid().getLocalDomain().offset);
-        gpuPhyCellOffset.y() += (localSize.y() * numSlides);
+        gpuPhyCellOffset.y() += slideDistance;
 
         gParticle->getHostBuffer().getDataBox()[0].globalCellOffset += gpuPhyCellOffset;
 
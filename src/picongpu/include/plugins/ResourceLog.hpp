@@ -24,6 +24,11 @@
 // PMacc
 #include "Environment.hpp"
 #include "mappings/simulation/ResourceMonitor.hpp"
+#include "mpi/MPIReduce.hpp"
+#include "mpi/reduceMethods/Reduce.hpp"
+#include "nvidia/functors/Min.hpp"
+#include "nvidia/functors/Max.hpp"
+#include "particles/memory/buffers/MallocMCBuffer.hpp"
 
 // PIConGPU
 #include "plugins/ILightweightPlugin.hpp"
@@ -43,6 +48,8 @@
 #include <sstream>   /* std::stringstream */
 #include <fstream>   /* std::filebuf */
 #include <map>       /* std::map */
+#include <vector>    /* std::vector */
+#include <utility>   /* std::pair */
 
 // C LIB
 #include <stdlib.h> /* itoa */
@@ -52,12 +59,31 @@ namespace picongpu
 {
     using namespace PMacc;
 
+namespace resourceLog
+{
+    /** collect the name and the number of particle slots per frame of a species */
+    template<typename T_Species>
+    struct GetSpeciesInfo
+    {
+        template<typename T_Names, typename T_Capacities>
+        void operator()(T_Names& names, T_Capacities& frameCapacities) const
+        {
+            using FrameType = typename T_Species::FrameType;
+            names.push_back(FrameType::getName());
+            frameCapacities.push_back(math::CT::volume<typename FrameType::SuperCellSize>::type::value);
+        }
+    };
+} // namespace resourceLog
 
     class ResourceLog : public ILightweightPlugin
     {
     private:
         MappingDesc *cellDescription;
         ResourceMonitor<simDim> resourceMonitor;
+        mpi::MPIReduce mpiReduce;
+
+        // numeric values of the current log entry, reduced over all ranks for `minMax`
+        std::vector<std::pair<std::string, double> > values;
 
         // programm options
         std::string outputFilePrefix;
@@ -119,6 +145,78 @@ namespace picongpu
                 pt.put("resourceLog.particleCount", std::accumulate(particleCounts.begin(), particleCounts.end(), 0));
             }
 
+            values.clear();
+
+            if(contains(propertyMap, "frameCount"))
+            {
+                std::vector<std::string> speciesNames;
+                std::vector<size_t> frameCapacities;
+                ForEach<VectorAllSpecies, resourceLog::GetSpeciesInfo<bmpl::_1> > getSpeciesInfo;
+                getSpeciesInfo(forward(speciesNames), forward(frameCapacities));
+
+                std::vector<size_t> frameCounts = resourceMonitor.getFrameCounts<VectorAllSpecies>(*cellDescription);
+                std::vector<size_t> particleCounts = resourceMonitor.getParticleCounts<VectorAllSpecies>(*cellDescription);
+                for(size_t i = 0; i < speciesNames.size(); ++i)
+                {
+                    const std::string key = std::string("species.") + speciesNames[i];
+                    // number of particles divided by the number of particle slots in all frames
+                    const double fillRatio = frameCounts[i] == 0 ? 0.0 :
+                        static_cast<double>(particleCounts[i]) / static_cast<double>(frameCounts[i] * frameCapacities[i]);
+                    putValue(pt, key + ".frames", frameCounts[i]);
+                    putValue(pt, key + ".fillRatio", fillRatio);
+                }
+            }
+
+            if(contains(propertyMap, "memory"))
+            {
+                nvidia::memory::MemoryInfo& memoryInfo = Environment<>::get().MemoryInfo();
+                size_t freeDeviceMemory = 0;
+                memoryInfo.getMemoryInfo(&freeDeviceMemory);
+                putValue(pt, "memory.freeDevice", freeDeviceMemory);
+
+                DataConnector &dc = Environment<>::get().DataConnector();
+                auto mallocMCBuffer = dc.get< MallocMCBuffer< DeviceHeap > >( MallocMCBuffer< DeviceHeap >::getName(), true );
+                std::shared_ptr< DeviceHeap > deviceHeap = mallocMCBuffer->getDeviceHeap();
+                putValue(pt, "memory.heap.size", deviceHeap->getHeapLocations()[0].size);
+                putValue(pt, "memory.heap.largestFreeBlock", getDeviceHeapLargestFreeBlock(*deviceHeap));
+                dc.releaseData( MallocMCBuffer< DeviceHeap >::getName() );
+
+                putValue(pt, "memory.buffers.device", memoryInfo.getBufferMemory(nvidia::memory::DEVICE_BUFFER_MEMORY));
+                putValue(pt, "memory.buffers.host", memoryInfo.getBufferMemory(nvidia::memory::HOST_BUFFER_MEMORY));
+                putValue(pt, "memory.buffers.deviceExchange", memoryInfo.getBufferMemory(nvidia::memory::DEVICE_EXCHANGE_MEMORY));
+                putValue(pt, "memory.buffers.hostExchange", memoryInfo.getBufferMemory(nvidia::memory::HOST_EXCHANGE_MEMORY));
+                putValue(pt, "memory.buffers.devicePeak", memoryInfo.getPeakBufferMemory(nvidia::memory::DEVICE_BUFFER_MEMORY));
+                putValue(pt, "memory.buffers.hostPeak", memoryInfo.getPeakBufferMemory(nvidia::memory::HOST_BUFFER_MEMORY));
+            }
+
+            if(contains(propertyMap, "communication"))
+            {
+                ICommunicator& comm = Environment<simDim>::get().EnvironmentController().getCommunicator();
+                putValue(pt, "communication.sentMessages", comm.getNumSentMessages());
+                putValue(pt, "communication.sentBytes", comm.getNumSentBytes());
+            }
+
+            if(contains(propertyMap, "minMax") && !values.empty())
+            {
+                // collective: all ranks log the same properties in the same step
+                std::vector<double> localValues(values.size());
+                for(size_t i = 0; i < values.size(); ++i)
+                    localValues[i] = values[i].second;
+                std::vector<double> minValues(values.size());
+                std::vector<double> maxValues(values.size());
+                mpiReduce(nvidia::functors::Min(), &minValues[0], &localValues[0], values.size(), mpi::reduceMethods::Reduce());
+                mpiReduce(nvidia::functors::Max(), &maxValues[0], &localValues[0], values.size(), mpi::reduceMethods::Reduce());
+
+                if(mpiReduce.hasResult(mpi::reduceMethods::Reduce()))
+                {
+                    for(size_t i = 0; i < values.size(); ++i)
+                    {
+                        pt.put("resourceLog.minMax." + values[i].first + ".min", minValues[i]);
+                        pt.put("resourceLog.minMax." + values[i].first + ".max", maxValues[i]);
+                    }
+                }
+            }
+
             //
             // Write property tree to string stream
             std::stringstream ss;
@@ -175,7 +273,13 @@ namespace picongpu
                     ("resourceLog.stream", po::value<std::string>(&streamType)->default_value("file"),
                      "Output stream [stdout, stderr, file]")
                     ("resourceLog.properties", po::value<std::vector<std::string> >(&properties)->multitoken(),
-                     "List of properties to log [rank, position, currentStep, cellCount, particleCount]")
+                     "List of properties to log [rank, position, currentStep, cellCount, particleCount, "
+                     "frameCount, memory, communication, minMax]\n"
+                     "  frameCount: frames and fill ratio (particles / frame slots) per species\n"
+                     "  memory: free device memory, particle heap, size of all buffers and exchanges\n"
+                     "  communication: number of MPI messages and bytes sent since the start\n"
+                     "  minMax: minimum and maximum over all ranks of frameCount, memory and communication "
+                     "(written by rank 0)")
                     ("resourceLog.format", po::value<std::string>(&outputFormat)->default_value("json"),
                      "Output format of log (pp for pretty print) [json, jsonpp, xml, xmlpp]");
         }
@@ -236,6 +340,14 @@ namespace picongpu
             return (map.find(value) != map.end());
         }
 
+        /** add a numeric value to the property tree and remember it for `minMax` */
+        template <typename T_Value>
+        void putValue(boost::property_tree::ptree& pt, std::string const key, T_Value const value)
+        {
+            pt.put(std::string("resourceLog.") + key, value);
+            values.push_back(std::make_pair(key, static_cast<double>(value)));
+        }
+
     };
 }
 
@@ -0,0 +1,140 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* only included by the species plugin translation units
+ * (translationUnits/speciesPlugins.cu.in)
+ */
+
+#include "simulation_defines.hpp"
+#include "simulationControl/TranslationUnits.def"
+
+#include "plugins/CountParticles.hpp"
+#include "plugins/EnergyParticles.hpp"
+#include "plugins/PositionsParticles.hpp"
+#include "plugins/BinEnergyParticles.hpp"
+#include "plugins/LiveViewPlugin.hpp"
+#include "plugins/staging/ParticleStaging.hpp"
+#if(ENABLE_HDF5 == 1)
+#include "plugins/radiation/parameters.hpp"
+#include "plugins/radiation/Radiation.hpp"
+#include "plugins/particleCalorimeter/ParticleCalorimeter.hpp"
+#include "plugins/PhaseSpace/PhaseSpaceMulti.hpp"
+#include "plugins/makroParticleCounter/PerSuperCell.hpp"
+#endif
+
+#include "plugins/output/images/PngCreator.hpp"
+// That's an abstract plugin for Png and Binary Density output
+// \todo rename PngPlugin to ImagePlugin or similar
+#include "plugins/PngPlugin.hpp"
+#include "plugins/output/images/Visualisation.hpp"
+
+#include "fields/Fields.tpp"
+
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/mpl/transform.hpp>
+#include <boost/mpl/apply.hpp>
+
+
+namespace picongpu
+{
+namespace translationUnits
+{
+namespace detail
+{
+    /** create the plugins of a species
+     *
+     * The default implementation is used for indices beyond the number of
+     * species, the translation units instantiate a fixed number of indices.
+     *
+     * @tparam T_speciesIdx index of the species in VectorAllSpecies
+     * @tparam T_isSpecies true if T_speciesIdx is a valid index
+     */
+    template<
+        uint32_t T_speciesIdx,
+        bool T_isSpecies = ( T_speciesIdx < bmpl::size< VectorAllSpecies >::type::value )
+    >
+    struct SpeciesPlugins
+    {
+        static void create( std::list< ISimulationPlugin* >& )
+        {
+        }
+    };
+
+    template< uint32_t T_speciesIdx >
+    struct SpeciesPlugins<
+        T_speciesIdx,
+        true
+    >
+    {
+        using SpeciesType = typename bmpl::at_c<
+            VectorAllSpecies,
+            T_speciesIdx
+        >::type;
+
+        /* define species plugins */
+        typedef bmpl::vector <
+            CountParticles<bmpl::_1>,
+            EnergyParticles<bmpl::_1>,
+            BinEnergyParticles<bmpl::_1>,
+            LiveViewPlugin<bmpl::_1>,
+            PositionsParticles<bmpl::_1>,
+            PngPlugin< Visualisation<bmpl::_1, PngCreator> >,
+            staging::ParticleStaging<bmpl::_1>
+#if(ENABLE_HDF5 == 1)
+          , Radiation<bmpl::_1>
+          , ParticleCalorimeter<bmpl::_1>
+          , PerSuperCell<bmpl::_1>
+          , PhaseSpaceMulti<particles::shapes::Counter::ChargeAssignment, bmpl::_1>
+#endif
+        > UnspecializedSpeciesPlugins;
+
+        /** specialize an unspecialized plugin for SpeciesType */
+        template< typename T_UnspecializedPlugin >
+        struct ApplySpecies : bmpl::apply1<
+            T_UnspecializedPlugin,
+            SpeciesType
+        >
+        {
+        };
+
+        typedef typename bmpl::transform<
+            UnspecializedSpeciesPlugins,
+            ApplySpecies< bmpl::_1 >
+        >::type Plugins;
+
+        static void create( std::list< ISimulationPlugin* >& plugins )
+        {
+            ForEach< Plugins, CreatePlugin< bmpl::_1 > > createPlugins;
+            createPlugins( forward( plugins ) );
+        }
+    };
+
+} // namespace detail
+
+    template< uint32_t T_speciesIdx >
+    void createSpeciesPlugins( std::list< ISimulationPlugin* >& plugins )
+    {
+        detail::SpeciesPlugins< T_speciesIdx >::create( plugins );
+    }
+
+} // namespace translationUnits
+} // namespace picongpu
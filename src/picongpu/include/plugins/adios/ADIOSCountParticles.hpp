@@ -103,13 +103,23 @@ public:
         /* load particle without copy particle data to host */
         auto speciesTmp = dc.get< ThisSpecies >( ThisSpecies::FrameType::getName(), true );
 
+        /* the same filter is used to count and to copy the particles */
+        openPMD::OutputParticleFilter filter;
+        params->regionOfInterest.initFilter(
+            filter,
+            params->localWindowToDomainOffset,
+            params->window.localDimensions.size,
+            params->isCheckpoint
+        );
+
         /* count total number of particles on the device */
         uint64_cu totalNumParticles = 0;
-        totalNumParticles = PMacc::CountParticles::countOnDevice < CORE + BORDER > (
-                                                                                    *speciesTmp,
-                                                                                    *(params->cellDescription),
-                                                                                    params->localWindowToDomainOffset,
-                                                                                    params->window.localDimensions.size);
+        /* ranks outside of the region of interest have nothing to write */
+        if( params->window.localDimensions.size.productOfComponents() != 0 )
+            totalNumParticles = PMacc::CountParticles::countOnDevice < CORE + BORDER > (
+                                                                                        *speciesTmp,
+                                                                                        *(params->cellDescription),
+                                                                                        filter);
 
         /* MPI_Allgather to compute global size and my offset */
         uint64_t myNumParticles = totalNumParticles;
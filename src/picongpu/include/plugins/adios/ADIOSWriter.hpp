@@ -42,8 +42,6 @@
 #include "pluginSystem/PluginConnector.hpp"
 #include "simulationControl/MovingWindow.hpp"
 #include "math/Vector.hpp"
-#include "particles/memory/buffers/MallocMCBuffer.hpp"
-#include "traits/Limits.hpp"
 
 #include "plugins/ILightweightPlugin.hpp"
 
@@ -67,12 +65,15 @@
 #include <boost/mpl/find.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/type_traits.hpp>
+#include <boost/thread.hpp>
 
 #if !defined(_WIN32)
 #include <unistd.h>
 #endif
 
 #include <pthread.h>
+#include <cmath>
+#include <exception>
 #include <sstream>
 #include <string>
 #include <list>
@@ -170,16 +171,14 @@ private:
 #ifndef __CUDA_ARCH__
             DataConnector &dc = Environment<simDim>::get().DataConnector();
 
-            auto field = dc.get< T >( T::getName() );
+            /* the components are gathered on the device, no host copy needed */
+            auto field = dc.get< T >( T::getName(), true );
             params->gridLayout = field->getGridLayout();
 
-            PICToAdios<ComponentType> adiosType;
             ADIOSWriter::template writeField<ComponentType>(params,
-                       sizeof(ComponentType),
-                       adiosType.type,
                        GetNComponents<ValueType>::value,
                        T::getName(),
-                       field->getHostDataBox().getPointer());
+                       field->getDeviceDataBox());
 
             dc.releaseData( T::getName() );
 #endif
@@ -246,22 +245,17 @@ private:
 
             EventTask fieldTmpEvent = fieldTmp->asyncCommunication(__getTransactionEvent());
             __setTransactionEvent(fieldTmpEvent);
-            /* copy data to host that we can write same to disk*/
-            fieldTmp->getGridBuffer().deviceToHost();
             dc.releaseData(Species::FrameType::getName());
             /*## finish update field ##*/
 
             const uint32_t components = GetNComponents<ValueType>::value;
-            PICToAdios<ComponentType> adiosType;
 
             params->gridLayout = fieldTmp->getGridLayout();
             /*write data to ADIOS file*/
             ADIOSWriter::template writeField<ComponentType>(params,
-                       sizeof(ComponentType),
-                       adiosType.type,
                        components,
                        getName(),
-                       fieldTmp->getHostDataBox().getPointer());
+                       fieldTmp->getDeviceDataBox());
 
             dc.releaseData( FieldTmp::getUniqueId( 0 ) );
 
@@ -370,8 +364,8 @@ private:
          */
         DataSpace<simDim> globalSlideOffset;
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(params->currentStep);
-        globalSlideOffset.y() += numSlides * localDomain.size.y();
+        const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(params->currentStep);
+        globalSlideOffset.y() += slideDistance;
 
         // globalDimensions is {x, y, z} but fields are F[z][y][x]
         std::vector<float_64> gridGlobalOffset(simDim, 0.0);
@@ -531,8 +525,14 @@ public:
     /* select MPI method, #OSTs and #aggregators */
     mpiTransportParams(""),
     notifyPeriod(0),
-    lastSpeciesSyncStep(PMacc::traits::limits::Max<uint32_t>::value)
+    isAdiosInitialized(false)
     {
+        mThreadParams.fieldComponentBuffer = nullptr;
+        mThreadParams.particleHostBuffer = nullptr;
+        mThreadParams.particleHostBufferSize = 0;
+        mThreadParams.adiosAsyncClose = false;
+        mThreadParams.adiosBufferSize = 0;
+        mThreadParams.adiosGroupDeclared = false;
         Environment<>::get().PluginConnector().registerPlugin(this);
     }
 
@@ -557,6 +557,14 @@ public:
             ("adios.compression", po::value<std::string >
              (&mThreadParams.adiosCompression)->default_value("none"),
              "ADIOS compression method, e.g., zlib (see `adios_config -m` for help)")
+            ("adios.persistent", po::bool_switch (&mThreadParams.adiosPersistent)->default_value(false)
+             ->notifier(&requestThreadMultiple),
+             "Keep ADIOS, its group and all host buffers alive between outputs and close output files "
+             "in a background thread (requires MPI_THREAD_MULTIPLE, else files are closed synchronously)")
+            ("adios.buffer-headroom", po::value<float_64 >
+             (&mThreadParams.adiosBufferHeadroom)->default_value(0.2),
+             "Relative headroom of the ADIOS buffer in persistent mode, the buffer is only enlarged "
+             "if an output does not fit")
             ("adios.file", po::value<std::string > (&filename)->default_value(filename),
              "ADIOS output file")
             ("adios.checkpoint-file", po::value<std::string > (&checkpointFilename),
@@ -568,6 +576,8 @@ public:
              **/
             ("adios.restart-chunkSize", po::value<uint32_t > (&restartChunkSize)->default_value(50000),
              "Number of particles processed in one kernel call during restart to prevent frame count blowup");
+
+        mThreadParams.regionOfInterest.registerHelp(desc, "adios");
     }
 
     std::string pluginGetName() const
@@ -702,8 +712,7 @@ public:
          * \warning enabling the moving window from a checkpoint that
          *          had no moving window will not work
          */
-        GridController<simDim> &gc = Environment<simDim>::get().GridController();
-        gc.setStateAfterSlides(slides);
+        MovingWindow::getInstance().setDomainStateAfterSlides(slides);
 
         /* set window for restart, complete global domain */
         mThreadParams.window = MovingWindow::getInstance().getDomainAsWindow(restartStep);
@@ -738,13 +747,27 @@ public:
 
 private:
 
+    /** closing files in a background thread needs MPI_THREAD_MULTIPLE
+     *
+     * Called while the command line is parsed, before MPI is initialized.
+     * Without persistent mode the default thread level is kept.
+     */
+    static void requestThreadMultiple(bool isPersistent)
+    {
+        if (isPersistent)
+            Environment<>::get().requestMpiThreadLevel(MPI_THREAD_MULTIPLE);
+    }
+
     void endAdios()
     {
+        /* in persistent mode the library is finalized in pluginUnload */
+        if (mThreadParams.adiosPersistent)
+            return;
+
         /* Finalize adios library */
         ADIOS_CMD(adios_finalize(Environment<simDim>::get().GridController()
                 .getCommunicator().getRank()));
-
-        __deleteArray(mThreadParams.fieldBfr);
+        isAdiosInitialized = false;
     }
 
     void beginAdios(const std::string adiosFilename)
@@ -755,13 +778,69 @@ private:
         mThreadParams.fullFilename = full_filename.str();
         mThreadParams.adiosFileHandle = ADIOS_INVALID_HANDLE;
 
-        mThreadParams.fieldBfr = new float_X[mThreadParams.window.localDimensions.size.productOfComponents()];
-
         std::stringstream adiosPathBase;
         adiosPathBase << ADIOS_PATH_ROOT << mThreadParams.currentStep << "/";
         mThreadParams.adiosBasePath = adiosPathBase.str();
 
-        ADIOS_CMD(adios_init_noxml(mThreadParams.adiosComm));
+        if (!isAdiosInitialized)
+        {
+            ADIOS_CMD(adios_init_noxml(mThreadParams.adiosComm));
+            isAdiosInitialized = true;
+        }
+    }
+
+    /** close the output file of the current step
+     *
+     * Outside of persistent mode and for checkpoints the file is closed
+     * synchronously. Otherwise the aggregation and the file write of
+     * `adios_close` run in a background thread, all data was already copied
+     * to the ADIOS buffer by `adios_write`.
+     */
+    void closeAdios()
+    {
+        log<picLog::INPUT_OUTPUT > ("ADIOS: closing file: %1%") % mThreadParams.fullFilename;
+
+        if (mThreadParams.adiosAsyncClose && !mThreadParams.isCheckpoint)
+        {
+            closeThread = boost::thread(&ADIOSWriter::closeInBackground, this, mThreadParams.adiosFileHandle);
+            return;
+        }
+
+        /* close adios file, most likely the actual write point */
+        ADIOS_CMD(adios_close(mThreadParams.adiosFileHandle));
+
+        /* avoid deadlock between not finished PMacc tasks and MPI_Barrier */
+        __getTransactionEvent().waitForFinished();
+        /*\todo: copied from adios example, we might not need this ? */
+        MPI_CHECK(MPI_Barrier(mThreadParams.adiosComm));
+    }
+
+    /** body of the background thread, must not call PMacc */
+    void closeInBackground(const int64_t fileHandle)
+    {
+        try
+        {
+            ADIOS_CMD(adios_close(fileHandle));
+        }
+        catch (...)
+        {
+            closeError = std::current_exception();
+        }
+    }
+
+    /** wait until the last file is closed, ADIOS is not thread-safe */
+    void waitForClose()
+    {
+        if (!closeThread.joinable())
+            return;
+
+        closeThread.join();
+        if (closeError)
+        {
+            std::exception_ptr error = closeError;
+            closeError = std::exception_ptr();
+            std::rethrow_exception(error);
+        }
     }
 
     /**
@@ -772,7 +851,8 @@ private:
      */
     void notificationReceived(uint32_t currentStep, bool isCheckpoint)
     {
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
+        waitForClose();
+
         mThreadParams.isCheckpoint = isCheckpoint;
         mThreadParams.currentStep = currentStep;
         mThreadParams.cellDescription = this->cellDescription;
@@ -797,43 +877,38 @@ private:
         if( isCheckpoint )
             mThreadParams.window = MovingWindow::getInstance().getDomainAsWindow(currentStep);
         else
-            mThreadParams.window = MovingWindow::getInstance().getWindow(currentStep);
-
-        for (uint32_t i = 0; i < simDim; ++i)
         {
-            mThreadParams.localWindowToDomainOffset[i] = 0;
-            if (mThreadParams.window.globalDimensions.offset[i] > localDomain.offset[i])
-            {
-                mThreadParams.localWindowToDomainOffset[i] =
-                    mThreadParams.window.globalDimensions.offset[i] -
-                    localDomain.offset[i];
-            }
+            mThreadParams.window = MovingWindow::getInstance().getWindow(currentStep);
+            /* restrict the window to the region of interest (if any) */
+            mThreadParams.window = mThreadParams.regionOfInterest.restrict(mThreadParams.window, currentStep);
         }
 
-
-        /* copy species only one time per timestep to the host */
-        if( lastSpeciesSyncStep != currentStep )
-        {
-            DataConnector &dc = Environment<>::get().DataConnector();
-
-            /* synchronizes the MallocMCBuffer to the host side */
-            dc.get< MallocMCBuffer< DeviceHeap > >( MallocMCBuffer< DeviceHeap >::getName() );
-
-            /* here we are copying all species to the host side since we
-             * can not say at this point if this time step will need all of them
-             * for sure (checkpoint) or just some user-defined species (dump)
-             */
-            ForEach<FileCheckpointParticles, CopySpeciesToHost<bmpl::_1> > copySpeciesToHost;
-            copySpeciesToHost();
-            lastSpeciesSyncStep = currentStep;
-            dc.releaseData(MallocMCBuffer<DeviceHeap>::getName());
-        }
+        mThreadParams.localWindowToDomainOffset =
+            openPMD::RegionOfInterest::getLocalWindowToDomainOffset(mThreadParams.window);
 
         beginAdios(mThreadParams.adiosFilename);
 
         writeAdios((void*) &mThreadParams, mpiTransportParams);
 
+        closeAdios();
+
         endAdios();
+
+        /* host buffers are only kept in persistent mode */
+        if (!mThreadParams.adiosPersistent)
+        {
+            freeParticleHostBuffer();
+            std::vector<char>().swap(mThreadParams.particleAttributeBuffer);
+        }
+    }
+
+    /** free the mapped memory used to gather particles */
+    void freeParticleHostBuffer()
+    {
+        if (mThreadParams.particleHostBuffer != nullptr)
+            CUDA_CHECK(cudaFreeHost(mThreadParams.particleHostBuffer));
+        mThreadParams.particleHostBuffer = nullptr;
+        mThreadParams.particleHostBufferSize = 0;
     }
 
     void pluginLoad()
@@ -878,16 +953,41 @@ private:
 
         mpiTransportParams = strMPITransportParams.str();
 
+        if (mThreadParams.adiosPersistent)
+        {
+            /* the group is reused, its definitions are deleted after each output */
+#if ( ( ADIOS_VERSION_MAJOR * 100 + ADIOS_VERSION_MINOR ) < 111 )
+            throw std::runtime_error("ADIOS: --adios.persistent requires ADIOS 1.11.0 or newer");
+#endif
+            /* the simulation continues with MPI calls while a file is closed */
+            int providedThreadLevel = MPI_THREAD_SINGLE;
+            MPI_CHECK(MPI_Query_thread(&providedThreadLevel));
+            mThreadParams.adiosAsyncClose = providedThreadLevel >= MPI_THREAD_MULTIPLE;
+            if (!mThreadParams.adiosAsyncClose)
+                log<picLog::INPUT_OUTPUT > ("ADIOS: MPI_THREAD_MULTIPLE is not provided, files are closed synchronously");
+        }
+
         if( restartFilename.empty() )
         {
             restartFilename = checkpointFilename;
         }
 
+        mThreadParams.regionOfInterest.load("adios");
+
         loaded = true;
     }
 
     void pluginUnload()
     {
+        waitForClose();
+
+        if (isAdiosInitialized)
+        {
+            ADIOS_CMD(adios_finalize(Environment<simDim>::get().GridController()
+                    .getCommunicator().getRank()));
+            isAdiosInitialized = false;
+        }
+
         if (notifyPeriod > 0)
         {
             if (mThreadParams.adiosComm != MPI_COMM_NULL)
@@ -895,59 +995,43 @@ private:
                 MPI_CHECK(MPI_Comm_free(&(mThreadParams.adiosComm)));
             }
         }
+
+        __delete(mThreadParams.fieldComponentBuffer);
+        freeParticleHostBuffer();
     }
 
-    template<typename ComponentType>
-    static void writeField(ThreadParams *params, const uint32_t sizePtrType,
-                           ADIOS_DATATYPES adiosType,
+    /** write all components of a field
+     *
+     * Each component of the local window is gathered on the device into a
+     * pinned contiguous buffer which is passed directly to ADIOS.
+     *
+     * @param deviceBox device data box of the field (including guards)
+     */
+    template<typename ComponentType, typename T_DeviceBox>
+    static void writeField(ThreadParams *params,
                            const uint32_t nComponents, const std::string name,
-                           void *ptr)
+                           const T_DeviceBox& deviceBox)
     {
-        log<picLog::INPUT_OUTPUT > ("ADIOS: write field: %1% %2% %3%") %
-            name % nComponents % ptr;
+        log<picLog::INPUT_OUTPUT > ("ADIOS: write field: %1% %2%") %
+            name % nComponents;
 
         const bool fieldTypeCorrect( boost::is_same<ComponentType, float_X>::value );
         PMACC_CASSERT_MSG(Precision_mismatch_in_Field_Components__ADIOS,fieldTypeCorrect);
 
         /* data to describe source buffer */
         GridLayout<simDim> field_layout = params->gridLayout;
-        DataSpace<simDim> field_full = field_layout.getDataSpace();
         DataSpace<simDim> field_no_guard = params->window.localDimensions.size;
         DataSpace<simDim> field_guard = field_layout.getGuard() + params->localWindowToDomainOffset;
 
+        if (params->fieldComponentBuffer == nullptr)
+            params->fieldComponentBuffer = new openPMD::FieldComponentBuffer<float_X>(
+                Environment<simDim>::get().SubGrid().getLocalDomain().size);
+
         /* write the actual field data */
         for (uint32_t d = 0; d < nComponents; d++)
         {
-            const size_t plane_full_size = field_full[1] * field_full[0] * nComponents;
-            const size_t plane_no_guard_size = field_no_guard[1] * field_no_guard[0];
-
-            /* copy strided data from source to temporary buffer
-             *
-             * \todo use d1Access as in `include/plugins/hdf5/writer/Field.hpp`
-             */
-            const int maxZ = simDim == DIM3 ? field_no_guard[2] : 1;
-            const int guardZ = simDim == DIM3 ? field_guard[2] : 0;
-            for (int z = 0; z < maxZ; ++z)
-            {
-                for (int y = 0; y < field_no_guard[1]; ++y)
-                {
-                    const size_t base_index_src =
-                                (z + guardZ) * plane_full_size +
-                                (y + field_guard[1]) * field_full[0] * nComponents;
-
-                    const size_t base_index_dst =
-                                z * plane_no_guard_size +
-                                y * field_no_guard[0];
-
-                    for (int x = 0; x < field_no_guard[0]; ++x)
-                    {
-                        size_t index_src = base_index_src + (x + field_guard[0]) * nComponents + d;
-                        size_t index_dst = base_index_dst + x;
-
-                        params->fieldBfr[index_dst] = ((float_X*)ptr)[index_src];
-                    }
-                }
-            }
+            float_X* componentData =
+                params->fieldComponentBuffer->extract(deviceBox, field_guard, field_no_guard, d);
 
             /* Write the actual field data. The id is on the front of the list. */
             if (params->adiosFieldVarIds.empty())
@@ -955,7 +1039,7 @@ private:
 
             int64_t adiosFieldVarId = *(params->adiosFieldVarIds.begin());
             params->adiosFieldVarIds.pop_front();
-            ADIOS_CMD(adios_write_byid(params->adiosFileHandle, adiosFieldVarId, params->fieldBfr));
+            ADIOS_CMD(adios_write_byid(params->adiosFileHandle, adiosFieldVarId, componentData));
         }
     }
 
@@ -981,29 +1065,40 @@ private:
         ADIOS_FLAG noStatistics = adios_flag_no;
 #endif
 
-        /* create adios group for fields without statistics */
-        ADIOS_CMD(adios_declare_group(&(threadParams->adiosGroupHandle),
-                ADIOS_GROUP_NAME,
-                (threadParams->adiosBasePath + std::string("iteration")).c_str(),
-                noStatistics));
-
-        /* select MPI method, #OSTs and #aggregators */
-        ADIOS_CMD(adios_select_method(threadParams->adiosGroupHandle,
-                  "MPI_AGGREGATE", mpiTransportParams.c_str(), ""));
-
-        threadParams->fieldsOffsetDims = precisionCast<uint64_t>(localDomain.offset);
+        if (!threadParams->adiosGroupDeclared)
+        {
+            /* create adios group for fields without statistics
+             * (a persistent group is used for many steps and has no time index)
+             */
+            const std::string timeIndex( threadParams->adiosPersistent ?
+                std::string("") : threadParams->adiosBasePath + std::string("iteration") );
+            ADIOS_CMD(adios_declare_group(&(threadParams->adiosGroupHandle),
+                    ADIOS_GROUP_NAME,
+                    timeIndex.c_str(),
+                    noStatistics));
+
+            /* select MPI method, #OSTs and #aggregators */
+            ADIOS_CMD(adios_select_method(threadParams->adiosGroupHandle,
+                      "MPI_AGGREGATE", mpiTransportParams.c_str(), ""));
+
+            threadParams->adiosGroupDeclared = threadParams->adiosPersistent;
+        }
+#if ( ( ADIOS_VERSION_MAJOR * 100 + ADIOS_VERSION_MINOR ) >= 111 )
+        else
+        {
+            /* all names contain the step, remove the definitions of the last output */
+            ADIOS_CMD(adios_delete_vardefs(threadParams->adiosGroupHandle));
+            ADIOS_CMD(adios_delete_attrdefs(threadParams->adiosGroupHandle));
+        }
+#endif
 
-        /* write created variable values */
+        /* write created variable values
+         * the offset is the offset of the local window inside the global
+         * window, the global window might be a region of interest
+         */
         for (uint32_t d = 0; d < simDim; ++d)
         {
-            /* dimension 1 is y and is the direction of the moving window (if any) */
-            if (1 == d)
-            {
-                uint64_t offset = std::max(0, localDomain.offset.y() -
-                                              threadParams->window.globalDimensions.offset.y());
-                threadParams->fieldsOffsetDims[d] = offset;
-            }
-
+            threadParams->fieldsOffsetDims[d] = threadParams->window.localDimensions.offset[d];
             threadParams->fieldsSizeDims[d] = threadParams->window.localDimensions.size[d];
             threadParams->fieldsGlobalSizeDims[d] = threadParams->window.globalDimensions.size[d];
         }
@@ -1054,7 +1149,21 @@ private:
         size_t writeBuffer_in_MiB=1+threadParams->adiosGroupSize / 1024 / 1024;
         /* value `1.1` is the secure factor if we miss to count some small buffers*/
         size_t buffer_mem=static_cast<size_t>(1.1 * static_cast<float_64>(writeBuffer_in_MiB));
-        adios_set_max_buffer_size(buffer_mem);
+        if (threadParams->adiosPersistent)
+        {
+            /* keep the reserved size as long as the output fits, the headroom
+             * absorbs the fluctuation of the particle numbers between outputs
+             */
+            if (buffer_mem > threadParams->adiosBufferSize)
+            {
+                threadParams->adiosBufferSize = static_cast<size_t>(std::ceil(
+                    static_cast<float_64>(buffer_mem) * (1.0 + threadParams->adiosBufferHeadroom)));
+                log<picLog::INPUT_OUTPUT > ("ADIOS: reserve buffer of %1% MiB") % threadParams->adiosBufferSize;
+                adios_set_max_buffer_size(threadParams->adiosBufferSize);
+            }
+        }
+        else
+            adios_set_max_buffer_size(buffer_mem);
         threadParams->adiosBufferInitialized = true;
 
         /* open adios file. all variables need to be defined at this point */
@@ -1110,15 +1219,7 @@ private:
         writeIdProviderStartId(*threadParams, idProviderState.startId);
         writeIdProviderNextId(*threadParams, idProviderState.nextId);
 
-        /* close adios file, most likely the actual write point */
-        log<picLog::INPUT_OUTPUT > ("ADIOS: closing file: %1%") % threadParams->fullFilename;
-        ADIOS_CMD(adios_close(threadParams->adiosFileHandle));
-
-        /* avoid deadlock between not finished PMacc tasks and MPI_Barrier */
-        __getTransactionEvent().waitForFinished();
-        /*\todo: copied from adios example, we might not need this ? */
-        MPI_CHECK(MPI_Barrier(threadParams->adiosComm));
-
+        /* the file is closed by the caller */
         return nullptr;
     }
 
@@ -1137,7 +1238,13 @@ private:
     std::string mpiTransportParams;
 
     uint32_t restartChunkSize;
-    uint32_t lastSpeciesSyncStep;
+
+    /* set between adios_init_noxml and adios_finalize */
+    bool isAdiosInitialized;
+    /* runs adios_close of the last output in persistent mode */
+    boost::thread closeThread;
+    /* error of the background adios_close, rethrown by waitForClose */
+    std::exception_ptr closeError;
 
     DataSpace<simDim> mpi_pos;
     DataSpace<simDim> mpi_size;
@@ -27,6 +27,7 @@
 #include "plugins/ISimulationPlugin.hpp"
 
 #include "plugins/output/WriteSpeciesCommon.hpp"
+#include "plugins/kernel/CopySpecies.kernel"
 #include "plugins/adios/writer/ParticleAttribute.hpp"
 
 #include "compileTime/conversion/MakeSeq.hpp"
@@ -34,10 +35,8 @@
 #include "dataManagement/DataConnector.hpp"
 #include "mappings/kernel/AreaMapping.hpp"
 #include "particles/ParticleDescription.hpp"
-#include "particles/operations/ConcatListOfFrames.hpp"
 #include "particles/particleFilter/FilterFactory.hpp"
 #include "particles/particleFilter/PositionFilter.hpp"
-#include "particles/memory/buffers/MallocMCBuffer.hpp"
 
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/pair.hpp>
@@ -56,7 +55,56 @@ namespace adios
 {
 using namespace PMacc;
 
+/** alignment of each attribute inside the host memory of a species */
+constexpr size_t hostMemoryAlignment = 16u;
+
+/** number of bytes of an attribute inside the host memory of a species
+ *
+ * @tparam T_Attribute particle attribute identifier
+ */
+template<typename T_Attribute>
+struct HostMemorySize
+{
+    HINLINE void operator()(size_t& numBytes, const size_t numParticles) const
+    {
+        typedef typename PMacc::traits::Resolve<T_Attribute>::type::type type;
+
+        const size_t size = sizeof(type) * numParticles;
+        numBytes += (size + hostMemoryAlignment - 1u) / hostMemoryAlignment * hostMemoryAlignment;
+    }
+};
+
+/** point an attribute of a frame to the memory of a species
+ *
+ * The same layout is used for the host and the device pointers of the
+ * mapped memory.
+ *
+ * @tparam T_Attribute particle attribute identifier
+ */
+template<typename T_Attribute>
+struct AssignHostMemory
+{
+    template<typename FrameType>
+    HINLINE void operator()(FrameType& frame, char*& memory, const size_t numParticles) const
+    {
+        typedef typename PMacc::traits::Resolve<T_Attribute>::type::type type;
+
+        type* ptr = nullptr;
+        if (numParticles != 0)
+        {
+            ptr = reinterpret_cast<type*>(memory);
+            size_t numBytes = 0;
+            HostMemorySize<T_Attribute>()(numBytes, numParticles);
+            memory += numBytes;
+        }
+        frame.getIdentifier(T_Attribute()) = VectorDataBox<type>(ptr);
+    }
+};
+
 /** Write copy particle to host memory and dump to ADIOS file
+ *
+ * Only the particles of this species are gathered on the device into mapped
+ * host memory, the frame lists are never copied to the host.
  *
  * @tparam T_Species type of species
  *
@@ -96,63 +144,77 @@ public:
         /* load particle without copy particle data to host */
         auto speciesTmp = dc.get< ThisSpecies >( ThisSpecies::FrameType::getName(), true );
 
+        /* the same filter is used to count and to copy the particles */
+        openPMD::OutputParticleFilter filter;
+        params->regionOfInterest.initFilter(
+            filter,
+            params->localWindowToDomainOffset,
+            params->window.localDimensions.size,
+            params->isCheckpoint
+        );
+
         /* count total number of particles on the device */
         log<picLog::INPUT_OUTPUT > ("ADIOS:   (begin) count particles: %1%") % AdiosFrameType::getName();
         uint64_cu totalNumParticles = 0;
-        totalNumParticles = PMacc::CountParticles::countOnDevice < CORE + BORDER > (
-                                                                                    *speciesTmp,
-                                                                                    *(params->cellDescription),
-                                                                                    params->localWindowToDomainOffset,
-                                                                                    params->window.localDimensions.size);
+        /* ranks outside of the region of interest have nothing to write */
+        if( params->window.localDimensions.size.productOfComponents() != 0 )
+            totalNumParticles = PMacc::CountParticles::countOnDevice < CORE + BORDER > (
+                                                                                        *speciesTmp,
+                                                                                        *(params->cellDescription),
+                                                                                        filter);
         log<picLog::INPUT_OUTPUT > ("ADIOS:   ( end ) count particles: %1% = %2%") % AdiosFrameType::getName() % totalNumParticles;
 
         AdiosFrameType hostFrame;
 
-        /* malloc host memory */
-        log<picLog::INPUT_OUTPUT > ("ADIOS:   (begin) malloc host memory: %1%") % AdiosFrameType::getName();
-        ForEach<typename AdiosFrameType::ValueTypeSeq, MallocHostMemory<bmpl::_1> > mallocMem;
-        mallocMem(forward(hostFrame), totalNumParticles);
-        log<picLog::INPUT_OUTPUT > ("ADIOS:   ( end ) malloc host memory: %1%") % AdiosFrameType::getName();
+        /* all attributes share one mapped host buffer which is reused by the
+         * following species and, in persistent mode, by the following outputs
+         */
+        log<picLog::INPUT_OUTPUT > ("ADIOS:   (begin) assign mapped memory: %1%") % AdiosFrameType::getName();
+        size_t hostMemorySize = 0;
+        ForEach<typename AdiosFrameType::ValueTypeSeq, HostMemorySize<bmpl::_1> > getHostMemorySize;
+        getHostMemorySize(forward(hostMemorySize), totalNumParticles);
+        if (params->particleHostBufferSize < hostMemorySize)
+        {
+            if (params->particleHostBuffer != nullptr)
+                CUDA_CHECK(cudaFreeHost(params->particleHostBuffer));
+            params->particleHostBuffer = nullptr;
+            params->particleHostBufferSize = 0;
+            CUDA_CHECK(cudaHostAlloc(&(params->particleHostBuffer), hostMemorySize, cudaHostAllocMapped));
+            params->particleHostBufferSize = hostMemorySize;
+        }
+
+        char* hostMemory = params->particleHostBuffer;
+        ForEach<typename AdiosFrameType::ValueTypeSeq, AssignHostMemory<bmpl::_1> > assignHostMemory;
+        assignHostMemory(forward(hostFrame), forward(hostMemory), totalNumParticles);
+        log<picLog::INPUT_OUTPUT > ("ADIOS:   ( end ) assign mapped memory: %1%") % AdiosFrameType::getName();
 
         if (totalNumParticles > 0)
         {
-            log<picLog::INPUT_OUTPUT > ("ADIOS:   (begin) copy particle host (with hierarchy) to host (without hierarchy): %1%") % AdiosFrameType::getName();
-            typedef bmpl::vector< typename GetPositionFilter<simDim>::type > usedFilters;
-            typedef typename FilterFactory<usedFilters>::FilterType MyParticleFilter;
-            MyParticleFilter filter;
-            /* activate filter pipeline if moving window is activated */
-            filter.setStatus(MovingWindow::getInstance().isSlidingWindowActive());
-            filter.setWindowPosition(params->localWindowToDomainOffset,
-                                     params->window.localDimensions.size);
-
-            DataConnector &dc = Environment<>::get().DataConnector();
-            auto mallocMCBuffer = dc.get< MallocMCBuffer< DeviceHeap > >( MallocMCBuffer< DeviceHeap >::getName(), true );
-
-            int globalParticleOffset = 0;
+            /* load device pointer of mapped memory */
+            char* deviceMemory = nullptr;
+            CUDA_CHECK(cudaHostGetDevicePointer(&deviceMemory, params->particleHostBuffer, 0));
+            AdiosFrameType deviceFrame;
+            assignHostMemory(forward(deviceFrame), forward(deviceMemory), totalNumParticles);
+
+            log<picLog::INPUT_OUTPUT > ("ADIOS:   (begin) copy particle to host: %1%") % AdiosFrameType::getName();
             AreaMapping < CORE + BORDER, MappingDesc > mapper(*(params->cellDescription));
 
-            PMacc::particles::operations::ConcatListOfFrames<simDim> concatListOfFrames(mapper.getGridDim());
-
-            concatListOfFrames(
-                                globalParticleOffset,
-                                hostFrame,
-                                speciesTmp->getHostParticlesBox( mallocMCBuffer->getOffset() ),
-                                filter,
-                                particleOffset, /*relative to data domain (not to physical domain)*/
-                                totalCellIdx_,
-                                mapper
-                                );
-            dc.releaseData( MallocMCBuffer< DeviceHeap >::getName() );
+            const uint64_t numCopiedParticles = copySpecies(
+                deviceFrame, speciesTmp->getDeviceParticlesBox(),
+                filter,
+                particleOffset, /*relative to data domain (not to physical domain)*/
+                totalCellIdx_,
+                mapper
+            );
+            log<picLog::INPUT_OUTPUT > ("ADIOS:   ( end ) copy particle to host: %1%") % AdiosFrameType::getName();
+
             /* this costs a little bit of time but adios writing is slower */
-            PMACC_ASSERT((uint64_cu) globalParticleOffset == totalNumParticles);
+            PMACC_ASSERT((uint64_cu) numCopiedParticles == totalNumParticles);
         }
         /* dump to adios file */
         ForEach<typename AdiosFrameType::ValueTypeSeq, adios::ParticleAttribute<bmpl::_1> > writeToAdios;
         writeToAdios(params, forward(hostFrame), totalNumParticles);
 
-        /* free host memory */
-        ForEach<typename AdiosFrameType::ValueTypeSeq, FreeHostMemory<bmpl::_1> > freeMem;
-        freeMem(forward(hostFrame));
         log<picLog::INPUT_OUTPUT > ("ADIOS: ( end ) writing species: %1%") % AdiosFrameType::getName();
 
         /* write species counter table to adios file */
@@ -152,24 +152,32 @@ public:
             (long long unsigned) totalNumParticles % (long long unsigned) particleOffset;
 
         AdiosFrameType hostFrame;
-        log<picLog::INPUT_OUTPUT > ("ADIOS: malloc mapped memory: %1%") % AdiosFrameType::getName();
-        /*malloc mapped memory*/
-        ForEach<typename AdiosFrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
-        mallocMem(forward(hostFrame), totalNumParticles);
-
-        log<picLog::INPUT_OUTPUT > ("ADIOS: get mapped memory device pointer: %1%") % AdiosFrameType::getName();
-        /*load device pointer of mapped memory*/
-        AdiosFrameType deviceFrame;
-        ForEach<typename AdiosFrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
-        getDevicePtr(forward(deviceFrame), forward(hostFrame));
+        log<picLog::INPUT_OUTPUT > ("ADIOS: malloc host memory: %1%") % AdiosFrameType::getName();
+        /* only read on the host, the ordered copy is mapped */
+        ForEach<typename AdiosFrameType::ValueTypeSeq, MallocHostMemory<bmpl::_1> > mallocHostMem;
+        mallocHostMem(forward(hostFrame), totalNumParticles);
 
         ForEach<typename AdiosFrameType::ValueTypeSeq, LoadParticleAttributesFromADIOS<bmpl::_1> > loadAttributes;
         loadAttributes(forward(params), forward(hostFrame), particlePath, particleOffset, totalNumParticles);
 
         if (totalNumParticles != 0)
         {
+            log<picLog::INPUT_OUTPUT > ("ADIOS: malloc mapped memory: %1%") % AdiosFrameType::getName();
+            /*malloc mapped memory for the particles ordered by supercell*/
+            AdiosFrameType orderedHostFrame;
+            ForEach<typename AdiosFrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
+            mallocMem(forward(orderedHostFrame), totalNumParticles);
+
+            log<picLog::INPUT_OUTPUT > ("ADIOS: get mapped memory device pointer: %1%") % AdiosFrameType::getName();
+            /*load device pointer of mapped memory*/
+            AdiosFrameType deviceFrame;
+            ForEach<typename AdiosFrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
+            getDevicePtr(forward(deviceFrame), forward(orderedHostFrame));
+
             PMacc::particles::operations::splitIntoListOfFrames(
                 *speciesTmp,
+                hostFrame,
+                orderedHostFrame,
                 deviceFrame,
                 totalNumParticles,
                 restartChunkSize,
@@ -181,7 +189,9 @@ public:
 
             /*free host memory*/
             ForEach<typename AdiosFrameType::ValueTypeSeq, FreeMemory<bmpl::_1> > freeMem;
-            freeMem(forward(hostFrame));
+            freeMem(forward(orderedHostFrame));
+            ForEach<typename AdiosFrameType::ValueTypeSeq, FreeHostMemory<bmpl::_1> > freeHostMem;
+            freeHostMem(forward(hostFrame));
         }
         log<picLog::INPUT_OUTPUT > ("ADIOS: ( end ) load species: %1%") % AdiosFrameType::getName();
     }
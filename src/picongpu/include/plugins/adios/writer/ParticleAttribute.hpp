@@ -60,10 +60,11 @@ struct ParticleAttribute
 
         log<picLog::INPUT_OUTPUT > ("ADIOS:  (begin) write species attribute: %1%") % Identifier::getName();
 
-        ComponentType* tmpBfr = nullptr;
-
-        if (elements > 0)
-            tmpBfr = new ComponentType[elements];
+        /* the buffer is kept in the thread params and only grows */
+        std::vector<char>& buffer = params->particleAttributeBuffer;
+        if (buffer.size() < elements * sizeof(ComponentType))
+            buffer.resize(elements * sizeof(ComponentType));
+        ComponentType* tmpBfr = reinterpret_cast<ComponentType*>(buffer.data());
 
         for (uint32_t d = 0; d < components; d++)
         {
@@ -82,8 +83,6 @@ struct ParticleAttribute
             ADIOS_CMD(adios_write_byid(params->adiosFileHandle, adiosAttributeVarId, tmpBfr));
         }
 
-        __deleteArray(tmpBfr);
-
         log<picLog::INPUT_OUTPUT > ("ADIOS:  ( end ) write species attribute: %1%") %
             Identifier::getName();
     }
@@ -0,0 +1,133 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "dimensions/DataSpaceOperations.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+
+namespace picongpu
+{
+namespace openPMD
+{
+using namespace PMacc;
+
+    /** number of threads per block to extract a field component */
+    constexpr int fieldComponentBlockSize = 256;
+
+    /** copy one component of a region of a field into a contiguous buffer
+     *
+     * The destination is ordered like a dataset on disk, x is the fastest
+     * varying index. Consecutive threads read consecutive cells in x.
+     */
+    struct KernelExtractFieldComponent
+    {
+        /** @param srcBox data box of the field, shifted to the begin of the region
+         *  @param dstBox one dimensional box of the destination buffer
+         *  @param size size of the region
+         *  @param component index of the component to extract
+         */
+        template< typename T_SrcBox, typename T_DstBox >
+        DINLINE void operator()(
+            T_SrcBox srcBox,
+            T_DstBox dstBox,
+            const DataSpace< simDim > size,
+            const uint32_t component
+        ) const
+        {
+            const int linearIdx = blockIdx.x * blockDim.x + threadIdx.x;
+            if( linearIdx >= size.productOfComponents() )
+                return;
+
+            const DataSpace< simDim > cellIdx = DataSpaceOperations< simDim >::map( size, linearIdx );
+            dstBox[ linearIdx ] = srcBox( cellIdx )[ component ];
+        }
+    };
+
+    /** pinned host buffer holding a single component of a field region
+     *
+     * Field output writes each component of the local window as its own
+     * dataset. Instead of copying the whole field including the guards to the
+     * host and de-interleaving the components there, the region of one
+     * component is gathered on the device into a contiguous buffer and only
+     * this buffer is copied into pinned host memory. The host pointer can be
+     * passed to the file writer as hyperslab without further copies.
+     *
+     * @tparam T_ComponentType type of a single component
+     */
+    template< typename T_ComponentType >
+    class FieldComponentBuffer
+    {
+    public:
+
+        /** @param maxSize largest region which will be extracted, e.g. the local domain */
+        FieldComponentBuffer( const DataSpace< simDim >& maxSize ) :
+            buffer( DataSpace< DIM1 >( maxSize.productOfComponents() ) )
+        {
+        }
+
+        /** gather one component of a field region on the device and copy it to the host
+         *
+         * @param deviceBox device data box of the full field (including guards)
+         * @param offset offset of the region in \p deviceBox, e.g. the guard size
+         * @param size size of the region
+         * @param component index of the component to extract
+         * @return pointer to pinned host memory with `size.productOfComponents()` elements
+         */
+        template< typename T_DeviceBox >
+        T_ComponentType* extract(
+            const T_DeviceBox& deviceBox,
+            const DataSpace< simDim >& offset,
+            const DataSpace< simDim >& size,
+            const uint32_t component
+        )
+        {
+            const int numElements = size.productOfComponents();
+            PMACC_ASSERT( size_t( numElements ) <= buffer.getGridLayout().getDataSpace().productOfComponents() );
+
+            if( numElements != 0 )
+            {
+                const int gridSize = ( numElements + fieldComponentBlockSize - 1 ) / fieldComponentBlockSize;
+                PMACC_KERNEL( KernelExtractFieldComponent{} )
+                    ( gridSize, fieldComponentBlockSize )
+                    (
+                        deviceBox.shift( offset ),
+                        buffer.getDeviceBuffer().getDataBox(),
+                        size,
+                        component
+                    );
+                /* copy only the extracted region to the host */
+                buffer.getDeviceBuffer().setCurrentSize( numElements );
+                buffer.getHostBuffer().copyFrom( buffer.getDeviceBuffer() );
+                __getTransactionEvent().waitForFinished();
+            }
+
+            return buffer.getHostBuffer().getBasePointer();
+        }
+
+    private:
+
+        GridBuffer< T_ComponentType, DIM1 > buffer;
+    };
+
+} // namespace openPMD
+} // namespace picongpu
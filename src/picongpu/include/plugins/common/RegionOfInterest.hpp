@@ -0,0 +1,293 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "algorithms/KinEnergy.hpp"
+#include "simulationControl/MovingWindow.hpp"
+#include "simulationControl/Window.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "particles/frame_types.hpp"
+#include "particles/memory/frames/NullFrame.hpp"
+#include "particles/particleFilter/FilterFactory.hpp"
+#include "particles/particleFilter/PositionFilter.hpp"
+
+#include <boost/program_options.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace picongpu
+{
+namespace openPMD
+{
+using namespace PMacc;
+
+namespace po = boost::program_options;
+
+    /** particle filter on the kinetic energy of a single real particle
+     *
+     * Must be used within a FilterFactory (can not be the last filter of the chain).
+     * The filter is disabled until setEnergyRange() is called.
+     */
+    template< class Base = NullFrame >
+    class EnergyFilter : public Base
+    {
+    protected:
+        float_X minEnergy;
+        float_X maxEnergy;
+        bool energyFilterActive;
+
+    public:
+
+        HDINLINE EnergyFilter() :
+            minEnergy( 0.0 ), maxEnergy( 0.0 ), energyFilterActive( false )
+        {
+        }
+
+        /** accept only particles with minEnergy <= energy < maxEnergy
+         *
+         * @param minEnergy lower limit in PIConGPU units
+         * @param maxEnergy upper limit in PIConGPU units
+         */
+        HDINLINE void setEnergyRange( const float_X minEnergy, const float_X maxEnergy )
+        {
+            this->minEnergy = minEnergy;
+            this->maxEnergy = maxEnergy;
+            energyFilterActive = true;
+        }
+
+        template< class FRAME >
+        HDINLINE bool operator()( FRAME & frame, lcellId_t id )
+        {
+            bool result = true;
+            if( energyFilterActive )
+            {
+                auto particle = frame[ id ];
+                const float_X weighting = particle[ weighting_ ];
+                const float_X mass = attribute::getMass( weighting, particle );
+                const float_X energy = KinEnergy<>()( particle[ momentum_ ], mass ) / weighting;
+                result = ( minEnergy <= energy ) && ( energy < maxEnergy );
+            }
+            return Base::operator()( frame, id ) && result;
+        }
+    };
+
+    /** particle filter chain of the openPMD writers
+     *
+     * The position filter selects the local part of the written window,
+     * the energy filter is only active if a region of interest defines
+     * an energy range.
+     */
+    typedef FilterFactory<
+        bmpl::vector<
+            GetPositionFilter< simDim >::type,
+            EnergyFilter<>
+        >
+    >::FilterType OutputParticleFilter;
+
+    /** user defined sub-volume and particle selection of a file output
+     *
+     * The region of interest (ROI) is a box in cells. By default the box is
+     * defined relative to the origin of the moving window and travels with
+     * it. If it is fixed, the box is defined relative to the origin of the
+     * simulation volume at time step zero and the moving window passes over it.
+     *
+     * The ROI is applied to the window selected for an output step: the global
+     * part of the window is clipped to the ROI and the local part becomes the
+     * intersection of the local window with the ROI, which can be empty.
+     * Checkpoints must never be restricted.
+     */
+    class RegionOfInterest
+    {
+    public:
+
+        RegionOfInterest() :
+            fixedInSpace( false ),
+            minEnergy_keV( 0.0 ),
+            maxEnergy_keV( 0.0 )
+        {
+        }
+
+        /** register the command line options of the ROI
+         *
+         * @param desc options of the owning plugin
+         * @param prefix option prefix of the owning plugin, e.g. `hdf5`
+         */
+        void registerHelp( po::options_description& desc, const std::string& prefix )
+        {
+            desc.add_options()
+                ( ( prefix + ".roi.offset" ).c_str(),
+                  po::value< std::vector< uint32_t > >( &offsetParam )->multitoken(),
+                  "offset of the region of interest in cells (x y z)" )
+                ( ( prefix + ".roi.size" ).c_str(),
+                  po::value< std::vector< uint32_t > >( &sizeParam )->multitoken(),
+                  "size of the region of interest in cells (x y z), 0 extends to the end of the window" )
+                ( ( prefix + ".roi.fixed" ).c_str(),
+                  po::bool_switch( &fixedInSpace )->default_value( false ),
+                  "region of interest is fixed in the simulation volume instead of moving with the window" )
+                ( ( prefix + ".roi.minEnergy" ).c_str(),
+                  po::value< float_X >( &minEnergy_keV )->default_value( 0.0 ),
+                  "write only particles with a kinetic energy >= minEnergy [in keV]" )
+                ( ( prefix + ".roi.maxEnergy" ).c_str(),
+                  po::value< float_X >( &maxEnergy_keV )->default_value( 0.0 ),
+                  "write only particles with a kinetic energy < maxEnergy [in keV], 0 means no upper limit" );
+        }
+
+        /** validate the options
+         *
+         * @param prefix option prefix of the owning plugin, used in error messages
+         */
+        void load( const std::string& prefix ) const
+        {
+            if( offsetParam.size() > simDim || sizeParam.size() > simDim )
+                throw std::runtime_error( prefix + ".roi: more components than simulation dimensions" );
+            if( minEnergy_keV < float_X( 0.0 ) || maxEnergy_keV < float_X( 0.0 ) )
+                throw std::runtime_error( prefix + ".roi: energies must be positive" );
+            if( maxEnergy_keV > float_X( 0.0 ) && minEnergy_keV >= maxEnergy_keV )
+                throw std::runtime_error( prefix + ".roi.minEnergy must be smaller than " + prefix + ".roi.maxEnergy" );
+        }
+
+        /** the written volume is smaller than the moving window */
+        bool isSpatiallyRestricted() const
+        {
+            return !offsetParam.empty() || !sizeParam.empty();
+        }
+
+        /** particles are selected by their kinetic energy
+         *
+         * A maximum energy of zero means no upper limit.
+         */
+        bool isEnergyRestricted() const
+        {
+            return minEnergy_keV > float_X( 0.0 ) || maxEnergy_keV > float_X( 0.0 );
+        }
+
+        /** intersect the window of an output step with the ROI
+         *
+         * @param window moving window of the output step
+         * @param currentStep current simulation step
+         * @return window clipped to the ROI, the local size can be zero
+         */
+        Window restrict( const Window& window, const uint32_t currentStep ) const
+        {
+            if( !isSpatiallyRestricted() )
+                return window;
+
+            /* offset of the window origin to the origin of the simulation volume at step zero */
+            DataSpace< simDim > globalSlideOffset;
+            globalSlideOffset.y() += MovingWindow::getInstance().getSlideDistance( currentStep );
+
+            Window roiWindow( window );
+            for( uint32_t d = 0; d < simDim; ++d )
+            {
+                const int64_t windowSize = window.globalDimensions.size[ d ];
+
+                /* ROI in coordinates relative to the window origin */
+                int64_t begin = d < offsetParam.size() ? int64_t( offsetParam[ d ] ) : 0;
+                if( fixedInSpace )
+                    begin -= int64_t( window.globalDimensions.offset[ d ] ) + globalSlideOffset[ d ];
+                const uint32_t size = d < sizeParam.size() ? sizeParam[ d ] : 0u;
+                int64_t end = size == 0u ? windowSize : begin + int64_t( size );
+
+                begin = std::min( std::max( begin, int64_t( 0 ) ), windowSize );
+                end = std::min( std::max( end, begin ), windowSize );
+
+                /* local window in coordinates relative to the window origin */
+                const int64_t localBegin = window.localDimensions.offset[ d ];
+                const int64_t localEnd = localBegin + window.localDimensions.size[ d ];
+
+                /* an empty intersection is moved to the border of the ROI */
+                const int64_t intersectionBegin = std::min( std::max( localBegin, begin ), end );
+                const int64_t intersectionEnd = std::max( intersectionBegin, std::min( localEnd, end ) );
+
+                roiWindow.globalDimensions.offset[ d ] = window.globalDimensions.offset[ d ] + int( begin );
+                roiWindow.globalDimensions.size[ d ] = int( end - begin );
+                roiWindow.localDimensions.offset[ d ] = int( intersectionBegin - begin );
+                roiWindow.localDimensions.size[ d ] = int( intersectionEnd - intersectionBegin );
+            }
+            return roiWindow;
+        }
+
+        /** offset from the local domain origin to the local part of a window
+         *
+         * @param window window of the output step
+         * @return offset in cells, without guards
+         */
+        static DataSpace< simDim > getLocalWindowToDomainOffset( const Window& window )
+        {
+            const PMacc::Selection< simDim >& localDomain = Environment< simDim >::get().SubGrid().getLocalDomain();
+            return window.globalDimensions.offset + window.localDimensions.offset - localDomain.offset;
+        }
+
+        /** configure the particle filter for the local part of a window
+         *
+         * The same filter must be used to count and to copy particles.
+         *
+         * @param filter particle filter of type OutputParticleFilter
+         * @param localWindowToDomainOffset offset from the local domain to the local window
+         * @param localWindowSize size of the local window
+         * @param isCheckpoint checkpoints ignore the energy selection
+         */
+        template< typename T_Filter >
+        void initFilter(
+            T_Filter& filter,
+            const DataSpace< simDim >& localWindowToDomainOffset,
+            const DataSpace< simDim >& localWindowSize,
+            const bool isCheckpoint
+        ) const
+        {
+            const bool useEnergy = !isCheckpoint && isEnergyRestricted();
+            /* activate filter pipeline if the written volume is not the full local domain */
+            filter.setStatus(
+                MovingWindow::getInstance().isSlidingWindowActive() ||
+                ( !isCheckpoint && isSpatiallyRestricted() ) ||
+                useEnergy
+            );
+            filter.setWindowPosition( localWindowToDomainOffset, localWindowSize );
+            if( useEnergy )
+            {
+                /* convert energy values from keV to PIConGPU units */
+                const float_X maxEnergy = maxEnergy_keV > float_X( 0.0 ) ?
+                    float_X( maxEnergy_keV * UNITCONV_keV_to_Joule / UNIT_ENERGY ) :
+                    std::numeric_limits< float_X >::max( );
+                filter.setEnergyRange(
+                    float_X( minEnergy_keV * UNITCONV_keV_to_Joule / UNIT_ENERGY ),
+                    maxEnergy
+                );
+            }
+        }
+
+    private:
+
+        std::vector< uint32_t > offsetParam;
+        std::vector< uint32_t > sizeParam;
+        bool fixedInSpace;
+        float_X minEnergy_keV;
+        float_X maxEnergy_keV;
+    };
+
+} // namespace openPMD
+} // namespace picongpu
@@ -68,6 +68,7 @@
 #include "plugins/hdf5/WriteSpecies.hpp"
 #include "plugins/hdf5/restart/LoadSpecies.hpp"
 #include "plugins/hdf5/restart/RestartFieldLoader.hpp"
+#include "plugins/hdf5/restart/RestartPipeline.hpp"
 #include "plugins/hdf5/NDScalars.hpp"
 #include "memory/boxes/DataBoxDim1Access.hpp"
 
@@ -124,7 +125,13 @@ public:
              * frame overflow in our memory manager if we process all particles in one kernel.
              **/
             ("hdf5.restart-chunkSize", po::value<uint32_t > (&restartChunkSize)->default_value(1000000),
-             "Number of particles processed in one kernel call during restart to prevent frame count blowup");
+             "Number of particles processed in one kernel call during restart to prevent frame count blowup")
+            ("hdf5.restart-prefetch", po::value<uint32_t > (&restartPrefetchDepth)->default_value(1),
+             "Number of checkpoint records read ahead while the previous record is copied to the device [0 == sequential restart]")
+            ("hdf5.particle-statistics", po::value<uint32_t > (&mThreadParams.particleStatisticsChunkSize)->default_value(0),
+             "Write min/max of all particle records per chunk of n particles and per patch [0 == disabled]");
+
+        mThreadParams.regionOfInterest.registerHelp(desc, "hdf5");
     }
 
     std::string pluginGetName() const
@@ -208,7 +215,7 @@ public:
          * \warning enabling the moving window from a checkpoint that
          *          had no moving window will not work
          */
-        gc.setStateAfterSlides(slides);
+        MovingWindow::getInstance().setDomainStateAfterSlides(slides);
 
         /* set window for restart, complete global domain */
         mThreadParams.window = MovingWindow::getInstance().getDomainAsWindow(restartStep);
@@ -219,13 +226,18 @@ public:
 
         ThreadParams *params = &mThreadParams;
 
+        /* the next record is read while the previous one is uploaded */
+        RestartPipeline pipeline(restartPrefetchDepth);
+
         /* load all fields */
         ForEach<FileCheckpointFields, LoadFields<bmpl::_1> > forEachLoadFields;
-        forEachLoadFields(params);
+        forEachLoadFields(params, forward(pipeline));
 
         /* load all particles */
         ForEach<FileCheckpointParticles, LoadSpecies<bmpl::_1> > forEachLoadSpecies;
-        forEachLoadSpecies(params, restartChunkSize);
+        forEachLoadSpecies(params, forward(pipeline), restartChunkSize);
+
+        pipeline.run();
 
         IdProvider<simDim>::State idProvState;
         ReadNDScalars<uint64_t, uint64_t>()(mThreadParams,
@@ -298,7 +310,6 @@ private:
      */
     void notificationReceived(uint32_t currentStep, bool isCheckpoint)
     {
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
         mThreadParams.isCheckpoint = isCheckpoint;
         mThreadParams.currentStep = currentStep;
         mThreadParams.cellDescription = this->cellDescription;
@@ -323,19 +334,15 @@ private:
         if( isCheckpoint )
             mThreadParams.window = MovingWindow::getInstance().getDomainAsWindow(currentStep);
         else
-            mThreadParams.window = MovingWindow::getInstance().getWindow(currentStep);
-
-        for (uint32_t i = 0; i < simDim; ++i)
         {
-            mThreadParams.localWindowToDomainOffset[i] = 0;
-            if (mThreadParams.window.globalDimensions.offset[i] > localDomain.offset[i])
-            {
-                mThreadParams.localWindowToDomainOffset[i] =
-                    mThreadParams.window.globalDimensions.offset[i] -
-                    localDomain.offset[i];
-            }
+            mThreadParams.window = MovingWindow::getInstance().getWindow(currentStep);
+            /* restrict the window to the region of interest (if any) */
+            mThreadParams.window = mThreadParams.regionOfInterest.restrict(mThreadParams.window, currentStep);
         }
 
+        mThreadParams.localWindowToDomainOffset =
+            openPMD::RegionOfInterest::getLocalWindowToDomainOffset(mThreadParams.window);
+
         openH5File(mThreadParams.h5Filename);
 
         writeHDF5((void*) &mThreadParams);
@@ -378,6 +385,8 @@ private:
             restartFilename = checkpointFilename;
         }
 
+        mThreadParams.regionOfInterest.load("hdf5");
+
         loaded = true;
     }
 
@@ -387,6 +396,7 @@ private:
             mThreadParams.dataCollector->finalize();
 
         __delete(mThreadParams.dataCollector);
+        __delete(mThreadParams.fieldComponentBuffer);
     }
 
     static void *writeHDF5(void *p_args)
@@ -456,6 +466,7 @@ private:
     std::string checkpointDirectory;
 
     uint32_t restartChunkSize;
+    uint32_t restartPrefetchDepth;
 
     DataSpace<simDim> mpi_pos;
     DataSpace<simDim> mpi_size;
@@ -82,7 +82,8 @@ public:
 #ifndef __CUDA_ARCH__
         DataConnector &dc = Environment<>::get().DataConnector();
 
-        auto field = dc.get< T >( T::getName() );
+        /* the components are gathered on the device, no host copy needed */
+        auto field = dc.get< T >( T::getName(), true );
         params->gridLayout = field->getGridLayout();
 
         // convert in a std::vector of std::vector format for writeField API
@@ -107,7 +108,7 @@ public:
                           T::getUnitDimension(),
                           inCellPosition,
                           timeOffset,
-                          field->getHostDataBox(),
+                          field->getDeviceDataBox(),
                           ValueType());
 
         dc.releaseData( T::getName() );
@@ -187,8 +188,6 @@ private:
 
         EventTask fieldTmpEvent = fieldTmp->asyncCommunication(__getTransactionEvent());
         __setTransactionEvent(fieldTmpEvent);
-        /* copy data to host that we can write same to disk*/
-        fieldTmp->getGridBuffer().deviceToHost();
         dc.releaseData( Species::FrameType::getName() );
         /*## finish update field ##*/
 
@@ -214,7 +213,7 @@ private:
                           FieldTmp::getUnitDimension<Solver>(),
                           inCellPosition,
                           timeOffset,
-                          fieldTmp->getHostDataBox(),
+                          fieldTmp->getDeviceDataBox(),
                           ValueType());
 
         dc.releaseData( FieldTmp::getUniqueId( 0 ) );
@@ -34,6 +34,7 @@
 #include "mappings/kernel/AreaMapping.hpp"
 
 #include "plugins/hdf5/writer/ParticleAttribute.hpp"
+#include "plugins/hdf5/writer/ParticleStatistics.hpp"
 
 #include "compileTime/conversion/MakeSeq.hpp"
 #include "compileTime/conversion/RemoveFromSeq.hpp"
@@ -110,19 +111,31 @@ public:
         /* load particle without copy particle data to host */
         auto speciesTmp = dc.get< ThisSpecies >( ThisSpecies::FrameType::getName(), true );
 
+        /* the same filter is used to count and to copy the particles */
+        openPMD::OutputParticleFilter filter;
+        params->regionOfInterest.initFilter(
+            filter,
+            params->localWindowToDomainOffset,
+            params->window.localDimensions.size,
+            params->isCheckpoint
+        );
+
         /* count number of particles for this species on the device */
         uint64_t numParticles = 0;
 
         log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) count particles: %1%") % Hdf5FrameType::getName();
-        /* at this point we cast to uint64_t, before we assume that per GPU
-         * less then 1e9 (int range) particles will be counted
-         */
-        numParticles = uint64_t( PMacc::CountParticles::countOnDevice< CORE + BORDER >(
-            *speciesTmp,
-            *(params->cellDescription),
-            params->localWindowToDomainOffset,
-            params->window.localDimensions.size
-        ));
+        /* ranks outside of the region of interest have nothing to write */
+        if( params->window.localDimensions.size.productOfComponents() != 0 )
+        {
+            /* at this point we cast to uint64_t, before we assume that per GPU
+             * less then 1e9 (int range) particles will be counted
+             */
+            numParticles = uint64_t( PMacc::CountParticles::countOnDevice< CORE + BORDER >(
+                *speciesTmp,
+                *(params->cellDescription),
+                filter
+            ));
+        }
 
 
         log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) count particles: %1% = %2%") % Hdf5FrameType::getName() % numParticles;
@@ -144,36 +157,19 @@ public:
             log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) get mapped memory device pointer: %1%") % Hdf5FrameType::getName();
 
             log<picLog::INPUT_OUTPUT > ("HDF5:  (begin) copy particle to host: %1%") % Hdf5FrameType::getName();
-            typedef bmpl::vector< typename GetPositionFilter<simDim>::type > usedFilters;
-            typedef typename FilterFactory<usedFilters>::FilterType MyParticleFilter;
-            MyParticleFilter filter;
-            /* activate filter pipeline if moving window is activated */
-            filter.setStatus(MovingWindow::getInstance().isSlidingWindowActive());
-            filter.setWindowPosition(params->localWindowToDomainOffset,
-                                     params->window.localDimensions.size);
-
-            auto block = PMacc::math::CT::volume<SuperCellSize>::type::value;
-
-            /* int: assume < 2e9 particles per GPU */
-            GridBuffer<int, DIM1> counterBuffer(DataSpace<DIM1>(1));
             AreaMapping < CORE + BORDER, MappingDesc > mapper(*(params->cellDescription));
 
-            /* this sanity check costs a little bit of time but hdf5 writing is slower */
-            PMACC_KERNEL(CopySpecies{})
-                (mapper.getGridDim(), block)
-                (counterBuffer.getDeviceBuffer().getPointer(),
-                 deviceFrame, speciesTmp->getDeviceParticlesBox(),
-                 filter,
-                 domainOffset,
-                 totalCellIdx_,
-                 mapper
-                 );
-            counterBuffer.deviceToHost();
+            const uint64_t numCopiedParticles = copySpecies(
+                deviceFrame, speciesTmp->getDeviceParticlesBox(),
+                filter,
+                domainOffset,
+                totalCellIdx_,
+                mapper
+            );
             log<picLog::INPUT_OUTPUT > ("HDF5:  ( end ) copy particle to host: %1%") % Hdf5FrameType::getName();
-            __getTransactionEvent().waitForFinished();
-            log<picLog::INPUT_OUTPUT > ("HDF5:  all events are finished: %1%") % Hdf5FrameType::getName();
 
-            PMACC_ASSERT((uint64_t) counterBuffer.getHostBuffer().getDataBox()[0] == numParticles);
+            /* this sanity check costs a little bit of time but hdf5 writing is slower */
+            PMACC_ASSERT(numCopiedParticles == numParticles);
         }
 
         /* We rather do an allgather at this point then letting libSplash
@@ -230,6 +226,17 @@ public:
 
         const std::string speciesPath( std::string("particles/") + FrameType::getName() );
 
+        /* per chunk min/max of all records, allows readers to skip particles */
+        const ParticleStatisticsLayout statistics(
+            params->isCheckpoint ? 0u : params->particleStatisticsChunkSize,
+            particleCounts,
+            myRank,
+            numParticlesOffset,
+            std::string("particleStatistics/") + FrameType::getName()
+        );
+        if( statistics.isEnabled() )
+            statistics.writeChunks( params );
+
         ForEach<typename Hdf5FrameType::ValueTypeSeq, hdf5::ParticleAttribute<bmpl::_1> > writeToHdf5;
         writeToHdf5(
             params,
@@ -237,7 +244,8 @@ public:
             speciesPath,
             numParticles,
             numParticlesOffset,
-            numParticlesGlobal
+            numParticlesGlobal,
+            statistics
         );
 
         /* write constant particle records to hdf5 file
@@ -26,6 +26,7 @@
 
 #include "plugins/output/WriteSpeciesCommon.hpp"
 #include "plugins/hdf5/restart/LoadParticleAttributesFromHDF5.hpp"
+#include "plugins/hdf5/restart/RestartPipeline.hpp"
 
 #include "plugins/common/particlePatches.hpp"
 #include "plugins/hdf5/openPMD/patchReader.hpp"
@@ -46,6 +47,8 @@
 #include <boost/type_traits.hpp>
 #include <boost/type_traits/is_same.hpp>
 
+#include <memory>
+
 
 namespace picongpu
 {
@@ -56,13 +59,16 @@ using namespace PMacc;
 
 using namespace splash;
 
-/** Load species from HDF5 checkpoint file
+/** restart record of a species
+ *
+ * The particles are read into mapped host memory by read() and inserted
+ * into the species on the device by upload().
  *
  * @tparam T_Species type of species
  *
  */
 template< typename T_Species >
-struct LoadSpecies
+class SpeciesRestartRecord : public IRestartRecord
 {
 public:
 
@@ -88,29 +94,30 @@ public:
 
     typedef Frame<OperatorCreateVectorBox, NewParticleDescription> Hdf5FrameType;
 
-    /** Load species from HDF5 checkpoint file
-     *
+    /**
      * @param params thread params with domainwriter, ...
      * @param restartChunkSize number of particles processed in one kernel call
      */
-    HINLINE void operator()(ThreadParams* params, const uint32_t restartChunkSize)
+    SpeciesRestartRecord(ThreadParams* params, const uint32_t restartChunkSize) :
+        params(params),
+        restartChunkSize(restartChunkSize),
+        totalNumParticles(0)
     {
+        DataConnector &dc = Environment<>::get().DataConnector();
+        // load particle without copying particle data to host
+        speciesTmp = dc.get< ThisSpecies >( ThisSpecies::FrameType::getName(), true );
+    }
 
+    void read()
+    {
         log<picLog::INPUT_OUTPUT > ("HDF5: (begin) load species: %1%") % Hdf5FrameType::getName();
-        DataConnector &dc = Environment<>::get().DataConnector();
         GridController<simDim> &gc = Environment<simDim>::get().GridController();
 
         const std::string speciesSubGroup(
             std::string("particles/") + FrameType::getName() + std::string("/")
         );
-        const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
         const PMacc::Selection<simDim>& globalDomain = Environment<simDim>::get().SubGrid().getGlobalDomain();
 
-        // load particle without copying particle data to host
-        auto speciesTmp = dc.get< ThisSpecies >( ThisSpecies::FrameType::getName(), true );
-
-        // count total number of particles on the device
-        uint64_cu totalNumParticles = 0;
         uint64_t particleOffset = 0;
 
         // load particle patches offsets to find own patch
@@ -171,25 +178,38 @@ public:
         log<picLog::INPUT_OUTPUT > ("Loading %1% particles from offset %2%") %
             (long long unsigned) totalNumParticles % (long long unsigned) particleOffset;
 
-        Hdf5FrameType hostFrame;
-        log<picLog::INPUT_OUTPUT > ("HDF5:  malloc mapped memory: %1%") % Hdf5FrameType::getName();
-        /*malloc mapped memory*/
-        ForEach<typename Hdf5FrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
+        log<picLog::INPUT_OUTPUT > ("HDF5:  malloc host memory: %1%") % Hdf5FrameType::getName();
+        /* only read on the host, the ordered copy in upload() is mapped */
+        ForEach<typename Hdf5FrameType::ValueTypeSeq, MallocHostMemory<bmpl::_1> > mallocMem;
         mallocMem(forward(hostFrame), totalNumParticles);
 
-        log<picLog::INPUT_OUTPUT > ("HDF5:  get mapped memory device pointer: %1%") % Hdf5FrameType::getName();
-        /*load device pointer of mapped memory*/
-        Hdf5FrameType deviceFrame;
-        ForEach<typename Hdf5FrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
-        getDevicePtr(forward(deviceFrame), forward(hostFrame));
-
         ForEach<typename Hdf5FrameType::ValueTypeSeq, LoadParticleAttributesFromHDF5<bmpl::_1> > loadAttributes;
         loadAttributes(forward(params), forward(hostFrame), speciesSubGroup, particleOffset, totalNumParticles);
+    }
 
+    void upload()
+    {
         if (totalNumParticles != 0)
         {
+            const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
+            const PMacc::Selection<simDim>& globalDomain = Environment<simDim>::get().SubGrid().getGlobalDomain();
+
+            log<picLog::INPUT_OUTPUT > ("HDF5:  malloc mapped memory: %1%") % Hdf5FrameType::getName();
+            /*malloc mapped memory for the particles ordered by supercell*/
+            Hdf5FrameType orderedHostFrame;
+            ForEach<typename Hdf5FrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
+            mallocMem(forward(orderedHostFrame), totalNumParticles);
+
+            log<picLog::INPUT_OUTPUT > ("HDF5:  get mapped memory device pointer: %1%") % Hdf5FrameType::getName();
+            /*load device pointer of mapped memory*/
+            Hdf5FrameType deviceFrame;
+            ForEach<typename Hdf5FrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
+            getDevicePtr(forward(deviceFrame), forward(orderedHostFrame));
+
             PMacc::particles::operations::splitIntoListOfFrames(
                 *speciesTmp,
+                hostFrame,
+                orderedHostFrame,
                 deviceFrame,
                 totalNumParticles,
                 restartChunkSize,
@@ -201,9 +221,42 @@ public:
 
             /*free host memory*/
             ForEach<typename Hdf5FrameType::ValueTypeSeq, FreeMemory<bmpl::_1> > freeMem;
-            freeMem(forward(hostFrame));
-            log<picLog::INPUT_OUTPUT > ("HDF5: ( end ) load species: %1%") % Hdf5FrameType::getName();
+            freeMem(forward(orderedHostFrame));
+            ForEach<typename Hdf5FrameType::ValueTypeSeq, FreeHostMemory<bmpl::_1> > freeHostMem;
+            freeHostMem(forward(hostFrame));
         }
+        speciesTmp.reset();
+        log<picLog::INPUT_OUTPUT > ("HDF5: ( end ) load species: %1%") % Hdf5FrameType::getName();
+    }
+
+private:
+
+    ThreadParams* params;
+    const uint32_t restartChunkSize;
+    std::shared_ptr< ThisSpecies > speciesTmp;
+    uint64_cu totalNumParticles;
+    Hdf5FrameType hostFrame;
+};
+
+/** Load species from HDF5 checkpoint file
+ *
+ * @tparam T_Species type of species
+ *
+ */
+template< typename T_Species >
+struct LoadSpecies
+{
+public:
+
+    /** add the species to the restart pipeline
+     *
+     * @param params thread params with domainwriter, ...
+     * @param pipeline pipeline which reads and uploads the species
+     * @param restartChunkSize number of particles processed in one kernel call
+     */
+    HINLINE void operator()(ThreadParams* params, RestartPipeline& pipeline, const uint32_t restartChunkSize)
+    {
+        pipeline.add(new SpeciesRestartRecord< T_Species >(params, restartChunkSize));
     }
 };
 
@@ -25,6 +25,7 @@
 #include "fields/FieldE.hpp"
 #include "fields/FieldB.hpp"
 #include "simulationControl/MovingWindow.hpp"
+#include "plugins/hdf5/restart/RestartPipeline.hpp"
 
 #include "dataManagement/DataConnector.hpp"
 #include "dimensions/DataSpace.hpp"
@@ -32,6 +33,7 @@
 
 #include <splash/splash.h>
 
+#include <memory>
 #include <string>
 #include <sstream>
 
@@ -48,17 +50,21 @@ namespace hdf5
 class RestartFieldLoader
 {
 public:
+
+    /** read all components of a field into its host buffer
+     *
+     * Only the host buffer is touched, the buffer must be zeroed before and
+     * copied to the device afterwards.
+     */
     template<class Data>
-    static void loadField(Data& field, const uint32_t numComponents, std::string objectName, ThreadParams *params)
+    static void readField(Data& field, const uint32_t numComponents, std::string objectName, ThreadParams *params)
     {
         log<picLog::INPUT_OUTPUT > ("Begin loading field '%1%'") % objectName;
         const DataSpace<simDim> field_guard = field.getGridLayout().getGuard();
 
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(params->currentStep);
+        const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(params->currentStep);
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
 
-        field.getHostBuffer().setValue(float3_X::create(0.0));
-
         const std::string name_lookup[] = {"x", "y", "z"};
 
         /* globalSlideOffset due to gpu slides between origin at time step 0
@@ -66,7 +72,7 @@ public:
          * ATTENTION: splash offset are globalSlideOffset + picongpu offsets
          */
         DataSpace<simDim> globalSlideOffset;
-        globalSlideOffset.y() = numSlides * localDomain.size.y();
+        globalSlideOffset.y() = slideDistance;
 
         Dimensions domain_offset(0, 0, 0);
         for (uint32_t d = 0; d < simDim; ++d)
@@ -109,12 +115,21 @@ public:
             delete field_container;
         }
 
+        log<picLog::INPUT_OUTPUT > ("Read from domain: offset=%1% size=%2%") %
+            domain_offset.toString() % local_domain_size.toString();
+    }
+
+    template<class Data>
+    static void loadField(Data& field, const uint32_t numComponents, std::string objectName, ThreadParams *params)
+    {
+        field.getHostBuffer().setValue(float3_X::create(0.0));
+
+        readField(field, numComponents, objectName, params);
+
         field.hostToDevice();
 
         __getTransactionEvent().waitForFinished();
 
-        log<picLog::INPUT_OUTPUT > ("Read from domain: offset=%1% size=%2%") %
-            domain_offset.toString() % local_domain_size.toString();
         log<picLog::INPUT_OUTPUT > ("Finished loading field '%1%'") % objectName;
     }
 
@@ -141,33 +156,71 @@ public:
     }
 };
 
-/**
- * Hepler class for HDF5Writer (forEach operator) to load a field from HDF5
+/** restart record of a field
  *
  * @tparam FieldType field class to load
  */
 template< typename FieldType >
-struct LoadFields
+class FieldRestartRecord : public IRestartRecord
 {
 public:
 
-    HDINLINE void operator()(ThreadParams* params)
+    FieldRestartRecord(ThreadParams* params) : params(params)
     {
-#ifndef __CUDA_ARCH__
         DataConnector &dc = Environment<>::get().DataConnector();
-        ThreadParams *tp = params;
 
         /* load field without copying data to host */
-        std::shared_ptr< FieldType > field = dc.get< FieldType >( FieldType::getName(), true );
+        field = dc.get< FieldType >( FieldType::getName(), true );
+        field->getGridBuffer().getHostBuffer().setValue(float3_X::create(0.0));
+    }
 
-        /* load from HDF5 */
-        RestartFieldLoader::loadField(
+    void read()
+    {
+        RestartFieldLoader::readField(
                 field->getGridBuffer(),
                 (uint32_t)FieldType::numComponents,
                 FieldType::getName(),
-                tp);
+                params);
+    }
 
+    void upload()
+    {
+        field->getGridBuffer().hostToDevice();
+
+        __getTransactionEvent().waitForFinished();
+
+        log<picLog::INPUT_OUTPUT > ("Finished loading field '%1%'") % FieldType::getName();
+
+        DataConnector &dc = Environment<>::get().DataConnector();
         dc.releaseData( FieldType::getName() );
+        field.reset();
+    }
+
+private:
+
+    ThreadParams* params;
+    std::shared_ptr< FieldType > field;
+};
+
+/**
+ * Hepler class for HDF5Writer (forEach operator) to load a field from HDF5
+ *
+ * @tparam FieldType field class to load
+ */
+template< typename FieldType >
+struct LoadFields
+{
+public:
+
+    /** add the field to the restart pipeline
+     *
+     * @param params thread params with domainwriter, ...
+     * @param pipeline pipeline which reads and uploads the field
+     */
+    HDINLINE void operator()(ThreadParams* params, RestartPipeline& pipeline)
+    {
+#ifndef __CUDA_ARCH__
+        pipeline.add(new FieldRestartRecord< FieldType >(params));
 #endif
     }
 
@@ -0,0 +1,223 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <mpi.h>
+
+#include <exception>
+#include <memory>
+#include <vector>
+
+
+namespace picongpu
+{
+
+namespace hdf5
+{
+using namespace PMacc;
+
+/** record of a checkpoint which is restored in two stages
+ *
+ * Everything which touches the event system or the DataConnector must be
+ * done in the constructor or in upload(), both run in the main thread.
+ */
+struct IRestartRecord
+{
+    virtual ~IRestartRecord()
+    {
+    }
+
+    /** read the record from the file into host memory
+     *
+     * Can run in the reader thread: only file access and host memory.
+     */
+    virtual void read() = 0;
+
+    /** copy the host data to the device, runs in the main thread */
+    virtual void upload() = 0;
+};
+
+/** restore checkpoint records in a two stage pipeline
+ *
+ * A reader thread reads the records in the order they were added while the
+ * main thread uploads the records which are already read. At most
+ * `prefetchDepth` records are read ahead of the record which is currently
+ * uploaded, this limits the additional host memory.
+ *
+ * All file reads are done by the single reader thread in the same order on
+ * all ranks, which is required for collective reads and because HDF5 is not
+ * thread-safe. If the MPI library does not provide MPI_THREAD_SERIALIZED or
+ * the depth is zero, the records are restored sequentially in the main thread.
+ */
+class RestartPipeline
+{
+public:
+
+    /** @param prefetchDepth number of records read ahead, 0 disables the reader thread */
+    RestartPipeline(const uint32_t prefetchDepth) :
+        prefetchDepth(prefetchDepth),
+        numRead(0),
+        numUploaded(0),
+        isAborted(false)
+    {
+    }
+
+    /** add a record, the pipeline takes ownership */
+    void add(IRestartRecord* record)
+    {
+        records.push_back(std::shared_ptr<IRestartRecord>(record));
+    }
+
+    /** restore all records, blocks until everything is on the device */
+    void run()
+    {
+        if (prefetchDepth == 0 || !isThreadingAvailable())
+        {
+            log<picLog::INPUT_OUTPUT > ("HDF5: restore %1% records sequentially") % records.size();
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                records[i]->read();
+                records[i]->upload();
+            }
+            records.clear();
+            return;
+        }
+
+        log<picLog::INPUT_OUTPUT > ("HDF5: restore %1% records with prefetch depth %2%") %
+            records.size() % prefetchDepth;
+
+        numRead = 0;
+        numUploaded = 0;
+        isAborted = false;
+        readerError = std::exception_ptr();
+
+        /* the reader thread must use the same device for mapped host memory */
+        int device = 0;
+        CUDA_CHECK(cudaGetDevice(&device));
+        boost::thread reader(&RestartPipeline::readAll, this, device);
+
+        try
+        {
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                {
+                    boost::unique_lock<boost::mutex> lock(mutex);
+                    while (numRead <= i && !readerError)
+                        stateChanged.wait(lock);
+                    if (readerError)
+                        break;
+                }
+
+                records[i]->upload();
+
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    ++numUploaded;
+                }
+                stateChanged.notify_all();
+            }
+        }
+        catch (...)
+        {
+            {
+                boost::lock_guard<boost::mutex> lock(mutex);
+                isAborted = true;
+            }
+            stateChanged.notify_all();
+            reader.join();
+            throw;
+        }
+
+        reader.join();
+        records.clear();
+
+        if (readerError)
+            std::rethrow_exception(readerError);
+    }
+
+private:
+
+    /** MPI calls from the reader thread are allowed */
+    static bool isThreadingAvailable()
+    {
+        int providedThreadLevel = MPI_THREAD_SINGLE;
+        MPI_CHECK(MPI_Query_thread(&providedThreadLevel));
+        return providedThreadLevel >= MPI_THREAD_SERIALIZED;
+    }
+
+    /** body of the reader thread
+     *
+     * @param device cuda device of the main thread
+     */
+    void readAll(const int device)
+    {
+        try
+        {
+            CUDA_CHECK(cudaSetDevice(device));
+
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                {
+                    boost::unique_lock<boost::mutex> lock(mutex);
+                    while (i > numUploaded + prefetchDepth && !isAborted)
+                        stateChanged.wait(lock);
+                    if (isAborted)
+                        return;
+                }
+
+                records[i]->read();
+
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    ++numRead;
+                }
+                stateChanged.notify_all();
+            }
+        }
+        catch (...)
+        {
+            {
+                boost::lock_guard<boost::mutex> lock(mutex);
+                readerError = std::current_exception();
+            }
+            stateChanged.notify_all();
+        }
+    }
+
+    std::vector<std::shared_ptr<IRestartRecord> > records;
+    const uint32_t prefetchDepth;
+
+    boost::mutex mutex;
+    boost::condition_variable stateChanged;
+    size_t numRead;
+    size_t numUploaded;
+    bool isAborted;
+    std::exception_ptr readerError;
+};
+
+} //namespace hdf5
+} //namespace picongpu
@@ -26,7 +26,9 @@
 #include "traits/GetComponentsType.hpp"
 #include "traits/GetNComponents.hpp"
 #include "assert.hpp"
+#include "static_assert.hpp"
 
+#include <boost/type_traits/is_same.hpp>
 #include <string>
 
 namespace picongpu
@@ -44,6 +46,8 @@ struct Field
     /* \param inCellPosition std::vector<std::vector<float_X> > with the outer
      *                       vector for each component and the inner vector for
      *                       the simDim position offset within the cell [0.0; 1.0)
+     * \param dataBox device data box of the field (including guards), each
+     *                component of the window is gathered on the device
      */
     template<typename T_ValueType, typename T_DataBoxType>
     static void writeField(ThreadParams *params,
@@ -56,7 +60,6 @@ struct Field
                            const T_ValueType&
                            )
     {
-        typedef T_DataBoxType NativeDataBoxType;
         typedef T_ValueType ValueType;
         typedef typename GetComponentsType<ValueType>::type ComponentType;
         typedef typename PICToSplash<ComponentType>::type SplashType;
@@ -64,6 +67,9 @@ struct Field
 
         const uint32_t nComponents = GetNComponents<ValueType>::value;
 
+        const bool fieldTypeCorrect( boost::is_same<ComponentType, float_X>::value );
+        PMACC_CASSERT_MSG(Precision_mismatch_in_Field_Components__HDF5,fieldTypeCorrect);
+
         SplashType splashType;
         ColTypeDouble ctDouble;
         SplashFloatXType splashFloatXType;
@@ -98,38 +104,34 @@ struct Field
          */
         DataSpace<simDim> globalSlideOffset;
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(params->currentStep);
-        globalSlideOffset.y() += numSlides * localDomain.size.y();
+        const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(params->currentStep);
+        globalSlideOffset.y() += slideDistance;
 
         Dimensions splashGlobalDomainOffset(0, 0, 0);
         Dimensions splashGlobalOffsetFile(0, 0, 0);
         Dimensions splashGlobalDomainSize(1, 1, 1);
 
+        /* the write offset is the offset of the local window inside the
+         * global window, the global window might be a region of interest
+         */
         for (uint32_t d = 0; d < simDim; ++d)
         {
-            splashGlobalOffsetFile[d] = localDomain.offset[d];
+            splashGlobalOffsetFile[d] = params->window.localDimensions.offset[d];
             splashGlobalDomainOffset[d] = params->window.globalDimensions.offset[d] + globalSlideOffset[d];
             splashGlobalDomainSize[d] = params->window.globalDimensions.size[d];
         }
 
-        splashGlobalOffsetFile[1] = std::max(0, localDomain.offset[1] -
-                                             params->window.globalDimensions.offset[1]);
-
-        size_t tmpArraySize = field_no_guard.productOfComponents();
-        ComponentType* tmpArray = new ComponentType[tmpArraySize];
-
-        typedef DataBoxDim1Access<NativeDataBoxType > D1Box;
-        D1Box d1Access(dataBox.shift(field_guard), field_no_guard);
+        if (params->fieldComponentBuffer == nullptr)
+            params->fieldComponentBuffer =
+                new openPMD::FieldComponentBuffer<float_X>(localDomain.size);
 
         for (uint32_t n = 0; n < nComponents; n++)
         {
-            /* copy data to temp array
-             * tmpArray has the size of the data without any offsets
+            /* gather the component on the device, the result has the size
+             * of the data without any offsets
              */
-            for (size_t i = 0; i < tmpArraySize; ++i)
-            {
-                tmpArray[i] = d1Access[i][n];
-            }
+            ComponentType* componentData =
+                params->fieldComponentBuffer->extract(dataBox, field_guard, field_no_guard, n);
 
             std::stringstream datasetName;
             datasetName << recordName;
@@ -155,7 +157,7 @@ struct Field
                                                       splashGlobalDomainSize    /* size of the global domain */
                                                ),
                                                DomainCollector::GridType,
-                                               tmpArray);
+                                               componentData);
 
             /* attributes */
             params->dataCollector->writeAttribute(params->currentStep,
@@ -168,7 +170,6 @@ struct Field
                                                   ctDouble, datasetName.str().c_str(),
                                                   "unitSI", &(unit.at(n)));
         }
-        __deleteArray(tmpArray);
 
 
         params->dataCollector->writeAttribute(params->currentStep,
@@ -25,6 +25,7 @@
 #include "pmacc_types.hpp"
 #include "simulation_types.hpp"
 #include "plugins/hdf5/HDF5Writer.def"
+#include "plugins/hdf5/writer/ParticleStatistics.hpp"
 #include "traits/PICToSplash.hpp"
 #include "traits/PICToOpenPMD.hpp"
 #include "traits/GetComponentsType.hpp"
@@ -57,6 +58,7 @@ struct ParticleAttribute
      * @param elements number of particles in this patch
      * @param elementsOffset number of particles in this patch
      * @param numParticlesGlobal number of particles globally
+     * @param statistics layout of the per chunk min/max statistics
      */
     template<typename FrameType>
     HINLINE void operator()(
@@ -65,7 +67,8 @@ struct ParticleAttribute
                             const std::string speciesPath,
                             const uint64_t elements,
                             const uint64_t elementsOffset,
-                            const uint64_t numParticlesGlobal
+                            const uint64_t numParticlesGlobal,
+                            const ParticleStatisticsLayout& statistics
     )
     {
 
@@ -108,8 +111,8 @@ struct ParticleAttribute
          */
         DataSpace<simDim> globalSlideOffset;
         const PMacc::Selection<simDim>& localDomain = Environment<simDim>::get().SubGrid().getLocalDomain();
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(threadParams->currentStep);
-        globalSlideOffset.y() += numSlides * localDomain.size.y();
+        const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(threadParams->currentStep);
+        globalSlideOffset.y() += slideDistance;
 
         Dimensions splashDomainOffset(0, 0, 0);
         Dimensions splashGlobalDomainOffset(0, 0, 0);
@@ -175,6 +178,14 @@ struct ParticleAttribute
                 ctDouble, datasetName.str().c_str(),
                 "unitSI", &(unit.at(d)));
 
+            if (statistics.isEnabled())
+            {
+                std::string componentPath(openPMDName());
+                if (components > 1)
+                    componentPath += std::string("/") + name_lookup[d];
+                statistics.writeComponent(params, componentPath, tmpArray);
+            }
+
         }
         __deleteArray(tmpArray);
 
@@ -0,0 +1,246 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_types.hpp"
+#include "plugins/hdf5/HDF5Writer.def"
+#include "traits/PICToSplash.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace picongpu
+{
+
+namespace hdf5
+{
+using namespace PMacc;
+
+using namespace splash;
+
+/** layout of the per chunk particle statistics of a species
+ *
+ * The particles of each patch (MPI rank) are split into chunks of
+ * `chunkSize` particles, the last chunk of a patch can be smaller.
+ * For each chunk and each patch the minimum and maximum of every particle
+ * record component is written to
+ *   particleStatistics/<species>/chunks/<record>[/<component>]/{min,max}
+ *   particleStatistics/<species>/patches/<record>[/<component>]/{min,max}
+ * Readers can skip chunks whose value range does not match a query.
+ * An empty patch has min > max.
+ */
+struct ParticleStatisticsLayout
+{
+    /** number of particles per chunk, 0 disables the statistics */
+    uint64_t chunkSize;
+    /** number of particles of this patch */
+    uint64_t numParticles;
+    /** offset of this patch in the particle records */
+    uint64_t numParticlesOffset;
+    /** number of chunks of this patch */
+    uint64_t numChunks;
+    /** number of chunks of all patches before this patch */
+    uint64_t numChunksOffset;
+    /** number of chunks of all patches */
+    uint64_t numChunksGlobal;
+    /** number of patches (MPI ranks) */
+    uint64_t numPatches;
+    /** index of this patch */
+    uint64_t patchIdx;
+    /** path of the statistics of the species, e.g. particleStatistics/e */
+    std::string path;
+
+    ParticleStatisticsLayout() :
+        chunkSize(0), numParticles(0), numParticlesOffset(0), numChunks(0),
+        numChunksOffset(0), numChunksGlobal(0), numPatches(0), patchIdx(0)
+    {
+    }
+
+    /** create the layout
+     *
+     * @param chunkSize number of particles per chunk, 0 disables the statistics
+     * @param particleCounts interleaved array of all patches: numParticles, mpi rank
+     * @param myRank mpi rank of this patch
+     * @param numParticlesOffset offset of this patch in the particle records
+     * @param path path of the statistics of the species
+     */
+    ParticleStatisticsLayout(
+        const uint64_t chunkSize,
+        const std::vector<uint64_t>& particleCounts,
+        const uint64_t myRank,
+        const uint64_t numParticlesOffset,
+        const std::string& path
+    ) :
+        chunkSize(chunkSize), numParticles(0), numParticlesOffset(numParticlesOffset), numChunks(0),
+        numChunksOffset(0), numChunksGlobal(0), numPatches(particleCounts.size() / 2), patchIdx(myRank),
+        path(path)
+    {
+        if (chunkSize == 0)
+            return;
+        for (uint64_t r = 0; r < numPatches; ++r)
+        {
+            const uint64_t chunks = getNumChunks(particleCounts.at(2 * r));
+            numChunksGlobal += chunks;
+            if (particleCounts.at(2 * r + 1) < myRank)
+                numChunksOffset += chunks;
+            else if (particleCounts.at(2 * r + 1) == myRank)
+            {
+                numParticles = particleCounts.at(2 * r);
+                numChunks = chunks;
+            }
+        }
+    }
+
+    bool isEnabled() const
+    {
+        return chunkSize != 0;
+    }
+
+    uint64_t getNumChunks(const uint64_t particles) const
+    {
+        return (particles + chunkSize - 1) / chunkSize;
+    }
+
+    /** write the number of particles and the particle offset of each chunk
+     *
+     * @param params thread params with the data collector
+     */
+    void writeChunks(ThreadParams* params) const
+    {
+        ColTypeUInt64 ctUInt64;
+        std::vector<uint64_t> chunkNumParticles(numChunks);
+        std::vector<uint64_t> chunkNumParticlesOffset(numChunks);
+        for (uint64_t c = 0; c < numChunks; ++c)
+        {
+            chunkNumParticlesOffset[c] = numParticlesOffset + c * chunkSize;
+            chunkNumParticles[c] = std::min(chunkSize, numParticles - c * chunkSize);
+        }
+
+        const std::string chunksPath(path + std::string("/chunks"));
+        params->dataCollector->write(
+            params->currentStep,
+            Dimensions(numChunksGlobal, 1, 1),
+            Dimensions(numChunksOffset, 0, 0),
+            ctUInt64, 1,
+            Dimensions(numChunks, 1, 1),
+            (chunksPath + std::string("/numParticles")).c_str(),
+            chunkNumParticles.empty() ? nullptr : &(*chunkNumParticles.begin()));
+        params->dataCollector->write(
+            params->currentStep,
+            Dimensions(numChunksGlobal, 1, 1),
+            Dimensions(numChunksOffset, 0, 0),
+            ctUInt64, 1,
+            Dimensions(numChunks, 1, 1),
+            (chunksPath + std::string("/numParticlesOffset")).c_str(),
+            chunkNumParticlesOffset.empty() ? nullptr : &(*chunkNumParticlesOffset.begin()));
+
+        params->dataCollector->writeAttribute(
+            params->currentStep,
+            ctUInt64, chunksPath.c_str(),
+            "chunkSize", &chunkSize);
+    }
+
+    /** write minimum and maximum of a record component per chunk and patch
+     *
+     * @param params thread params with the data collector
+     * @param componentPath path of the record component relative to the species, e.g. momentum/x
+     * @param data values of the component of this patch
+     */
+    template<typename T_Type>
+    void writeComponent(
+        ThreadParams* params,
+        const std::string& componentPath,
+        const T_Type* data
+    ) const
+    {
+        typedef typename PICToSplash<T_Type>::type SplashType;
+        SplashType splashType;
+
+        /* byte buffers: std::vector<bool> packs bits and has no contiguous
+         * data, writing neighboring chunks from different threads would race */
+        std::vector<char> chunkMinBuffer(numChunks * sizeof(T_Type));
+        std::vector<char> chunkMaxBuffer(numChunks * sizeof(T_Type));
+        T_Type* chunkMin = reinterpret_cast<T_Type*>(chunkMinBuffer.data());
+        T_Type* chunkMax = reinterpret_cast<T_Type*>(chunkMaxBuffer.data());
+        std::fill(chunkMin, chunkMin + numChunks, std::numeric_limits<T_Type>::max());
+        std::fill(chunkMax, chunkMax + numChunks, std::numeric_limits<T_Type>::lowest());
+        T_Type patchMin = std::numeric_limits<T_Type>::max();
+        T_Type patchMax = std::numeric_limits<T_Type>::lowest();
+
+        #pragma omp parallel for
+        for (uint64_t c = 0; c < numChunks; ++c)
+        {
+            const uint64_t end = std::min(numParticles, (c + 1) * chunkSize);
+            for (uint64_t i = c * chunkSize; i < end; ++i)
+            {
+                chunkMin[c] = std::min(chunkMin[c], data[i]);
+                chunkMax[c] = std::max(chunkMax[c], data[i]);
+            }
+        }
+        for (uint64_t c = 0; c < numChunks; ++c)
+        {
+            patchMin = std::min(patchMin, chunkMin[c]);
+            patchMax = std::max(patchMax, chunkMax[c]);
+        }
+
+        const std::string chunksPath(path + std::string("/chunks/") + componentPath);
+        params->dataCollector->write(
+            params->currentStep,
+            Dimensions(numChunksGlobal, 1, 1),
+            Dimensions(numChunksOffset, 0, 0),
+            splashType, 1,
+            Dimensions(numChunks, 1, 1),
+            (chunksPath + std::string("/min")).c_str(),
+            numChunks == 0 ? nullptr : chunkMin);
+        params->dataCollector->write(
+            params->currentStep,
+            Dimensions(numChunksGlobal, 1, 1),
+            Dimensions(numChunksOffset, 0, 0),
+            splashType, 1,
+            Dimensions(numChunks, 1, 1),
+            (chunksPath + std::string("/max")).c_str(),
+            numChunks == 0 ? nullptr : chunkMax);
+
+        const std::string patchesPath(path + std::string("/patches/") + componentPath);
+        params->dataCollector->write(
+            params->currentStep,
+            Dimensions(numPatches, 1, 1),
+            Dimensions(patchIdx, 0, 0),
+            splashType, 1,
+            Dimensions(1, 1, 1),
+            (patchesPath + std::string("/min")).c_str(),
+            &patchMin);
+        params->dataCollector->write(
+            params->currentStep,
+            Dimensions(numPatches, 1, 1),
+            Dimensions(patchIdx, 0, 0),
+            splashType, 1,
+            Dimensions(1, 1, 1),
+            (patchesPath + std::string("/max")).c_str(),
+            &patchMax);
+    }
+};
+
+} //namspace hdf5
+
+} //namespace picongpu
@@ -22,6 +22,7 @@
 #include "mappings/simulation/GridController.hpp"
 #include "memory/boxes/PitchedBox.hpp"
 #include "header/MessageHeader.hpp"
+#include "mpi/CommunicatorSplit.hpp"
 
 #include "simulation_defines.hpp"
 
@@ -76,7 +77,9 @@ struct GatherSlice
         if (!isActive)
             mpiRank = -1;
 
-        MPI_CHECK(MPI_Allgather(&mpiRank, 1, MPI_INT, &gatherRanks[0], 1, MPI_INT, MPI_COMM_WORLD));
+        /* staging ranks are not part of the grid */
+        const MPI_Comm simulationComm = mpi::CommunicatorSplit::get().getSimulationComm();
+        MPI_CHECK(MPI_Allgather(&mpiRank, 1, MPI_INT, &gatherRanks[0], 1, MPI_INT, simulationComm));
 
         for (int i = 0; i < countRanks; ++i)
         {
@@ -89,10 +92,10 @@ struct GatherSlice
 
         MPI_Group group = MPI_GROUP_NULL;
         MPI_Group newgroup = MPI_GROUP_NULL;
-        MPI_CHECK(MPI_Comm_group(MPI_COMM_WORLD, &group));
+        MPI_CHECK(MPI_Comm_group(simulationComm, &group));
         MPI_CHECK(MPI_Group_incl(group, numRanks, &groupRanks[0], &newgroup));
 
-        MPI_CHECK(MPI_Comm_create(MPI_COMM_WORLD, newgroup, &comm));
+        MPI_CHECK(MPI_Comm_create(simulationComm, newgroup, &comm));
 
         if (mpiRank != -1)
         {
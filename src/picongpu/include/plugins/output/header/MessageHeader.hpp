@@ -129,12 +129,12 @@ struct MessageHeader
         sim.step = currentStep;
 
         /*add sliding windo informations to header*/
-        const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+        const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(currentStep);
         sim.simOffsetToNull = DataSpace<DIM2 > ();
         if (transpose.x() == 1)
-            sim.simOffsetToNull.x() = node.maxSize.x() * numSlides;
+            sim.simOffsetToNull.x() = slideDistance;
         else if (transpose.y() == 1)
-            sim.simOffsetToNull.y() = node.maxSize.y() * numSlides;
+            sim.simOffsetToNull.y() = slideDistance;
 
     }
 
@@ -45,8 +45,12 @@
 
 #include <splash/splash.h>
 #include <boost/filesystem.hpp>
+#include <mpi.h>
 
 #include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
@@ -114,6 +118,12 @@ private:
     bool radPerGPU;
     std::string folderRadPerGPU;
     DataSpace<simDim> lastGPUpos;
+    /** output format of lastRad, totalRad and radPerGPU: "text" or "hdf5" */
+    std::string outputFormat;
+
+    /** ranks sharing one node, used to aggregate radPerGPU output in hdf5 mode */
+    MPI_Comm nodeComm;
+    bool isNodeLeader;
 
     /** defines if all kernel dependencies are full filled
      *
@@ -146,7 +156,6 @@ private:
 
     mpi::MPIReduce reduce;
     bool compressionOn;
-    static const int numberMeshRecords = 3;
 
 public:
 
@@ -168,6 +177,9 @@ public:
     isMaster(false),
     currentStep(0),
     radPerGPU(false),
+    outputFormat("text"),
+    nodeComm(MPI_COMM_NULL),
+    isNodeLeader(false),
     lastStep(0),
     meshesPathName("DetectorMesh/"),
     particlesPathName("DetectorParticle/"),
@@ -224,6 +236,9 @@ public:
                 ((pluginPrefix + ".omegaList").c_str(), po::value<std::string > (&pathOmegaList)->default_value("_noPath_"), "path to file containing all frequencies to calculate")
                 ((pluginPrefix + ".radPerGPU").c_str(), po::bool_switch(&radPerGPU), "enable radiation output from each GPU individually")
                 ((pluginPrefix + ".folderRadPerGPU").c_str(), po::value<std::string > (&folderRadPerGPU)->default_value("radPerGPU"), "folder in which the radiation of each GPU is written")
+                ((pluginPrefix + ".format").c_str(), po::value<std::string > (&outputFormat)->default_value("text"),
+                 "output format of lastRad, totalRad and radPerGPU [text, hdf5]; "
+                 "hdf5: totalRad is only written to radiationHDF5, radPerGPU is aggregated to one file per node")
                 ((pluginPrefix + ".compression").c_str(), po::bool_switch(&compressionOn), "enable compression of hdf5 output");
         }
         else
@@ -306,6 +321,10 @@ private:
 
             if (notifyFrequency > 0)
             {
+                if (outputFormat != "text" && outputFormat != "hdf5")
+                    throw std::runtime_error(std::string("Radiation: unknown output format '") + outputFormat +
+                                             std::string("', use 'text' or 'hdf5'"));
+
                 /*only rank 0 create a file*/
                 isMaster = reduce.hasResult(mpi::reduceMethods::Reduce());
 
@@ -319,9 +338,26 @@ private:
                 PMacc::Filesystem<simDim>& fs = Environment<simDim>::get().Filesystem();
 
                 if (isMaster)
-                {
                     timeSumArray = new Amplitude[elements_amplitude()];
 
+                /* node leaders write radPerGPU hdf5 files and need the detector description too */
+                if (radPerGPU && isHDF5Output())
+                {
+                    GridController<simDim>& gc = Environment<simDim>::get().GridController();
+                    int globalRank = 0;
+                    MPI_CHECK(MPI_Comm_rank(gc.getCommunicator().getMPIComm(), &globalRank));
+                    MPI_CHECK(MPI_Comm_split_type(gc.getCommunicator().getMPIComm(),
+                                                  MPI_COMM_TYPE_SHARED,
+                                                  globalRank,
+                                                  MPI_INFO_NULL,
+                                                  &nodeComm));
+                    int nodeRank = 0;
+                    MPI_CHECK(MPI_Comm_rank(nodeComm, &nodeRank));
+                    isNodeLeader = (nodeRank == 0);
+                }
+
+                if (isMaster || isNodeLeader)
+                {
                     /* save detector position / observation direction */
                     detectorPositions = new vector_64[parameters::N_observer];
                     for(uint32_t detectorIndex=0; detectorIndex < parameters::N_observer; ++detectorIndex)
@@ -379,10 +415,9 @@ private:
             // Some funny things that make it possible for the kernel to calculate
             // the absolute position of the particles
             const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
-            DataSpace<simDim> localSize(subGrid.getLocalDomain().size);
-            const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+            const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(currentStep);
             DataSpace<simDim> globalOffset(subGrid.getLocalDomain().offset);
-            globalOffset.y() += (localSize.y() * numSlides);
+            globalOffset.y() += slideDistance;
 
             // only print data at end of simulation if no dump period was set
             if (dumpPeriod == 0)
@@ -392,11 +427,12 @@ private:
             }
 
             if (isMaster)
-            {
                 __deleteArray(timeSumArray);
-                delete[] detectorPositions;
-                delete[] detectorFrequencies;
-            }
+            __deleteArray(detectorPositions);
+            __deleteArray(detectorFrequencies);
+
+            if (nodeComm != MPI_COMM_NULL)
+                MPI_CHECK(MPI_Comm_free(&nodeComm));
 
             __delete(radiation);
             CUDA_CHECK(cudaGetLastError());
@@ -414,14 +450,26 @@ private:
   }
 
 
+  /** true if lastRad, totalRad and radPerGPU are written as HDF5 instead of text */
+  bool isHDF5Output() const
+  {
+      return outputFormat == "hdf5";
+  }
+
+
   /** write radiation from each GPU to file individually
    *  requires call of copyRadiationDeviceToHost() before */
   void saveRadPerGPU(const DataSpace<simDim> currentGPUpos)
   {
     if (radPerGPU)
       {
+        if (isHDF5Output())
+          {
+            // all ranks of a node take part, even if their period is incomplete
+            saveRadPerGPUToHDF5(currentGPUpos, lastGPUpos == currentGPUpos);
+          }
         // only print lastGPUrad if full time period was covered
-        if (lastGPUpos == currentGPUpos)
+        else if (lastGPUpos == currentGPUpos)
           {
             std::stringstream last_time_step_str;
             std::stringstream current_time_step_str;
@@ -444,6 +492,85 @@ private:
   }
 
 
+  /** gather the radiation of all GPUs of a node and write it to one HDF5 file
+   *
+   * Each GPU is stored as an own amplitude record `Amplitude_pos_<offset>/`
+   * in the file `<species>_radPerGPU_node<rank of leader>_<step>_0_0_0.h5`.
+   * This replaces one text file per GPU and dump by one binary file per
+   * node and dump.
+   *
+   * @param currentGPUpos global cell offset of this GPU
+   * @param isValid true if this GPU covered the full time period since the last dump
+   */
+  void saveRadPerGPUToHDF5(const DataSpace<simDim> currentGPUpos, const bool isValid)
+  {
+      int nodeSize = 0;
+      MPI_CHECK(MPI_Comm_size(nodeComm, &nodeSize));
+
+      /* position of the GPU and a flag if the data is written */
+      std::vector<int> localHeader(simDim + 1);
+      for(uint32_t d = 0; d < simDim; ++d)
+          localHeader[d] = currentGPUpos[d];
+      localHeader[simDim] = isValid ? 1 : 0;
+
+      std::vector<int> headers;
+      std::vector<Amplitude> amplitudes;
+      if (isNodeLeader)
+      {
+          headers.resize(nodeSize * (simDim + 1));
+          amplitudes.resize(nodeSize * elements_amplitude());
+      }
+
+      MPI_CHECK(MPI_Gather(&(localHeader.front()), simDim + 1, MPI_INT,
+                           isNodeLeader ? &(headers.front()) : nullptr, simDim + 1, MPI_INT,
+                           0, nodeComm));
+      /* Amplitude is a plain struct of float_64 */
+      MPI_CHECK(MPI_Gather(radiation->getHostBuffer().getBasePointer(),
+                           elements_amplitude() * sizeof(Amplitude), MPI_CHAR,
+                           isNodeLeader ? &(amplitudes.front()) : nullptr,
+                           elements_amplitude() * sizeof(Amplitude), MPI_CHAR,
+                           0, nodeComm));
+
+      if (!isNodeLeader)
+          return;
+
+      std::vector<Amplitude*> values;
+      std::vector<std::string> recordNames;
+      std::vector<DataSpace<simDim> > gpuPositions;
+      for(int r = 0; r < nodeSize; ++r)
+      {
+          const int* header = &(headers.front()) + r * (simDim + 1);
+          if (header[simDim] == 0)
+              continue;
+
+          DataSpace<simDim> gpuPos;
+          std::stringstream recordName;
+          recordName << "Amplitude_pos";
+          for(uint32_t d = 0; d < simDim; ++d)
+          {
+              gpuPos[d] = header[d];
+              recordName << "_" << header[d];
+          }
+          recordName << "/";
+
+          values.push_back(&(amplitudes.front()) + r * elements_amplitude());
+          recordNames.push_back(recordName.str());
+          gpuPositions.push_back(gpuPos);
+      }
+
+      if (values.empty())
+          return;
+
+      GridController<simDim>& gc = Environment<simDim>::get().GridController();
+      int globalRank = 0;
+      MPI_CHECK(MPI_Comm_rank(gc.getCommunicator().getMPIComm(), &globalRank));
+
+      std::stringstream name;
+      name << folderRadPerGPU << "/" << speciesName << "_radPerGPU_node" << globalRank << "_";
+      writeHDF5file(values, recordNames, name.str(), gpuPositions);
+  }
+
+
   /** returns number of observers (radiation detectors) */
   static unsigned int elements_amplitude()
   {
@@ -480,7 +607,7 @@ private:
 
   /** writes to file the emitted radiation only from the current
    *  time step. Radiation from previous time steps is neglected. */
-  void writeLastRadToText()
+  void writeLastRad()
   {
       // only the master rank writes data
       if (isMaster)
@@ -492,21 +619,27 @@ private:
               std::stringstream o_step;
               o_step << currentStep;
 
-              // write lastRad data to txt
-              writeFile(tmp_result, folderLastRad + "/" + filename_prefix + "_" + o_step.str() + ".dat");
+              if (isHDF5Output())
+                  writeHDF5file(tmp_result, folderLastRad + "/" + filename_prefix + "_");
+              else
+                  // write lastRad data to txt
+                  writeFile(tmp_result, folderLastRad + "/" + filename_prefix + "_" + o_step.str() + ".dat");
           }
       }
   }
 
 
-  /** writes the total radiation (over entire simulation time) to file */
-  void writeTotalRadToText()
+  /** writes the total radiation (over entire simulation time) to file
+   *
+   * In hdf5 mode the same data is already written by writeAmplitudesToHDF5().
+   */
+  void writeTotalRad()
   {
       // only the master rank writes data
       if (isMaster)
       {
           // write file only if totalRad flag was selected
-          if (totalRad)
+          if (totalRad && !isHDF5Output())
           {
               // get time step as string
               std::stringstream o_step;
@@ -544,8 +677,8 @@ private:
   {
       // write data to files
       saveRadPerGPU(currentGPUpos);
-      writeLastRadToText();
-      writeTotalRadToText();
+      writeLastRad();
+      writeTotalRad();
       writeAmplitudesToHDF5();
   }
 
@@ -555,15 +688,15 @@ private:
    *  Arguments:
    *  int index - index of Amplitude
    *              "-1" return record name
+   *  std::string path - name of the amplitude record
    *
    *  Return:
    *  std::string - name
    *
    * This method avoids initializing static constexpr string arrays.
    */
-  static const std::string dataLabels(int index)
+  static const std::string dataLabels(int index, const std::string path = std::string("Amplitude/"))
   {
-      const std::string path("Amplitude/");
 
       /* return record name if handed -1 */
       if(index == -1)
@@ -664,6 +797,29 @@ private:
    * std::string name - path and beginning of file name to store data to
    */
   void writeHDF5file(Amplitude* values, std::string name)
+  {
+      writeHDF5file(std::vector<Amplitude*>(1, values),
+                    std::vector<std::string>(1, dataLabels(-1)),
+                    name,
+                    std::vector<DataSpace<simDim> >());
+  }
+
+
+  /** Write several Amplitude records to one HDF5 file
+   *
+   * Arguments:
+   * values - arrays of complex amplitude values, one per record
+   * recordNames - name of the mesh record of each array (e.g. "Amplitude/")
+   * std::string name - path and beginning of file name to store data to
+   * gpuPositions - if not empty, global cell offset of the GPU each record
+   *                was calculated on, stored as record attribute
+   *                `gpuPosition` together with the iteration attribute
+   *                `radiationStartStep`
+   */
+  void writeHDF5file(const std::vector<Amplitude*>& values,
+                     const std::vector<std::string>& recordNames,
+                     std::string name,
+                     const std::vector<DataSpace<simDim> >& gpuPositions)
   {
       splash::SerialDataCollector hdf5DataFile(1);
       splash::DataCollector::FileCreationAttr fAttr;
@@ -696,47 +852,68 @@ private:
       typedef PICToSplash<float_X>::type SplashFloatXType;
       SplashFloatXType splashFloatXType;
 
-      for(uint32_t ampIndex=0; ampIndex < Amplitude::numComponents; ++ampIndex)
+      for(size_t recordIndex = 0; recordIndex < values.size(); ++recordIndex)
       {
-          splash::Dimensions offset(ampIndex,0,0);
-          splash::Selection dataSelection(bufferSize,
-                                          componentSize,
-                                          offset,
-                                          stride);
+          const std::string& recordName = recordNames[recordIndex];
 
-          /* save data for each x/y/z * Re/Im amplitude */
-          hdf5DataFile.write(currentStep,
-                             radSplashType,
-                             3,
-                             dataSelection,
-                             (meshesPathName + dataLabels(ampIndex)).c_str(),
-                             values);
+          for(uint32_t ampIndex=0; ampIndex < Amplitude::numComponents; ++ampIndex)
+          {
+              splash::Dimensions offset(ampIndex,0,0);
+              splash::Selection dataSelection(bufferSize,
+                                              componentSize,
+                                              offset,
+                                              stride);
+
+              /* save data for each x/y/z * Re/Im amplitude */
+              hdf5DataFile.write(currentStep,
+                                 radSplashType,
+                                 3,
+                                 dataSelection,
+                                 (meshesPathName + dataLabels(ampIndex, recordName)).c_str(),
+                                 values[recordIndex]);
+
+              /* save SI unit as attribute together with data set */
+              hdf5DataFile.writeAttribute(currentStep,
+                                          radSplashType,
+                                          (meshesPathName + dataLabels(ampIndex, recordName)).c_str(),
+                                          "unitSI",
+                                          &factor);
+
+              /* position */
+              std::vector<float_X> positionMesh(simDim, 0.0); /* there is no offset - zero */
+              hdf5DataFile.writeAttribute(currentStep,
+                                          splashFloatXType,
+                                          (meshesPathName + dataLabels(ampIndex, recordName)).c_str(),
+                                          "position",
+                                          1u,
+                                          splash::Dimensions(simDim,0,0),
+                                          &(*positionMesh.begin()));
+          }
 
-          /* save SI unit as attribute together with data set */
+          /* save SI unit as attribute in the Amplitude group (for convenience) */
+          const std::string recordGroup(recordName.substr(0, recordName.rfind('/')));
           hdf5DataFile.writeAttribute(currentStep,
                                       radSplashType,
-                                      (meshesPathName + dataLabels(ampIndex)).c_str(),
+                                      (meshesPathName + recordGroup).c_str(),
                                       "unitSI",
                                       &factor);
 
-          /* position */
-          std::vector<float_X> positionMesh(simDim, 0.0); /* there is no offset - zero */
-          hdf5DataFile.writeAttribute(currentStep,
-                                      splashFloatXType,
-                                      (meshesPathName + dataLabels(ampIndex)).c_str(),
-                                      "position",
-                                      1u,
-                                      splash::Dimensions(simDim,0,0),
-                                      &(*positionMesh.begin()));
+          if (!gpuPositions.empty())
+          {
+              splash::ColTypeInt32 ctInt32;
+              std::vector<int32_t> gpuPosition(simDim);
+              for(uint32_t d = 0; d < simDim; ++d)
+                  gpuPosition[d] = gpuPositions[recordIndex][d];
+              hdf5DataFile.writeAttribute(currentStep,
+                                          ctInt32,
+                                          (meshesPathName + recordGroup).c_str(),
+                                          "gpuPosition",
+                                          1u,
+                                          splash::Dimensions(simDim,0,0),
+                                          &(*gpuPosition.begin()));
+          }
       }
 
-      /* save SI unit as attribute in the Amplitude group (for convenience) */
-      hdf5DataFile.writeAttribute(currentStep,
-                                  radSplashType,
-                                  (meshesPathName + std::string("Amplitude")).c_str(),
-                                  "unitSI",
-                                  &factor);
-
       /* save detector position / observation direction */
       splash::Dimensions bufferSizeDetector(3,
                                             1,
@@ -876,6 +1053,13 @@ private:
       splash::ColTypeDouble ctDouble;
       hdf5DataFile.writeAttribute(currentStep, ctDouble, nullptr, "timeUnitSI", &UNIT_TIME);
 
+      if (!gpuPositions.empty())
+      {
+          /* first time step of the integration period of the per GPU data */
+          splash::ColTypeUInt32 ctStartStep;
+          hdf5DataFile.writeAttribute(currentStep, ctStartStep, nullptr, "radiationStartStep", &lastStep);
+      }
+
       /* end required openPMD global attributes */
 
       /* begin recommended openPMD global attributes */
@@ -916,19 +1100,28 @@ private:
 
       /* begin required openPMD attributes for meshes records */
 
-      for(int i = 0; i<numberMeshRecords; ++i)
+      std::vector<std::pair<std::string, int> > meshRecords;
+      for(size_t recordIndex = 0; recordIndex < recordNames.size(); ++recordIndex)
+          meshRecords.push_back(std::make_pair(recordNames[recordIndex], int(idLabels::Amplitude)));
+      meshRecords.push_back(std::make_pair(meshRecordLabels(idLabels::Detector), int(idLabels::Detector)));
+      meshRecords.push_back(std::make_pair(meshRecordLabels(idLabels::Frequency), int(idLabels::Frequency)));
+
+      for(size_t recordIndex = 0; recordIndex < meshRecords.size(); ++recordIndex)
       {
+          const std::string recordPath(meshesPathName + meshRecords[recordIndex].first);
+          const int i = meshRecords[recordIndex].second;
+
           /* timeOffset */
           const float_X timeOffset = 0.0;
           hdf5DataFile.writeAttribute(currentStep, splashFloatXType,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "timeOffset", &timeOffset);
 
           /* gridGlobalOffset */
           std::vector<float_64> gridGlobalOffset(simDim, 0.0); /* there is no offset - zero */
           hdf5DataFile.writeAttribute(currentStep,
                                       ctDouble,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "gridGlobalOffset",
                                       1u,
                                       splash::Dimensions(simDim,0,0),
@@ -939,7 +1132,7 @@ private:
           const double unitNone = 1.0;
           hdf5DataFile.writeAttribute(currentStep,
                                       ctDouble,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "gridUnitSI",
                                       &unitNone);
 
@@ -948,7 +1141,7 @@ private:
           splash::ColTypeString ctGeometry(geometry.length());
           hdf5DataFile.writeAttribute(currentStep,
                                       ctGeometry,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "geometry",
                                       geometry.c_str());
 
@@ -957,7 +1150,7 @@ private:
           splash::ColTypeString ctDataOrder(dataOrder.length());
           hdf5DataFile.writeAttribute(currentStep,
                                       ctDataOrder,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "dataOrder",
                                       dataOrder.c_str());
 
@@ -966,7 +1159,7 @@ private:
               gridSpacing.at(d) = float_X(1.0);
           hdf5DataFile.writeAttribute(currentStep,
                                       splashFloatXType,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "gridSpacing",
                                       1u,
                                       splash::Dimensions(simDim,0,0),
@@ -999,7 +1192,7 @@ private:
 
           hdf5DataFile.writeAttribute(currentStep,
                                       ctSomeListOfStr,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "axisLabels",
                                       1u, /* ndims: 1D array */
                                       splash::Dimensions(myListOfStr.size(),0,0), /* size of 1D array */
@@ -1026,7 +1219,7 @@ private:
           }
           hdf5DataFile.writeAttribute(currentStep,
                                       ctDouble,
-                                      (meshesPathName + meshRecordLabels(i)).c_str(),
+                                      recordPath.c_str(),
                                       "unitDimension",
                                       1u,
                                       splash::Dimensions(traits::NUnitDimension,0,0),
@@ -1199,11 +1392,10 @@ private:
 
       // Some funny things that make it possible for the kernel to calculate
       // the absolute position of the particles
-      DataSpace<simDim> localSize(cellDescription->getGridLayout().getDataSpaceWithoutGuarding());
-      const uint32_t numSlides = MovingWindow::getInstance().getSlideCounter(currentStep);
+      const uint32_t slideDistance = MovingWindow::getInstance().getSlideDistance(currentStep);
       const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
       DataSpace<simDim> globalOffset(subGrid.getLocalDomain().offset);
-      globalOffset.y() += (localSize.y() * numSlides);
+      globalOffset.y() += slideDistance;
 
 
       // PIC-like kernel call of the radiation kernel
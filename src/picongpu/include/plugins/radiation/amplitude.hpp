@@ -37,12 +37,14 @@ public:
    *
    * Arguments:
    * - vector_64: real 3D vector
-   * - float: complex phase */
-  DINLINE Amplitude(vector_64 vec, picongpu::float_X phase)
+   * - float: complex phase
+   * - precision policy of sincos (default: mathPrecision::Radiation) */
+  template<typename T_Precision = picongpu::mathPrecision::Radiation>
+  DINLINE Amplitude(vector_64 vec, picongpu::float_X phase, const T_Precision& precision = T_Precision())
   {
       picongpu::float_X cosValue;
       picongpu::float_X sinValue;
-      picongpu::math::sincos(phase, sinValue, cosValue);
+      picongpu::math::sincos(phase, sinValue, cosValue, precision);
       amp_x=picongpu::math::euler(vec.x(), picongpu::precisionCast<picongpu::float_64>(sinValue), picongpu::precisionCast<picongpu::float_64>(cosValue) );
       amp_y=picongpu::math::euler(vec.y(), picongpu::precisionCast<picongpu::float_64>(sinValue), picongpu::precisionCast<picongpu::float_64>(cosValue) );
       amp_z=picongpu::math::euler(vec.z(), picongpu::precisionCast<picongpu::float_64>(sinValue), picongpu::precisionCast<picongpu::float_64>(cosValue) );
@@ -140,7 +142,7 @@ namespace mpi
 
   /** implementation of MPI transaction on Amplitude class */
   template<>
-  MPI_StructAsArray getMPI_StructAsArray< ::Amplitude >()
+  inline MPI_StructAsArray getMPI_StructAsArray< ::Amplitude >()
   {
       MPI_StructAsArray result = getMPI_StructAsArray< complex_64::type > ();
       result.sizeMultiplier *= Amplitude::numComponents;
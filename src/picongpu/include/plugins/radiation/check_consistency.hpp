@@ -26,7 +26,7 @@
 namespace picongpu
 {
 
-void check_consistency(void)
+inline void check_consistency(void)
 {
   using namespace parameters;
   std::cout << " checking efficiency of radiation code: " ;
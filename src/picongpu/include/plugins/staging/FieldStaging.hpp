@@ -0,0 +1,205 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "plugins/ISimulationPlugin.hpp"
+#include "plugins/common/FieldComponentBuffer.hpp"
+#include "plugins/staging/StagingProtocol.hpp"
+#include "simulationControl/MovingWindow.hpp"
+#include "fields/FieldE.hpp"
+#include "fields/FieldB.hpp"
+
+#include "dataManagement/DataConnector.hpp"
+#include "mpi/CommunicatorSplit.hpp"
+
+#include <mpi.h>
+#include <vector>
+#include <string>
+
+
+namespace picongpu
+{
+namespace staging
+{
+using namespace PMacc;
+
+    /** ship field snapshots to the staging ranks
+     *
+     * Each component of E and B of the local domain is gathered into pinned
+     * host memory and sent with MPI_Isend to the staging rank of this
+     * simulation rank, which writes it to disk (see StagingServer).
+     * The simulation only waits for the device to host copy; the sends of a
+     * snapshot are completed at the begin of the next snapshot.
+     */
+    class FieldStaging : public ISimulationPlugin
+    {
+    public:
+
+        FieldStaging() :
+            notifyPeriod(0),
+            cellDescription(nullptr),
+            stagingRank(0)
+        {
+            Environment<>::get().PluginConnector().registerPlugin(this);
+        }
+
+        virtual ~FieldStaging()
+        {
+        }
+
+        void notify(uint32_t currentStep)
+        {
+            waitForPendingSends();
+
+            sendField<FieldE>(currentStep, 0);
+            sendField<FieldB>(currentStep, 1);
+        }
+
+        void pluginRegisterHelp(po::options_description& desc)
+        {
+            desc.add_options()
+                ("staging.period", po::value<uint32_t>(&notifyPeriod)->default_value(0),
+                 "send E and B to the staging ranks [for each n-th step], requires --staging.ranks");
+        }
+
+        std::string pluginGetName() const
+        {
+            return "FieldStaging";
+        }
+
+        void setMappingDescription(MappingDesc* cellDescription)
+        {
+            this->cellDescription = cellDescription;
+        }
+
+    private:
+
+        /** number of fields which are sent */
+        static constexpr uint32_t numFields = 2;
+
+        void pluginLoad()
+        {
+            if (notifyPeriod == 0)
+                return;
+
+            if (mpi::CommunicatorSplit::get().getNumStagingRanks() == 0)
+            {
+                log<picLog::INPUT_OUTPUT >("FieldStaging: no staging ranks reserved (--staging.ranks), plugin disabled");
+                notifyPeriod = 0;
+                return;
+            }
+
+            int simulationRank = 0;
+            MPI_CHECK(MPI_Comm_rank(mpi::CommunicatorSplit::get().getSimulationComm(), &simulationRank));
+            stagingRank = getStagingRank(simulationRank);
+
+            const DataSpace<simDim> localSize = Environment<simDim>::get().SubGrid().getLocalDomain().size;
+            buffers.resize(numFields * 3u);
+            for (size_t i = 0; i < buffers.size(); ++i)
+                buffers[i] = new openPMD::FieldComponentBuffer<float_X>(localSize);
+            headers.resize(buffers.size());
+
+            Environment<>::get().PluginConnector().setNotificationPeriod(this, notifyPeriod);
+        }
+
+        void pluginUnload()
+        {
+            waitForPendingSends();
+            for (size_t i = 0; i < buffers.size(); ++i)
+                __delete(buffers[i]);
+            buffers.clear();
+        }
+
+        /** send all components of a field
+         *
+         * @param currentStep current simulation step
+         * @param fieldIdx index of the field in the buffer list
+         */
+        template<typename T_Field>
+        void sendField(const uint32_t currentStep, const uint32_t fieldIdx)
+        {
+            DataConnector& dc = Environment<>::get().DataConnector();
+            auto field = dc.get<T_Field>(T_Field::getName(), true);
+
+            const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+            const DataSpace<simDim> localSize = subGrid.getLocalDomain().size;
+            DataSpace<simDim> globalOffset = subGrid.getLocalDomain().offset;
+            globalOffset.y() += MovingWindow::getInstance().getSlideDistance(currentStep);
+            const DataSpace<simDim> guard = field->getGridLayout().getGuard();
+
+            const typename T_Field::UnitValueType unit = T_Field::getUnit();
+            const std::string componentNames[] = {"x", "y", "z"};
+
+            for (uint32_t c = 0; c < 3u; ++c)
+            {
+                const uint32_t bufferIdx = fieldIdx * 3u + c;
+                float_X* data = buffers[bufferIdx]->extract(
+                    field->getGridBuffer().getDeviceBuffer().getDataBox(),
+                    guard,
+                    localSize,
+                    c
+                );
+
+                SnapshotHeader& header = headers[bufferIdx];
+                header.type = snapshotField;
+                header.step = currentStep;
+                header.setName(T_Field::getName() + "/" + componentNames[c]);
+                for (uint32_t d = 0; d < simDim; ++d)
+                {
+                    header.offset[d] = globalOffset[d];
+                    header.size[d] = localSize[d];
+                }
+                header.unitSI[0] = unit[c];
+
+                MPI_Comm interComm = mpi::CommunicatorSplit::get().getInterComm();
+                pendingRequests.push_back(MPI_Request());
+                MPI_CHECK(MPI_Isend(&header, sizeof(SnapshotHeader), MPI_BYTE,
+                                    stagingRank, snapshotHeaderTag, interComm, &pendingRequests.back()));
+                pendingRequests.push_back(MPI_Request());
+                MPI_CHECK(MPI_Isend(data, localSize.productOfComponents() * sizeof(float_X), MPI_BYTE,
+                                    stagingRank, snapshotDataTag, interComm, &pendingRequests.back()));
+            }
+
+            dc.releaseData(T_Field::getName());
+        }
+
+        /** complete all sends of the previous snapshot, afterwards the buffers can be reused */
+        void waitForPendingSends()
+        {
+            if (pendingRequests.empty())
+                return;
+            MPI_CHECK(MPI_Waitall(pendingRequests.size(), &(pendingRequests.front()), MPI_STATUSES_IGNORE));
+            pendingRequests.clear();
+        }
+
+        uint32_t notifyPeriod;
+        MappingDesc* cellDescription;
+        int stagingRank;
+
+        /** one pinned buffer per field component */
+        std::vector<openPMD::FieldComponentBuffer<float_X>*> buffers;
+        /** headers of the snapshot in flight, one per buffer */
+        std::vector<SnapshotHeader> headers;
+        std::vector<MPI_Request> pendingRequests;
+    };
+
+} // namespace staging
+} // namespace picongpu
@@ -0,0 +1,310 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "simulation_types.hpp"
+#include "plugins/ISimulationPlugin.hpp"
+#include "plugins/common/RegionOfInterest.hpp"
+#include "plugins/output/WriteSpeciesCommon.hpp"
+#include "plugins/kernel/CopySpecies.kernel"
+#include "plugins/staging/StagingProtocol.hpp"
+#include "simulationControl/MovingWindow.hpp"
+#include "traits/PICToOpenPMD.hpp"
+#include "traits/GetComponentsType.hpp"
+#include "traits/GetNComponents.hpp"
+#include "traits/Resolve.hpp"
+
+#include "mappings/kernel/AreaMapping.hpp"
+#include "memory/buffers/GridBuffer.hpp"
+#include "compileTime/conversion/MakeSeq.hpp"
+#include "compileTime/conversion/RemoveFromSeq.hpp"
+#include "dataManagement/DataConnector.hpp"
+#include "particles/ParticleDescription.hpp"
+#include "particles/operations/CountParticles.hpp"
+#include "mpi/CommunicatorSplit.hpp"
+#include "algorithms/ForEach.hpp"
+#include "assert.hpp"
+
+#include <boost/mpl/vector.hpp>
+#include <mpi.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace picongpu
+{
+namespace staging
+{
+using namespace PMacc;
+
+    /** send one particle record of a host frame to the staging rank
+     *
+     * The components stay interleaved, they are split by the staging rank.
+     *
+     * @tparam T_Identifier identifier of a particle record
+     */
+    template<typename T_Identifier>
+    struct SendParticleRecord
+    {
+        /** @param hostFrame frame with all particles of the local domain
+         * @param header common part of the headers of all records
+         * @param speciesName name of the species, prefix of the record name
+         * @param stagingRank rank in the remote group of the intercommunicator
+         * @param headers headers of all sends in flight, must keep their address
+         * @param requests requests of all sends in flight
+         */
+        template<typename T_Frame>
+        HINLINE void operator()(
+            T_Frame& hostFrame,
+            const SnapshotHeader& header,
+            const std::string& speciesName,
+            const int stagingRank,
+            std::deque<SnapshotHeader>& headers,
+            std::vector<MPI_Request>& requests
+        ) const
+        {
+            typedef T_Identifier Identifier;
+            typedef typename PMacc::traits::Resolve<Identifier>::type::type ValueType;
+            typedef typename PMacc::traits::GetComponentsType<ValueType>::type ComponentType;
+            const uint32_t components = PMacc::traits::GetNComponents<ValueType>::value;
+
+            picongpu::traits::OpenPMDName<Identifier> openPMDName;
+            picongpu::traits::OpenPMDUnit<Identifier> openPMDUnit;
+            const std::vector<float_64> unit = openPMDUnit();
+            PMACC_ASSERT(unit.size() == components);
+
+            headers.push_back(header);
+            SnapshotHeader& recordHeader = headers.back();
+            recordHeader.setName(speciesName + "/" + openPMDName());
+            recordHeader.valueType = GetSnapshotValueType<ComponentType>::value;
+            recordHeader.numComponents = components;
+            for (uint32_t c = 0; c < components; ++c)
+                recordHeader.unitSI[c] = unit[c];
+
+            MPI_Comm interComm = mpi::CommunicatorSplit::get().getInterComm();
+            requests.push_back(MPI_Request());
+            MPI_CHECK(MPI_Isend(&recordHeader, sizeof(SnapshotHeader), MPI_BYTE,
+                                stagingRank, snapshotHeaderTag, interComm, &requests.back()));
+
+            const size_t numBytes = recordHeader.getNumScalars() * sizeof(ComponentType);
+            if (numBytes == 0)
+                return;
+
+            requests.push_back(MPI_Request());
+            MPI_CHECK(MPI_Isend(hostFrame.getIdentifier(Identifier()).getPointer(), numBytes, MPI_BYTE,
+                                stagingRank, snapshotDataTag, interComm, &requests.back()));
+        }
+    };
+
+    /** ship particle snapshots of a species to the staging ranks
+     *
+     * All particles of the local domain are copied with copySpecies()
+     * into mapped host memory, with the same records as in the openPMD
+     * writers (localCellIdx is replaced by the global totalCellIdx). Each
+     * record is sent with MPI_Isend to the staging rank of this simulation
+     * rank (see StagingServer). The host frame is kept until the sends
+     * are completed at the begin of the next snapshot.
+     *
+     * @tparam T_Species particle species
+     */
+    template<typename T_Species>
+    class ParticleStaging : public ISimulationPlugin
+    {
+    public:
+
+        typedef T_Species SpeciesType;
+        typedef typename SpeciesType::FrameType FrameType;
+        typedef typename FrameType::ParticleDescription ParticleDescription;
+        typedef typename FrameType::ValueTypeSeq ParticleAttributeList;
+
+        /* replace multiMask and localCellIdx by totalCellIdx, as in the openPMD writers */
+        typedef bmpl::vector<multiMask, localCellIdx> TypesToDelete;
+        typedef typename RemoveFromSeq<ParticleAttributeList, TypesToDelete>::type ParticleCleanedAttributeList;
+        typedef typename MakeSeq<
+            ParticleCleanedAttributeList,
+            totalCellIdx
+        >::type ParticleNewAttributeList;
+        typedef typename ReplaceValueTypeSeq<ParticleDescription, ParticleNewAttributeList>::type
+            NewParticleDescription;
+        typedef Frame<OperatorCreateVectorBox, NewParticleDescription> StagingFrameType;
+
+        ParticleStaging() :
+            pluginPrefix(FrameType::getName() + std::string("_staging")),
+            notifyPeriod(0),
+            cellDescription(nullptr),
+            stagingRank(0),
+            hasHostFrame(false)
+        {
+            Environment<>::get().PluginConnector().registerPlugin(this);
+        }
+
+        virtual ~ParticleStaging()
+        {
+        }
+
+        void notify(uint32_t currentStep)
+        {
+            waitForPendingSends();
+            freeHostFrame();
+            sendSpecies(currentStep);
+        }
+
+        void pluginRegisterHelp(po::options_description& desc)
+        {
+            desc.add_options()
+                ((pluginPrefix + ".period").c_str(), po::value<uint32_t>(&notifyPeriod)->default_value(0),
+                 "send all particles of the species to the staging ranks [for each n-th step], "
+                 "requires --staging.ranks");
+        }
+
+        std::string pluginGetName() const
+        {
+            return "ParticleStaging: " + FrameType::getName();
+        }
+
+        void setMappingDescription(MappingDesc* cellDescription)
+        {
+            this->cellDescription = cellDescription;
+        }
+
+    private:
+
+        void pluginLoad()
+        {
+            if (notifyPeriod == 0)
+                return;
+
+            if (mpi::CommunicatorSplit::get().getNumStagingRanks() == 0)
+            {
+                log<picLog::INPUT_OUTPUT >("ParticleStaging: no staging ranks reserved (--staging.ranks), "
+                                           "plugin for %1% disabled") % FrameType::getName();
+                notifyPeriod = 0;
+                return;
+            }
+
+            int simulationRank = 0;
+            MPI_CHECK(MPI_Comm_rank(mpi::CommunicatorSplit::get().getSimulationComm(), &simulationRank));
+            stagingRank = getStagingRank(simulationRank);
+
+            Environment<>::get().PluginConnector().setNotificationPeriod(this, notifyPeriod);
+        }
+
+        void pluginUnload()
+        {
+            waitForPendingSends();
+            freeHostFrame();
+        }
+
+        /** copy all particles of the local domain to the host and send them */
+        void sendSpecies(const uint32_t currentStep)
+        {
+            DataConnector& dc = Environment<>::get().DataConnector();
+            auto species = dc.get<SpeciesType>(FrameType::getName(), true);
+
+            const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+            const DataSpace<simDim> localSize = subGrid.getLocalDomain().size;
+            DataSpace<simDim> localOffset = subGrid.getLocalDomain().offset;
+            localOffset.y() += MovingWindow::getInstance().getSlideDistance(currentStep);
+
+            /* the full local domain is sent, the filter accepts every particle */
+            openPMD::OutputParticleFilter filter;
+            filter.setStatus(false);
+            filter.setWindowPosition(DataSpace<simDim>(), localSize);
+
+            const uint64_t numParticles = uint64_t(PMacc::CountParticles::countOnDevice<CORE + BORDER>(
+                *species,
+                *cellDescription,
+                filter
+            ));
+
+            ForEach<typename StagingFrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
+            mallocMem(forward(hostFrame), numParticles);
+            hasHostFrame = true;
+
+            if (numParticles != 0)
+            {
+                StagingFrameType deviceFrame;
+                ForEach<typename StagingFrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
+                getDevicePtr(forward(deviceFrame), forward(hostFrame));
+
+                AreaMapping<CORE + BORDER, MappingDesc> mapper(*cellDescription);
+                const DataSpace<simDim> domainOffset = subGrid.getGlobalDomain().offset + localOffset;
+
+                const uint64_t numCopiedParticles = copySpecies(
+                    deviceFrame, species->getDeviceParticlesBox(),
+                    filter,
+                    domainOffset,
+                    totalCellIdx_,
+                    mapper
+                );
+
+                PMACC_ASSERT(numCopiedParticles == numParticles);
+            }
+            dc.releaseData(FrameType::getName());
+
+            SnapshotHeader header;
+            header.type = snapshotParticles;
+            header.step = currentStep;
+            for (uint32_t d = 0; d < simDim; ++d)
+                header.offset[d] = localOffset[d];
+            /* int: assume < 2e9 particles per GPU */
+            header.size[0] = int32_t(numParticles);
+
+            ForEach<typename StagingFrameType::ValueTypeSeq, SendParticleRecord<bmpl::_1> > sendRecords;
+            sendRecords(forward(hostFrame), header, FrameType::getName(), stagingRank,
+                        forward(headers), forward(pendingRequests));
+        }
+
+        /** complete all sends of the previous snapshot, afterwards the host frame can be freed */
+        void waitForPendingSends()
+        {
+            if (!pendingRequests.empty())
+                MPI_CHECK(MPI_Waitall(pendingRequests.size(), &(pendingRequests.front()), MPI_STATUSES_IGNORE));
+            pendingRequests.clear();
+            headers.clear();
+        }
+
+        void freeHostFrame()
+        {
+            if (!hasHostFrame)
+                return;
+            ForEach<typename StagingFrameType::ValueTypeSeq, FreeMemory<bmpl::_1> > freeMem;
+            freeMem(forward(hostFrame));
+            hasHostFrame = false;
+        }
+
+        std::string pluginPrefix;
+        uint32_t notifyPeriod;
+        MappingDesc* cellDescription;
+        int stagingRank;
+
+        /** mapped host memory of the snapshot in flight */
+        StagingFrameType hostFrame;
+        bool hasHostFrame;
+        /** headers of the snapshot in flight, one per record */
+        std::deque<SnapshotHeader> headers;
+        std::vector<MPI_Request> pendingRequests;
+    };
+
+} // namespace staging
+} // namespace picongpu
@@ -0,0 +1,183 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "mpi/CommunicatorSplit.hpp"
+
+#include <boost/mpl/int.hpp>
+#include <mpi.h>
+#include <cstring>
+#include <string>
+
+
+namespace picongpu
+{
+namespace staging
+{
+using namespace PMacc;
+
+    /** MPI tags on the intercommunicator between simulation and staging ranks */
+    enum StagingTags
+    {
+        snapshotHeaderTag = 1,
+        snapshotDataTag = 2
+    };
+
+    /** kind of a staging message */
+    enum SnapshotType
+    {
+        /** the simulation rank sends no more data */
+        snapshotFinish = 0,
+        /** one component of a field region follows as float_X array */
+        snapshotField = 1,
+        /** one record of the particles of a species follows, components are interleaved */
+        snapshotParticles = 2
+    };
+
+    /** scalar type of the data behind a header */
+    enum SnapshotValueType
+    {
+        valueBool = 0,
+        valueFloat32 = 1,
+        valueFloat64 = 2,
+        valueInt32 = 3,
+        valueUInt32 = 4,
+        valueInt64 = 5,
+        valueUInt64 = 6
+    };
+
+    /** SnapshotValueType of a scalar type
+     *
+     * @tparam T_Type scalar type
+     * @treturn ::value SnapshotValueType
+     */
+    template<typename T_Type>
+    struct GetSnapshotValueType;
+
+    template<>
+    struct GetSnapshotValueType<bool> : bmpl::int_<valueBool> {};
+    template<>
+    struct GetSnapshotValueType<float_32> : bmpl::int_<valueFloat32> {};
+    template<>
+    struct GetSnapshotValueType<float_64> : bmpl::int_<valueFloat64> {};
+    template<>
+    struct GetSnapshotValueType<int32_t> : bmpl::int_<valueInt32> {};
+    template<>
+    struct GetSnapshotValueType<uint32_t> : bmpl::int_<valueUInt32> {};
+    template<>
+    struct GetSnapshotValueType<int64_t> : bmpl::int_<valueInt64> {};
+    template<>
+    struct GetSnapshotValueType<uint64_t> : bmpl::int_<valueUInt64> {};
+
+    /** size of a scalar of a SnapshotValueType [in byte] */
+    inline size_t getSnapshotValueSize(const int32_t valueType)
+    {
+        switch (valueType)
+        {
+            case valueBool:
+                return sizeof(bool);
+            case valueFloat32:
+            case valueInt32:
+            case valueUInt32:
+                return 4u;
+            default:
+                return 8u;
+        }
+    }
+
+    /** header sent in front of each snapshot */
+    struct SnapshotHeader
+    {
+        int32_t type;
+        uint32_t step;
+        /** record name, e.g. "E/x" or "e/momentum" */
+        char name[64];
+        /** global offset of the local domain [in cells] */
+        int32_t offset[3];
+        /** field: size of the region [in cells], particles: number of particles */
+        int32_t size[3];
+        /** SnapshotValueType of the scalars */
+        int32_t valueType;
+        /** number of interleaved components per element */
+        uint32_t numComponents;
+        /** unit of each component */
+        float_64 unitSI[3];
+
+        SnapshotHeader() :
+            type(snapshotFinish),
+            step(0),
+            valueType(GetSnapshotValueType<float_X>::value),
+            numComponents(1u)
+        {
+            std::memset(name, 0, sizeof(name));
+            for (int d = 0; d < 3; ++d)
+            {
+                offset[d] = 0;
+                size[d] = 1;
+                unitSI[d] = 1.0;
+            }
+        }
+
+        /** number of scalars in the data message */
+        size_t getNumScalars() const
+        {
+            return size_t(size[0]) * size[1] * size[2] * numComponents;
+        }
+
+        void setName(const std::string& recordName)
+        {
+            std::strncpy(name, recordName.c_str(), sizeof(name) - 1);
+        }
+    };
+
+    /** staging rank which serves a simulation rank
+     *
+     * @param simulationRank rank in the simulation communicator
+     * @return rank in the remote group of the intercommunicator
+     */
+    inline int getStagingRank(const int simulationRank)
+    {
+        return simulationRank % static_cast<int>(mpi::CommunicatorSplit::get().getNumStagingRanks());
+    }
+
+    /** tell the staging rank of this simulation rank that no more data follows
+     *
+     * Must be called once by every simulation rank if staging ranks are used.
+     */
+    inline void sendFinish()
+    {
+        mpi::CommunicatorSplit& split = mpi::CommunicatorSplit::get();
+        if (split.getNumStagingRanks() == 0 || split.isStagingRank())
+            return;
+
+        int simulationRank = 0;
+        MPI_CHECK(MPI_Comm_rank(split.getSimulationComm(), &simulationRank));
+
+        SnapshotHeader header;
+        header.type = snapshotFinish;
+        MPI_CHECK(MPI_Send(&header, sizeof(SnapshotHeader), MPI_BYTE,
+                           getStagingRank(simulationRank), snapshotHeaderTag,
+                           split.getInterComm()));
+    }
+
+} // namespace staging
+} // namespace picongpu
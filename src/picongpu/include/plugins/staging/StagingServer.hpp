@@ -0,0 +1,255 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "plugins/staging/StagingProtocol.hpp"
+#include "traits/PICToSplash.hpp"
+#include "mpi/CommunicatorSplit.hpp"
+
+#include <splash/splash.h>
+#include <boost/filesystem.hpp>
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+
+
+namespace picongpu
+{
+namespace staging
+{
+using namespace PMacc;
+
+    /** receive loop of a staging rank
+     *
+     * A staging rank serves the simulation ranks `r` with
+     * `r % numStagingRanks == stagingRank`. Received snapshots are written to
+     * `<folder>/fields_<stagingRank>_0_0.h5`:
+     *   - fields as dataset `/data/<step>/fields/<record>/<simulationRank>`
+     *   - particles as dataset
+     *     `/data/<step>/particles/<species>/<record>[/<component>]/<simulationRank>`,
+     *     the interleaved components are split here and not on the
+     *     simulation ranks
+     * together with the attributes `globalOffset` and `unitSI`.
+     * The loop ends if all served simulation ranks sent snapshotFinish.
+     */
+    class StagingServer
+    {
+    public:
+
+        /** @param folder output directory of the staging ranks */
+        StagingServer(const std::string& folder) : folder(folder)
+        {
+        }
+
+        void run()
+        {
+            mpi::CommunicatorSplit& split = mpi::CommunicatorSplit::get();
+            MPI_Comm interComm = split.getInterComm();
+
+            int stagingRank = 0;
+            int numSimulationRanks = 0;
+            MPI_CHECK(MPI_Comm_rank(split.getLocalComm(), &stagingRank));
+            MPI_CHECK(MPI_Comm_remote_size(interComm, &numSimulationRanks));
+
+            int numClients = 0;
+            for (int r = 0; r < numSimulationRanks; ++r)
+                if (getStagingRank(r) == stagingRank)
+                    ++numClients;
+
+            boost::filesystem::create_directories(folder);
+
+            splash::SerialDataCollector dataCollector(1);
+            splash::DataCollector::FileCreationAttr attr;
+            splash::DataCollector::initFileCreationAttr(attr);
+            attr.fileAccType = splash::DataCollector::FAT_CREATE;
+            attr.mpiPosition.set(stagingRank, 0, 0);
+            dataCollector.open((folder + "/fields").c_str(), attr);
+
+            std::vector<char> buffer;
+            int numFinished = 0;
+            while (numFinished < numClients)
+            {
+                SnapshotHeader header;
+                MPI_Status status;
+                MPI_CHECK(MPI_Recv(&header, sizeof(SnapshotHeader), MPI_BYTE,
+                                   MPI_ANY_SOURCE, snapshotHeaderTag, interComm, &status));
+
+                if (header.type == snapshotFinish)
+                {
+                    ++numFinished;
+                    continue;
+                }
+
+                /* empty records (no particles) are sent without data message */
+                const size_t numBytes = header.getNumScalars() * getSnapshotValueSize(header.valueType);
+                if (numBytes == 0)
+                    continue;
+
+                buffer.resize(numBytes);
+                MPI_CHECK(MPI_Recv(&(buffer.front()), numBytes, MPI_BYTE,
+                                   status.MPI_SOURCE, snapshotDataTag, interComm, MPI_STATUS_IGNORE));
+
+                if (header.type == snapshotField)
+                    writeField(dataCollector, header, status.MPI_SOURCE, buffer);
+                else if (header.type == snapshotParticles)
+                    writeParticles(dataCollector, header, status.MPI_SOURCE, buffer);
+            }
+
+            dataCollector.close();
+        }
+
+    private:
+
+        void writeField(
+            splash::SerialDataCollector& dataCollector,
+            const SnapshotHeader& header,
+            const int simulationRank,
+            const std::vector<char>& data
+        )
+        {
+            typename PICToSplash<float_X>::type splashFloatXType;
+
+            std::stringstream datasetName;
+            datasetName << "fields/" << header.name << "/" << simulationRank;
+
+            const splash::Dimensions size(header.size[0], header.size[1], header.size[2]);
+            dataCollector.write(header.step,
+                                splashFloatXType,
+                                simDim,
+                                splash::Selection(size),
+                                datasetName.str().c_str(),
+                                &(data.front()));
+
+            writeAttributes(dataCollector, header, datasetName.str(), header.unitSI[0]);
+        }
+
+        void writeParticles(
+            splash::SerialDataCollector& dataCollector,
+            const SnapshotHeader& header,
+            const int simulationRank,
+            const std::vector<char>& data
+        )
+        {
+            switch (header.valueType)
+            {
+                case valueBool:
+                    writeParticleRecord<bool>(dataCollector, header, simulationRank, data);
+                    break;
+                case valueFloat32:
+                    writeParticleRecord<float_32>(dataCollector, header, simulationRank, data);
+                    break;
+                case valueFloat64:
+                    writeParticleRecord<float_64>(dataCollector, header, simulationRank, data);
+                    break;
+                case valueInt32:
+                    writeParticleRecord<int32_t>(dataCollector, header, simulationRank, data);
+                    break;
+                case valueUInt32:
+                    writeParticleRecord<uint32_t>(dataCollector, header, simulationRank, data);
+                    break;
+                case valueInt64:
+                    writeParticleRecord<int64_t>(dataCollector, header, simulationRank, data);
+                    break;
+                case valueUInt64:
+                    writeParticleRecord<uint64_t>(dataCollector, header, simulationRank, data);
+                    break;
+                default:
+                    std::cerr << "StagingServer: unknown value type of record " << header.name << std::endl;
+            }
+        }
+
+        /** split the interleaved components of a particle record and write each of them
+         *
+         * @tparam T_Scalar scalar type of the record
+         */
+        template<typename T_Scalar>
+        void writeParticleRecord(
+            splash::SerialDataCollector& dataCollector,
+            const SnapshotHeader& header,
+            const int simulationRank,
+            const std::vector<char>& data
+        )
+        {
+            typename PICToSplash<T_Scalar>::type splashType;
+            const std::string componentNames[] = {"x", "y", "z"};
+
+            const uint32_t numComponents = header.numComponents;
+            const size_t numParticles = header.size[0];
+            const T_Scalar* src = reinterpret_cast<const T_Scalar*>(&(data.front()));
+            /* not std::vector<T_Scalar>, it has no contiguous storage for bool */
+            std::vector<char> componentBuffer(numParticles * sizeof(T_Scalar));
+            T_Scalar* component = reinterpret_cast<T_Scalar*>(&(componentBuffer.front()));
+
+            for (uint32_t c = 0; c < numComponents; ++c)
+            {
+                for (size_t i = 0; i < numParticles; ++i)
+                    component[i] = src[i * numComponents + c];
+
+                std::stringstream datasetName;
+                datasetName << "particles/" << header.name;
+                if (numComponents > 1)
+                    datasetName << "/" << componentNames[c];
+                datasetName << "/" << simulationRank;
+
+                dataCollector.write(header.step,
+                                    splashType,
+                                    1u,
+                                    splash::Selection(splash::Dimensions(numParticles, 1, 1)),
+                                    datasetName.str().c_str(),
+                                    component);
+
+                writeAttributes(dataCollector, header, datasetName.str(), header.unitSI[c]);
+            }
+        }
+
+        void writeAttributes(
+            splash::SerialDataCollector& dataCollector,
+            const SnapshotHeader& header,
+            const std::string& datasetName,
+            const float_64 unitSI
+        )
+        {
+            splash::ColTypeInt32 ctInt32;
+            splash::ColTypeDouble ctDouble;
+
+            dataCollector.writeAttribute(header.step,
+                                         ctInt32,
+                                         datasetName.c_str(),
+                                         "globalOffset",
+                                         1u,
+                                         splash::Dimensions(simDim, 0, 0),
+                                         header.offset);
+
+            dataCollector.writeAttribute(header.step,
+                                         ctDouble,
+                                         datasetName.c_str(),
+                                         "unitSI",
+                                         &unitSI);
+        }
+
+        std::string folder;
+    };
+
+} // namespace staging
+} // namespace picongpu
@@ -0,0 +1,382 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "plugins/ISimulationPlugin.hpp"
+#include "plugins/common/FieldComponentBuffer.hpp"
+#include "plugins/common/RegionOfInterest.hpp"
+#include "plugins/common/stringHelpers.hpp"
+#include "plugins/streaming/StreamProtocol.hpp"
+#include "plugins/streaming/StreamTransport.hpp"
+#include "plugins/streaming/StreamSender.hpp"
+#include "plugins/streaming/StreamSpecies.hpp"
+#include "simulationControl/MovingWindow.hpp"
+#include "fields/FieldE.hpp"
+#include "fields/FieldB.hpp"
+#include "fields/FieldManipulator.hpp"
+#include "fields/currentInterpolation/CurrentInterpolation.hpp"
+#include "Environment.hpp"
+
+#include "dataManagement/DataConnector.hpp"
+
+#include <mpi.h>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace picongpu
+{
+namespace streaming
+{
+using namespace PMacc;
+
+    /** publish openPMD records of each output step to a local consumer
+     *
+     * Every rank builds one message per step with the meta data of the
+     * openPMD output (see hdf5::WriteMeta), the fields E and B of its part of
+     * the moving window and the particles of all FileOutputParticles species.
+     * The message is handed to a StreamSender, the simulation only waits
+     * for the device to host copies. A consumer which cannot keep up loses
+     * steps according to the drop policy instead of stalling the simulation.
+     *
+     * Mesh records are stored in C order like the openPMD axisLabels,
+     * e.g. F[z][y][x]. Constant particle records (charge, mass) and particle
+     * patches are not streamed.
+     *
+     * The reference consumer is src/tools/openPMDStream.
+     */
+    class OpenPMDStream : public ISimulationPlugin
+    {
+    public:
+
+        OpenPMDStream() :
+            notifyPeriod(0),
+            transportName("unix"),
+            address("picongpu_stream.sock"),
+            maxQueuedSteps(2),
+            policyName("oldest"),
+            timeoutMs(1000),
+            sendTimeoutMs(10000),
+            closeTimeoutMs(10000),
+            cellDescription(nullptr)
+        {
+            Environment<>::get().PluginConnector().registerPlugin(this);
+        }
+
+        virtual ~OpenPMDStream()
+        {
+        }
+
+        void notify(uint32_t currentStep)
+        {
+            GridController<simDim>& gc = Environment<simDim>::get().GridController();
+
+            /* A step which would be dropped is not copied from the device.
+             * Building a step is collective, therefore it is dropped on all
+             * ranks if one rank has no free slot.
+             */
+            int hasSlot = sender->reserveSlot() ? 1 : 0;
+            int allHaveSlot = 0;
+            MPI_CHECK(MPI_Allreduce(&hasSlot, &allHaveSlot, 1, MPI_INT, MPI_MIN,
+                                    gc.getCommunicator().getMPIComm()));
+            if (allHaveSlot == 0)
+            {
+                sender->dropMessage();
+                log<picLog::INPUT_OUTPUT >("Stream: step %1% dropped (sent %2%, dropped %3%, failed %4%)") %
+                    currentStep % sender->getNumSent() % sender->getNumDropped() % sender->getNumFailed();
+                return;
+            }
+
+            StreamParams params;
+            MessageWriter writer;
+            params.writer = &writer;
+            params.currentStep = currentStep;
+            params.cellDescription = cellDescription;
+            params.regionOfInterest = &regionOfInterest;
+            params.window = regionOfInterest.restrict(MovingWindow::getInstance().getWindow(currentStep), currentStep);
+            params.localWindowToDomainOffset = openPMD::RegionOfInterest::getLocalWindowToDomainOffset(params.window);
+
+            writeMeta(params);
+            streamField<FieldE>(params);
+            streamField<FieldB>(params);
+
+            const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+            const DataSpace<simDim> domainOffset(
+                subGrid.getGlobalDomain().offset +
+                subGrid.getLocalDomain().offset
+            );
+            ForEach<FileOutputParticles, StreamSpecies<bmpl::_1> > streamSpecies;
+            streamSpecies(&params, domainOffset);
+
+            const bool isQueued = sender->publish(std::make_shared<std::vector<char> >(
+                writer.finish(gc.getGlobalRank(), gc.getGlobalSize(), currentStep)
+            ));
+
+            log<picLog::INPUT_OUTPUT >("Stream: step %1% %2% (sent %3%, dropped %4%, failed %5%)") %
+                currentStep % (isQueued ? "queued" : "dropped") %
+                sender->getNumSent() % sender->getNumDropped() % sender->getNumFailed();
+        }
+
+        void pluginRegisterHelp(po::options_description& desc)
+        {
+            desc.add_options()
+                ("stream.period", po::value<uint32_t>(&notifyPeriod)->default_value(0),
+                 "publish openPMD records to a consumer [for each n-th step]")
+                ("stream.transport", po::value<std::string>(&transportName)->default_value(transportName),
+                 "transport to the consumer, supported: unix (local socket)")
+                ("stream.address", po::value<std::string>(&address)->default_value(address),
+                 "address of the consumer, for unix the path of the socket")
+                ("stream.queue", po::value<uint32_t>(&maxQueuedSteps)->default_value(maxQueuedSteps),
+                 "maximal number of steps waiting for the consumer per rank")
+                ("stream.policy", po::value<std::string>(&policyName)->default_value(policyName),
+                 "if the queue is full: oldest, newest (drop this step) or block (wait up to stream.timeout)")
+                ("stream.timeout", po::value<uint32_t>(&timeoutMs)->default_value(timeoutMs),
+                 "maximal wait for a free queue slot with policy block [ms]")
+                ("stream.sendTimeout", po::value<uint32_t>(&sendTimeoutMs)->default_value(sendTimeoutMs),
+                 "maximal time to deliver one step to the consumer, afterwards the connection is closed [ms], "
+                 "0 waits forever")
+                ("stream.closeTimeout", po::value<uint32_t>(&closeTimeoutMs)->default_value(closeTimeoutMs),
+                 "maximal wait for queued steps at the end of the simulation, afterwards they are dropped [ms]");
+            regionOfInterest.registerHelp(desc, "stream");
+        }
+
+        std::string pluginGetName() const
+        {
+            return "OpenPMDStream";
+        }
+
+        void setMappingDescription(MappingDesc* cellDescription)
+        {
+            this->cellDescription = cellDescription;
+        }
+
+    private:
+
+        void pluginLoad()
+        {
+            if (notifyPeriod == 0)
+                return;
+
+            regionOfInterest.load("stream");
+            const DropPolicy policy = getDropPolicy(policyName);
+            sender.reset(new StreamSender(
+                createTransport(transportName, address, sendTimeoutMs),
+                maxQueuedSteps,
+                policy,
+                timeoutMs,
+                closeTimeoutMs
+            ));
+
+            const DataSpace<simDim> localSize = Environment<simDim>::get().SubGrid().getLocalDomain().size;
+            fieldComponentBuffer.reset(new openPMD::FieldComponentBuffer<float_X>(localSize));
+
+            Environment<>::get().PluginConnector().setNotificationPeriod(this, notifyPeriod);
+        }
+
+        void pluginUnload()
+        {
+            if (sender)
+            {
+                /* waits until all queued steps are delivered or failed, at most stream.closeTimeout */
+                sender.reset();
+                log<picLog::INPUT_OUTPUT >("Stream: finished");
+            }
+            fieldComponentBuffer.reset();
+        }
+
+        /** add the openPMD meta data of the step, same as hdf5::WriteMeta */
+        void writeMeta(StreamParams& params) const
+        {
+            MessageWriter& writer = *params.writer;
+            const std::string meshesPath("fields/");
+
+            writer.addAttribute("/", "openPMD", "1.0.0");
+            writer.addAttribute("/", "openPMDextension", uint32_t(1)); // ED-PIC ID
+            writer.addAttribute("/", "basePath", "/data/%T/");
+            writer.addAttribute("/", "meshesPath", meshesPath);
+            writer.addAttribute("/", "particlesPath", "particles/");
+            writer.addAttribute("/", "iterationEncoding", "fileBased");
+            writer.addAttribute("/", "iterationFormat", "stream_%T");
+
+            const std::string author = Environment<>::get().SimulationDescription().getAuthor();
+            if (author.length() > 0)
+                writer.addAttribute("/", "author", author);
+            writer.addAttribute("/", "software", "PIConGPU");
+            std::stringstream softwareVersion;
+            softwareVersion << PICONGPU_VERSION_MAJOR << "."
+                            << PICONGPU_VERSION_MINOR << "."
+                            << PICONGPU_VERSION_PATCH;
+            if (!std::string(PICONGPU_VERSION_LABEL).empty())
+                softwareVersion << "-" << PICONGPU_VERSION_LABEL;
+            writer.addAttribute("/", "softwareVersion", softwareVersion.str());
+            writer.addAttribute("/", "date", helper::getDateString("%F %T %z"));
+
+            /* ED-PIC */
+            GetStringProperties<fieldSolver::FieldSolver> fieldSolverProps;
+            writer.addAttribute(meshesPath, "fieldSolver", fieldSolverProps["name"].value);
+
+            /* order as in axisLabels:
+             *    3D: z-lower, z-upper, y-lower, y-upper, x-lower, x-upper
+             *    2D: y-lower, y-upper, x-lower, x-upper
+             */
+            GetStringProperties<FieldManipulator> fieldBoundaryProp;
+            std::vector<std::string> fieldBoundary;
+            std::vector<std::string> fieldBoundaryParam;
+            for (uint32_t i = NumberOfExchanges<simDim>::value - 1; i > 0; --i)
+            {
+                if (FRONT % i == 0)
+                {
+                    fieldBoundary.push_back(fieldBoundaryProp[ExchangeTypeNames()[i]]["name"].value);
+                    fieldBoundaryParam.push_back(fieldBoundaryProp[ExchangeTypeNames()[i]]["param"].value);
+                }
+            }
+            writer.addAttribute(meshesPath, "fieldBoundary", fieldBoundary);
+            writer.addAttribute(meshesPath, "fieldBoundaryParameters", fieldBoundaryParam);
+
+            GetStringProperties<fieldSolver::CurrentInterpolation> currentSmoothingProp;
+            writer.addAttribute(meshesPath, "currentSmoothing", currentSmoothingProp["name"].value);
+            if (currentSmoothingProp.find("param") != currentSmoothingProp.end())
+                writer.addAttribute(meshesPath, "currentSmoothingParameters", currentSmoothingProp["param"].value);
+            writer.addAttribute(meshesPath, "chargeCorrection", "none");
+
+            /* iteration */
+            const std::string iterationPath("");
+            writer.addAttribute(iterationPath, "sim_slides",
+                                uint32_t(MovingWindow::getInstance().getSlideCounter(params.currentStep)));
+            writer.addAttribute(iterationPath, "dt", float_X(DELTA_T));
+            writer.addAttribute(iterationPath, "time", float_X(float_X(params.currentStep) * DELTA_T));
+            writer.addAttribute(iterationPath, "timeUnitSI", float_64(UNIT_TIME));
+
+            writer.addAttribute(iterationPath, "cell_width", float_X(CELL_WIDTH));
+            writer.addAttribute(iterationPath, "cell_height", float_X(CELL_HEIGHT));
+            if (simDim == DIM3)
+                writer.addAttribute(iterationPath, "cell_depth", float_X(CELL_DEPTH));
+
+            writer.addAttribute(iterationPath, "unit_energy", float_64(UNIT_ENERGY));
+            writer.addAttribute(iterationPath, "unit_length", float_64(UNIT_LENGTH));
+            writer.addAttribute(iterationPath, "unit_speed", float_64(UNIT_SPEED));
+            writer.addAttribute(iterationPath, "unit_time", float_64(UNIT_TIME));
+            writer.addAttribute(iterationPath, "unit_mass", float_64(UNIT_MASS));
+            writer.addAttribute(iterationPath, "unit_charge", float_64(UNIT_CHARGE));
+            writer.addAttribute(iterationPath, "unit_efield", float_64(UNIT_EFIELD));
+            writer.addAttribute(iterationPath, "unit_bfield", float_64(UNIT_BFIELD));
+
+            writer.addAttribute(iterationPath, "mue0", float_X(MUE0));
+            writer.addAttribute(iterationPath, "eps0", float_X(EPS0));
+        }
+
+        /** add all components of the local window of a field
+         *
+         * @tparam T_Field field type, e.g. FieldE
+         */
+        template<typename T_Field>
+        void streamField(StreamParams& params)
+        {
+            DataConnector& dc = Environment<>::get().DataConnector();
+            auto field = dc.get<T_Field>(T_Field::getName(), true);
+
+            const std::string recordPath = std::string("fields/") + T_Field::getName();
+            const std::string componentNames[] = {"x", "y", "z"};
+            const Window& window = params.window;
+
+            DataSpace<simDim> globalSlideOffset;
+            globalSlideOffset.y() += MovingWindow::getInstance().getSlideDistance(params.currentStep);
+
+            /* C order: the slowest varying dimension first */
+            uint64_t globalSize[3];
+            uint64_t offset[3];
+            uint64_t size[3];
+            std::vector<float_X> gridSpacing(simDim);
+            std::vector<float_64> gridGlobalOffset(simDim);
+            std::vector<std::string> axisLabels(simDim);
+            for (uint32_t d = 0; d < simDim; ++d)
+            {
+                const uint32_t i = simDim - 1 - d;
+                globalSize[i] = window.globalDimensions.size[d];
+                offset[i] = window.localDimensions.offset[d];
+                size[i] = window.localDimensions.size[d];
+                gridSpacing[i] = cellSize[d];
+                gridGlobalOffset[i] = float_64(cellSize[d]) *
+                    float_64(window.globalDimensions.offset[d] + globalSlideOffset[d]);
+                axisLabels[i] = std::string(1, char('x' + d));
+            }
+
+            const fieldSolver::numericalCellType::traits::FieldPosition<T_Field> fieldPos;
+            const typename T_Field::UnitValueType unit = T_Field::getUnit();
+            const DataSpace<simDim> guard = field->getGridLayout().getGuard() + params.localWindowToDomainOffset;
+
+            for (uint32_t c = 0; c < T_Field::numComponents; ++c)
+            {
+                const std::string componentPath = recordPath + std::string("/") + componentNames[c];
+                const float_X* data = fieldComponentBuffer->extract(
+                    field->getGridBuffer().getDeviceBuffer().getDataBox(),
+                    guard,
+                    window.localDimensions.size,
+                    c
+                );
+                params.writer->addRecord(
+                    componentPath,
+                    ToStreamType<float_X>::value,
+                    simDim,
+                    globalSize,
+                    offset,
+                    size,
+                    data
+                );
+
+                std::vector<float_X> position(simDim);
+                for (uint32_t d = 0; d < simDim; ++d)
+                    position[d] = fieldPos()[c][d];
+                params.writer->addAttribute(componentPath, "position", position);
+                params.writer->addAttribute(componentPath, "unitSI", float_64(unit[c]));
+            }
+            dc.releaseData(T_Field::getName());
+
+            params.writer->addAttribute(recordPath, "unitDimension", T_Field::getUnitDimension());
+            params.writer->addAttribute(recordPath, "timeOffset", float_X(0.0));
+            params.writer->addAttribute(recordPath, "geometry", "cartesian");
+            params.writer->addAttribute(recordPath, "dataOrder", "C");
+            params.writer->addAttribute(recordPath, "axisLabels", axisLabels);
+            params.writer->addAttribute(recordPath, "gridSpacing", gridSpacing);
+            params.writer->addAttribute(recordPath, "gridGlobalOffset", gridGlobalOffset);
+            params.writer->addAttribute(recordPath, "gridUnitSI", float_64(UNIT_LENGTH));
+            params.writer->addAttribute(recordPath, "fieldSmoothing", "none");
+        }
+
+        uint32_t notifyPeriod;
+        std::string transportName;
+        std::string address;
+        uint32_t maxQueuedSteps;
+        std::string policyName;
+        uint32_t timeoutMs;
+        uint32_t sendTimeoutMs;
+        uint32_t closeTimeoutMs;
+        MappingDesc* cellDescription;
+
+        openPMD::RegionOfInterest regionOfInterest;
+        std::unique_ptr<StreamSender> sender;
+        std::unique_ptr<openPMD::FieldComponentBuffer<float_X> > fieldComponentBuffer;
+    };
+
+} // namespace streaming
+} // namespace picongpu
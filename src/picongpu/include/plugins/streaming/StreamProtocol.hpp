@@ -0,0 +1,403 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* This header is shared with the consumer tool (src/tools/openPMDStream)
+ * and must not depend on PIConGPU or PMacc headers.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace picongpu
+{
+namespace streaming
+{
+
+    /** first bytes of each step message */
+    constexpr uint32_t streamMagic = 0x4f504d53; /* "SMPO" */
+    /** increased with each incompatible change of the message layout */
+    constexpr uint32_t streamVersion = 2;
+
+    /** type of attribute values and record data */
+    enum StreamDataType
+    {
+        streamFloat32 = 0,
+        streamFloat64 = 1,
+        streamUInt32 = 2,
+        streamUInt64 = 3,
+        streamInt32 = 4,
+        streamInt64 = 5,
+        /** characters of a single string, count is the length */
+        streamString = 6,
+        /** '\0' terminated strings, count is the number of strings */
+        streamStringArray = 7,
+        /** one byte per value, 0 is false */
+        streamBool = 8
+    };
+
+    /** size of one element of a type in byte, 1 for strings */
+    inline size_t getTypeSize(const uint32_t type)
+    {
+        switch (type)
+        {
+        case streamFloat32:
+        case streamUInt32:
+        case streamInt32:
+            return 4u;
+        case streamFloat64:
+        case streamUInt64:
+        case streamInt64:
+            return 8u;
+        case streamString:
+        case streamStringArray:
+        case streamBool:
+            return 1u;
+        }
+        throw std::runtime_error("openPMD stream: unknown data type");
+    }
+
+    /** map C++ types to stream types */
+    template<typename T_Type>
+    struct ToStreamType;
+
+    template<> struct ToStreamType<float> { static constexpr uint32_t value = streamFloat32; };
+    template<> struct ToStreamType<double> { static constexpr uint32_t value = streamFloat64; };
+    template<> struct ToStreamType<uint32_t> { static constexpr uint32_t value = streamUInt32; };
+    template<> struct ToStreamType<uint64_t> { static constexpr uint32_t value = streamUInt64; };
+    template<> struct ToStreamType<int32_t> { static constexpr uint32_t value = streamInt32; };
+    template<> struct ToStreamType<int64_t> { static constexpr uint32_t value = streamInt64; };
+    template<> struct ToStreamType<bool> { static constexpr uint32_t value = streamBool; };
+    static_assert(sizeof(bool) == 1u, "openPMD stream: streamBool needs a one byte bool");
+
+    /** step message layout
+     *
+     * A message holds the data of one simulation rank for one step. All
+     * integers are in host byte order, transports are node local.
+     *
+     *   uint32 magic, uint32 version, uint32 rank, uint32 numRanks, uint64 step
+     *   uint32 numAttributes, numAttributes x attribute
+     *   uint32 numRecords, numRecords x record
+     *
+     * attribute: string path, string name, uint32 type, uint64 count, data
+     * record: string path, uint32 type, uint32 ndim,
+     *         uint64 globalSize[3], uint64 offset[3], uint64 size[3], data
+     *
+     * A string is a uint32 length followed by the characters. Attribute paths
+     * follow openPMD relative to the iteration ("" is the iteration itself,
+     * "/" holds the file global attributes). Record data is contiguous with
+     * the first dimension (x) varying fastest, which is the openPMD "C" order
+     * for the reversed axisLabels.
+     */
+    class MessageWriter
+    {
+    public:
+
+        MessageWriter() : numAttributes(0), numRecords(0)
+        {
+        }
+
+        template<typename T_Type>
+        void addAttribute(const std::string& path, const std::string& name, const T_Type value)
+        {
+            addAttribute(path, name, ToStreamType<T_Type>::value, 1u, &value);
+        }
+
+        template<typename T_Type>
+        void addAttribute(const std::string& path, const std::string& name, const std::vector<T_Type>& values)
+        {
+            addAttribute(path, name, ToStreamType<T_Type>::value, values.size(), values.data());
+        }
+
+        void addAttribute(const std::string& path, const std::string& name, const std::string& value)
+        {
+            addAttribute(path, name, streamString, value.size(), value.data());
+        }
+
+        void addAttribute(const std::string& path, const std::string& name, const char* value)
+        {
+            addAttribute(path, name, std::string(value));
+        }
+
+        void addAttribute(const std::string& path, const std::string& name, const std::vector<std::string>& values)
+        {
+            std::string joined;
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                joined += values[i];
+                joined.push_back('\0');
+            }
+            put(attributes, path);
+            put(attributes, name);
+            put(attributes, uint32_t(streamStringArray));
+            put(attributes, uint64_t(values.size()));
+            append(attributes, joined.data(), joined.size());
+            ++numAttributes;
+        }
+
+        /** add a record
+         *
+         * @param path openPMD path of the record component, e.g. "fields/E/x"
+         * @param type stream type of the data
+         * @param ndim number of dimensions (1-3)
+         * @param globalSize size of the record over all ranks
+         * @param offset offset of this rank's block in the record
+         * @param size size of this rank's block
+         * @param data contiguous data of the block
+         */
+        void addRecord(
+            const std::string& path,
+            const uint32_t type,
+            const uint32_t ndim,
+            const uint64_t globalSize[3],
+            const uint64_t offset[3],
+            const uint64_t size[3],
+            const void* data
+        )
+        {
+            put(records, path);
+            put(records, type);
+            put(records, ndim);
+            uint64_t numElements = 1u;
+            for (uint32_t d = 0; d < 3u; ++d)
+                put(records, d < ndim ? globalSize[d] : uint64_t(1u));
+            for (uint32_t d = 0; d < 3u; ++d)
+                put(records, d < ndim ? offset[d] : uint64_t(0u));
+            for (uint32_t d = 0; d < 3u; ++d)
+            {
+                const uint64_t s = d < ndim ? size[d] : uint64_t(1u);
+                put(records, s);
+                numElements *= s;
+            }
+            append(records, data, numElements * getTypeSize(type));
+            ++numRecords;
+        }
+
+        /** create the message, the writer is empty afterwards */
+        std::vector<char> finish(const uint32_t rank, const uint32_t numRanks, const uint64_t step)
+        {
+            std::vector<char> message;
+            message.reserve(attributes.size() + records.size() + 64u);
+            put(message, streamMagic);
+            put(message, streamVersion);
+            put(message, rank);
+            put(message, numRanks);
+            put(message, step);
+            put(message, numAttributes);
+            message.insert(message.end(), attributes.begin(), attributes.end());
+            put(message, numRecords);
+            message.insert(message.end(), records.begin(), records.end());
+
+            attributes.clear();
+            records.clear();
+            numAttributes = 0;
+            numRecords = 0;
+            return message;
+        }
+
+    private:
+
+        void addAttribute(
+            const std::string& path,
+            const std::string& name,
+            const uint32_t type,
+            const uint64_t count,
+            const void* data
+        )
+        {
+            put(attributes, path);
+            put(attributes, name);
+            put(attributes, type);
+            put(attributes, count);
+            append(attributes, data, count * getTypeSize(type));
+            ++numAttributes;
+        }
+
+        static void append(std::vector<char>& buffer, const void* data, const size_t numBytes)
+        {
+            const char* bytes = static_cast<const char*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + numBytes);
+        }
+
+        template<typename T_Type>
+        static void put(std::vector<char>& buffer, const T_Type value)
+        {
+            append(buffer, &value, sizeof(T_Type));
+        }
+
+        static void put(std::vector<char>& buffer, const std::string& value)
+        {
+            put(buffer, uint32_t(value.size()));
+            append(buffer, value.data(), value.size());
+        }
+
+        std::vector<char> attributes;
+        std::vector<char> records;
+        uint32_t numAttributes;
+        uint32_t numRecords;
+    };
+
+    /** attribute of a received message */
+    struct StreamAttribute
+    {
+        std::string path;
+        std::string name;
+        uint32_t type;
+        uint64_t count;
+        /** points into the message */
+        const char* data;
+    };
+
+    /** record of a received message */
+    struct StreamRecord
+    {
+        std::string path;
+        uint32_t type;
+        uint32_t ndim;
+        uint64_t globalSize[3];
+        uint64_t offset[3];
+        uint64_t size[3];
+        /** points into the message */
+        const char* data;
+
+        uint64_t getNumElements() const
+        {
+            return size[0] * size[1] * size[2];
+        }
+    };
+
+    /** parsed step message, references the message buffer */
+    struct StreamStep
+    {
+        uint32_t rank;
+        uint32_t numRanks;
+        uint64_t step;
+        std::vector<StreamAttribute> attributes;
+        std::vector<StreamRecord> records;
+    };
+
+    namespace detail
+    {
+        /** sequential reader of a message buffer */
+        struct MessageCursor
+        {
+            const std::vector<char>& buffer;
+            size_t pos;
+
+            MessageCursor(const std::vector<char>& message) : buffer(message), pos(0u)
+            {
+            }
+
+            const char* take(const uint64_t numBytes)
+            {
+                if (numBytes > buffer.size() - pos)
+                    throw std::runtime_error("openPMD stream: truncated message");
+                const char* ptr = buffer.data() + pos;
+                pos += numBytes;
+                return ptr;
+            }
+
+            template<typename T_Type>
+            T_Type get()
+            {
+                T_Type value;
+                std::memcpy(&value, take(sizeof(T_Type)), sizeof(T_Type));
+                return value;
+            }
+
+            std::string getString()
+            {
+                const uint32_t length = get<uint32_t>();
+                return std::string(take(length), length);
+            }
+        };
+    } // namespace detail
+
+    /** parse a step message
+     *
+     * @param message buffer which must outlive the result
+     * @return parsed step, throws std::runtime_error for broken messages
+     */
+    inline StreamStep parseMessage(const std::vector<char>& message)
+    {
+        detail::MessageCursor cursor(message);
+
+        if (cursor.get<uint32_t>() != streamMagic)
+            throw std::runtime_error("openPMD stream: message has no stream header");
+        if (cursor.get<uint32_t>() != streamVersion)
+            throw std::runtime_error("openPMD stream: unsupported message version");
+
+        StreamStep step;
+        step.rank = cursor.get<uint32_t>();
+        step.numRanks = cursor.get<uint32_t>();
+        step.step = cursor.get<uint64_t>();
+
+        const uint32_t numAttributes = cursor.get<uint32_t>();
+        step.attributes.resize(numAttributes);
+        for (uint32_t i = 0; i < numAttributes; ++i)
+        {
+            StreamAttribute& attribute = step.attributes[i];
+            attribute.path = cursor.getString();
+            attribute.name = cursor.getString();
+            attribute.type = cursor.get<uint32_t>();
+            attribute.count = cursor.get<uint64_t>();
+            uint64_t numBytes = attribute.count * getTypeSize(attribute.type);
+            /* the count of a string array is the number of strings */
+            if (attribute.type == streamStringArray)
+            {
+                numBytes = 0u;
+                for (uint64_t s = 0; s < attribute.count; ++s)
+                {
+                    const size_t end = cursor.pos + numBytes;
+                    const void* terminator = std::memchr(message.data() + end, '\0', message.size() - end);
+                    if (terminator == nullptr)
+                        throw std::runtime_error("openPMD stream: truncated message");
+                    numBytes = static_cast<const char*>(terminator) - (message.data() + cursor.pos) + 1u;
+                }
+            }
+            attribute.data = cursor.take(numBytes);
+        }
+
+        const uint32_t numRecords = cursor.get<uint32_t>();
+        step.records.resize(numRecords);
+        for (uint32_t i = 0; i < numRecords; ++i)
+        {
+            StreamRecord& record = step.records[i];
+            record.path = cursor.getString();
+            record.type = cursor.get<uint32_t>();
+            record.ndim = cursor.get<uint32_t>();
+            for (uint32_t d = 0; d < 3u; ++d)
+                record.globalSize[d] = cursor.get<uint64_t>();
+            for (uint32_t d = 0; d < 3u; ++d)
+                record.offset[d] = cursor.get<uint64_t>();
+            for (uint32_t d = 0; d < 3u; ++d)
+                record.size[d] = cursor.get<uint64_t>();
+            record.data = cursor.take(record.getNumElements() * getTypeSize(record.type));
+        }
+
+        return step;
+    }
+
+} // namespace streaming
+} // namespace picongpu
@@ -0,0 +1,269 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "plugins/streaming/StreamTransport.hpp"
+
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace picongpu
+{
+namespace streaming
+{
+
+    /** what happens with a step if the send queue is full */
+    enum DropPolicy
+    {
+        /** wait for a free slot, but at most the configured timeout, then drop the new step */
+        dropPolicyBlock = 0,
+        /** discard the oldest queued step */
+        dropPolicyOldest = 1,
+        /** discard the new step */
+        dropPolicyNewest = 2
+    };
+
+    /** parse a drop policy name: block, oldest or newest */
+    inline DropPolicy getDropPolicy(const std::string& name)
+    {
+        if (name == "block")
+            return dropPolicyBlock;
+        if (name == "oldest")
+            return dropPolicyOldest;
+        if (name == "newest")
+            return dropPolicyNewest;
+        throw std::runtime_error("openPMD stream: unknown drop policy '" + name + "'");
+    }
+
+    /** send step messages in a background thread
+     *
+     * publish() hands a message to a bounded queue and returns. A sender
+     * thread delivers the queued messages in order through the transport,
+     * which blocks while the consumer is slow. If the queue is full, the drop
+     * policy decides which step is lost, so the simulation never waits longer
+     * than the timeout of the block policy. reserveSlot() applies the policy
+     * before a message is built.
+     */
+    class StreamSender
+    {
+    public:
+
+        typedef std::shared_ptr<std::vector<char> > Message;
+
+        /**
+         * @param transport transport to the consumer, the sender takes ownership
+         * @param maxQueuedSteps capacity of the queue (>= 1)
+         * @param policy drop policy if the queue is full
+         * @param timeoutMs maximal wait of publish() for dropPolicyBlock
+         * @param closeTimeoutMs maximal wait of the destructor for queued messages
+         */
+        StreamSender(
+            IStreamTransport* transport,
+            const uint32_t maxQueuedSteps,
+            const DropPolicy policy,
+            const uint32_t timeoutMs,
+            const uint32_t closeTimeoutMs
+        ) :
+            transport(transport),
+            maxQueuedSteps(maxQueuedSteps == 0u ? 1u : maxQueuedSteps),
+            policy(policy),
+            timeoutMs(timeoutMs),
+            closeTimeoutMs(closeTimeoutMs),
+            isClosed(false),
+            numSent(0),
+            numDropped(0),
+            numFailed(0)
+        {
+            sender = boost::thread(&StreamSender::sendLoop, this);
+        }
+
+        /** deliver the queued messages and stop the sender thread
+         *
+         * Waits at most closeTimeoutMs for the queue to drain, afterwards the
+         * remaining messages are dropped. The message in delivery is bounded by
+         * the send timeout of the transport.
+         */
+        ~StreamSender()
+        {
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                const boost::system_time deadline =
+                    boost::get_system_time() + boost::posix_time::milliseconds(closeTimeoutMs);
+                while (!queue.empty())
+                {
+                    if (!queueChanged.timed_wait(lock, deadline))
+                        break;
+                }
+                numDropped += queue.size();
+                queue.clear();
+                isClosed = true;
+            }
+            queueChanged.notify_all();
+            sender.join();
+        }
+
+        /** apply the drop policy for the next message before it is built
+         *
+         * Must be called by the only thread which publishes messages. If it
+         * returns true, the following publish() queues the message without
+         * waiting. If the message is not built, call dropMessage().
+         *
+         * @return false if the next message would be dropped
+         */
+        bool reserveSlot()
+        {
+            boost::unique_lock<boost::mutex> lock(mutex);
+            return waitForSlot(lock);
+        }
+
+        /** count a message which is not built and published */
+        void dropMessage()
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+            ++numDropped;
+        }
+
+        /** queue a message
+         *
+         * @return false if the message was dropped
+         */
+        bool publish(const Message& message)
+        {
+            boost::unique_lock<boost::mutex> lock(mutex);
+            if (!waitForSlot(lock))
+            {
+                ++numDropped;
+                return false;
+            }
+            if (queue.size() >= maxQueuedSteps)
+            {
+                /* dropPolicyOldest */
+                queue.pop_front();
+                ++numDropped;
+            }
+            queue.push_back(message);
+            lock.unlock();
+            queueChanged.notify_all();
+            return true;
+        }
+
+        /** number of delivered messages */
+        uint64_t getNumSent()
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+            return numSent;
+        }
+
+        /** number of messages dropped by the drop policy */
+        uint64_t getNumDropped()
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+            return numDropped;
+        }
+
+        /** number of messages the transport could not deliver, e.g. no consumer */
+        uint64_t getNumFailed()
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+            return numFailed;
+        }
+
+    private:
+
+        /** wait for a free slot according to the drop policy
+         *
+         * @return false if a new message must be dropped, with dropPolicyOldest
+         *         always true even if the queue is full
+         */
+        bool waitForSlot(boost::unique_lock<boost::mutex>& lock)
+        {
+            if (queue.size() < maxQueuedSteps || policy == dropPolicyOldest)
+                return true;
+            if (policy == dropPolicyNewest)
+                return false;
+
+            const boost::system_time deadline =
+                boost::get_system_time() + boost::posix_time::milliseconds(timeoutMs);
+            while (queue.size() >= maxQueuedSteps)
+            {
+                if (!queueChanged.timed_wait(lock, deadline))
+                    break;
+            }
+            return queue.size() < maxQueuedSteps;
+        }
+
+        void sendLoop()
+        {
+            while (true)
+            {
+                Message message;
+                {
+                    boost::unique_lock<boost::mutex> lock(mutex);
+                    while (queue.empty() && !isClosed)
+                        queueChanged.wait(lock);
+                    if (queue.empty())
+                        return;
+                    message = queue.front();
+                    queue.pop_front();
+                }
+                /* a free slot for publish() */
+                queueChanged.notify_all();
+
+                const bool isSent = transport->send(*message);
+
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    if (isSent)
+                        ++numSent;
+                    else
+                        ++numFailed;
+                }
+            }
+        }
+
+        std::unique_ptr<IStreamTransport> transport;
+        const uint32_t maxQueuedSteps;
+        const DropPolicy policy;
+        const uint32_t timeoutMs;
+        const uint32_t closeTimeoutMs;
+
+        boost::mutex mutex;
+        boost::condition_variable queueChanged;
+        std::deque<Message> queue;
+        bool isClosed;
+        uint64_t numSent;
+        uint64_t numDropped;
+        uint64_t numFailed;
+
+        boost::thread sender;
+    };
+
+} // namespace streaming
+} // namespace picongpu
@@ -0,0 +1,254 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "plugins/streaming/StreamProtocol.hpp"
+#include "plugins/common/RegionOfInterest.hpp"
+#include "plugins/output/WriteSpeciesCommon.hpp"
+#include "plugins/kernel/CopySpecies.kernel"
+#include "traits/PICToOpenPMD.hpp"
+#include "traits/GetComponentsType.hpp"
+#include "traits/GetNComponents.hpp"
+#include "traits/Resolve.hpp"
+#include "simulationControl/Window.hpp"
+#include "assert.hpp"
+
+#include "mappings/kernel/AreaMapping.hpp"
+#include "particles/operations/CountParticles.hpp"
+#include "compileTime/conversion/MakeSeq.hpp"
+#include "compileTime/conversion/RemoveFromSeq.hpp"
+#include "dataManagement/DataConnector.hpp"
+#include "particles/ParticleDescription.hpp"
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+
+namespace picongpu
+{
+namespace streaming
+{
+using namespace PMacc;
+
+    /** state of a stream message which is shared by all functors of a step */
+    struct StreamParams
+    {
+        MessageWriter* writer;
+        uint32_t currentStep;
+        Window window;
+        DataSpace<simDim> localWindowToDomainOffset;
+        MappingDesc* cellDescription;
+        openPMD::RegionOfInterest* regionOfInterest;
+    };
+
+    /** add all components of a particle attribute to the stream message
+     *
+     * @tparam T_Identifier identifier of a particle record
+     */
+    template<typename T_Identifier>
+    struct StreamParticleAttribute
+    {
+        /**
+         * @param params stream parameters of the step
+         * @param frame host frame with all particles of this rank
+         * @param speciesPath path for the current species
+         * @param elements number of particles of this rank
+         * @param elementsOffset offset of this rank's particles in the record
+         * @param numParticlesGlobal number of particles over all ranks
+         */
+        template<typename T_Frame>
+        HINLINE void operator()(
+            StreamParams* params,
+            T_Frame& frame,
+            const std::string speciesPath,
+            const uint64_t elements,
+            const uint64_t elementsOffset,
+            const uint64_t numParticlesGlobal
+        )
+        {
+            typedef typename PMacc::traits::Resolve<T_Identifier>::type::type ValueType;
+            typedef typename GetComponentsType<ValueType>::type ComponentType;
+            const uint32_t components = GetNComponents<ValueType>::value;
+
+            OpenPMDName<T_Identifier> openPMDName;
+            const std::string recordPath(speciesPath + std::string("/") + openPMDName());
+            const std::string name_lookup[] = {"x", "y", "z"};
+
+            OpenPMDUnit<T_Identifier> openPMDUnit;
+            const std::vector<float_64> unit = openPMDUnit();
+            OpenPMDUnitDimension<T_Identifier> openPMDUnitDimension;
+            const std::vector<float_64> unitDimension = openPMDUnitDimension();
+            PMACC_ASSERT(unit.size() == components);
+            PMACC_ASSERT(unitDimension.size() == 7);
+
+            const uint64_t globalSize[3] = {numParticlesGlobal, 1u, 1u};
+            const uint64_t offset[3] = {elementsOffset, 0u, 0u};
+            const uint64_t size[3] = {elements, 1u, 1u};
+
+            /* staged as bytes, std::vector<bool> has no contiguous data */
+            std::vector<char> componentBuffer(elements * sizeof(ComponentType));
+            ComponentType* componentData = reinterpret_cast<ComponentType*>(componentBuffer.data());
+            const ComponentType* dataPtr =
+                reinterpret_cast<const ComponentType*>(frame.getIdentifier(T_Identifier()).getPointer());
+
+            for (uint32_t d = 0; d < components; ++d)
+            {
+                std::string componentPath(recordPath);
+                if (components > 1)
+                    componentPath += std::string("/") + name_lookup[d];
+
+                for (uint64_t i = 0; i < elements; ++i)
+                    componentData[i] = dataPtr[i * components + d];
+
+                params->writer->addRecord(
+                    componentPath,
+                    ToStreamType<ComponentType>::value,
+                    1u,
+                    globalSize,
+                    offset,
+                    size,
+                    componentData
+                );
+                params->writer->addAttribute(componentPath, "unitSI", unit.at(d));
+            }
+
+            params->writer->addAttribute(recordPath, "unitDimension", unitDimension);
+            params->writer->addAttribute(recordPath, "macroWeighted", uint32_t(MacroWeighted<T_Identifier>::get() ? 1 : 0));
+            params->writer->addAttribute(recordPath, "weightingPower", float_64(WeightingPower<T_Identifier>::get()));
+            params->writer->addAttribute(recordPath, "timeOffset", float_64(0.0));
+        }
+    };
+
+    /** copy the particles of a species to the host and add them to the stream message
+     *
+     * Selection and record layout are the same as for the HDF5 output: the
+     * particles of the (region of interest restricted) window with the
+     * attribute totalCellIdx instead of localCellIdx.
+     *
+     * @tparam T_Species type of species
+     */
+    template<typename T_Species>
+    struct StreamSpecies
+    {
+        typedef T_Species ThisSpecies;
+        typedef typename ThisSpecies::FrameType FrameType;
+        typedef typename FrameType::ParticleDescription ParticleDescription;
+        typedef typename FrameType::ValueTypeSeq ParticleAttributeList;
+
+        typedef bmpl::vector<multiMask, localCellIdx> TypesToDelete;
+        typedef typename RemoveFromSeq<ParticleAttributeList, TypesToDelete>::type ParticleCleanedAttributeList;
+        typedef typename MakeSeq<ParticleCleanedAttributeList, totalCellIdx>::type ParticleNewAttributeList;
+        typedef typename ReplaceValueTypeSeq<ParticleDescription, ParticleNewAttributeList>::type NewParticleDescription;
+        typedef Frame<OperatorCreateVectorBox, NewParticleDescription> StreamFrameType;
+
+        /**
+         * @param params stream parameters of the step
+         * @param domainOffset offset to the local domain: globalDomain.offset + localDomain.offset
+         */
+        HINLINE void operator()(StreamParams* params, const DataSpace<simDim> domainOffset)
+        {
+            log<picLog::INPUT_OUTPUT >("Stream:  (begin) species: %1%") % FrameType::getName();
+            DataConnector& dc = Environment<>::get().DataConnector();
+            auto species = dc.get<ThisSpecies>(FrameType::getName(), true);
+
+            openPMD::OutputParticleFilter filter;
+            params->regionOfInterest->initFilter(
+                filter,
+                params->localWindowToDomainOffset,
+                params->window.localDimensions.size,
+                false
+            );
+
+            uint64_t numParticles = 0;
+            if (params->window.localDimensions.size.productOfComponents() != 0)
+            {
+                numParticles = uint64_t(PMacc::CountParticles::countOnDevice<CORE + BORDER>(
+                    *species,
+                    *(params->cellDescription),
+                    filter
+                ));
+            }
+
+            StreamFrameType hostFrame;
+            ForEach<typename StreamFrameType::ValueTypeSeq, MallocMemory<bmpl::_1> > mallocMem;
+            mallocMem(forward(hostFrame), numParticles);
+
+            if (numParticles != 0)
+            {
+                StreamFrameType deviceFrame;
+                ForEach<typename StreamFrameType::ValueTypeSeq, GetDevicePtr<bmpl::_1> > getDevicePtr;
+                getDevicePtr(forward(deviceFrame), forward(hostFrame));
+
+                AreaMapping<CORE + BORDER, MappingDesc> mapper(*(params->cellDescription));
+
+                const uint64_t numCopiedParticles = copySpecies(
+                    deviceFrame, species->getDeviceParticlesBox(),
+                    filter,
+                    domainOffset,
+                    totalCellIdx_,
+                    mapper
+                );
+
+                PMACC_ASSERT(numCopiedParticles == numParticles);
+            }
+            dc.releaseData(FrameType::getName());
+
+            /* global number of particles and the offset of this rank, ordered by rank */
+            GridController<simDim>& gc = Environment<simDim>::get().GridController();
+            const uint64_t numRanks(gc.getGlobalSize());
+            const uint64_t myRank(gc.getGlobalRank());
+            std::vector<uint64_t> particleCounts(numRanks, 0u);
+            MPI_CHECK(MPI_Allgather(
+                &numParticles, 1, MPI_UINT64_T,
+                &(*particleCounts.begin()), 1, MPI_UINT64_T,
+                gc.getCommunicator().getMPIComm()
+            ));
+
+            uint64_t numParticlesOffset = 0;
+            uint64_t numParticlesGlobal = 0;
+            for (uint64_t r = 0; r < numRanks; ++r)
+            {
+                numParticlesGlobal += particleCounts[r];
+                if (r < myRank)
+                    numParticlesOffset += particleCounts[r];
+            }
+
+            const std::string speciesPath(std::string("particles/") + FrameType::getName());
+            ForEach<typename StreamFrameType::ValueTypeSeq, StreamParticleAttribute<bmpl::_1> > streamAttribute;
+            streamAttribute(
+                params,
+                forward(hostFrame),
+                speciesPath,
+                numParticles,
+                numParticlesOffset,
+                numParticlesGlobal
+            );
+
+            ForEach<typename StreamFrameType::ValueTypeSeq, FreeMemory<bmpl::_1> > freeMem;
+            freeMem(forward(hostFrame));
+
+            log<picLog::INPUT_OUTPUT >("Stream:  ( end ) species: %1% = %2%") % FrameType::getName() % numParticles;
+        }
+    };
+
+} // namespace streaming
+} // namespace picongpu
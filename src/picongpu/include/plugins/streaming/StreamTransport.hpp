@@ -0,0 +1,244 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* This header is shared with the consumer tool (src/tools/openPMDStream)
+ * and must not depend on PIConGPU or PMacc headers.
+ */
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace picongpu
+{
+namespace streaming
+{
+
+    /** interface of a transport which delivers step messages to a consumer */
+    class IStreamTransport
+    {
+    public:
+
+        virtual ~IStreamTransport()
+        {
+        }
+
+        /** deliver a message
+         *
+         * Can block until the consumer accepted the data, this is the
+         * backpressure of the stream.
+         *
+         * @param message complete step message
+         * @return false if the message could not be delivered
+         */
+        virtual bool send(const std::vector<char>& message) = 0;
+    };
+
+    namespace detail
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        /** write all bytes to a socket
+         *
+         * @param deadline point in time after which the write is given up
+         * @param hasDeadline false waits forever
+         * @return false if the connection is broken or the deadline passed,
+         *         the stream is then out of sync and must be closed
+         */
+        inline bool writeAll(
+            const int fd,
+            const char* data,
+            size_t numBytes,
+            const Clock::time_point deadline,
+            const bool hasDeadline
+        )
+        {
+            while (numBytes != 0u)
+            {
+                int pollTimeoutMs = -1;
+                if (hasDeadline)
+                {
+                    const int64_t remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - Clock::now()
+                    ).count();
+                    if (remainingMs <= 0)
+                        return false;
+                    pollTimeoutMs = int(remainingMs);
+                }
+
+                pollfd request;
+                request.fd = fd;
+                request.events = POLLOUT;
+                request.revents = 0;
+                const int numReady = ::poll(&request, 1, pollTimeoutMs);
+                if (numReady < 0 && errno == EINTR)
+                    continue;
+                if (numReady <= 0)
+                    return false;
+
+                /* MSG_NOSIGNAL: a vanished consumer must not kill the simulation with SIGPIPE */
+                const ssize_t written = ::send(fd, data, numBytes, MSG_NOSIGNAL | MSG_DONTWAIT);
+                if (written < 0)
+                {
+                    if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                        continue;
+                    return false;
+                }
+                data += written;
+                numBytes -= size_t(written);
+            }
+            return true;
+        }
+
+        /** read exactly numBytes from a socket
+         *
+         * @return false if the connection is closed or broken
+         */
+        inline bool readAll(const int fd, char* data, size_t numBytes)
+        {
+            while (numBytes != 0u)
+            {
+                const ssize_t numRead = ::recv(fd, data, numBytes, 0);
+                if (numRead < 0 && errno == EINTR)
+                    continue;
+                if (numRead <= 0)
+                    return false;
+                data += numRead;
+                numBytes -= size_t(numRead);
+            }
+            return true;
+        }
+
+        inline sockaddr_un getSocketAddress(const std::string& path)
+        {
+            sockaddr_un address;
+            std::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            if (path.size() >= sizeof(address.sun_path))
+                throw std::runtime_error("openPMD stream: socket path is too long: " + path);
+            std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            return address;
+        }
+    } // namespace detail
+
+    /** node local transport over a unix domain stream socket
+     *
+     * The consumer listens on the socket path, each producer connects to it.
+     * A message is sent as uint64 length followed by the message. If no
+     * consumer is listening the message is not delivered, the connection is
+     * tried again with the next message. If a consumer does not read a message
+     * within the send timeout, the connection is closed and the message is lost.
+     */
+    class UnixSocketTransport : public IStreamTransport
+    {
+    public:
+
+        /**
+         * @param path file system path of the consumer socket
+         * @param sendTimeoutMs maximal time to send one message [ms], 0 waits forever
+         */
+        UnixSocketTransport(const std::string& path, const uint32_t sendTimeoutMs) :
+            path(path), sendTimeoutMs(sendTimeoutMs), fd(-1)
+        {
+        }
+
+        virtual ~UnixSocketTransport()
+        {
+            disconnect();
+        }
+
+        bool send(const std::vector<char>& message)
+        {
+            if (fd < 0 && !connect())
+                return false;
+
+            const detail::Clock::time_point deadline =
+                detail::Clock::now() + std::chrono::milliseconds(sendTimeoutMs);
+            const bool hasDeadline = sendTimeoutMs != 0u;
+
+            const uint64_t numBytes = message.size();
+            if (!detail::writeAll(fd, reinterpret_cast<const char*>(&numBytes), sizeof(numBytes),
+                                  deadline, hasDeadline) ||
+                !detail::writeAll(fd, message.data(), message.size(), deadline, hasDeadline))
+            {
+                disconnect();
+                return false;
+            }
+            return true;
+        }
+
+    private:
+
+        bool connect()
+        {
+            const sockaddr_un address = detail::getSocketAddress(path);
+            fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0)
+                return false;
+            if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                disconnect();
+                return false;
+            }
+            return true;
+        }
+
+        void disconnect()
+        {
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+        }
+
+        std::string path;
+        uint32_t sendTimeoutMs;
+        int fd;
+    };
+
+    /** create a transport by name
+     *
+     * @param name transport name, currently only "unix"
+     * @param address transport specific address, for "unix" the socket path
+     * @param sendTimeoutMs maximal time to send one message [ms], 0 waits forever
+     * @return new transport, the caller takes ownership
+     */
+    inline IStreamTransport* createTransport(
+        const std::string& name,
+        const std::string& address,
+        const uint32_t sendTimeoutMs
+    )
+    {
+        if (name == "unix")
+            return new UnixSocketTransport(address, sendTimeoutMs);
+        throw std::runtime_error("openPMD stream: unknown transport '" + name + "'");
+    }
+
+} // namespace streaming
+} // namespace picongpu
@@ -0,0 +1,537 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+#include "simulationControl/MySimulation.hpp"
+#include "simulationControl/TimeInterval.hpp"
+#include "particles/operations/CountParticles.hpp"
+#include "particles/operations/CountFrames.hpp"
+#include "particles/particleToGrid/ComputeGridValuePerFrame.def"
+#include "particles/traits/GetSpeciesFlagName.hpp"
+#include "particles/traits/FilterByFlag.hpp"
+#include "communication/AsyncCommunication.hpp"
+#include "mpi/MPIReduce.hpp"
+#include "mpi/reduceMethods/Reduce.hpp"
+#include "nvidia/functors/Add.hpp"
+#include "nvidia/functors/Max.hpp"
+#include "algorithms/ForEach.hpp"
+#include "forward.hpp"
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace picongpu
+{
+using namespace PMacc;
+
+namespace kernelBenchmark
+{
+
+    /** description and timings of one benchmarked kernel */
+    struct Result
+    {
+        /** name of the kernel group, e.g. `pusher` */
+        std::string kernel;
+        /** species name or `none` for field kernels */
+        std::string species;
+        /** name of the selected method, e.g. the pusher or current solver */
+        std::string method;
+        /** unit of `items`, `particles` or `cells` */
+        std::string unit;
+        /** number of processed items per repetition, summed over all ranks */
+        uint64_t items;
+        /** estimated number of transferred bytes per repetition, summed over all ranks */
+        double bytes;
+        /** ratio between used and available particle slots in the frames, -1 for field kernels */
+        double frameFillRatio;
+        /** duration of each repetition in milliseconds, maximum over all ranks */
+        std::vector<double> timesMs;
+
+        Result() : items(0u), bytes(0.), frameFillRatio(-1.)
+        {
+        }
+    };
+
+    /** number of bytes of one particle in the frame memory */
+    template<typename T_FrameType>
+    HINLINE double getBytesPerParticle()
+    {
+        return static_cast<double>(sizeof(T_FrameType)) /
+            static_cast<double>(PMacc::math::CT::volume<MappingDesc::SuperCellSize>::type::value);
+    }
+
+    /** number of cells in CORE + BORDER of the local domain */
+    HINLINE uint64_t getLocalCells()
+    {
+        const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+        return static_cast<uint64_t>(subGrid.getLocalDomain().size.productOfComponents());
+    }
+
+    /** count particles and the fill ratio of the frames of a species
+     *
+     * @param species particle species
+     * @param cellDescription mapping description of the local domain
+     * @param[out] fillRatio ratio between particles and particle slots in CORE + BORDER
+     * @return number of particles in CORE + BORDER
+     */
+    template<typename T_Species>
+    HINLINE uint64_t countParticles(T_Species& species, const MappingDesc& cellDescription, double& fillRatio)
+    {
+        const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+        const uint64_t numParticles = PMacc::CountParticles::countOnDevice<CORE + BORDER>(
+            species,
+            cellDescription,
+            DataSpace<simDim>(),
+            subGrid.getLocalDomain().size
+        );
+        const uint64_t numFrames = PMacc::CountFrames::countOnDevice<CORE + BORDER>(species, cellDescription);
+        const uint64_t frameSize = PMacc::math::CT::volume<MappingDesc::SuperCellSize>::type::value;
+        fillRatio = numFrames == 0u ? 0. :
+            static_cast<double>(numParticles) / static_cast<double>(numFrames * frameSize);
+        return numParticles;
+    }
+
+    /** benchmark the particle pusher (KernelMoveAndMarkParticles and the shift)
+     *
+     * The particles are communicated before each repetition (not timed) so
+     * that the number of particles is stable.
+     *
+     * @tparam T_SpeciesType species with the flag `particlePusher<>`
+     */
+    template<typename T_SpeciesType>
+    struct BenchmarkPusher
+    {
+        using SpeciesType = T_SpeciesType;
+        using FrameType = typename SpeciesType::FrameType;
+
+        template<typename T_Benchmark>
+        HINLINE void operator()(T_Benchmark& benchmark, const MappingDesc& cellDescription) const
+        {
+            DataConnector &dc = Environment<>::get().DataConnector();
+            auto species = dc.get< SpeciesType >( FrameType::getName(), true );
+
+            Result result;
+            result.kernel = "pusher";
+            result.species = FrameType::getName();
+            result.method = picongpu::traits::GetSpeciesFlagName<SpeciesType, particlePusher<> >()();
+            result.unit = "particles";
+            const uint64_t numParticles = countParticles(*species, cellDescription, result.frameFillRatio);
+            /* read and write of all particle attributes */
+            const double bytes = 2. * numParticles * getBytesPerParticle<FrameType>();
+
+            benchmark.run(
+                result,
+                numParticles,
+                bytes,
+                [&]( uint32_t step ){ species->update( step ); },
+                [&]( uint32_t ){ __setTransactionEvent( communication::asyncCommunication( *species, __getTransactionEvent() ) ); }
+            );
+
+            dc.releaseData( FrameType::getName() );
+        }
+    };
+
+    /** benchmark the current deposition (KernelComputeCurrent)
+     *
+     * @tparam T_SpeciesType species with the flag `current<>`
+     */
+    template<typename T_SpeciesType>
+    struct BenchmarkCurrent
+    {
+        using SpeciesType = T_SpeciesType;
+        using FrameType = typename SpeciesType::FrameType;
+
+        template<typename T_Benchmark>
+        HINLINE void operator()(T_Benchmark& benchmark, const MappingDesc& cellDescription) const
+        {
+            DataConnector &dc = Environment<>::get().DataConnector();
+            auto species = dc.get< SpeciesType >( FrameType::getName(), true );
+            auto fieldJ = dc.get< FieldJ >( FieldJ::getName(), true );
+
+            Result result;
+            result.kernel = "currentDeposition";
+            result.species = FrameType::getName();
+            result.method = picongpu::traits::GetSpeciesFlagName<SpeciesType, current<> >()();
+            result.unit = "particles";
+            const uint64_t numParticles = countParticles(*species, cellDescription, result.frameFillRatio);
+            /* read of all particle attributes, read and write of the current density */
+            const double bytes = numParticles * getBytesPerParticle<FrameType>() +
+                2. * getLocalCells() * sizeof(FieldJ::ValueType);
+
+            benchmark.run(
+                result,
+                numParticles,
+                bytes,
+                [&]( uint32_t step ){ fieldJ->computeCurrent< CORE + BORDER, SpeciesType >( *species, step ); },
+                [&]( uint32_t ){ fieldJ->assign( FieldJ::ValueType::create( 0. ) ); }
+            );
+
+            dc.releaseData( FieldJ::getName() );
+            dc.releaseData( FrameType::getName() );
+        }
+    };
+
+    /** benchmark shiftParticles and fillGaps of a species
+     *
+     * Before each repetition the particles are communicated and pushed again
+     * (not timed) so that each call finds particles which left their
+     * supercell. For fillGaps the particles are also shifted without filling
+     * the gaps.
+     *
+     * @tparam T_SpeciesType species with the flag `particlePusher<>`
+     */
+    template<typename T_SpeciesType>
+    struct BenchmarkShiftParticles
+    {
+        using SpeciesType = T_SpeciesType;
+        using FrameType = typename SpeciesType::FrameType;
+
+        template<typename T_Benchmark>
+        HINLINE void operator()(T_Benchmark& benchmark, const MappingDesc& cellDescription) const
+        {
+            DataConnector &dc = Environment<>::get().DataConnector();
+            auto species = dc.get< SpeciesType >( FrameType::getName(), true );
+
+            Result result;
+            result.species = FrameType::getName();
+            result.method = "none";
+            result.unit = "particles";
+            const uint64_t numParticles = countParticles(*species, cellDescription, result.frameFillRatio);
+            const double bytes = 2. * numParticles * getBytesPerParticle<FrameType>();
+
+            result.kernel = "shiftParticles";
+            benchmark.run(
+                result,
+                numParticles,
+                bytes,
+                [&]( uint32_t ){ species->template shiftParticles< CORE + BORDER >(); },
+                [&]( uint32_t step )
+                {
+                    __setTransactionEvent( communication::asyncCommunication( *species, __getTransactionEvent() ) );
+                    species->push( step );
+                }
+            );
+
+            result.kernel = "fillGaps";
+            benchmark.run(
+                result,
+                numParticles,
+                bytes,
+                [&]( uint32_t ){ species->template fillGaps< CORE + BORDER >(); },
+                [&]( uint32_t step )
+                {
+                    __setTransactionEvent( communication::asyncCommunication( *species, __getTransactionEvent() ) );
+                    species->push( step );
+                    species->template shiftParticles< CORE + BORDER, false >();
+                }
+            );
+
+            dc.releaseData( FrameType::getName() );
+        }
+    };
+
+    /** benchmark the particle to grid projection of the density
+     *
+     * @tparam T_SpeciesType species with the flag `shape<>`
+     */
+    template<typename T_SpeciesType>
+    struct BenchmarkParticleToGrid
+    {
+        using SpeciesType = T_SpeciesType;
+        using FrameType = typename SpeciesType::FrameType;
+        using DensitySolver = typename particleToGrid::CreateDensityOperation<SpeciesType>::type::Solver;
+
+        template<typename T_Benchmark>
+        HINLINE void operator()(T_Benchmark& benchmark, const MappingDesc& cellDescription) const
+        {
+            PMACC_CASSERT_MSG(
+                _please_allocate_at_least_one_FieldTmp_in_memory_param,
+                ( fieldTmpNumSlots > 0 ) && ( sizeof( T_SpeciesType ) != 0 )
+            );
+            DataConnector &dc = Environment<>::get().DataConnector();
+            auto species = dc.get< SpeciesType >( FrameType::getName(), true );
+            auto fieldTmp = dc.get< FieldTmp >( FieldTmp::getUniqueId( 0 ), true );
+
+            Result result;
+            result.kernel = "particleToGrid";
+            result.species = FrameType::getName();
+            result.method = picongpu::traits::GetSpeciesFlagName<SpeciesType, shape<> >()();
+            result.unit = "particles";
+            const uint64_t numParticles = countParticles(*species, cellDescription, result.frameFillRatio);
+            const double bytes = numParticles * getBytesPerParticle<FrameType>() +
+                2. * getLocalCells() * sizeof(FieldTmp::ValueType);
+
+            benchmark.run(
+                result,
+                numParticles,
+                bytes,
+                [&]( uint32_t step ){ fieldTmp->template computeValue< CORE + BORDER, DensitySolver >( *species, step ); },
+                [&]( uint32_t ){ fieldTmp->getGridBuffer().getDeviceBuffer().setValue( FieldTmp::ValueType( 0. ) ); }
+            );
+
+            dc.releaseData( FieldTmp::getUniqueId( 0 ) );
+            dc.releaseData( FrameType::getName() );
+        }
+    };
+
+} // namespace kernelBenchmark
+
+/** run the hot kernels of a time step in isolation
+ *
+ * The simulation is initialized like a normal PIConGPU run (the particle and
+ * field configuration is defined by the param files, e.g. ppc, temperature
+ * and density), afterwards each kernel is executed `repetitions` times after
+ * `warmup` untimed calls. Before each call the state is restored without
+ * being timed, e.g. the pushed particles are communicated.
+ *
+ * The throughput of each kernel in particles (or cells) per second and the
+ * estimated memory throughput is written by rank 0 to a JSON file.
+ */
+class KernelBenchmark : public MySimulation
+{
+public:
+
+    KernelBenchmark() :
+        MySimulation(),
+        repetitions(10u),
+        warmup(2u),
+        fileName("kernelBenchmark.json")
+    {
+    }
+
+    virtual void pluginRegisterHelp(po::options_description& desc)
+    {
+        MySimulation::pluginRegisterHelp(desc);
+        desc.add_options()
+            ("benchmark.repetitions", po::value<uint32_t>(&repetitions)->default_value(repetitions),
+             "number of timed calls of each kernel")
+            ("benchmark.warmup", po::value<uint32_t>(&warmup)->default_value(warmup),
+             "number of untimed calls of each kernel before the timed calls")
+            ("benchmark.file", po::value<std::string>(&fileName)->default_value(fileName),
+             "file name of the JSON report (written by rank 0)");
+    }
+
+    std::string pluginGetName() const
+    {
+        return "PIConGPU kernel benchmark";
+    }
+
+    /** initialize the simulation and benchmark all kernels
+     *
+     * hides SimulationHelper::startSimulation(), no time steps are executed
+     */
+    void startSimulation()
+    {
+        init();
+        resetAll(0);
+        const uint32_t currentStep = fillSimulation();
+        Environment<>::get().SimulationDescription().setCurrentStep( currentStep );
+
+        typedef typename PMacc::particles::traits::FilterByFlag
+        <
+            VectorAllSpecies,
+            particlePusher<>
+        >::type VectorSpeciesWithPusher;
+        ForEach< VectorSpeciesWithPusher, kernelBenchmark::BenchmarkPusher< bmpl::_1 > > benchmarkPusher;
+        benchmarkPusher( forward(*this), *cellDescription );
+
+        typedef typename PMacc::particles::traits::FilterByFlag
+        <
+            VectorAllSpecies,
+            current<>
+        >::type VectorSpeciesWithCurrentSolver;
+        ForEach< VectorSpeciesWithCurrentSolver, kernelBenchmark::BenchmarkCurrent< bmpl::_1 > > benchmarkCurrent;
+        benchmarkCurrent( forward(*this), *cellDescription );
+
+        ForEach< VectorSpeciesWithPusher, kernelBenchmark::BenchmarkShiftParticles< bmpl::_1 > > benchmarkShift;
+        benchmarkShift( forward(*this), *cellDescription );
+
+        typedef typename PMacc::particles::traits::FilterByFlag
+        <
+            VectorAllSpecies,
+            shape<>
+        >::type VectorSpeciesWithShape;
+        ForEach< VectorSpeciesWithShape, kernelBenchmark::BenchmarkParticleToGrid< bmpl::_1 > > benchmarkParticleToGrid;
+        benchmarkParticleToGrid( forward(*this), *cellDescription );
+
+        benchmarkFieldSolver();
+
+        writeReport();
+    }
+
+    /** time a kernel
+     *
+     * @param result description of the kernel, the timings are appended
+     * @param localItems number of items processed by this rank per call
+     * @param localBytes estimated number of bytes transferred by this rank per call
+     * @param kernel functor `void(uint32_t step)` which is timed
+     * @param restore functor `void(uint32_t step)` called untimed before each call of `kernel`
+     */
+    template<typename T_Kernel, typename T_Restore>
+    void run(
+        kernelBenchmark::Result result,
+        const uint64_t localItems,
+        const double localBytes,
+        T_Kernel kernel,
+        T_Restore restore
+    )
+    {
+        Manager& manager = Environment<>::get().Manager();
+        const uint32_t step = Environment<>::get().SimulationDescription().getCurrentStep();
+
+        for( uint32_t i = 0; i < warmup; ++i )
+        {
+            restore( step );
+            kernel( step );
+        }
+
+        std::vector<double> localTimes;
+        for( uint32_t i = 0; i < repetitions; ++i )
+        {
+            restore( step );
+            manager.waitForAllTasks();
+
+            TimeIntervall timer;
+            timer.toggleStart();
+            kernel( step );
+            manager.waitForAllTasks();
+            timer.toggleEnd();
+            localTimes.push_back( timer.getInterval() );
+        }
+
+        /* the slowest rank defines the duration of a repetition */
+        result.timesMs.resize( localTimes.size() );
+        if( !localTimes.empty() )
+            mpiReduce( nvidia::functors::Max(), &result.timesMs[0], &localTimes[0], localTimes.size(), mpi::reduceMethods::Reduce() );
+
+        uint64_t items = localItems;
+        mpiReduce( nvidia::functors::Add(), &result.items, &items, 1, mpi::reduceMethods::Reduce() );
+        double bytes = localBytes;
+        mpiReduce( nvidia::functors::Add(), &result.bytes, &bytes, 1, mpi::reduceMethods::Reduce() );
+
+        results.push_back( result );
+    }
+
+private:
+
+    /** benchmark the Maxwell solver, both halves of the update */
+    void benchmarkFieldSolver()
+    {
+        GetStringProperties<fieldSolver::FieldSolver> fieldSolverProps;
+
+        kernelBenchmark::Result result;
+        result.species = "none";
+        result.method = fieldSolverProps["name"].value;
+        result.unit = "cells";
+        const uint64_t numCells = kernelBenchmark::getLocalCells();
+        /* read and write of E and B */
+        const double bytes = 4. * numCells * sizeof(FieldE::ValueType);
+
+        result.kernel = "fieldSolverBeforeCurrent";
+        run(
+            result,
+            numCells,
+            bytes,
+            [&]( uint32_t step ){ this->myFieldSolver->update_beforeCurrent( step ); },
+            []( uint32_t ){}
+        );
+
+        result.kernel = "fieldSolverAfterCurrent";
+        run(
+            result,
+            numCells,
+            bytes,
+            [&]( uint32_t step ){ this->myFieldSolver->update_afterCurrent( step ); },
+            []( uint32_t ){}
+        );
+    }
+
+    /** write the reduced results to `fileName` (rank 0 only) */
+    void writeReport()
+    {
+        if( !mpiReduce.hasResult( mpi::reduceMethods::Reduce() ) )
+            return;
+
+        using boost::property_tree::ptree;
+        ptree pt;
+
+        int deviceId = 0;
+        cudaDeviceProp deviceProp;
+        CUDA_CHECK( cudaGetDevice( &deviceId ) );
+        CUDA_CHECK( cudaGetDeviceProperties( &deviceProp, deviceId ) );
+
+        pt.put( "benchmark.backend", "cuda" );
+        pt.put( "benchmark.device", std::string( deviceProp.name ) );
+        pt.put( "benchmark.repetitions", repetitions );
+        pt.put( "benchmark.warmup", warmup );
+        pt.put( "benchmark.numRanks", Environment<simDim>::get().GridController().getGpuNodes().productOfComponents() );
+        pt.put( "benchmark.globalCells", Environment<simDim>::get().SubGrid().getGlobalDomain().size.productOfComponents() );
+        pt.put( "benchmark.bytesModel",
+            "particle kernels: sizeof(frame) / particles per frame per accessed particle, "
+            "written attributes and fields are counted twice (read + write)" );
+
+        ptree kernels;
+        for( std::vector<kernelBenchmark::Result>::const_iterator it = results.begin(); it != results.end(); ++it )
+        {
+            const std::vector<double>& times = it->timesMs;
+            const double minMs = times.empty() ? 0. : *std::min_element( times.begin(), times.end() );
+            const double meanMs = times.empty() ? 0. :
+                std::accumulate( times.begin(), times.end(), 0. ) / times.size();
+            const double meanSec = meanMs / 1000.;
+
+            ptree entry;
+            entry.put( "kernel", it->kernel );
+            entry.put( "species", it->species );
+            entry.put( "method", it->method );
+            entry.put( "unit", it->unit );
+            entry.put( "items", it->items );
+            entry.put( "frameFillRatio", it->frameFillRatio );
+            entry.put( "timeMinMs", minMs );
+            entry.put( "timeMeanMs", meanMs );
+            entry.put( "itemsPerSecond", meanSec > 0. ? it->items / meanSec : 0. );
+            entry.put( "GBPerSecond", meanSec > 0. ? it->bytes / meanSec / 1.0e9 : 0. );
+            kernels.push_back( std::make_pair( "", entry ) );
+
+            log<picLog::PHYSICS >("benchmark %1% (%2%, %3%): %4% ms, %5% %6%/s") %
+                it->kernel % it->species % it->method % meanMs %
+                ( meanSec > 0. ? it->items / meanSec : 0. ) % it->unit;
+        }
+        pt.add_child( "benchmark.kernels", kernels );
+
+        std::ofstream file( fileName.c_str() );
+        boost::property_tree::write_json( file, pt, true );
+    }
+
+    uint32_t repetitions;
+    uint32_t warmup;
+    std::string fileName;
+
+    std::vector<kernelBenchmark::Result> results;
+    mpi::MPIReduce mpiReduce;
+};
+
+} // namespace picongpu
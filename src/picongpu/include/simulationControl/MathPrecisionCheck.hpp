@@ -0,0 +1,322 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "verify.hpp"
+#include "debug/PIConGPUVerbose.hpp"
+#include "memory/buffers/HostDeviceBuffer.hpp"
+#include "algorithms/Gamma.hpp"
+#include "particles/ionization/byField/ADK/AlgorithmADK.hpp"
+#include "particles/ionization/byField/Keldysh/AlgorithmKeldysh.hpp"
+#include "plugins/radiation/amplitude.hpp"
+#include "fields/background/templates/TWTS/TWTS.hpp"
+
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <sstream>
+
+
+namespace picongpu
+{
+namespace mathPrecisionCheck
+{
+    namespace pmMath = PMacc::algorithms::math;
+
+    /* Each module below evaluates the code path that depends on its
+     * mathPrecision policy (precision.param) for a sample index.
+     * The samples cover the values seen in typical simulations.
+     */
+
+    /** field ionization rate of the ADK model (linear polarization) */
+    struct IonizationADK
+    {
+        typedef mathPrecision::Ionization Policy;
+
+        static std::string getName()
+        {
+            return "mathPrecision::Ionization (ADK rate)";
+        }
+
+        static float_64 getTolerance()
+        {
+            return 1.0e-3;
+        }
+
+        template< typename T_Precision >
+        DINLINE float_64 operator()( const uint32_t sample, const uint32_t numSamples,
+                                     const T_Precision& ) const
+        {
+            /* hydrogen, helium and carbon like ionization energies [AU] */
+            const float_X iEnergies[3] = { 0.5, 2.0, 18.0 };
+            const float_X charges[3] = { 1.0, 2.0, 6.0 };
+            const uint32_t species = sample % 3u;
+            /* field strength log-spaced in [1e-2, 1e1] AU */
+            const float_64 t = float_64( sample ) / float_64( numSamples - 1u );
+            const float_X eInAU = float_X( 1.0e-2 * math::pow( 1.0e3, t ) );
+
+            return particles::ionization::AlgorithmADK< true >::rate< T_Precision >(
+                eInAU, iEnergies[species], charges[species] );
+        }
+    };
+
+    /** field ionization rate of the Keldysh model */
+    struct IonizationKeldysh
+    {
+        typedef mathPrecision::Ionization Policy;
+
+        static std::string getName()
+        {
+            return "mathPrecision::Ionization (Keldysh rate)";
+        }
+
+        static float_64 getTolerance()
+        {
+            return 1.0e-3;
+        }
+
+        template< typename T_Precision >
+        DINLINE float_64 operator()( const uint32_t sample, const uint32_t numSamples,
+                                     const T_Precision& ) const
+        {
+            const float_X iEnergies[3] = { 0.5, 2.0, 18.0 };
+            const uint32_t species = sample % 3u;
+            const float_64 t = float_64( sample ) / float_64( numSamples - 1u );
+            const float_X eInAU = float_X( 1.0e-2 * math::pow( 1.0e3, t ) );
+
+            return particles::ionization::AlgorithmKeldysh::rate< T_Precision >(
+                eInAU, iEnergies[species] );
+        }
+    };
+
+    /** real part of a radiation amplitude for phases in [-1e3, 1e3] */
+    struct RadiationAmplitude
+    {
+        typedef mathPrecision::Radiation Policy;
+
+        static std::string getName()
+        {
+            return "mathPrecision::Radiation (amplitude)";
+        }
+
+        static float_64 getTolerance()
+        {
+            return 1.0e-3;
+        }
+
+        template< typename T_Precision >
+        DINLINE float_64 operator()( const uint32_t sample, const uint32_t numSamples,
+                                     const T_Precision& precision ) const
+        {
+            const float_X phase = float_X( -1.0e3 + 2.0e3 * float_64( sample ) / float_64( numSamples ) );
+            ::Amplitude amplitude( vector_64( 1.0, 0.0, 0.0 ), phase, precision );
+            return amplitude.debug();
+        }
+    };
+
+    /** Ex of a TWTS laser along the y-axis through the focus */
+    struct TWTSEField
+    {
+        typedef mathPrecision::TWTS Policy;
+
+        /* host-only constructor, needs the initialized SubGrid */
+        HINLINE TWTSEField() :
+            field( 30.0e-6, 0.8e-6, 10.0e-15 / 2.3548200450309493820231386529194, 5.0e-6, 0.01,
+                   60. * ( PI / 180. ), 1.0, 0.0, false )
+        {
+        }
+
+        static std::string getName()
+        {
+            return "mathPrecision::TWTS (E-field)";
+        }
+
+        static float_64 getTolerance()
+        {
+            return 1.0e-3;
+        }
+
+        template< typename T_Precision >
+        DINLINE float_64 operator()( const uint32_t sample, const uint32_t numSamples,
+                                     const T_Precision& ) const
+        {
+            /* +-5 wavelengths around the focus at the time of the focus */
+            const float_64 y = -4.0e-6 + 8.0e-6 * float_64( sample ) / float_64( numSamples );
+            return field.calcTWTSEx< T_Precision >( float3_64( 0.0, y, 0.0 ), 0.0 );
+        }
+
+        templates::twts::EField field;
+    };
+
+    /** By and Bz of a TWTS laser along the y-axis through the focus */
+    struct TWTSBField
+    {
+        typedef mathPrecision::TWTS Policy;
+
+        HINLINE TWTSBField() :
+            field( 30.0e-6, 0.8e-6, 10.0e-15 / 2.3548200450309493820231386529194, 5.0e-6, 0.01,
+                   60. * ( PI / 180. ), 1.0, 0.0, false )
+        {
+        }
+
+        static std::string getName()
+        {
+            return "mathPrecision::TWTS (B-field)";
+        }
+
+        static float_64 getTolerance()
+        {
+            return 1.0e-3;
+        }
+
+        template< typename T_Precision >
+        DINLINE float_64 operator()( const uint32_t sample, const uint32_t numSamples,
+                                     const T_Precision& ) const
+        {
+            const float_64 y = -4.0e-6 + 8.0e-6 * float_64( sample / 2u ) / float_64( numSamples / 2u );
+            const float3_64 pos( 0.0, y, 0.0 );
+            if( sample % 2u == 0u )
+                return field.calcTWTSBy< T_Precision >( pos, 0.0 );
+            return field.calcTWTSBz_Ex< T_Precision >( pos, 0.0 );
+        }
+
+        templates::twts::BField field;
+    };
+
+    /** Lorentz factor used by the particle pushers for u = p/(m c) in [0, 1e3] */
+    struct PusherGamma
+    {
+        typedef mathPrecision::Pusher Policy;
+
+        static std::string getName()
+        {
+            return "mathPrecision::Pusher (gamma)";
+        }
+
+        static float_64 getTolerance()
+        {
+            return 1.0e-5;
+        }
+
+        template< typename T_Precision >
+        DINLINE float_64 operator()( const uint32_t sample, const uint32_t numSamples,
+                                     const T_Precision& ) const
+        {
+            const float_X u = float_X( 1.0e3 * float_64( sample ) / float_64( numSamples ) );
+            const float_X mass( 1.0 );
+            return Gamma< float_X, T_Precision >()( float3_X( u * SPEED_OF_LIGHT, 0.0, 0.0 ), mass );
+        }
+    };
+
+    /** evaluate a module with both precision policies */
+    struct KernelEvaluateModule
+    {
+        template< class T_Box, class T_Module >
+        DINLINE void operator()( T_Box preciseBox, T_Box fastBox, const T_Module module,
+                                 const uint32_t numSamples ) const
+        {
+            const uint32_t linearId = blockIdx.x * blockDim.x + threadIdx.x;
+            if( linearId < numSamples )
+            {
+                preciseBox( linearId ) = module( linearId, numSamples, pmMath::Precise() );
+                fastBox( linearId ) = module( linearId, numSamples, pmMath::Fast() );
+            }
+        }
+    };
+
+    /** compare the Fast and the Precise output of a module
+     *
+     * Only modules whose policy is Fast are evaluated. The deviation is the
+     * maximal absolute difference relative to the maximal absolute Precise
+     * output. The simulation is aborted if it exceeds the tolerance of the
+     * module.
+     */
+    template<
+        typename T_Module,
+        bool T_isFast = boost::is_same< typename T_Module::Policy, pmMath::Fast >::value
+    >
+    struct Check
+    {
+        HINLINE void operator()() const
+        {
+            constexpr uint32_t numSamples = 4096u;
+            constexpr uint32_t numThreadsPerBlock = 256u;
+
+            T_Module module;
+            PMacc::HostDeviceBuffer< float_64, 1 > preciseBuffer( numSamples );
+            PMacc::HostDeviceBuffer< float_64, 1 > fastBuffer( numSamples );
+            PMACC_KERNEL( KernelEvaluateModule{ } )( numSamples / numThreadsPerBlock, numThreadsPerBlock )
+                ( preciseBuffer.getDeviceBuffer().getDataBox(), fastBuffer.getDeviceBuffer().getDataBox(),
+                  module, numSamples );
+            preciseBuffer.deviceToHost();
+            fastBuffer.deviceToHost();
+
+            auto preciseBox = preciseBuffer.getHostBuffer().getDataBox();
+            auto fastBox = fastBuffer.getHostBuffer().getDataBox();
+            float_64 maxDifference = 0.0;
+            float_64 maxPrecise = 0.0;
+            for( uint32_t i = 0u; i < numSamples; ++i )
+            {
+                maxDifference = std::max( maxDifference, std::abs( fastBox( i ) - preciseBox( i ) ) );
+                maxPrecise = std::max( maxPrecise, std::abs( preciseBox( i ) ) );
+            }
+            const float_64 deviation = maxPrecise > 0.0 ? maxDifference / maxPrecise : maxDifference;
+
+            if( Environment< simDim >::get().GridController().getGlobalRank() == 0 )
+                log< picLog::PHYSICS >( "%1% is Fast: relative deviation to Precise %2%" ) %
+                    T_Module::getName() % deviation;
+
+            std::stringstream msg;
+            msg << T_Module::getName() << " is Fast but deviates by " << deviation
+                << " (tolerance " << T_Module::getTolerance() << ") from Precise,"
+                << " use PMacc::algorithms::math::Precise in precision.param";
+            PMACC_VERIFY_MSG( deviation <= T_Module::getTolerance(), msg.str() );
+        }
+    };
+
+    template< typename T_Module >
+    struct Check< T_Module, false >
+    {
+        HINLINE void operator()() const
+        {
+        }
+    };
+
+} // namespace mathPrecisionCheck
+
+    /** compare the output of all modules set to Fast in precision.param
+     *  with their Precise output
+     *
+     * must be called after the grids are initialized (TWTS fields)
+     */
+    HINLINE void checkMathPrecision()
+    {
+        mathPrecisionCheck::Check< mathPrecisionCheck::IonizationADK >()();
+        mathPrecisionCheck::Check< mathPrecisionCheck::IonizationKeldysh >()();
+        mathPrecisionCheck::Check< mathPrecisionCheck::RadiationAmplitude >()();
+        mathPrecisionCheck::Check< mathPrecisionCheck::TWTSEField >()();
+        mathPrecisionCheck::Check< mathPrecisionCheck::TWTSBField >()();
+        mathPrecisionCheck::Check< mathPrecisionCheck::PusherGamma >()();
+    }
+
+} // namespace picongpu
@@ -23,6 +23,9 @@
 #include "simulation_defines.hpp"
 
 #include "simulationControl/Window.hpp"
+#include "mappings/simulation/GridController.hpp"
+
+#include <algorithm>
 
 namespace picongpu
 {
@@ -36,7 +39,9 @@ class MovingWindow
 {
 private:
 
-    MovingWindow() : slidingWindowActive(false), slideCounter(0), lastSlideStep(0)
+    MovingWindow() :
+        slidingWindowActive(false), slideBySupercellRow(false), initEnteringRowOnly(false),
+        slideCounter(0), lastSlideStep(0)
     {
     }
 
@@ -65,15 +70,14 @@ private:
              */
             const uint32_t moveDirection = 1;
 
-            /* the moving window is smaller than the global domain by exactly one
-             * GPU (local domain size)
+            /* the moving window is smaller than the global domain by exactly the
+             * distance of one slide (local domain size or supercell size)
              * \todo calculation of the globalWindowSizeInMoveDirection is constant should be
              * only done once in it's own central object/api
              */
+            const uint32_t cellsPerSlide = getCellsPerSlide();
             const uint32_t globalWindowSizeInMoveDirection =
-                subGrid.getGlobalDomain().size[moveDirection] - subGrid.getLocalDomain().size[moveDirection];
-
-            const uint32_t gpuNumberOfCellsInMoveDirection = subGrid.getLocalDomain().size[moveDirection];
+                subGrid.getGlobalDomain().size[moveDirection] - cellsPerSlide;
 
             /* unit PIConGPU length */
             const float_64 cellSizeInMoveDirection = float_64(cellSize[moveDirection]);
@@ -140,12 +144,12 @@ private:
                  */
                 const bool endOfInitialGlobalDomain = firstSlideStep <= currentStep;
 
-                /* virtual particle will pass a GPU border during the current
+                /* virtual particle will pass a GPU (or supercell) border during the current
                  * (to be simulated) time step
                  */
                 const bool virtualParticlePassesGPUBorder =
-                    (nextVirtualParticlePositionInCells % gpuNumberOfCellsInMoveDirection) <
-                    (virtualParticlePositionInCells % gpuNumberOfCellsInMoveDirection);
+                    (nextVirtualParticlePositionInCells % cellsPerSlide) <
+                    (virtualParticlePositionInCells % cellsPerSlide);
 
                 if (endOfInitialGlobalDomain && virtualParticlePassesGPUBorder)
                 {
@@ -154,7 +158,7 @@ private:
                         *doSlide = true;
                 }
 
-                /* valid range for the offset is [0;GPU number of cells in move direction) */
+                /* valid range for the offset is [0;number of cells per slide) */
                 if (offsetFirstGPU)
                 {
                     /* since the moving window in PIConGPU always starts on the
@@ -163,7 +167,7 @@ private:
                      *
                      * note: also works with windowMovingSpeed > c
                      */
-                    *offsetFirstGPU = nextVirtualParticlePositionInCells % gpuNumberOfCellsInMoveDirection;
+                    *offsetFirstGPU = nextVirtualParticlePositionInCells % cellsPerSlide;
                 }
             }
         }
@@ -190,6 +194,12 @@ private:
     /** true is sliding window is activated */
     bool slidingWindowActive;
 
+    /** true if the window slides by one supercell row instead of one local domain */
+    bool slideBySupercellRow;
+
+    /** true while the species are initialized in the supercell row entering the window */
+    bool initEnteringRowOnly;
+
     /** current number of slides since start of simulation */
     uint32_t slideCounter;
 
@@ -210,6 +220,90 @@ public:
         slidingWindowActive = value;
     }
 
+    /**
+     * Slide by one supercell row instead of one local domain
+     *
+     * Each GPU shifts its fields and particles by one supercell row and only
+     * the row entering the window is initialized, instead of re-initializing
+     * the whole local domain of the last GPU in y direction.
+     *
+     * @param value true to slide by supercell rows, false otherwise
+     */
+    void setSlideBySupercellRow(bool value)
+    {
+        slideBySupercellRow = value;
+    }
+
+    /**
+     * Returns if the window slides by supercell rows
+     *
+     * @return true if sliding by supercell rows, false if sliding by local domains
+     */
+    bool isSlideBySupercellRow() const
+    {
+        return slideBySupercellRow;
+    }
+
+    /**
+     * Returns the number of cells the window moves with one slide (y direction)
+     *
+     * @return supercell size or local domain size in y
+     */
+    uint32_t getCellsPerSlide() const
+    {
+        if (slideBySupercellRow)
+            return SuperCellSize::y::value;
+        return Environment<simDim>::get().SubGrid().getLocalDomain().size.y();
+    }
+
+    /**
+     * Return the number of cells the global domain moved since start of simulation.
+     * If slide occurs in \p currentStep, it is included in the result.
+     *
+     * @param currentStep current simulation step
+     * @return number of cells in y direction
+     */
+    uint32_t getSlideDistance(uint32_t currentStep)
+    {
+        return getSlideCounter(currentStep) * getCellsPerSlide();
+    }
+
+    /**
+     * Restore the domain decomposition as if \p numSlides slides had been performed
+     *
+     * \warning a simulation can not be restarted with a different slide mode
+     *
+     * @param numSlides number of slides
+     */
+    void setDomainStateAfterSlides(uint32_t numSlides)
+    {
+        GridController<simDim>& gc = Environment<simDim>::get().GridController();
+        if (slideBySupercellRow)
+            gc.shiftGlobalDomainOffset(numSlides * getCellsPerSlide());
+        else
+            gc.setStateAfterSlides(numSlides);
+    }
+
+    /**
+     * Restrict the species initialization to the supercell row entering the window
+     *
+     * @param value true while only the entering row is initialized
+     */
+    void setInitEnteringRowOnly(bool value)
+    {
+        initEnteringRowOnly = value;
+    }
+
+    /**
+     * Returns if only the supercell row entering the window is initialized
+     *
+     * @return true if the initialization is restricted to the last BORDER row in y direction
+     */
+    bool isInitEnteringRowOnly() const
+    {
+        return initEnteringRowOnly;
+    }
+
     /**
      * Set the number of already performed moving window slides
      *
@@ -238,6 +332,39 @@ public:
         return slideCounter;
     }
 
+    /**
+     * Upper bound of the end of the global domain in y until a simulation step.
+     *
+     * The global domain ends at most one slide behind the virtual particle
+     * which defines the window position. In contrast to getSlideDistance()
+     * this method does not modify the slide counter and can be used for
+     * future steps.
+     *
+     * @param lastStep last simulation step which is calculated
+     * @return end of the global domain including all slides [in cells]
+     */
+    uint32_t getMaxGlobalDomainEnd(uint32_t lastStep) const
+    {
+        const SubGrid<simDim>& subGrid = Environment<simDim>::get().SubGrid();
+        const uint32_t globalDomainEnd = subGrid.getGlobalDomain().size.y();
+
+        if (!slidingWindowActive)
+            return globalDomainEnd;
+
+        const uint32_t cellsPerSlide = getCellsPerSlide();
+        const uint32_t globalWindowSizeInMoveDirection = globalDomainEnd - cellsPerSlide;
+        const uint32_t virtualParticleInitialStartCell = math::ceil(
+            float_64(globalWindowSizeInMoveDirection) * (float_64(1.0) - movePoint)
+        );
+        const float_64 virtualParticleWayPassed =
+            float_64(SPEED_OF_LIGHT) * float_64(DELTA_T) * float_64(lastStep + 1);
+        const uint32_t virtualParticlePositionInCells = virtualParticleInitialStartCell + uint32_t(
+            math::floor(virtualParticleWayPassed / float_64(cellSize[1]))
+        );
+
+        return std::max(globalDomainEnd, virtualParticlePositionInCells + cellsPerSlide);
+    }
+
     /**
      * Returns if sliding window is active
      *
@@ -313,15 +440,16 @@ public:
         if (slidingWindowActive)
         {
             /* the moving window is smaller than the global domain by exactly one
-             * GPU (local domain size) in moving (y) direction
+             * slide (local domain size or supercell size) in moving (y) direction
              */
-            window.globalDimensions.size.y() -= subGrid.getLocalDomain().size.y();
+            const uint32_t cellsPerSlide = getCellsPerSlide();
+            window.globalDimensions.size.y() -= cellsPerSlide;
 
             float_64 offsetFirstGPU = 0.0;
             getCurrentSlideInfo(currentStep, nullptr, &offsetFirstGPU);
 
             /* while moving, the windows global offset within the global domain is between 0
-             * and smaller than the local domain's size in y.
+             * and smaller than the number of cells per slide in y.
              */
             window.globalDimensions.offset.y() = offsetFirstGPU;
 
@@ -341,10 +469,12 @@ public:
             else
             {
                 window.localDimensions.offset.y() = subGrid.getLocalDomain().offset.y() - offsetFirstGPU;
-                if (isBottomGpu)
-                {
-                    window.localDimensions.size.y() = offsetFirstGPU;
-                }
+            }
+
+            if (isBottomGpu)
+            {
+                /* the last slide distance of the global domain is not part of the window */
+                window.localDimensions.size.y() -= cellsPerSlide - offsetFirstGPU;
             }
         }
 
@@ -42,6 +42,9 @@
 #include "nvidia/memory/MemoryInfo.hpp"
 #include "mappings/kernel/MappingDescription.hpp"
 #include "simulationControl/MovingWindow.hpp"
+#include "simulationControl/ShiftBySupercellRow.hpp"
+#include "simulationControl/RuntimeParameters.hpp"
+#include "simulationControl/MathPrecisionCheck.hpp"
 #include "mappings/simulation/SubGrid.hpp"
 #include "mappings/simulation/GridController.hpp"
 
@@ -108,7 +111,13 @@ public:
     currentBGField(nullptr),
     cellDescription(nullptr),
     initialiserController(nullptr),
-    slidingWindow(false)
+    slidingWindow(false),
+    slideBySupercellRow(false),
+    numStreams(6),
+    numIndependentStreams(0),
+    streamPolicy("roundRobin"),
+    heapCompactionPeriod(0),
+    runtimeParameters(runtime::getDefaultParameters())
     {
     }
 
@@ -132,7 +141,29 @@ public:
             ("periodic", po::value<std::vector<uint32_t> > (&periodic)->multitoken(),
              "specifying whether the grid is periodic (1) or not (0) in each dimension, default: no periodic dimensions")
 
-            ("moving,m", po::value<bool>(&slidingWindow)->zero_tokens(), "enable sliding/moving window");
+            ("moving,m", po::value<bool>(&slidingWindow)->zero_tokens(), "enable sliding/moving window")
+
+            ("movingSupercellRow", po::value<bool>(&slideBySupercellRow)->zero_tokens(),
+             "slide the moving window by one supercell row instead of one local domain, "
+             "the global domain is larger than the window by one supercell row (requires --moving)")
+
+            ("streams", po::value<uint32_t>(&numStreams)->default_value(numStreams),
+             "number of CUDA streams for the simulation")
+
+            ("independentStreams", po::value<uint32_t>(&numIndependentStreams)->default_value(numIndependentStreams),
+             "number of additional CUDA streams for independent work like exchanges and plugin copies")
+
+            ("streamPolicy", po::value<std::string>(&streamPolicy)->default_value(streamPolicy),
+             "selection of the stream for tasks without an unfinished producer on the device\n"
+             "  roundRobin: use the streams in a fixed order\n"
+             "  dependency: use the stream with the fewest unfinished tasks\n"
+             "independent work always uses the independent streams")
+
+            ("heapCompactionPeriod", po::value<uint32_t>(&heapCompactionPeriod)->default_value(heapCompactionPeriod),
+             "compact the particle heap and log the occupancy per species every N steps (0 = disabled), "
+             "empty slabs are returned to the heap and can be reused by all species");
+
+        runtime::registerOptions(desc, runtimeParameters);
     }
 
     std::string pluginGetName() const
@@ -164,11 +195,16 @@ public:
             if (gridSize.size() == 2)
             gridSize.push_back(1);
 
-        if (slidingWindow && devices[1] == 1)
+        if (slidingWindow && !slideBySupercellRow && devices[1] == 1)
         {
             std::cerr << "Invalid configuration. Can't use moving window with one device in Y direction" << std::endl;
         }
 
+        if (streamPolicy != "roundRobin" && streamPolicy != "dependency")
+        {
+            throw std::runtime_error(std::string("Unknown stream policy: ") + streamPolicy);
+        }
+
         DataSpace<simDim> global_grid_size;
         DataSpace<simDim> gpus;
         DataSpace<simDim> isPeriodic;
@@ -182,6 +218,9 @@ public:
 
         Environment<simDim>::get().initDevices(gpus, isPeriodic);
 
+        /* the device is selected, upload the parameters of runtimeParameters.param */
+        runtime::setParameters(runtimeParameters);
+
         DataSpace<simDim> myGPUpos(Environment<simDim>::get().GridController().getPosition());
 
         // calculate the number of local grid cells and
@@ -205,6 +244,7 @@ public:
         Environment<simDim>::get().initGrids(global_grid_size, gridSizeLocal, gridOffset);
 
         MovingWindow::getInstance().setSlidingWindow(slidingWindow);
+        MovingWindow::getInstance().setSlideBySupercellRow(slidingWindow && slideBySupercellRow);
 
         log<picLog::DOMAINS > ("rank %1%; localsize %2%; localoffset %3%;") %
             myGPUpos.toString() % gridSizeLocal.toString() % gridOffset.toString();
@@ -218,12 +258,16 @@ public:
 
         if (Environment<simDim>::get().GridController().getGlobalRank() == 0)
         {
-            if (slidingWindow)
+            if (slidingWindow && slideBySupercellRow)
+                log<picLog::PHYSICS > ("Sliding Window is ON (slides by supercell row)");
+            else if (slidingWindow)
                 log<picLog::PHYSICS > ("Sliding Window is ON");
             else
                 log<picLog::PHYSICS > ("Sliding Window is OFF");
         }
 
+        checkMathPrecision();
+
         for (uint32_t i = 0; i < simDim; ++i)
         {
 
@@ -338,6 +382,10 @@ public:
             this->bremsstrahlungPhotonAngle.init();
         }
 
+        /* create the field solver before the heap for the particles is sized,
+         * solvers can allocate device memory (e.g. PSATD spectra and FFT plans) */
+        this->myFieldSolver = new fieldSolver::FieldSolver(*cellDescription);
+
         /* Create an empty allocator. This one is resized after all exchanges
          * for particles are created */
         deviceHeap.reset(new DeviceHeap(0));
@@ -387,9 +435,6 @@ public:
         for( uint32_t slot = 0; slot < fieldTmpNumSlots; ++slot)
             fieldTmp.at( slot )->init();
 
-        // create field solver
-        this->myFieldSolver = new fieldSolver::FieldSolver(*cellDescription);
-
         // create current interpolation
         this->myCurrentInterpolation = new fieldSolver::CurrentInterpolation;
 
@@ -399,7 +444,12 @@ public:
 
 
         /* add CUDA streams to the StreamController for concurrent execution */
-        Environment<>::get().StreamController().addStreams(6);
+        StreamController& streamController = Environment<>::get().StreamController();
+        streamController.addStreams(numStreams);
+        streamController.addIndependentStreams(numIndependentStreams);
+        streamController.setPolicy(
+            streamPolicy == "dependency" ? STREAM_DEPENDENCY_AWARE : STREAM_ROUND_ROBIN
+        );
     }
 
     virtual uint32_t fillSimulation()
@@ -564,7 +614,7 @@ public:
         dc.releaseData( FieldE::getName() );
         dc.releaseData( FieldB::getName() );
 
-        this->myFieldSolver->update_beforeCurrent(currentStep);
+        translationUnits::updateFieldSolverBeforeCurrent(*this->myFieldSolver, currentStep);
 
         auto fieldJ = dc.get< FieldJ >( FieldJ::getName(), true );
         FieldJ::ValueType zeroJ( FieldJ::ValueType::create(0.) );
@@ -581,10 +631,7 @@ public:
         >::type VectorSpeciesWithCurrentSolver;
         ForEach<
             VectorSpeciesWithCurrentSolver,
-            ComputeCurrent<
-                bmpl::_1,
-                bmpl::int_<CORE + BORDER>
-            >
+            particles::ComputeSpeciesCurrent< bmpl::_1 >
         > computeCurrent;
         computeCurrent( currentStep );
 #endif
@@ -621,11 +668,14 @@ public:
 #endif
         dc.releaseData( FieldJ::getName() );
 
-        this->myFieldSolver->update_afterCurrent(currentStep);
+        translationUnits::updateFieldSolverAfterCurrent(*this->myFieldSolver, currentStep);
     }
 
     virtual void movingWindowCheck(uint32_t currentStep)
     {
+        if (heapCompactionPeriod != 0 && currentStep % heapCompactionPeriod == 0)
+            compactDeviceHeap(currentStep);
+
         if (MovingWindow::getInstance().slideInCurrentStep(currentStep))
         {
             slide(currentStep);
@@ -655,6 +705,9 @@ public:
 
     virtual void resetAll(uint32_t currentStep)
     {
+        /* the tasks of the next step differ from the captured step */
+        Environment<>::get().StepGraph().invalidate();
+
         DataConnector &dc = Environment<>::get().DataConnector();
 
         auto fieldE = dc.get< FieldE >( FieldE::getName(), true );
@@ -669,8 +722,28 @@ public:
         dc.releaseData( FieldB::getName() );
     }
 
+    /** return empty slabs of the particle heap and log the usage per species
+     *
+     * Is called in between two time steps, so no frames are created or
+     * removed concurrently.
+     *
+     * @param currentStep iteration number of the current step
+     */
+    void compactDeviceHeap(uint32_t currentStep)
+    {
+        PMacc::compactDeviceHeap(*deviceHeap);
+        ForEach< VectorAllSpecies, particles::LogDeviceHeapUsage<bmpl::_1> > logDeviceHeapUsage;
+        logDeviceHeapUsage( deviceHeap, currentStep );
+    }
+
     void slide(uint32_t currentStep)
     {
+        if (MovingWindow::getInstance().isSlideBySupercellRow())
+        {
+            slideOneSupercellRow(currentStep);
+            return;
+        }
+
         GridController<simDim>& gc = Environment<simDim>::get().GridController();
 
         if (gc.slide())
@@ -683,6 +756,57 @@ public:
         }
     }
 
+    /** slide the window by one supercell row
+     *
+     * Fields and particles are shifted on each GPU by one supercell row towards
+     * smaller y. The data leaving a GPU is passed to the neighbor with the
+     * regular guard communication and only the supercell row entering the
+     * window is initialized on the last GPU in y direction.
+     */
+    void slideOneSupercellRow(uint32_t currentStep)
+    {
+        log<picLog::SIMULATION_STATE > ("slide by supercell row in step %1%") % currentStep;
+
+        /* the tasks of the next step differ from the captured step */
+        Environment<>::get().StepGraph().invalidate();
+
+        GridController<simDim>& gc = Environment<simDim>::get().GridController();
+        const bool isBottomGpu = MovingWindow::getInstance().isBottomGPU();
+
+        DataConnector &dc = Environment<>::get().DataConnector();
+        auto fieldE = dc.get< FieldE >( FieldE::getName(), true );
+        auto fieldB = dc.get< FieldB >( FieldB::getName(), true );
+
+        /* the guard of the neighbor below becomes our last border row */
+        EventTask eRfieldE = fieldE->asyncCommunication(__getTransactionEvent());
+        EventTask eRfieldB = fieldB->asyncCommunication(__getTransactionEvent());
+        __setTransactionEvent(eRfieldE + eRfieldB);
+
+        movingWindow::shiftFieldBySupercellRow(*fieldE, isBottomGpu);
+        movingWindow::shiftFieldBySupercellRow(*fieldB, isBottomGpu);
+
+        eRfieldE = fieldE->asyncCommunication(__getTransactionEvent());
+        eRfieldB = fieldB->asyncCommunication(__getTransactionEvent());
+        __setTransactionEvent(eRfieldE + eRfieldB);
+
+        dc.releaseData( FieldE::getName() );
+        dc.releaseData( FieldB::getName() );
+
+        ForEach< VectorAllSpecies, movingWindow::ShiftSpeciesBySupercellRow< bmpl::_1 > > shiftSpecies;
+        shiftSpecies( );
+        __getTransactionEvent().waitForFinished();
+
+        gc.shiftGlobalDomainOffset(MovingWindow::getInstance().getCellsPerSlide());
+
+        if (isBottomGpu)
+        {
+            MovingWindow::getInstance().setInitEnteringRowOnly(true);
+            ForEach< particles::InitPipeline, particles::CallFunctor< bmpl::_1 > > initSpecies;
+            initSpecies( currentStep );
+            MovingWindow::getInstance().setInitEnteringRowOnly(false);
+        }
+    }
+
     virtual void setInitController(IInitPlugin *initController)
     {
 
@@ -754,6 +878,19 @@ protected:
     std::vector<std::string> gridDistribution;
 
     bool slidingWindow;
+    bool slideBySupercellRow;
+
+    // number of CUDA streams for the simulation and for independent work
+    uint32_t numStreams;
+    uint32_t numIndependentStreams;
+    // name of the stream selection policy
+    std::string streamPolicy;
+
+    // period of the particle heap compaction, 0 disables the compaction
+    uint32_t heapCompactionPeriod;
+
+    // values of the parameters selected in runtimeParameters.param
+    runtime::Parameters runtimeParameters;
 };
 } /* namespace picongpu */
 
@@ -761,3 +898,8 @@ protected:
 #include "particles/synchrotronPhotons/SynchrotronFunctions.tpp"
 #include "particles/bremsstrahlung/Bremsstrahlung.tpp"
 #include "particles/bremsstrahlung/ScaledSpectrum.tpp"
+
+/* the host functions of the IdProvider are called by the I/O writers, which
+ * live in other translation units and only include IdProvider.def
+ */
+template class PMacc::IdProvider< picongpu::simDim >;
@@ -0,0 +1,192 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simulation_defines.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <vector>
+
+
+/** @file
+ *
+ * Physics parameters which can be changed at runtime
+ *
+ * The parameters are selected in runtimeParameters.param. The accessors
+ * return 1.0 for a parameter which is not selected, the compiler folds the
+ * factor into the compile time constants.
+ *
+ * Each translation unit holds its own copy of the parameters in constant
+ * memory (no relocatable device code, see TranslationUnits.def) and
+ * registers an upload function for it, setParameters() updates all copies.
+ */
+
+namespace picongpu
+{
+namespace runtime
+{
+    namespace po = boost::program_options;
+
+    /** factors to values of the param files */
+    struct Parameters
+    {
+        float_X laserAmplitudeScale;
+        float_X laserPulseLengthScale;
+        float_X densityScale;
+        float_X temperatureScale;
+    };
+
+    /** parameters of a simulation which uses the param files unchanged */
+    inline Parameters getDefaultParameters()
+    {
+        Parameters params;
+        params.laserAmplitudeScale = float_X( 1.0 );
+        params.laserPulseLengthScale = float_X( 1.0 );
+        params.densityScale = float_X( 1.0 );
+        params.temperatureScale = float_X( 1.0 );
+        return params;
+    }
+
+namespace detail
+{
+    typedef void (*UploadFunction)( const Parameters& );
+
+    /** parameters on the host, shared by all translation units */
+    inline Parameters& getHostParameters()
+    {
+        static Parameters params = getDefaultParameters( );
+        return params;
+    }
+
+    /** upload functions of all translation units */
+    inline std::vector< UploadFunction >& getUploadFunctions()
+    {
+        static std::vector< UploadFunction > uploadFunctions;
+        return uploadFunctions;
+    }
+
+/* internal linkage: one copy per translation unit */
+namespace
+{
+#ifdef __CUDACC__
+    __constant__ Parameters deviceParameters;
+
+    void uploadParameters( const Parameters& params )
+    {
+        CUDA_CHECK( cudaMemcpyToSymbol( deviceParameters, &params, sizeof( Parameters ) ) );
+    }
+
+    /** add uploadParameters() of this translation unit to the upload functions */
+    struct RegisterUploadFunction
+    {
+        RegisterUploadFunction()
+        {
+            getUploadFunctions( ).push_back( &uploadParameters );
+        }
+    };
+
+    const RegisterUploadFunction registerUploadFunction;
+#endif
+} // anonymous namespace
+} // namespace detail
+
+    /** set the parameters on the host and in the constant memory of all
+     *  translation units
+     *
+     * Must be called after the device is selected and before the first
+     * kernel using the parameters.
+     */
+    inline void setParameters( const Parameters& params )
+    {
+        detail::getHostParameters( ) = params;
+        for( detail::UploadFunction upload : detail::getUploadFunctions( ) )
+            upload( params );
+    }
+
+    /** current parameters, on the host or on the device */
+    HDINLINE const Parameters& getParameters()
+    {
+#ifdef __CUDA_ARCH__
+        return detail::deviceParameters;
+#else
+        return detail::getHostParameters( );
+#endif
+    }
+
+    /** register a command line option for each selected parameter
+     *
+     * @param desc options to extend
+     * @param params storage for the parsed values
+     */
+    inline void registerOptions( po::options_description& desc, Parameters& params )
+    {
+        if( runtimeTunable::laserAmplitudeScale )
+            desc.add_options( )
+                ( "runtime.laserAmplitudeScale",
+                  po::value< float_X >( &params.laserAmplitudeScale )->default_value( params.laserAmplitudeScale ),
+                  "factor for the laser amplitude of laser.param" );
+        if( runtimeTunable::laserPulseLengthScale )
+            desc.add_options( )
+                ( "runtime.laserPulseLengthScale",
+                  po::value< float_X >( &params.laserPulseLengthScale )->default_value( params.laserPulseLengthScale ),
+                  "factor for the laser pulse length and initialization time of laser.param" );
+        if( runtimeTunable::densityScale )
+            desc.add_options( )
+                ( "runtime.densityScale",
+                  po::value< float_X >( &params.densityScale )->default_value( params.densityScale ),
+                  "factor for the base density of density.param" );
+        if( runtimeTunable::temperatureScale )
+            desc.add_options( )
+                ( "runtime.temperatureScale",
+                  po::value< float_X >( &params.temperatureScale )->default_value( params.temperatureScale ),
+                  "factor for the temperature of all temperature manipulators" );
+    }
+
+    /** factor for laserProfile::AMPLITUDE */
+    HDINLINE float_X laserAmplitudeScale()
+    {
+        return runtimeTunable::laserAmplitudeScale ?
+            getParameters( ).laserAmplitudeScale : float_X( 1.0 );
+    }
+
+    /** factor for laserProfile::PULSE_LENGTH */
+    HDINLINE float_X laserPulseLengthScale()
+    {
+        return runtimeTunable::laserPulseLengthScale ?
+            getParameters( ).laserPulseLengthScale : float_X( 1.0 );
+    }
+
+    /** factor for BASE_DENSITY */
+    HDINLINE float_X densityScale()
+    {
+        return runtimeTunable::densityScale ?
+            getParameters( ).densityScale : float_X( 1.0 );
+    }
+
+    /** factor for the temperature of the temperature manipulators */
+    HDINLINE float_X temperatureScale()
+    {
+        return runtimeTunable::temperatureScale ?
+            getParameters( ).temperatureScale : float_X( 1.0 );
+    }
+
+} // namespace runtime
+} // namespace picongpu
@@ -0,0 +1,177 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pmacc_types.hpp"
+#include "simulation_defines.hpp"
+#include "dimensions/DataSpace.hpp"
+#include "communication/AsyncCommunication.hpp"
+#include "particles/AsyncCommunicationImpl.hpp"
+#include "Environment.hpp"
+
+namespace picongpu
+{
+namespace movingWindow
+{
+using namespace PMacc;
+
+    /** number of threads per block used to shift rows */
+    constexpr int shiftRowsBlockSize = 256;
+
+    /** shift the content of a buffer towards smaller indices in y
+     *
+     * Each thread owns one column in y and walks it from the first to the last
+     * row, therefore the source row is always read before it is overwritten
+     * and no temporary buffer is needed.
+     *
+     * The grid is two dimensional: x covers the columns, y the z extent (3D).
+     */
+    struct KernelShiftRows
+    {
+        /** @param box data box of the full buffer (including guards)
+         *  @param size size of the full buffer
+         *  @param numRows number of rows to shift
+         *  @param numClearRows number of rows at the end which are set to \p clearValue
+         *  @param clearValue value for the cleared rows
+         */
+        template< typename T_Box, typename T_Value >
+        DINLINE void operator()(
+            T_Box box,
+            const DataSpace< simDim > size,
+            const int numRows,
+            const int numClearRows,
+            const T_Value clearValue
+        ) const
+        {
+            DataSpace< simDim > idx;
+            idx.x() = blockIdx.x * blockDim.x + threadIdx.x;
+            if( idx.x() >= size.x() )
+                return;
+#if(SIMDIM==DIM3)
+            idx.z() = blockIdx.y;
+#endif
+            for( int y = 0; y < size.y() - numRows; ++y )
+            {
+                DataSpace< simDim > srcIdx( idx );
+                srcIdx.y() = y + numRows;
+                idx.y() = y;
+                box( idx ) = box( srcIdx );
+            }
+            for( int y = size.y() - numClearRows; y < size.y(); ++y )
+            {
+                idx.y() = y;
+                box( idx ) = clearValue;
+            }
+        }
+    };
+
+    /** shift a device buffer by a number of rows in y
+     *
+     * @param deviceBuffer buffer to shift, all data including the guard is moved
+     * @param numRows number of rows to shift towards smaller y indices
+     * @param numClearRows number of rows at the end of the buffer to set to \p clearValue
+     * @param clearValue value of the cleared rows
+     */
+    template< typename T_DeviceBuffer, typename T_Value >
+    void shiftRows(
+        T_DeviceBuffer& deviceBuffer,
+        const int numRows,
+        const int numClearRows,
+        const T_Value& clearValue
+    )
+    {
+        const DataSpace< simDim > size = deviceBuffer.getDataSpace();
+
+        DataSpace< simDim - 1 > gridBlocks;
+        DataSpace< simDim - 1 > blockSize = DataSpace< simDim - 1 >::create( 1 );
+        gridBlocks.x() = ( size.x() + shiftRowsBlockSize - 1 ) / shiftRowsBlockSize;
+        blockSize.x() = shiftRowsBlockSize;
+#if(SIMDIM==DIM3)
+        gridBlocks.y() = size.z();
+#endif
+        PMACC_KERNEL( KernelShiftRows{} )
+            ( gridBlocks, blockSize )
+            ( deviceBuffer.getDataBox(), size, numRows, numClearRows, clearValue );
+    }
+
+    /** shift a field by one supercell row towards smaller y
+     *
+     * The guards must be up to date before the call: the guard row of the
+     * neighbor below becomes the last BORDER row. The GUARD must be
+     * communicated again afterwards.
+     *
+     * @param field field with `getGridBuffer()` and `ValueType`
+     * @param isBottomGpu true if the GPU has no neighbor in BOTTOM direction,
+     *                    the entering BORDER row is set to zero
+     */
+    template< typename T_Field >
+    void shiftFieldBySupercellRow( T_Field& field, const bool isBottomGpu )
+    {
+        typedef typename T_Field::ValueType ValueType;
+
+        const int rowCells = SuperCellSize::y::value;
+        const int guardCells = field.getGridBuffer().getGridLayout().getGuard().y();
+        shiftRows(
+            field.getGridBuffer().getDeviceBuffer(),
+            rowCells,
+            isBottomGpu ? rowCells + guardCells : rowCells,
+            ValueType::create( 0.0 )
+        );
+    }
+
+    /** shift all particles of a species by one supercell row towards smaller y
+     *
+     * The frame lists of all supercells are moved, the particles are not
+     * touched. Particles moved into the GUARD are sent to the neighbor (or
+     * deleted at the border of the global domain) with the regular particle
+     * communication, the particles of the neighbor below are inserted into
+     * the last BORDER row.
+     *
+     * @tparam T_SpeciesType type of particle species
+     */
+    template< typename T_SpeciesType >
+    struct ShiftSpeciesBySupercellRow
+    {
+        using SpeciesType = T_SpeciesType;
+        using FrameType = typename SpeciesType::FrameType;
+
+        HINLINE void operator()() const
+        {
+            typedef typename SpeciesType::BufferType::SuperCellType SuperCellType;
+
+            DataConnector &dc = Environment<>::get().DataConnector();
+            auto species = dc.get< SpeciesType >( FrameType::getName(), true );
+
+            shiftRows(
+                species->getParticlesBuffer().getSuperCellsBuffer().getDeviceBuffer(),
+                1,
+                1,
+                SuperCellType()
+            );
+            __setTransactionEvent(
+                communication::asyncCommunication( *species, __getTransactionEvent() )
+            );
+
+            dc.releaseData( FrameType::getName() );
+        }
+    };
+
+} // namespace movingWindow
+} // namespace picongpu
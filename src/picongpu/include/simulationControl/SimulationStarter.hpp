@@ -33,6 +33,10 @@
 #include "mappings/kernel/MappingDescription.hpp"
 #include "pluginSystem/PluginConnector.hpp"
 #include "simulationControl/ISimulationStarter.hpp"
+#include "plugins/staging/StagingProtocol.hpp"
+#if (ENABLE_HDF5 == 1)
+#   include "plugins/staging/StagingServer.hpp"
+#endif
 
 namespace picongpu
 {
@@ -50,9 +54,19 @@ namespace picongpu
 
 
         MappingDesc* mappingDesc;
+
+        /** number of MPI ranks reserved for staging */
+        uint32_t numStagingRanks;
+        /** output directory of the staging ranks */
+        std::string stagingFolder;
+        /** true if this rank does not take part in the simulation */
+        bool isStagingRank;
     public:
 
-        SimulationStarter() : mappingDesc(nullptr)
+        SimulationStarter() :
+            mappingDesc(nullptr),
+            numStagingRanks(0),
+            isStagingRank(false)
         {
             simulationClass = new SimulationClass();
             initClass = new InitClass();
@@ -74,6 +88,12 @@ namespace picongpu
 
         virtual void start()
         {
+            if (isStagingRank)
+            {
+                runStagingServer();
+                return;
+            }
+
             PluginConnector& pluginConnector = Environment<>::get().PluginConnector();
             pluginConnector.loadPlugins();
             log<picLog::SIMULATION_STATE > ("Startup");
@@ -81,8 +101,13 @@ namespace picongpu
             simulationClass->startSimulation();
         }
 
-        virtual void pluginRegisterHelp(po::options_description&)
+        virtual void pluginRegisterHelp(po::options_description& desc)
         {
+            desc.add_options()
+                ("staging.ranks", po::value<uint32_t>(&numStagingRanks)->default_value(0),
+                 "number of MPI ranks (the last ranks) reserved for staging, they do not take part in the simulation")
+                ("staging.folder", po::value<std::string>(&stagingFolder)->default_value("staging"),
+                 "folder in which the staging ranks write the received data");
         }
 
         void notify(uint32_t)
@@ -94,6 +119,10 @@ namespace picongpu
             ArgsParser& ap = ArgsParser::getInstance();
             PluginConnector& pluginConnector = Environment<>::get().PluginConnector();
 
+            po::options_description starterDesc(pluginGetName());
+            pluginRegisterHelp(starterDesc);
+            ap.addOptions(starterDesc);
+
             po::options_description simDesc(simulationClass->pluginGetName());
             simulationClass->pluginRegisterHelp(simDesc);
             ap.addOptions(simDesc);
@@ -122,6 +151,17 @@ namespace picongpu
 
         void pluginLoad()
         {
+            if (numStagingRanks > 0)
+            {
+#if (ENABLE_HDF5 != 1)
+                throw std::runtime_error("staging ranks (--staging.ranks) require HDF5 support");
+#endif
+                isStagingRank = Environment<simDim>::get().initStagingRanks(numStagingRanks);
+                /* staging ranks neither select a device nor create the simulation */
+                if (isStagingRank)
+                    return;
+            }
+
             simulationClass->load();
             mappingDesc = simulationClass->getMappingDescription();
             pluginClass->setMappingDescription(mappingDesc);
@@ -130,14 +170,29 @@ namespace picongpu
 
         void pluginUnload()
         {
+            if (isStagingRank)
+                return;
+
             PluginConnector& pluginConnector = Environment<>::get().PluginConnector();
             pluginConnector.unloadPlugins();
             initClass->unload();
             pluginClass->unload();
             simulationClass->unload();
+
+            /* all data is sent, release the staging ranks */
+            staging::sendFinish();
         }
     private:
 
+        void runStagingServer()
+        {
+#if (ENABLE_HDF5 == 1)
+            log<picLog::SIMULATION_STATE > ("Startup staging rank");
+            staging::StagingServer server(stagingFolder);
+            server.run();
+#endif
+        }
+
         void printStartParameters(int argc, char **argv)
         {
             std::cout << "Start Parameters: ";
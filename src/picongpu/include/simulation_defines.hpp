@@ -49,5 +49,8 @@ namespace picongpu
 // ##### load unitless
 #include <simulation_defines/_defaultUnitless.loader>
 #include <simulation_defines/extensionUnitless.loader>
-//load starter after user extensions and all params are loaded
-#include <simulation_defines/unitless/starter.unitless>
+
+/* the starter (simulation_defines/unitless/starter.unitless) is only
+ * included by the simulation translation unit (main.cu), see
+ * simulationControl/TranslationUnits.def
+ */
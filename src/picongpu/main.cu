@@ -31,6 +31,8 @@
 #include "Environment.hpp"
 
 #include <simulation_defines.hpp>
+//load starter after user extensions and all params are loaded
+#include <simulation_defines/unitless/starter.unitless>
 
 
 /*! start of PIConGPU
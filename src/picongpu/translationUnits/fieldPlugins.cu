@@ -0,0 +1,78 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *
+ * Translation unit of the plugins for FieldE, FieldB and FieldJ
+ *
+ * @see simulationControl/TranslationUnits.def
+ */
+
+#include <simulation_defines.hpp>
+#include "simulationControl/TranslationUnits.def"
+
+#include "plugins/SliceFieldPrinterMulti.hpp"
+#include "compileTime/AllCombinations.hpp"
+#include "math/Vector.hpp"
+
+#include "fields/Fields.tpp"
+
+
+namespace picongpu
+{
+namespace translationUnits
+{
+namespace
+{
+    /** apply the 1st vector component to the 2nd
+     *
+     * @tparam T_TupleVector vector of type PMacc::math::CT::vector<dataType,plugin>
+     *                       with two components
+     */
+    template<typename T_TupleVector>
+    struct ApplyDataToPlugin :
+    bmpl::apply1<typename PMacc::math::CT::At<T_TupleVector, bmpl::int_<1> >::type,
+    typename PMacc::math::CT::At<T_TupleVector, bmpl::int_<0> >::type >
+    {
+    };
+} // anonymous namespace
+
+    void createFieldPlugins( std::list< ISimulationPlugin* >& plugins )
+    {
+        typedef bmpl::vector<
+         SliceFieldPrinterMulti<bmpl::_1>
+        > UnspecializedFieldPlugins;
+
+        typedef bmpl::vector< FieldB, FieldE, FieldJ> AllFields;
+
+        typedef AllCombinations<
+          bmpl::vector<AllFields, UnspecializedFieldPlugins>
+        >::type CombinedUnspecializedFieldPlugins;
+
+        typedef bmpl::transform<
+        CombinedUnspecializedFieldPlugins,
+          ApplyDataToPlugin<bmpl::_1>
+        >::type FieldPlugins;
+
+        ForEach< FieldPlugins, CreatePlugin< bmpl::_1 > > createPlugins;
+        createPlugins( forward( plugins ) );
+    }
+
+} // namespace translationUnits
+} // namespace picongpu
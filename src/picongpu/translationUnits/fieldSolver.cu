@@ -0,0 +1,57 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *
+ * Translation unit of the Maxwell solver
+ *
+ * @see simulationControl/TranslationUnits.def
+ */
+
+#include <simulation_defines.hpp>
+#include "simulationControl/TranslationUnits.def"
+
+#include "fields/MaxwellSolver/Solvers.hpp"
+
+#include "fields/Fields.tpp"
+
+
+namespace picongpu
+{
+namespace translationUnits
+{
+
+    void updateFieldSolverBeforeCurrent(
+        fieldSolver::FieldSolver& solver,
+        uint32_t currentStep
+    )
+    {
+        solver.update_beforeCurrent( currentStep );
+    }
+
+    void updateFieldSolverAfterCurrent(
+        fieldSolver::FieldSolver& solver,
+        uint32_t currentStep
+    )
+    {
+        solver.update_afterCurrent( currentStep );
+    }
+
+} // namespace translationUnits
+} // namespace picongpu
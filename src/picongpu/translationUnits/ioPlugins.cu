@@ -0,0 +1,68 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *
+ * Translation unit of the I/O writers
+ *
+ * The writers only use the host side of PMacc::IdProvider, which is
+ * instantiated in the simulation translation unit.
+ *
+ * @see simulationControl/TranslationUnits.def
+ */
+
+#include <simulation_defines.hpp>
+#include "simulationControl/TranslationUnits.def"
+
+#if (ENABLE_ADIOS == 1)
+#include "plugins/adios/ADIOSWriter.hpp"
+#endif
+
+#if (ENABLE_HDF5 == 1)
+#include "plugins/hdf5/HDF5Writer.hpp"
+#endif
+
+#include "fields/Fields.tpp"
+
+
+namespace picongpu
+{
+namespace translationUnits
+{
+
+    void createIOPlugins( std::list< ISimulationPlugin* >& plugins )
+    {
+        typedef bmpl::vector<
+#if (ENABLE_ADIOS == 1)
+            adios::ADIOSWriter
+#endif
+#if (ENABLE_ADIOS == 1) && (ENABLE_HDF5 == 1)
+          ,
+#endif
+#if (ENABLE_HDF5 == 1)
+            hdf5::HDF5Writer
+#endif
+        > IOPlugins;
+
+        ForEach< IOPlugins, CreatePlugin< bmpl::_1 > > createPlugins;
+        createPlugins( forward( plugins ) );
+    }
+
+} // namespace translationUnits
+} // namespace picongpu
@@ -0,0 +1,83 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *
+ * Translation unit of the plugins which do not depend on a species or field
+ *
+ * @see simulationControl/TranslationUnits.def
+ */
+
+#include <simulation_defines.hpp>
+#include "simulationControl/TranslationUnits.def"
+
+#include "plugins/EnergyFields.hpp"
+#include "plugins/SumCurrents.hpp"
+#include "plugins/ChargeConservation.hpp"
+
+#if(SIMDIM==DIM3)
+#include "plugins/IntensityPlugin.hpp"
+#endif
+
+#if (ENABLE_INSITU_VOLVIS == 1)
+#include "plugins/InSituVolumeRenderer.hpp"
+#endif
+
+#if (ENABLE_ISAAC == 1) && (SIMDIM==DIM3)
+#include "plugins/IsaacPlugin.hpp"
+#endif
+
+#include "plugins/ResourceLog.hpp"
+#include "plugins/staging/FieldStaging.hpp"
+#include "plugins/streaming/OpenPMDStream.hpp"
+
+#include "fields/Fields.tpp"
+
+
+namespace picongpu
+{
+namespace translationUnits
+{
+
+    void createStandAlonePlugins( std::list< ISimulationPlugin* >& plugins )
+    {
+        typedef bmpl::vector<
+            EnergyFields,
+            SumCurrents,
+            ChargeConservation
+#if(SIMDIM==DIM3)
+          , IntensityPlugin
+#endif
+#if (ENABLE_INSITU_VOLVIS == 1)
+          , InSituVolumeRenderer
+#endif
+#if (ENABLE_ISAAC == 1) && (SIMDIM==DIM3)
+          , isaacP::IsaacPlugin
+#endif
+          , ResourceLog
+          , staging::FieldStaging
+          , streaming::OpenPMDStream
+        > StandAlonePlugins;
+
+        ForEach< StandAlonePlugins, CreatePlugin< bmpl::_1 > > createPlugins;
+        createPlugins( forward( plugins ) );
+    }
+
+} // namespace translationUnits
+} // namespace picongpu
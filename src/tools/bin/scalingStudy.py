@@ -0,0 +1,482 @@
+#!/usr/bin/env python
+#
+# Copyright 2017 PIConGPU contributors
+#
+# This file is part of PIConGPU.
+#
+# PIConGPU is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# PIConGPU is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with PIConGPU.
+# If not, see <http://www.gnu.org/licenses/>.
+#
+
+from __future__ import print_function
+
+import argparse
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+
+
+__doc__ = '''
+Weak and strong scaling studies based on the tbg cfg files of an example.
+
+The study is done in three steps, all of them are called from the directory
+of a parameter set (created with `pic-create`):
+
+  generate  create the cfg files for all rank counts based on a reference
+            cfg file, e.g. submit/0001gpus.cfg
+              weak:   the local domain of the reference is kept per rank
+              strong: the global domain of the reference is kept
+  run       call tbg for each generated cfg file, by default all ranks are
+            started on the local machine (mpiexec --oversubscribe, see
+            submit/bash/bash_mpiexec_oversubscribe.tpl), any other submit
+            template and command can be used
+  collect   read the output of all runs and print the efficiency tables
+
+The efficiency is computed from the wall times PIConGPU prints at the end
+of a run (initialization, calculation and full simulation time), i.e. per
+whole time step. PIConGPU does not time the phases of a step (field solver,
+particle push, current deposition, communication) separately, therefore
+the tables contain no per-phase efficiency. The generated cfg files enable
+the ResourceLog plugin to count the MPI messages and bytes which are sent
+by each rank, which shows how the communication volume scales. The
+throughput of single kernels can be measured with the KernelBenchmark
+example (examples/KernelBenchmark).
+
+Example:
+  scalingStudy.py generate -c submit/0001gpus.cfg -n 1 2 4 8 --steps 100
+  scalingStudy.py run -c submit/scaling.json -d $SCRATCH/scaling
+  scalingStudy.py collect -c submit/scaling.json
+'''
+
+MANIFEST_NAME = "scaling.json"
+
+# default size of a supercell, see memory.param
+DEFAULT_SUPERCELL = [8, 8, 4]
+
+
+def read_cfg(cfg_file):
+    """
+    read the devices, the grid size and the number of steps of a cfg file
+
+    Parameters:
+    cfg_file: string
+        path to a tbg cfg file
+
+    Returns:
+    dictionary with the keys `devices`, `grid` and `steps`
+    """
+    with open(cfg_file) as f:
+        content = f.read()
+
+    devices = []
+    for d in "xyz":
+        match = re.search(r"^\s*TBG_gpu_%s\s*=\s*(\d+)" % d, content, re.M)
+        devices.append(int(match.group(1)) if match else 1)
+
+    match = re.search(r"^\s*TBG_gridSize\s*=\s*\"-g\s+([\d\s]+)\"", content,
+                      re.M)
+    if match is None:
+        raise RuntimeError("no TBG_gridSize=\"-g ...\" found in " + cfg_file)
+    grid = [int(v) for v in match.group(1).split()]
+
+    match = re.search(r"^\s*TBG_steps\s*=\s*\"-s\s+(\d+)\"", content, re.M)
+    steps = int(match.group(1)) if match else None
+
+    return {"devices": devices[:len(grid)], "grid": grid, "steps": steps,
+            "content": content}
+
+
+def prime_factors(n):
+    """ prime factors of n in descending order """
+    factors = []
+    p = 2
+    while p * p <= n:
+        while n % p == 0:
+            factors.append(p)
+            n //= p
+        p += 1
+    if n > 1:
+        factors.append(n)
+    return sorted(factors, reverse=True)
+
+
+def decomposition(ranks, dims, local_grid, candidates):
+    """
+    devices per direction, the rule is shared by weak and strong scaling
+
+    Each prime factor of the number of ranks is added to the direction with
+    the fewest devices, ties are broken by the largest local domain and then
+    by the lowest direction index. Weak and strong scaling therefore use the
+    same layout for the same number of ranks as long as the global domain of
+    strong scaling can be divided.
+
+    Parameters:
+    local_grid: function(devices, i), local domain in direction i
+    candidates: function(devices, p), directions which can take factor p
+
+    Returns:
+    list of devices per direction or None if no direction can take a factor
+    """
+    devices = [1] * dims
+    for p in prime_factors(ranks):
+        valid = candidates(devices, p)
+        if not valid:
+            return None
+        d = min(valid, key=lambda i: (devices[i], -local_grid(devices, i), i))
+        devices[d] *= p
+    return devices
+
+
+def weak_decomposition(ranks, local_grid):
+    """
+    devices and global grid for weak scaling
+
+    The local domain is kept, see decomposition() for the layout rule.
+    """
+    dims = len(local_grid)
+    devices = decomposition(
+        ranks, dims,
+        lambda devices, i: local_grid[i],
+        lambda devices, p: list(range(dims)))
+    grid = [local_grid[i] * devices[i] for i in range(dims)]
+    return devices, grid
+
+
+def strong_decomposition(ranks, grid, supercell):
+    """
+    devices for strong scaling
+
+    The global domain is kept, a factor is only added to a direction if the
+    global domain can still be divided into full supercells, see
+    decomposition() for the layout rule.
+
+    Returns:
+    list of devices per direction or None if the grid can not be divided
+    """
+    dims = len(grid)
+    return decomposition(
+        ranks, dims,
+        lambda devices, i: grid[i] // devices[i],
+        lambda devices, p: [
+            i for i in range(dims)
+            if grid[i] % (devices[i] * p * supercell[i]) == 0
+        ])
+
+
+def is_valid_local_domain(grid, devices, supercell):
+    """
+    each local domain needs at least 3 supercells (core + 2x border)
+    in each direction and must be divisible into supercells
+    """
+    for i in range(len(grid)):
+        local = grid[i] // devices[i]
+        if grid[i] % devices[i] != 0 or local % supercell[i] != 0:
+            return False
+        if local < 3 * supercell[i]:
+            return False
+    return True
+
+
+def write_cfg(reference, cfg_file, devices, grid, steps, disable_plugins):
+    """
+    write a cfg file which overwrites devices, grid and steps of a reference
+
+    The overwrites are inserted in front of the `Program Parameters`
+    section, the definitions of the reference are not modified.
+    """
+    devices3 = list(devices) + [1] * (3 - len(devices))
+    block = [
+        "# overwrites of scalingStudy.py",
+        "TBG_gpu_x=%d" % devices3[0],
+        "TBG_gpu_y=%d" % devices3[1],
+        "TBG_gpu_z=%d" % devices3[2],
+        "TBG_gridSize=\"-g %s\"" % " ".join(str(g) for g in grid),
+        "TBG_steps=\"-s %d\"" % steps
+    ]
+    if disable_plugins:
+        block.append("TBG_plugins=\"\"")
+    # the ResourceLog is called at step 0 and at the last step
+    block.append("TBG_scalingLog=\"--resourceLog.period %d "
+                 "--resourceLog.properties rank currentStep communication "
+                 "--resourceLog.prefix resourceLog_\"" % steps)
+    block.append("")
+
+    lines = reference["content"].splitlines()
+    insert = None
+    for n, line in enumerate(lines):
+        if re.match(r"^\s*TBG_(devices|programParams)\s*=", line):
+            insert = n
+            break
+    if insert is None:
+        raise RuntimeError("no TBG_devices or TBG_programParams found in "
+                           "the reference cfg file")
+    lines[insert:insert] = block
+
+    content = "\n".join(lines) + "\n"
+    content, count = re.subn(r"^(\s*TBG_programParams\s*=\s*\")",
+                             r"\1!TBG_scalingLog ", content, flags=re.M)
+    if count == 0:
+        raise RuntimeError("no TBG_programParams found in the reference "
+                           "cfg file")
+
+    with open(cfg_file, "w") as f:
+        f.write(content)
+
+
+def generate(args):
+    reference = read_cfg(args.cfg)
+    dims = len(reference["grid"])
+    supercell = (args.supercell or DEFAULT_SUPERCELL)[:dims]
+    steps = args.steps or reference["steps"]
+    if steps is None:
+        raise RuntimeError("number of steps not found, use --steps")
+
+    ref_devices = reference["devices"]
+    ref_grid = reference["grid"]
+    local_grid = [ref_grid[i] // ref_devices[i] for i in range(dims)]
+
+    out_dir = args.out or os.path.dirname(os.path.abspath(args.cfg))
+    modes = ["weak", "strong"] if args.mode == "both" else [args.mode]
+
+    runs = []
+    # devices of the first mode per number of ranks
+    layouts = {}
+    for mode in modes:
+        for ranks in args.ranks:
+            if mode == "weak":
+                devices, grid = weak_decomposition(ranks, local_grid)
+            else:
+                grid = list(ref_grid)
+                devices = strong_decomposition(ranks, grid, supercell)
+            if devices is None or \
+                    not is_valid_local_domain(grid, devices, supercell):
+                print("skip %s scaling with %d ranks: grid %s can not be "
+                      "divided into local domains of at least 3 supercells"
+                      % (mode, ranks, grid), file=sys.stderr)
+                continue
+
+            if layouts.setdefault(ranks, devices) != devices:
+                print("warning: %d ranks use devices %s for weak and %s for "
+                      "strong scaling, the global grid can not be divided "
+                      "like the weak scaling layout"
+                      % (ranks, layouts[ranks], devices), file=sys.stderr)
+
+            name = "scaling_%s_%04dgpus" % (mode, ranks)
+            cfg_file = os.path.join(out_dir, name + ".cfg")
+            write_cfg(reference, cfg_file, devices, grid, steps,
+                      args.no_plugins)
+            runs.append({"name": name, "mode": mode, "ranks": ranks,
+                         "devices": devices, "grid": grid, "steps": steps,
+                         "cfg": cfg_file})
+            print("%s: devices %s grid %s" % (name, devices, grid))
+
+    manifest = os.path.join(out_dir, MANIFEST_NAME)
+    with open(manifest, "w") as f:
+        json.dump({"reference": os.path.abspath(args.cfg), "runs": runs}, f,
+                  indent=2)
+    print("manifest: " + manifest)
+
+
+def run(args):
+    with open(args.cfg) as f:
+        manifest = json.load(f)
+
+    project = os.path.abspath(args.project)
+    tpl = args.tpl or os.path.join(
+        project, "submit", "bash", "bash_mpiexec_oversubscribe.tpl")
+
+    for entry in manifest["runs"]:
+        if args.mode != "both" and entry["mode"] != args.mode:
+            continue
+        dst = os.path.join(os.path.abspath(args.dst), entry["name"])
+        command = [args.tbg, "-s", args.submit, "-t", tpl, "-c",
+                   entry["cfg"], project, dst]
+        print(" ".join(command))
+        if subprocess.call(command) != 0:
+            print("tbg failed for " + entry["name"], file=sys.stderr)
+            continue
+        entry["dst"] = dst
+
+    with open(args.cfg, "w") as f:
+        json.dump(manifest, f, indent=2)
+
+
+def parse_time(text):
+    """ convert the output of TimeIntervall::printeTime to seconds """
+    units = {"h": 3600., "min": 60., "sec": 1., "msec": 1.e-3}
+    return sum(float(value) * units[unit]
+               for value, unit in re.findall(r"(\d+)\s*(msec|min|sec|h)\b",
+                                             text))
+
+
+def read_run(entry):
+    """
+    read the timings and communication statistics of a run
+
+    Only the wall times of the whole run are available (`init`,
+    `calculation`, `full`), `step` is the average calculation time per step.
+
+    Returns:
+    dictionary with the collected values or None if the run is not finished
+    """
+    out_dir = os.path.join(entry.get("dst", ""), "simOutput")
+    output = os.path.join(out_dir, "output")
+    if not os.path.isfile(output):
+        return None
+
+    result = {}
+    with open(output) as f:
+        for line in f:
+            for key, pattern in (("init", "initialization time:"),
+                                 ("calculation",
+                                  "calculation  simulation time:"),
+                                 ("full", "full simulation time:")):
+                pos = line.find(pattern)
+                if pos != -1:
+                    # drop the rounded duplicate after `=`
+                    text = line[pos + len(pattern):].split("=")[0]
+                    result[key] = parse_time(text)
+    if "calculation" not in result:
+        return None
+    result["step"] = result["calculation"] / entry["steps"]
+
+    # ResourceLog: first and last entry of each rank
+    sent_bytes = []
+    sent_messages = []
+    for log_file in glob.glob(os.path.join(out_dir, "resourceLog_*")):
+        with open(log_file) as f:
+            entries = [json.loads(l)["resourceLog"] for l in f if l.strip()]
+        if not entries:
+            continue
+        first = entries[0].get("communication", {})
+        last = entries[-1].get("communication", {})
+        sent_bytes.append(float(last.get("sentBytes", 0)) -
+                          float(first.get("sentBytes", 0)))
+        sent_messages.append(float(last.get("sentMessages", 0)) -
+                             float(first.get("sentMessages", 0)))
+    if sent_bytes:
+        steps = float(entry["steps"])
+        result["bytesPerStep"] = sum(sent_bytes) / steps
+        result["maxRankBytesPerStep"] = max(sent_bytes) / steps
+        result["messagesPerStep"] = sum(sent_messages) / steps
+    return result
+
+
+def collect(args):
+    with open(args.cfg) as f:
+        manifest = json.load(f)
+
+    tables = {}
+    for entry in manifest["runs"]:
+        result = read_run(entry)
+        if result is None:
+            print("no results for " + entry["name"], file=sys.stderr)
+            continue
+        row = dict(entry)
+        row.update(result)
+        tables.setdefault(entry["mode"], []).append(row)
+
+    for mode, rows in sorted(tables.items()):
+        rows.sort(key=lambda r: r["ranks"])
+        ref = rows[0]
+        for row in rows:
+            ratio = float(row["ranks"]) / ref["ranks"]
+            if mode == "weak":
+                row["speedup"] = ref["step"] / row["step"] * ratio
+                row["efficiency"] = ref["step"] / row["step"]
+            else:
+                row["speedup"] = ref["step"] / row["step"]
+                row["efficiency"] = row["speedup"] / ratio
+
+        print("\n%s scaling (reference: %d ranks)" % (mode, ref["ranks"]))
+        header = ("ranks", "devices", "grid", "init[s]", "step[ms]",
+                  "speedup", "eff[%]", "MiB/step", "maxRank MiB/step",
+                  "msg/step")
+        print(" | ".join(header))
+        for row in rows:
+            mib = 1024. * 1024.
+            print(" | ".join((
+                "%d" % row["ranks"],
+                "x".join(str(d) for d in row["devices"]),
+                "x".join(str(g) for g in row["grid"]),
+                "%.1f" % row.get("init", 0.),
+                "%.2f" % (row["step"] * 1000.),
+                "%.2f" % row["speedup"],
+                "%.1f" % (row["efficiency"] * 100.),
+                "%.2f" % (row.get("bytesPerStep", 0.) / mib),
+                "%.2f" % (row.get("maxRankBytesPerStep", 0.) / mib),
+                "%.0f" % row.get("messagesPerStep", 0.))))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(tables, f, indent=2)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command")
+
+    p = sub.add_parser("generate", help="create cfg files for a study")
+    p.add_argument("-c", "--cfg", required=True,
+                   help="reference cfg file, e.g. submit/0001gpus.cfg")
+    p.add_argument("-n", "--ranks", type=int, nargs="+", required=True,
+                   help="number of ranks, e.g. 1 2 4 8")
+    p.add_argument("-m", "--mode", choices=["weak", "strong", "both"],
+                   default="both", help="type of the study")
+    p.add_argument("--steps", type=int,
+                   help="number of time steps (default: reference)")
+    p.add_argument("--supercell", type=int, nargs="+",
+                   help="supercell size of memory.param (default: 8 8 4)")
+    p.add_argument("--no-plugins", action="store_true",
+                   help="disable the plugins of the reference (TBG_plugins)")
+    p.add_argument("-o", "--out",
+                   help="directory of the generated cfg files "
+                        "(default: directory of the reference)")
+    p.set_defaults(func=generate)
+
+    p = sub.add_parser("run", help="start all runs of a study with tbg")
+    p.add_argument("-c", "--cfg", required=True,
+                   help="manifest written by generate (" + MANIFEST_NAME + ")")
+    p.add_argument("-d", "--dst", required=True,
+                   help="directory for the output of all runs")
+    p.add_argument("-m", "--mode", choices=["weak", "strong", "both"],
+                   default="both", help="type of the study")
+    p.add_argument("-p", "--project", default=".",
+                   help="parameter set with the installed binary")
+    p.add_argument("-s", "--submit", default="bash",
+                   help="submit command passed to tbg (default: bash)")
+    p.add_argument("-t", "--tpl",
+                   help="tbg template (default: "
+                        "submit/bash/bash_mpiexec_oversubscribe.tpl)")
+    p.add_argument("--tbg", default="tbg", help="path to tbg")
+    p.set_defaults(func=run)
+
+    p = sub.add_parser("collect",
+                       help="print the efficiency tables (time per step "
+                            "and MPI traffic, no per-phase timings)")
+    p.add_argument("-c", "--cfg", required=True,
+                   help="manifest written by generate and run")
+    p.add_argument("--json", help="write the tables to a JSON file")
+    p.set_defaults(func=collect)
+
+    args = parser.parse_args()
+    if args.command is None:
+        parser.print_help()
+        sys.exit(1)
+    args.func(args)
@@ -0,0 +1,322 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Reference consumer of the PIConGPU openPMD stream (plugin `--stream.*`).
+ *
+ * Listens on a unix domain socket, receives the step messages of all
+ * simulation ranks and either writes them to disk or reduces each record
+ * over all ranks of a step.
+ */
+
+#include "plugins/streaming/StreamProtocol.hpp"
+#include "plugins/streaming/StreamTransport.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+using namespace picongpu::streaming;
+
+struct Options
+{
+    std::string socketPath;
+    std::string mode;
+    std::string outputDir;
+    uint32_t numProducers;
+    uint32_t delayMs;
+};
+
+bool parseCmdLine(int argc, char **argv, Options &options)
+{
+    try
+    {
+        std::stringstream desc_stream;
+        desc_stream << "Usage " << argv[0] << " [options]" << std::endl;
+
+        po::options_description desc(desc_stream.str());
+        desc.add_options()
+                ("help,h", "print help message")
+                ("socket,s", po::value<std::string > (&options.socketPath)->default_value("picongpu_stream.sock"),
+                "Socket path, same as --stream.address of the simulation")
+                ("producers,n", po::value<uint32_t > (&options.numProducers)->default_value(1),
+                "Number of simulation ranks on this node (the socket is node local), "
+                "a step is complete after all of them delivered it, "
+                "the consumer exits after all of them sent data and disconnected")
+                ("mode,m", po::value<std::string > (&options.mode)->default_value("reduce"),
+                "write: store each message as <output>/step_<step>_rank_<rank>.opmdstream, "
+                "reduce: print min/max/mean of each record per step")
+                ("output,o", po::value<std::string > (&options.outputDir)->default_value("."),
+                "Output directory for mode write")
+                ("delay", po::value<uint32_t > (&options.delayMs)->default_value(0),
+                "Sleep after each message [ms], emulates a slow consumer")
+                ;
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return false;
+        }
+
+        if (options.mode != "write" && options.mode != "reduce")
+        {
+            std::cerr << "unknown mode '" << options.mode << "'" << std::endl;
+            return false;
+        }
+    }
+    catch (const boost::program_options::error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/** reduction of one record over all ranks of a step */
+struct RecordReduction
+{
+    uint64_t count;
+    double min;
+    double max;
+    double sum;
+
+    RecordReduction() :
+        count(0),
+        min(std::numeric_limits<double>::max()),
+        max(-std::numeric_limits<double>::max()),
+        sum(0.0)
+    {
+    }
+};
+
+/** partial reductions of a step until all ranks delivered it */
+struct StepReduction
+{
+    uint32_t numReceived;
+    std::map<std::string, RecordReduction> records;
+
+    StepReduction() : numReceived(0)
+    {
+    }
+};
+
+template<typename T_Type>
+void reduceData(const StreamRecord& record, RecordReduction& reduction)
+{
+    const uint64_t numElements = record.getNumElements();
+    for (uint64_t i = 0; i < numElements; ++i)
+    {
+        T_Type value;
+        std::memcpy(&value, record.data + i * sizeof(T_Type), sizeof(T_Type));
+        const double v = double(value);
+        reduction.min = std::min(reduction.min, v);
+        reduction.max = std::max(reduction.max, v);
+        reduction.sum += v;
+    }
+    reduction.count += numElements;
+}
+
+void reduceRecord(const StreamRecord& record, RecordReduction& reduction)
+{
+    switch (record.type)
+    {
+    case streamFloat32: reduceData<float>(record, reduction); break;
+    case streamFloat64: reduceData<double>(record, reduction); break;
+    case streamUInt32: reduceData<uint32_t>(record, reduction); break;
+    case streamUInt64: reduceData<uint64_t>(record, reduction); break;
+    case streamInt32: reduceData<int32_t>(record, reduction); break;
+    case streamInt64: reduceData<int64_t>(record, reduction); break;
+    case streamBool: reduceData<uint8_t>(record, reduction); break;
+    default: break;
+    }
+}
+
+void printStep(const uint64_t step, const StepReduction& stepReduction)
+{
+    for (std::map<std::string, RecordReduction>::const_iterator it = stepReduction.records.begin();
+         it != stepReduction.records.end(); ++it)
+    {
+        const RecordReduction& r = it->second;
+        std::cout << step << "\t" << it->first << "\t" << r.count;
+        if (r.count != 0)
+            std::cout << "\t" << r.min << "\t" << r.max << "\t" << r.sum / double(r.count);
+        std::cout << std::endl;
+    }
+}
+
+/** process one received message
+ *
+ * @param producerRanks simulation ranks which delivered at least one message
+ * @return false if the message is broken
+ */
+bool processMessage(
+    const Options& options,
+    const std::vector<char>& message,
+    std::map<uint64_t, StepReduction>& openSteps,
+    std::set<uint32_t>& producerRanks
+)
+{
+    StreamStep step;
+    try
+    {
+        step = parseMessage(message);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+    producerRanks.insert(step.rank);
+
+    if (options.mode == "write")
+    {
+        std::stringstream filename;
+        filename << options.outputDir << "/step_" << step.step << "_rank_" << step.rank << ".opmdstream";
+        std::ofstream file(filename.str().c_str(), std::ios::binary);
+        file.write(message.data(), message.size());
+        if (!file)
+            std::cerr << "could not write " << filename.str() << std::endl;
+    }
+    else
+    {
+        StepReduction& stepReduction = openSteps[step.step];
+        for (size_t i = 0; i < step.records.size(); ++i)
+            reduceRecord(step.records[i], stepReduction.records[step.records[i].path]);
+        ++stepReduction.numReceived;
+        /* step.numRanks counts all ranks, only the ranks of this node share the socket */
+        if (stepReduction.numReceived == options.numProducers)
+        {
+            printStep(step.step, stepReduction);
+            openSteps.erase(step.step);
+        }
+    }
+
+    if (options.delayMs != 0u)
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.delayMs));
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseCmdLine(argc, argv, options))
+        return 1;
+
+    const sockaddr_un address = picongpu::streaming::detail::getSocketAddress(options.socketPath);
+    ::unlink(options.socketPath.c_str());
+
+    const int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 ||
+        ::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0)
+    {
+        std::cerr << "could not listen on " << options.socketPath << std::endl;
+        return 1;
+    }
+    std::cerr << "listening on " << options.socketPath << std::endl;
+
+    std::vector<int> clients;
+    /* counted by rank, a producer may reconnect after a failed send */
+    std::set<uint32_t> producerRanks;
+    std::map<uint64_t, StepReduction> openSteps;
+    std::vector<char> message;
+
+    while (producerRanks.size() < options.numProducers || !clients.empty())
+    {
+        std::vector<pollfd> fds(1);
+        fds[0].fd = listenFd;
+        fds[0].events = POLLIN;
+        for (size_t i = 0; i < clients.size(); ++i)
+        {
+            pollfd client;
+            client.fd = clients[i];
+            client.events = POLLIN;
+            fds.push_back(client);
+        }
+
+        if (::poll(&fds[0], fds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            const int clientFd = ::accept(listenFd, nullptr, nullptr);
+            if (clientFd >= 0)
+                clients.push_back(clientFd);
+        }
+
+        for (size_t i = 1; i < fds.size(); ++i)
+        {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+
+            const int fd = fds[i].fd;
+            uint64_t numBytes = 0;
+            bool isOpen = picongpu::streaming::detail::readAll(fd, reinterpret_cast<char*>(&numBytes), sizeof(numBytes));
+            if (isOpen)
+            {
+                message.resize(numBytes);
+                isOpen = picongpu::streaming::detail::readAll(fd, message.data(), numBytes) &&
+                    processMessage(options, message, openSteps, producerRanks);
+            }
+            if (!isOpen)
+            {
+                ::close(fd);
+                clients.erase(std::find(clients.begin(), clients.end(), fd));
+            }
+        }
+    }
+
+    /* steps where not all ranks delivered a message, e.g. dropped by the producer */
+    for (std::map<uint64_t, StepReduction>::const_iterator it = openSteps.begin(); it != openSteps.end(); ++it)
+    {
+        std::cerr << "step " << it->first << " is incomplete (" << it->second.numReceived << " ranks)" << std::endl;
+        printStep(it->first, it->second);
+    }
+
+    ::close(listenFd);
+    ::unlink(options.socketPath.c_str());
+    return 0;
+}
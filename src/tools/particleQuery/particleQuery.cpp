@@ -0,0 +1,536 @@
+/* Copyright 2017 PIConGPU contributors
+ *
+ * This file is part of PIConGPU.
+ *
+ * PIConGPU is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PIConGPU is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PIConGPU.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Query the particles of a PIConGPU HDF5 output file.
+ *
+ * If the file was written with `--hdf5.particle-statistics <n>`, the min/max
+ * of each record per patch and per chunk of n particles are used to skip
+ * all chunks which can not contain matching particles. The remaining chunks
+ * are distributed over the MPI ranks, each rank reads its chunks
+ * independently.
+ */
+
+#include <mpi.h>
+#include <hdf5.h>
+
+#include <boost/program_options.hpp>
+#include <boost/regex.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+struct Options
+{
+    std::string inputFile;
+    std::string species;
+    std::vector<std::string> conditions;
+    std::vector<std::string> columns;
+    std::string outputPrefix;
+    uint64_t scanChunkSize;
+    bool useSI;
+    bool ignoreStatistics;
+    bool verbose;
+};
+
+/** comparison of a particle record component with a value */
+struct Condition
+{
+    enum Operator { greater, greaterEqual, less, lessEqual };
+
+    std::string component;
+    Operator op;
+    double value;
+
+    bool matches(const double x) const
+    {
+        switch (op)
+        {
+        case greater: return x > value;
+        case greaterEqual: return x >= value;
+        case less: return x < value;
+        default: return x <= value;
+        }
+    }
+
+    /** true if any value in [min, max] can match */
+    bool mayMatch(const double min, const double max) const
+    {
+        switch (op)
+        {
+        case greater: return max > value;
+        case greaterEqual: return max >= value;
+        case less: return min < value;
+        default: return min <= value;
+        }
+    }
+};
+
+/** range of particles which is read as a whole */
+struct Chunk
+{
+    uint64_t offset;
+    uint64_t numParticles;
+};
+
+Condition parseCondition(const std::string& text)
+{
+    static const boost::regex expression("^\\s*([A-Za-z0-9_/]+)\\s*(>=|<=|>|<)\\s*(\\S+)\\s*$");
+    boost::smatch match;
+    if (!boost::regex_match(text, match, expression))
+        throw std::runtime_error("invalid condition '" + text + "', expected e.g. 'momentum/x>1e-3'");
+
+    Condition condition;
+    condition.component = match[1];
+    const std::string op = match[2];
+    if (op == ">")
+        condition.op = Condition::greater;
+    else if (op == ">=")
+        condition.op = Condition::greaterEqual;
+    else if (op == "<")
+        condition.op = Condition::less;
+    else
+        condition.op = Condition::lessEqual;
+    condition.value = std::stod(match[3]);
+    return condition;
+}
+
+bool parseCmdLine(int argc, char **argv, Options &options, const int rank)
+{
+    try
+    {
+        std::stringstream desc_stream;
+        desc_stream << "Usage " << argv[0] << " [options]" << std::endl;
+
+        po::options_description desc(desc_stream.str());
+        desc.add_options()
+                ("help,h", "print help message")
+                ("input-file,i", po::value<std::string > (&options.inputFile), "PIConGPU HDF5 file, e.g. h5/simData_1000.h5")
+                ("species,s", po::value<std::string > (&options.species), "species name, e.g. e")
+                ("where,w", po::value<std::vector<std::string> > (&options.conditions)->multitoken(),
+                "conditions which must all hold, e.g. 'momentum/y>1e-3' 'weighting<=10'")
+                ("print,p", po::value<std::vector<std::string> > (&options.columns)->multitoken(),
+                "record components written for matching particles [default: components of the conditions]")
+                ("output,o", po::value<std::string > (&options.outputPrefix),
+                "write matching particles to <output>_<rank>.dat, otherwise only count them")
+                ("si", po::bool_switch(&options.useSI)->default_value(false),
+                "values of conditions and output are in SI units (scaled with unitSI)")
+                ("scan-chunk", po::value<uint64_t > (&options.scanChunkSize)->default_value(1000000),
+                "particles per read if the file has no statistics")
+                ("ignore-statistics", po::bool_switch(&options.ignoreStatistics)->default_value(false),
+                "read all particles even if statistics are available")
+                ("verbose,v", po::bool_switch(&options.verbose)->default_value(false), "print the chunks of each rank")
+                ;
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help") || options.inputFile.empty() || options.species.empty())
+        {
+            if (rank == 0)
+                std::cout << desc << std::endl;
+            return false;
+        }
+    }
+    catch (const boost::program_options::error& e)
+    {
+        if (rank == 0)
+            std::cerr << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/** read only access to one iteration of a PIConGPU HDF5 file */
+class ParticleFile
+{
+public:
+
+    ParticleFile(const std::string& filename) : bytesRead(0)
+    {
+        file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        if (file < 0)
+            throw std::runtime_error("could not open " + filename);
+
+        /* file based iteration encoding: /data/<step> is the only group */
+        hid_t data = H5Gopen(file, "/data", H5P_DEFAULT);
+        if (data < 0)
+            throw std::runtime_error(filename + " has no /data group");
+        char name[64];
+        if (H5Lget_name_by_idx(data, ".", H5_INDEX_NAME, H5_ITER_INC, 0, name, sizeof(name), H5P_DEFAULT) < 0)
+            throw std::runtime_error(filename + " contains no iteration");
+        H5Gclose(data);
+        basePath = std::string("/data/") + name + "/";
+    }
+
+    ~ParticleFile()
+    {
+        H5Fclose(file);
+    }
+
+    bool exists(const std::string& path) const
+    {
+        /* check each level, H5Lexists fails for missing intermediate groups */
+        std::string current;
+        std::stringstream stream(basePath + path);
+        std::string part;
+        while (std::getline(stream, part, '/'))
+        {
+            if (part.empty())
+                continue;
+            current += "/" + part;
+            if (H5Lexists(file, current.c_str(), H5P_DEFAULT) <= 0)
+                return false;
+        }
+        return true;
+    }
+
+    uint64_t getLength(const std::string& path) const
+    {
+        hid_t dataset = openDataset(path);
+        hid_t space = H5Dget_space(dataset);
+        hsize_t dims[3] = {0, 0, 0};
+        H5Sget_simple_extent_dims(space, dims, nullptr);
+        H5Sclose(space);
+        H5Dclose(dataset);
+        return dims[0];
+    }
+
+    /** unitSI attribute of a dataset, 1.0 if not available */
+    double getUnitSI(const std::string& path) const
+    {
+        double unit = 1.0;
+        hid_t dataset = openDataset(path);
+        if (H5Aexists(dataset, "unitSI") > 0)
+        {
+            hid_t attribute = H5Aopen(dataset, "unitSI", H5P_DEFAULT);
+            H5Aread(attribute, H5T_NATIVE_DOUBLE, &unit);
+            H5Aclose(attribute);
+        }
+        H5Dclose(dataset);
+        return unit;
+    }
+
+    bool isInteger(const std::string& path) const
+    {
+        hid_t dataset = openDataset(path);
+        hid_t type = H5Dget_type(dataset);
+        const bool result = H5Tget_class(type) == H5T_INTEGER;
+        H5Tclose(type);
+        H5Dclose(dataset);
+        return result;
+    }
+
+    /** read a range of a 1D dataset, converted to T_Type */
+    template<typename T_Type>
+    std::vector<T_Type> read(const std::string& path, const hid_t memType, const uint64_t offset, const uint64_t count)
+    {
+        std::vector<T_Type> values(count);
+        if (count == 0)
+            return values;
+
+        hid_t dataset = openDataset(path);
+        hid_t fileSpace = H5Dget_space(dataset);
+        const hsize_t start = offset;
+        const hsize_t size = count;
+        H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &start, nullptr, &size, nullptr);
+        hid_t memSpace = H5Screate_simple(1, &size, nullptr);
+        const herr_t status = H5Dread(dataset, memType, memSpace, fileSpace, H5P_DEFAULT, values.data());
+        H5Sclose(memSpace);
+        H5Sclose(fileSpace);
+        H5Dclose(dataset);
+        if (status < 0)
+            throw std::runtime_error("could not read " + path);
+
+        bytesRead += count * sizeof(T_Type);
+        return values;
+    }
+
+    std::vector<double> readAll(const std::string& path)
+    {
+        return read<double>(path, H5T_NATIVE_DOUBLE, 0, getLength(path));
+    }
+
+    uint64_t getBytesRead() const
+    {
+        return bytesRead;
+    }
+
+private:
+
+    hid_t openDataset(const std::string& path) const
+    {
+        hid_t dataset = H5Dopen(file, (basePath + path).c_str(), H5P_DEFAULT);
+        if (dataset < 0)
+            throw std::runtime_error("dataset " + basePath + path + " not found");
+        return dataset;
+    }
+
+    hid_t file;
+    std::string basePath;
+    uint64_t bytesRead;
+};
+
+/** chunks which may contain matching particles
+ *
+ * uses the per patch statistics first and the per chunk statistics of the
+ * remaining patches afterwards
+ */
+std::vector<Chunk> selectChunks(
+    ParticleFile& file,
+    const Options& options,
+    const std::vector<Condition>& conditions,
+    const std::string& speciesPath,
+    uint64_t& numChunksTotal,
+    uint64_t& numPatchesSkipped
+)
+{
+    const std::string statisticsPath = "particleStatistics/" + options.species + "/";
+    std::vector<Chunk> chunks;
+
+    if (options.ignoreStatistics || !file.exists(statisticsPath + "chunks/numParticles"))
+    {
+        /* no statistics: read everything in chunks of scanChunkSize */
+        const std::string firstRecord = speciesPath + (conditions.empty() ? "weighting" : conditions[0].component);
+        const uint64_t numParticles = file.getLength(firstRecord);
+        for (uint64_t offset = 0; offset < numParticles; offset += options.scanChunkSize)
+        {
+            Chunk chunk = {offset, std::min(options.scanChunkSize, numParticles - offset)};
+            chunks.push_back(chunk);
+        }
+        numChunksTotal = chunks.size();
+        return chunks;
+    }
+
+    const std::vector<double> chunkNumParticles = file.readAll(statisticsPath + "chunks/numParticles");
+    const std::vector<double> chunkOffsets = file.readAll(statisticsPath + "chunks/numParticlesOffset");
+    const std::vector<double> patchNumParticles = file.readAll(speciesPath + "particlePatches/numParticles");
+    const std::vector<double> patchOffsets = file.readAll(speciesPath + "particlePatches/numParticlesOffset");
+    numChunksTotal = chunkNumParticles.size();
+
+    /* patch statistics of all conditions */
+    std::vector<bool> patchMayMatch(patchNumParticles.size(), true);
+    std::vector<bool> chunkMayMatch(chunkNumParticles.size(), true);
+    for (size_t c = 0; c < conditions.size(); ++c)
+    {
+        const double unit = options.useSI ? file.getUnitSI(speciesPath + conditions[c].component) : 1.0;
+        const std::string patchPath = statisticsPath + "patches/" + conditions[c].component;
+        const std::vector<double> patchMin = file.readAll(patchPath + "/min");
+        const std::vector<double> patchMax = file.readAll(patchPath + "/max");
+        for (size_t p = 0; p < patchMin.size(); ++p)
+        {
+            const double a = patchMin[p] * unit;
+            const double b = patchMax[p] * unit;
+            /* empty patches have min > max */
+            if (patchMin[p] > patchMax[p] || !conditions[c].mayMatch(std::min(a, b), std::max(a, b)))
+                patchMayMatch[p] = false;
+        }
+    }
+
+    /* chunks and patches are both ordered by their particle offset */
+    size_t patchIdx = 0;
+    for (size_t i = 0; i < chunkNumParticles.size(); ++i)
+    {
+        while (patchIdx < patchNumParticles.size() &&
+               chunkOffsets[i] >= patchOffsets[patchIdx] + patchNumParticles[patchIdx])
+            ++patchIdx;
+        if (patchIdx < patchNumParticles.size() && !patchMayMatch[patchIdx])
+            chunkMayMatch[i] = false;
+    }
+    numPatchesSkipped = std::count(patchMayMatch.begin(), patchMayMatch.end(), false);
+
+    for (size_t c = 0; c < conditions.size(); ++c)
+    {
+        const double unit = options.useSI ? file.getUnitSI(speciesPath + conditions[c].component) : 1.0;
+        const std::string chunkPath = statisticsPath + "chunks/" + conditions[c].component;
+        const std::vector<double> chunkMin = file.readAll(chunkPath + "/min");
+        const std::vector<double> chunkMax = file.readAll(chunkPath + "/max");
+        for (size_t i = 0; i < chunkMin.size(); ++i)
+        {
+            const double a = chunkMin[i] * unit;
+            const double b = chunkMax[i] * unit;
+            if (chunkMin[i] > chunkMax[i] || !conditions[c].mayMatch(std::min(a, b), std::max(a, b)))
+                chunkMayMatch[i] = false;
+        }
+    }
+
+    for (size_t i = 0; i < chunkNumParticles.size(); ++i)
+    {
+        if (chunkMayMatch[i])
+        {
+            Chunk chunk = {uint64_t(chunkOffsets[i]), uint64_t(chunkNumParticles[i])};
+            chunks.push_back(chunk);
+        }
+    }
+    return chunks;
+}
+
+/** a column of the output, integers are not converted to double */
+struct Column
+{
+    std::string component;
+    bool isInteger;
+    double unit;
+    std::vector<double> floatValues;
+    std::vector<int64_t> intValues;
+};
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    int rank = 0;
+    int numRanks = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+
+    Options options;
+    if (!parseCmdLine(argc, argv, options, rank))
+    {
+        MPI_Finalize();
+        return 1;
+    }
+
+    int exitCode = 0;
+    try
+    {
+        std::vector<Condition> conditions;
+        for (size_t i = 0; i < options.conditions.size(); ++i)
+            conditions.push_back(parseCondition(options.conditions[i]));
+        if (options.columns.empty())
+            for (size_t i = 0; i < conditions.size(); ++i)
+                if (std::find(options.columns.begin(), options.columns.end(), conditions[i].component) == options.columns.end())
+                    options.columns.push_back(conditions[i].component);
+
+        ParticleFile file(options.inputFile);
+        const std::string speciesPath = "particles/" + options.species + "/";
+
+        /* every rank evaluates the (small) statistics itself */
+        uint64_t numChunksTotal = 0;
+        uint64_t numPatchesSkipped = 0;
+        const std::vector<Chunk> chunks =
+            selectChunks(file, options, conditions, speciesPath, numChunksTotal, numPatchesSkipped);
+
+        std::vector<double> conditionUnits(conditions.size(), 1.0);
+        std::vector<Column> columns(options.columns.size());
+        for (size_t c = 0; c < conditions.size(); ++c)
+            if (options.useSI)
+                conditionUnits[c] = file.getUnitSI(speciesPath + conditions[c].component);
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            columns[c].component = options.columns[c];
+            columns[c].isInteger = file.isInteger(speciesPath + columns[c].component) && !options.useSI;
+            columns[c].unit = options.useSI ? file.getUnitSI(speciesPath + columns[c].component) : 1.0;
+        }
+
+        std::ofstream output;
+        if (!options.outputPrefix.empty())
+        {
+            std::stringstream filename;
+            filename << options.outputPrefix << "_" << rank << ".dat";
+            output.open(filename.str().c_str());
+            output << "#";
+            for (size_t c = 0; c < columns.size(); ++c)
+                output << " " << columns[c].component;
+            output << std::endl;
+            output << std::setprecision(16);
+        }
+
+        /* round robin distribution of the selected chunks */
+        uint64_t numParticlesRead = 0;
+        uint64_t numMatches = 0;
+        for (size_t i = rank; i < chunks.size(); i += numRanks)
+        {
+            const Chunk& chunk = chunks[i];
+            if (options.verbose)
+                std::cerr << "rank " << rank << ": chunk " << chunk.offset << " + " << chunk.numParticles << std::endl;
+
+            std::vector<bool> isMatch(chunk.numParticles, true);
+            for (size_t c = 0; c < conditions.size(); ++c)
+            {
+                const std::vector<double> values = file.read<double>(
+                    speciesPath + conditions[c].component, H5T_NATIVE_DOUBLE, chunk.offset, chunk.numParticles);
+                for (uint64_t p = 0; p < chunk.numParticles; ++p)
+                    isMatch[p] = isMatch[p] && conditions[c].matches(values[p] * conditionUnits[c]);
+            }
+            numParticlesRead += chunk.numParticles;
+
+            const uint64_t numChunkMatches = std::count(isMatch.begin(), isMatch.end(), true);
+            numMatches += numChunkMatches;
+            if (numChunkMatches == 0 || !output.is_open())
+                continue;
+
+            for (size_t c = 0; c < columns.size(); ++c)
+            {
+                if (columns[c].isInteger)
+                    columns[c].intValues = file.read<int64_t>(
+                        speciesPath + columns[c].component, H5T_NATIVE_INT64, chunk.offset, chunk.numParticles);
+                else
+                    columns[c].floatValues = file.read<double>(
+                        speciesPath + columns[c].component, H5T_NATIVE_DOUBLE, chunk.offset, chunk.numParticles);
+            }
+            for (uint64_t p = 0; p < chunk.numParticles; ++p)
+            {
+                if (!isMatch[p])
+                    continue;
+                for (size_t c = 0; c < columns.size(); ++c)
+                {
+                    if (c != 0)
+                        output << " ";
+                    if (columns[c].isInteger)
+                        output << columns[c].intValues[p];
+                    else
+                        output << columns[c].floatValues[p] * columns[c].unit;
+                }
+                output << std::endl;
+            }
+        }
+
+        uint64_t localCounts[3] = {numParticlesRead, numMatches, file.getBytesRead()};
+        uint64_t globalCounts[3] = {0, 0, 0};
+        MPI_Reduce(localCounts, globalCounts, 3, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+
+        if (rank == 0)
+        {
+            std::cout << "chunks: " << chunks.size() << " of " << numChunksTotal << " read"
+                      << " (" << numPatchesSkipped << " patches skipped)" << std::endl;
+            std::cout << "particles read: " << globalCounts[0] << std::endl;
+            std::cout << "bytes read: " << globalCounts[2] << std::endl;
+            std::cout << "matching particles: " << globalCounts[1] << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "rank " << rank << ": " << e.what() << std::endl;
+        exitCode = 1;
+        MPI_Abort(MPI_COMM_WORLD, exitCode);
+    }
+
+    MPI_Finalize();
+    return exitCode;
+}
@@ -18,8 +18,14 @@
  */
 
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <stdexcept>
 #include <pngwriter.h>
 #include <splash/splash.h>
 #include <mpi.h>
@@ -30,12 +36,15 @@ namespace po = boost::program_options;
 
 typedef struct
 {
-    std::string filename;
+    std::vector<std::string> filenames;
     std::string densityFilename;
     std::string densityDataset;
     int iteration;
     Dimensions dataSize;
     Dimensions dataOffset;
+    bool resample;
+    bool compress;
+    size_t slicesPerWrite;
 } Options;
 
 bool parseCmdLine(int argc, char **argv, Options &options)
@@ -43,14 +52,15 @@ bool parseCmdLine(int argc, char **argv, Options &options)
     try
     {
         std::vector<size_t> sizes, offset;
-        options.filename = "";
         options.densityFilename = "gas";
         options.densityDataset = "fields/e_chargeDensity";
         options.dataOffset.set(0, 0, 0);
         options.iteration = 0;
+        options.slicesPerWrite = 16;
 
         std::stringstream desc_stream;
-        desc_stream << "Usage " << argv[0] << " <png-file> -g width height depth [options]" << std::endl;
+        desc_stream << "Usage " << argv[0] << " <png-file> [<png-file> ...] -g width height depth [options]" << std::endl
+                    << "  one png file is extruded along z, several png files are the z slices of a 3D stack" << std::endl;
 
         // add possible options
         po::options_description desc(desc_stream.str());
@@ -58,7 +68,13 @@ bool parseCmdLine(int argc, char **argv, Options &options)
                 ("help,h", "print help message")
                 ("grid,g", po::value<std::vector<size_t> > (&sizes)->multitoken(), "3D Grid dimensions")
                 ("offset", po::value<std::vector<size_t> > (&offset)->multitoken(), "3D Grid offset, default (0,0,0)")
-                ("png", po::value<std::string > (&options.filename), "Input PNG file")
+                ("png", po::value<std::vector<std::string> > (&options.filenames), "Input PNG file(s), one per z slice")
+                ("resample,r", po::bool_switch(&options.resample)->default_value(false),
+                "Resample the images to the grid: bilinear within a slice, linear between slices")
+                ("slices-per-write", po::value<size_t > (&options.slicesPerWrite)->default_value(options.slicesPerWrite),
+                "Number of z slices each rank creates before they are written")
+                ("compress", po::bool_switch(&options.compress)->default_value(false),
+                "Enable compression of the HDF5 dataset")
                 ("iteration,i", po::value<int > (&options.iteration)->default_value(options.iteration),
                 "Iteration (timestep) for density data")
                 ("output,o", po::value<std::string > (&options.densityFilename)->default_value(options.densityFilename),
@@ -68,7 +84,7 @@ bool parseCmdLine(int argc, char **argv, Options &options)
                 ;
 
         po::positional_options_description pos_options_descr;
-        pos_options_descr.add("png", 1);
+        pos_options_descr.add("png", -1);
 
         po::variables_map vm;
         po::store(po::command_line_parser(argc, argv).options(desc).positional(pos_options_descr).run(), vm);
@@ -81,9 +97,9 @@ bool parseCmdLine(int argc, char **argv, Options &options)
             return false;
         }
 
-        if (vm.count("png") != 1)
+        if (options.filenames.empty())
         {
-            std::cerr << "Error: Please specify exactly one input PNG file." << std::endl;
+            std::cerr << "Error: Please specify at least one input PNG file." << std::endl;
             std::cerr << std::endl << desc << std::endl;
             return false;
         }
@@ -97,6 +113,16 @@ bool parseCmdLine(int argc, char **argv, Options &options)
 
         options.dataSize.set(sizes[0], sizes[1], sizes[2]);
 
+        if (options.filenames.size() > 1 && !options.resample && options.filenames.size() != sizes[2])
+        {
+            std::cerr << "Error: The number of PNG files (" << options.filenames.size() <<
+                    ") must match the grid depth or --resample must be set." << std::endl;
+            return false;
+        }
+
+        if (options.slicesPerWrite == 0)
+            options.slicesPerWrite = 1;
+
         if (vm.count("offset"))
         {
             if (offset.size() != 3)
@@ -119,89 +145,257 @@ bool parseCmdLine(int argc, char **argv, Options &options)
     return true;
 }
 
-int main(int argc, char **argv)
+/** normalized density of one PNG file
+ *
+ * The Value component of the image in HSV colorspace is the density.
+ * Row r of the image (counted from the top) is x, column c is y.
+ */
+struct Slice
 {
-    Options options;
-    if (!parseCmdLine(argc, argv, options))
-        return -1;
+    size_t height;
+    size_t width;
+    std::vector<float> values;
 
-    MPI_Init(nullptr, nullptr);
+    float get(const size_t r, const size_t c) const
+    {
+        return values[r * width + c];
+    }
+};
 
-    Dimensions data_size(options.dataSize);
-    std::cout << "Creating density data with size " << data_size.toString() << std::endl;
+bool readSlice(const std::string& filename, Slice& slice)
+{
+    pngwriter image;
+    image.readfromfile(filename.c_str());
+    if (image.getwidth() <= 0 || image.getheight() <= 0)
+        return false;
 
-    std::cout << " Reading PNG file '" << options.filename << "'" << std::endl;
-    pngwriter image(data_size[1], data_size[0], 0, (options.filename + std::string(".tmp")).c_str());
-    image.readfromfile(options.filename.c_str());
+    slice.height = image.getheight();
+    slice.width = image.getwidth();
+    slice.values.resize(slice.height * slice.width);
+    for (size_t r = 0; r < slice.height; ++r)
+        for (size_t c = 0; c < slice.width; ++c)
+        {
+            /* pngwriter coordinates start at (1,1) and the y direction is inverted */
+            slice.values[r * slice.width + c] = image.dreadHSV(1 + c, slice.height - r, 3);
+        }
+    return true;
+}
+
+/** position in the source for a cell of the target grid, cell centered
+ *
+ * @return lower source index, `weight` is the weight of the upper index
+ */
+size_t getSourceIndex(const size_t targetIdx, const size_t targetSize, const size_t sourceSize, float& weight)
+{
+    const double pos = (double(targetIdx) + 0.5) * double(sourceSize) / double(targetSize) - 0.5;
+    const double clamped = std::min(std::max(pos, 0.0), double(sourceSize - 1));
+    const size_t lower = std::min(size_t(clamped), sourceSize - 1);
+    weight = float(clamped - double(lower));
+    return lower;
+}
 
-    if (image.getwidth() != (int) data_size[1] || image.getheight() != (int) data_size[0])
+/** slices of the input stack which are currently needed, loaded on demand */
+class SliceCache
+{
+public:
+
+    SliceCache(const std::vector<std::string>& filenames) : filenames(filenames)
     {
-        image.close();
-        std::cerr << "Invalid image size (" << image.getwidth() << "," <<
-                image.getheight() << ") for data size" << std::endl;
-        MPI_Finalize();
-        return -1;
     }
 
-    float *data = new float[data_size.getScalarSize()];
-    memset(data, 0, data_size.getScalarSize() * sizeof (float));
+    const Slice& get(const size_t idx)
+    {
+        std::map<size_t, Slice>::iterator it = slices.find(idx);
+        if (it != slices.end())
+            return it->second;
+
+        Slice& slice = slices[idx];
+        if (!readSlice(filenames.at(idx), slice))
+            throw std::runtime_error("could not read PNG file '" + filenames.at(idx) + "'");
+        return slice;
+    }
 
-    for (size_t x = 0; x < data_size[0]; ++x)
-        for (size_t y = 0; y < data_size[1]; ++y)
-        {
-            /* pngwriter coordinates start at (1,1) and the y direction is inverted */
-            int pos_x = 1 + y;
-            int pos_y = 1 + (data_size[0] - x - 1);
+    /** drop all slices before idx, slices are requested in increasing order */
+    void release(const size_t idx)
+    {
+        slices.erase(slices.begin(), slices.lower_bound(idx));
+    }
+
+private:
+
+    const std::vector<std::string>& filenames;
+    std::map<size_t, Slice> slices;
+};
+
+/** fill one z slice of the target grid (x fastest)
+ *
+ * @param lower, upper source slices, upper is weighted with zWeight
+ */
+bool createTargetSlice(const Options& options, const Slice& lower, const Slice& upper,
+                       const float zWeight, float* target)
+{
+    const size_t sizeX = options.dataSize[0];
+    const size_t sizeY = options.dataSize[1];
 
-            double color = image.dreadHSV(pos_x, pos_y, 3);
+    if (!options.resample)
+    {
+        if (lower.height != sizeX || lower.width != sizeY)
+            return false;
+        for (size_t y = 0; y < sizeY; ++y)
+            for (size_t x = 0; x < sizeX; ++x)
+                target[y * sizeX + x] = lower.get(x, y);
+        return true;
+    }
 
-            image.plot(pos_x, pos_y, color, color, color);
+    if (lower.height != upper.height || lower.width != upper.width)
+        return false;
 
-            for (size_t z = 0; z < data_size[2]; ++z)
+    #pragma omp parallel for
+    for (size_t y = 0; y < sizeY; ++y)
+    {
+        float wc;
+        const size_t c0 = getSourceIndex(y, sizeY, lower.width, wc);
+        const size_t c1 = std::min(c0 + 1, lower.width - 1);
+        for (size_t x = 0; x < sizeX; ++x)
+        {
+            float wr;
+            const size_t r0 = getSourceIndex(x, sizeX, lower.height, wr);
+            const size_t r1 = std::min(r0 + 1, lower.height - 1);
+
+            float value = 0.0f;
+            const Slice* slices[2] = {&lower, &upper};
+            const float sliceWeights[2] = {1.0f - zWeight, zWeight};
+            for (int s = 0; s < 2; ++s)
             {
-                size_t index = z * (data_size[0] * data_size[1]) + y * data_size[0] + x;
-                data[index] = color;
+                const Slice& src = *slices[s];
+                const float bilinear =
+                    (1.0f - wr) * ((1.0f - wc) * src.get(r0, c0) + wc * src.get(r0, c1)) +
+                    wr * ((1.0f - wc) * src.get(r1, c0) + wc * src.get(r1, c1));
+                value += sliceWeights[s] * bilinear;
             }
+            target[y * sizeX + x] = value;
         }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseCmdLine(argc, argv, options))
+        return -1;
 
-    /* write and close the output png */
-    image.close();
+    MPI_Init(nullptr, nullptr);
 
-    std::cout << " Creating density HDF5 file '" << options.densityFilename << "_" <<
-            options.iteration << ".h5'" << std::endl;
+    int mpiRank = 0;
+    int mpiSize = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+
+    Dimensions data_size(options.dataSize);
+    const size_t numSlices = options.filenames.size();
+    if (mpiRank == 0)
+        std::cout << "Creating density data with size " << data_size.toString() <<
+                " from " << numSlices << " PNG file(s) on " << mpiSize << " rank(s)" << std::endl;
+
+    /* every rank creates a contiguous block of z slices */
+    const size_t sliceSize = data_size[0] * data_size[1];
+    const size_t zBegin = data_size[2] * mpiRank / mpiSize;
+    const size_t zEnd = data_size[2] * (mpiRank + 1) / mpiSize;
+
+    /* all ranks have to take part in each collective write */
+    const uint64_t numLocalWrites =
+            (zEnd - zBegin + options.slicesPerWrite - 1) / options.slicesPerWrite;
+    uint64_t numWrites = 0;
+    MPI_Allreduce(&numLocalWrites, &numWrites, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+
+    if (mpiRank == 0)
+        std::cout << " Creating density HDF5 file '" << options.densityFilename << "_" <<
+                options.iteration << ".h5'" << std::endl;
 
     /* write density information to HDF5 */
     ParallelDomainCollector *pdc = new
-            ParallelDomainCollector(MPI_COMM_WORLD, MPI_INFO_NULL, Dimensions(1, 1, 1), 1);
+            ParallelDomainCollector(MPI_COMM_WORLD, MPI_INFO_NULL, Dimensions(1, 1, mpiSize), 1);
     DataCollector::FileCreationAttr attr;
     DataCollector::initFileCreationAttr(attr);
+    attr.enableCompression = options.compress;
+    attr.mpiPosition.set(0, 0, mpiRank);
     pdc->open(options.densityFilename.c_str(), attr);
 
     ColTypeFloat ctFloat;
-    pdc->writeDomain(
+    pdc->reserveDomain(
             options.iteration,
-            ctFloat,
+            data_size,
             data_size.getDims(),
-            Selection(data_size),
+            ctFloat,
             options.densityDataset.c_str(),
             Domain(
                    options.dataOffset,
                    data_size
             ),
-            Domain(
-                   options.dataOffset,
-                   data_size
-            ),
-            DomainCollector::GridType,
-            data);
+            DomainCollector::GridType);
+
+    SliceCache cache(options.filenames);
+    std::vector<float> data(sliceSize * options.slicesPerWrite);
+    int errorCode = 0;
+
+    for (size_t w = 0; w < numWrites; ++w)
+    {
+        const size_t batchBegin = std::min(zEnd, zBegin + w * options.slicesPerWrite);
+        const size_t batchEnd = std::min(zEnd, batchBegin + options.slicesPerWrite);
+
+        try
+        {
+            for (size_t z = batchBegin; z < batchEnd && errorCode == 0; ++z)
+            {
+                size_t lowerIdx = 0;
+                float zWeight = 0.0f;
+                if (numSlices > 1)
+                {
+                    if (options.resample)
+                        lowerIdx = getSourceIndex(z, data_size[2], numSlices, zWeight);
+                    else
+                        lowerIdx = z;
+                }
+                const size_t upperIdx = std::min(lowerIdx + 1, numSlices - 1);
+                cache.release(lowerIdx);
+
+                if (!createTargetSlice(options, cache.get(lowerIdx), cache.get(upperIdx), zWeight,
+                                       &data[(z - batchBegin) * sliceSize]))
+                {
+                    std::cerr << "Invalid image size (" << cache.get(lowerIdx).width << "," <<
+                            cache.get(lowerIdx).height << ") for data size, use --resample" << std::endl;
+                    errorCode = -1;
+                }
+            }
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::cerr << e.what() << std::endl;
+            errorCode = -1;
+        }
+
+        /* write the slices of this batch, ranks without slices write nothing */
+        pdc->append(
+                options.iteration,
+                Dimensions(data_size[0], data_size[1], batchEnd - batchBegin),
+                data_size.getDims(),
+                Dimensions(0, 0, batchBegin),
+                options.densityDataset.c_str(),
+                &(data[0]));
+
+        if (mpiRank == 0)
+            std::cout << "  wrote part " << (w + 1) << " of " << numWrites << std::endl;
+    }
 
     pdc->close();
     pdc->finalize();
     delete pdc;
 
-    delete[] data;
+    int globalErrorCode = 0;
+    MPI_Allreduce(&errorCode, &globalErrorCode, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
 
     MPI_Finalize();
 
-    return 0;
+    return globalErrorCode;
 }
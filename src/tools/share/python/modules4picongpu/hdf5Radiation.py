@@ -21,7 +21,7 @@ import h5py
 
 
 class radiationHDF5:
-    def __init__(self, filename):
+    def __init__(self, filename, record="Amplitude"):
         """
         Open references to hdf5 file to access radiation data.
 
@@ -32,6 +32,9 @@ class radiationHDF5:
         Key-Argument:
         filename: string
                   path and name of the hdf5 radiation data file
+        record: string
+                name of the amplitude record, e.g. "Amplitude_pos_0_128_0"
+                for per GPU data (see get_records())
 
         """
         # set hdf5 file
@@ -40,26 +43,27 @@ class radiationHDF5:
         # extract time step
         self.timestep = self.get_timestep()
 
+        mesh_path = "/data/{}/DetectorMesh/{}".format(self.timestep, record)
+
         # Amplitude
         # A_x
-        self.h5_Ax_Re = self.h5_file["/data/{}/DetectorMesh".format(self.timestep) +
-                                     "/Amplitude/x_Re"]
-        self.h5_Ax_Im = self.h5_file["/data/{}/DetectorMesh".format(self.timestep) +
-                                     "/Amplitude/x_Im"]
+        self.h5_Ax_Re = self.h5_file[mesh_path + "/x_Re"]
+        self.h5_Ax_Im = self.h5_file[mesh_path + "/x_Im"]
         # A_y
-        self.h5_Ay_Re = self.h5_file["/data/{}/DetectorMesh".format(self.timestep) +
-                                     "/Amplitude/y_Re"]
-        self.h5_Ay_Im = self.h5_file["/data/{}/DetectorMesh".format(self.timestep) +
-                                     "/Amplitude/y_Im"]
+        self.h5_Ay_Re = self.h5_file[mesh_path + "/y_Re"]
+        self.h5_Ay_Im = self.h5_file[mesh_path + "/y_Im"]
         # A_z
-        self.h5_Az_Re = self.h5_file["/data/{}/DetectorMesh".format(self.timestep) +
-                                     "/Amplitude/z_Re"]
-        self.h5_Az_Im = self.h5_file["/data/{}/DetectorMesh".format(self.timestep) +
-                                     "/Amplitude/z_Im"]
+        self.h5_Az_Re = self.h5_file[mesh_path + "/z_Re"]
+        self.h5_Az_Im = self.h5_file[mesh_path + "/z_Im"]
 
         # conversion factor for spectra from PIC units to SI units
-        self.convert_to_SI = self.h5_file["/data/{}/DetectorMesh".format(self.timestep) +
-                                          "/Amplitude"].attrs['unitSI']
+        self.convert_to_SI = self.h5_file[mesh_path].attrs['unitSI']
+
+    def get_records(self):
+        """Returns the names of all amplitude records in the file."""
+        mesh = self.h5_file["/data/{}/DetectorMesh".format(self.timestep)]
+        return sorted([name for name in mesh.keys()
+                       if name.startswith("Amplitude")])
 
     def get_timestep(self):
         """Returns simulation timestep of the hdf5 data."""